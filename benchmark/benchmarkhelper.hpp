@@ -0,0 +1,32 @@
+#ifndef THZ_BENCHMARK_COMMON_BENCHMARKHELPER_HPP
+#define THZ_BENCHMARK_COMMON_BENCHMARKHELPER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+namespace Terrahertz::Benchmarks {
+
+/// @brief Shortcut to the clock used for measuring benchmarks.
+using BenchmarkClock = std::chrono::steady_clock;
+
+/// @brief Prints the rate of operations per second for a benchmark run.
+///
+/// @param name The name of the measured operation.
+/// @param operations The number of operations performed.
+/// @param duration The time it took to perform the operations.
+inline void reportRate(std::string_view const         name,
+                       std::uint64_t const            operations,
+                       BenchmarkClock::duration const duration) noexcept
+{
+    auto const seconds = std::chrono::duration<double>(duration).count();
+    auto const rate    = (seconds > 0.0) ? (static_cast<double>(operations) / seconds) : 0.0;
+    std::cout << "[ BENCHMARK] " << name << ": " << static_cast<std::uint64_t>(rate) << " ops/s (" << operations
+              << " ops in " << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << " ms)"
+              << std::endl;
+}
+
+} // namespace Terrahertz::Benchmarks
+
+#endif // !THZ_BENCHMARK_COMMON_BENCHMARKHELPER_HPP
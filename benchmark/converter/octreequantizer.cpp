@@ -0,0 +1,102 @@
+#include "THzCommon/converter/octreequantizer.hpp"
+
+#include "../benchmarkhelper.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+
+struct ConverterOctreeQuantizer : public testing::Test
+{
+    /// @brief The width of the frames, 4K UHD.
+    static constexpr std::uint32_t Width = 3840U;
+
+    /// @brief The height of the frames, 4K UHD.
+    static constexpr std::uint32_t Height = 2160U;
+
+    /// @brief The number of frames quantized.
+    static constexpr std::size_t Rounds = 3U;
+
+    /// @brief The number of colors of the palette.
+    static constexpr std::size_t Colors = 256U;
+
+    /// @brief Creates a frame of smooth gradients with a little noise, like a photo.
+    ///
+    /// @return The pixels of the frame.
+    static std::vector<std::uint8_t> createFrame() noexcept
+    {
+        std::mt19937                                rng{42U};
+        std::uniform_int_distribution<std::int32_t> noise{-8, 8};
+        std::vector<std::uint8_t>                   pixels(std::size_t{Width} * Height * 3U);
+
+        auto const channel = [&](std::uint32_t const value) noexcept {
+            return static_cast<std::uint8_t>(std::clamp(static_cast<std::int32_t>(value % 256U) + noise(rng), 0, 255));
+        };
+        for (std::uint32_t y = 0U; y < Height; ++y)
+        {
+            for (std::uint32_t x = 0U; x < Width; ++x)
+            {
+                auto const i   = ((std::size_t{y} * Width) + x) * 3U;
+                pixels[i]      = channel((x * 256U) / Width);
+                pixels[i + 1U] = channel((y * 256U) / Height);
+                pixels[i + 2U] = channel((x + y) / 16U);
+            }
+        }
+        return pixels;
+    }
+
+    /// @brief Quantizes the frame a few times using the given quantizer.
+    ///
+    /// @param prefix The prefix of the names of the runs.
+    /// @param quantizer The quantizer to use.
+    void run(std::string_view const prefix, OctreeQuantizer &quantizer) noexcept
+    {
+        auto const                frame = std::size_t{Width} * Height;
+        std::vector<std::uint8_t> indices(frame);
+        BenchmarkClock::duration  add{};
+        BenchmarkClock::duration  reduce{};
+        BenchmarkClock::duration  map{};
+        for (std::size_t round = 0U; round < Rounds; ++round)
+        {
+            quantizer.reset();
+            auto start = BenchmarkClock::now();
+            EXPECT_TRUE(quantizer.addPixels(pixels, Width, Height));
+            add += BenchmarkClock::now() - start;
+
+            start = BenchmarkClock::now();
+            EXPECT_EQ(quantizer.reducePalette(Colors).size(), Colors);
+            reduce += BenchmarkClock::now() - start;
+
+            start = BenchmarkClock::now();
+            EXPECT_TRUE(quantizer.mapPixels(pixels, Width, Height, 3U, indices));
+            map += BenchmarkClock::now() - start;
+        }
+        reportRate(std::string{prefix} + "addPixels", frame * Rounds, add);
+        reportRate(std::string{prefix} + "reducePalette", Rounds, reduce);
+        reportRate(std::string{prefix} + "mapPixels", frame * Rounds, map);
+    }
+
+    std::vector<std::uint8_t> pixels{createFrame()};
+};
+
+TEST_F(ConverterOctreeQuantizer, Sequential)
+{
+    OctreeQuantizer quantizer{};
+    run("", quantizer);
+}
+
+TEST_F(ConverterOctreeQuantizer, Parallel)
+{
+    ThreadPool      pool{std::max(std::thread::hardware_concurrency(), 2U)};
+    OctreeQuantizer quantizer{&pool};
+    run("parallel ", quantizer);
+}
+
+} // namespace Terrahertz::Benchmarks
@@ -0,0 +1,89 @@
+#include "THzCommon/memory/backingstorage.hpp"
+
+#include "../benchmarkhelper.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace Terrahertz::Benchmarks {
+
+struct MemoryBackingStorage : public testing::Test
+{
+    /// @brief The size of the region the accesses are spread over.
+    static constexpr std::size_t RegionSize = std::size_t{256U} << 20U;
+
+    /// @brief The distance between two slots of the chain, a cache line so every access misses.
+    static constexpr std::size_t SlotSize = 64U;
+
+    /// @brief The number of dependent accesses measured per run.
+    static constexpr std::uint64_t Accesses = 10000000U;
+
+    /// @brief Measures the latency of random accesses to a region mapped with the given policy.
+    ///
+    /// @param name The name of the run.
+    /// @param policy The policy to map the region with.
+    void run(std::string const &name, StoragePolicy const &policy) noexcept
+    {
+        BackingStorage storage{RegionSize, policy};
+        ASSERT_TRUE(storage.good());
+
+        // links all slots into a single random cycle (Sattolo), so every load depends on the previous one
+        auto const slots = storage.size() / SlotSize;
+        auto const link  = [&](std::size_t const slot) noexcept -> std::uint64_t & {
+            return *reinterpret_cast<std::uint64_t *>(storage.data() + (slot * SlotSize));
+        };
+        for (std::size_t slot = 0U; slot < slots; ++slot)
+        {
+            link(slot) = slot;
+        }
+        for (std::size_t i = slots - 1U; i > 0U; --i)
+        {
+            std::uniform_int_distribution<std::size_t> distrib{0U, i - 1U};
+            std::swap(link(i), link(distrib(randomEngine)));
+        }
+
+        std::uint64_t slot{};
+        auto const    start = BenchmarkClock::now();
+        for (std::uint64_t i = 0U; i < Accesses; ++i)
+        {
+            slot = link(slot);
+        }
+        auto const duration = BenchmarkClock::now() - start;
+        EXPECT_LT(slot, slots);
+
+        auto const &applied = storage.applied();
+        auto const  pages   = (applied.pages == PageKind::Huge)              ? "huge"
+                              : (applied.pages == PageKind::TransparentHuge) ? "transparent huge"
+                                                                             : "regular";
+        reportRate(name + " (applied: " + pages + " pages" + (applied.locked ? ", locked" : "") +
+                       ((applied.numaNode >= 0) ? (", node " + std::to_string(applied.numaNode)) : std::string{}) +
+                       ")",
+                   Accesses,
+                   duration);
+        std::cout << "[ BENCHMARK]   "
+                  << (std::chrono::duration<double, std::nano>(duration).count() / static_cast<double>(Accesses))
+                  << " ns per access" << std::endl;
+    }
+
+    std::mt19937_64 randomEngine{1337};
+};
+
+TEST_F(MemoryBackingStorage, RegularPages) { run("regular pages", StoragePolicy{}); }
+
+TEST_F(MemoryBackingStorage, TransparentHugePages)
+{
+    run("transparent huge pages", StoragePolicy{PageKind::TransparentHuge});
+}
+
+TEST_F(MemoryBackingStorage, HugePages) { run("huge pages", StoragePolicy{PageKind::Huge}); }
+
+TEST_F(MemoryBackingStorage, LockedPages) { run("locked pages", StoragePolicy{PageKind::Regular, true}); }
+
+TEST_F(MemoryBackingStorage, BoundToNode) { run("bound to node 0", StoragePolicy{PageKind::Regular, false, 0}); }
+
+} // namespace Terrahertz::Benchmarks
@@ -0,0 +1,111 @@
+#include "THzCommon/memory/fixedblockpool.hpp"
+
+#include "../benchmarkhelper.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+
+struct MemoryFixedBlockPool : public testing::Test
+{
+    /// @brief The number of allocations performed per run, shared by all threads.
+    static constexpr std::uint64_t Count = 8000000U;
+
+    /// @brief The size of a message buffer.
+    static constexpr std::size_t BufferSize = 1500U;
+
+    /// @brief The number of buffers each thread holds at the same time.
+    static constexpr std::size_t InFlight = 16U;
+
+    /// @brief Allocates and deallocates buffers on the given number of threads.
+    ///
+    /// @param name The name of the run.
+    /// @param threads The number of threads.
+    /// @param allocate Allocates a single buffer.
+    /// @param deallocate Deallocates a single buffer.
+    template <typename TAllocate, typename TDeallocate>
+    void run(std::string const &name, std::size_t const threads, TAllocate allocate, TDeallocate deallocate) noexcept
+    {
+        auto const perThread = Count / threads;
+
+        std::vector<std::thread> workers{};
+        auto const               start = BenchmarkClock::now();
+        for (std::size_t t = 0U; t < threads; ++t)
+        {
+            workers.emplace_back([&]() noexcept {
+                std::array<char *, InFlight> held{};
+                for (std::uint64_t i = 0U; i < perThread; ++i)
+                {
+                    auto &slot = held[i % InFlight];
+                    if (slot != nullptr)
+                    {
+                        deallocate(slot);
+                    }
+                    slot    = allocate();
+                    slot[0] = static_cast<char>(i);
+                }
+                for (auto const slot : held)
+                {
+                    if (slot != nullptr)
+                    {
+                        deallocate(slot);
+                    }
+                }
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        auto const duration = BenchmarkClock::now() - start;
+        reportRate(name + " on " + std::to_string(threads) + " thread(s)", threads * perThread, duration);
+    }
+
+    /// @brief Returns the thread counts to measure, doubling from 1 up to the number of hardware threads.
+    ///
+    /// @return The thread counts to measure.
+    static std::vector<std::size_t> threadCounts() noexcept
+    {
+        std::vector<std::size_t> counts{};
+        auto const               hardwareThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 2U);
+        for (std::size_t threads = 1U; threads <= hardwareThreads; threads *= 2U)
+        {
+            counts.emplace_back(threads);
+        }
+        return counts;
+    }
+};
+
+TEST_F(MemoryFixedBlockPool, FixedBlockPool)
+{
+    for (auto const threads : threadCounts())
+    {
+        FixedBlockPool pool{BufferSize, threads * InFlight};
+        run(
+            "FixedBlockPool",
+            threads,
+            [&]() { return pool.allocate(BufferSize); },
+            [&](char *const p) noexcept { pool.deallocate(p, BufferSize); });
+        EXPECT_EQ(pool.usedSpace(), 0U);
+    }
+}
+
+TEST_F(MemoryFixedBlockPool, GlobalHeap)
+{
+    for (auto const threads : threadCounts())
+    {
+        run(
+            "new/delete",
+            threads,
+            []() { return new char[BufferSize]; },
+            [](char *const p) noexcept { delete[] p; });
+    }
+}
+
+} // namespace Terrahertz::Benchmarks
@@ -0,0 +1,79 @@
+#include "THzCommon/memory/monotonicarena.hpp"
+
+#include "../benchmarkhelper.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+
+struct MemoryMonotonicArena : public testing::Test
+{
+    /// @brief The number of requests handled per run.
+    static constexpr std::uint64_t Requests = 200000U;
+
+    /// @brief The number of entries each request builds.
+    static constexpr std::size_t Entries = 32U;
+
+    /// @brief Builds the short-lived containers of a single request, like parsing a small configuration.
+    ///
+    /// @tparam TAllocator The type of allocator for the characters of the strings.
+    /// @param allocator The allocator to use.
+    /// @return The number of entries built.
+    template <typename TAllocator>
+    static std::size_t handleRequest(TAllocator const &allocator) noexcept
+    {
+        using String      = std::basic_string<char, std::char_traits<char>, TAllocator>;
+        using Traits      = std::allocator_traits<TAllocator>;
+        using StringAlloc = typename Traits::template rebind_alloc<String>;
+        using PairAlloc   = typename Traits::template rebind_alloc<std::pair<String const, String>>;
+
+        std::vector<String, StringAlloc>                 lines{StringAlloc{allocator}};
+        std::map<String, String, std::less<>, PairAlloc> entries{PairAlloc{allocator}};
+        for (std::size_t i = 0U; i < Entries; ++i)
+        {
+            lines.emplace_back("section.subsection.key" + std::to_string(i) + " = some value of the entry", allocator);
+        }
+        for (auto const &line : lines)
+        {
+            auto const separator = line.find('=');
+            entries.emplace(String{line, 0U, separator, allocator}, String{line, separator, String::npos, allocator});
+        }
+        return entries.size();
+    }
+};
+
+TEST_F(MemoryMonotonicArena, GlobalHeap)
+{
+    std::size_t entries{};
+    auto const  start = BenchmarkClock::now();
+    for (std::uint64_t i = 0U; i < Requests; ++i)
+    {
+        entries += handleRequest(std::allocator<char>{});
+    }
+    auto const duration = BenchmarkClock::now() - start;
+    EXPECT_EQ(entries, Requests * Entries);
+    reportRate("requests using std::allocator", Requests, duration);
+}
+
+TEST_F(MemoryMonotonicArena, ArenaResetPerRequest)
+{
+    MonotonicArena arena{};
+    std::size_t    entries{};
+    auto const     start = BenchmarkClock::now();
+    for (std::uint64_t i = 0U; i < Requests; ++i)
+    {
+        entries += handleRequest(ArenaAllocator<char>{arena});
+        arena.reset();
+    }
+    auto const duration = BenchmarkClock::now() - start;
+    EXPECT_EQ(entries, Requests * Entries);
+    reportRate("requests using ArenaAllocator", Requests, duration);
+}
+
+} // namespace Terrahertz::Benchmarks
@@ -0,0 +1,111 @@
+#include "THzCommon/memory/slabpool.hpp"
+
+#include "../benchmarkhelper.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+
+struct MemorySlabPool : public testing::Test
+{
+    /// @brief The number of allocations performed per run, shared by all threads.
+    static constexpr std::uint64_t Count = 8000000U;
+
+    /// @brief The number of buffers each thread holds at the same time.
+    static constexpr std::size_t InFlight = 64U;
+
+    /// @brief Allocates and deallocates buffers between 1 and 4096 bytes on the given number of threads.
+    ///
+    /// @param name The name of the run.
+    /// @param threads The number of threads.
+    /// @param allocate Allocates a buffer of the given size.
+    /// @param deallocate Deallocates a buffer of the given size.
+    template <typename TAllocate, typename TDeallocate>
+    void run(std::string const &name, std::size_t const threads, TAllocate allocate, TDeallocate deallocate) noexcept
+    {
+        auto const perThread = Count / threads;
+
+        std::vector<std::thread> workers{};
+        auto const               start = BenchmarkClock::now();
+        for (std::size_t t = 0U; t < threads; ++t)
+        {
+            workers.emplace_back([&]() noexcept {
+                std::array<std::pair<char *, std::size_t>, InFlight> held{};
+                for (std::uint64_t i = 0U; i < perThread; ++i)
+                {
+                    auto &slot = held[i % InFlight];
+                    if (slot.first != nullptr)
+                    {
+                        deallocate(slot.first, slot.second);
+                    }
+                    // cheap pseudo random sizes, skewed towards small buffers
+                    auto const size = 1U + (((i * 2654435761U) >> 7U) % (((i & 3U) == 0U) ? 4096U : 256U));
+                    slot            = {allocate(size), size};
+                    slot.first[0]   = static_cast<char>(i);
+                }
+                for (auto const &slot : held)
+                {
+                    if (slot.first != nullptr)
+                    {
+                        deallocate(slot.first, slot.second);
+                    }
+                }
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        auto const duration = BenchmarkClock::now() - start;
+        reportRate(name + " on " + std::to_string(threads) + " thread(s)", threads * perThread, duration);
+    }
+
+    /// @brief Returns the thread counts to measure, doubling from 1 up to the number of hardware threads.
+    ///
+    /// @return The thread counts to measure.
+    static std::vector<std::size_t> threadCounts() noexcept
+    {
+        std::vector<std::size_t> counts{};
+        auto const               hardwareThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 2U);
+        for (std::size_t threads = 1U; threads <= hardwareThreads; threads *= 2U)
+        {
+            counts.emplace_back(threads);
+        }
+        return counts;
+    }
+};
+
+TEST_F(MemorySlabPool, SlabPool)
+{
+    for (auto const threads : threadCounts())
+    {
+        SlabPool pool{std::size_t{1U} << 32U};
+        run(
+            "SlabPool",
+            threads,
+            [&](std::size_t const size) { return pool.allocate(size); },
+            [&](char *const p, std::size_t const size) noexcept { pool.deallocate(p, size); });
+        EXPECT_EQ(pool.usedSpace(), 0U);
+    }
+}
+
+TEST_F(MemorySlabPool, GlobalHeap)
+{
+    for (auto const threads : threadCounts())
+    {
+        run(
+            "new/delete",
+            threads,
+            [](std::size_t const size) { return new char[size]; },
+            [](char *const p, std::size_t const) noexcept { delete[] p; });
+    }
+}
+
+} // namespace Terrahertz::Benchmarks
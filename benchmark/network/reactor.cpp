@@ -0,0 +1,187 @@
+#include "THzCommon/network/reactor.hpp"
+
+#include "../benchmarkhelper.hpp"
+#include "THzCommon/network/tcpsocket.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+
+struct NetworkReactor : public testing::Test
+{
+    using TCPSocketV4 = TCPSocket<IPVersion::V4>;
+
+    /// @brief The number of round trips measured per run, shared by all connections.
+    static constexpr std::uint32_t RoundTrips = 100000U;
+
+    /// @brief The size of the messages exchanged.
+    static constexpr std::size_t MessageSize = 64U;
+
+    /// @brief Sends back every message received on the connection until the peer closes it.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param connection The connection to serve.
+    /// @param closed Incremented once the connection has been closed.
+    static Task<> echo(Reactor &reactor, TCPSocketV4 connection, std::atomic<std::uint32_t> &closed) noexcept
+    {
+        std::array<std::byte, MessageSize> buffer{};
+        for (;;)
+        {
+            auto const received = co_await connection.asyncReceive(reactor, buffer);
+            if (received.isError() || received.value().empty() ||
+                (co_await connection.asyncSend(reactor, received.value())).isError())
+            {
+                break;
+            }
+        }
+        ++closed;
+    }
+
+    /// @brief Accepts the given number of connections, serving each by its own coroutine.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param listener The listening socket.
+    /// @param count The number of connections to accept.
+    /// @param closed Incremented once a connection has been closed.
+    static Task<> serve(Reactor                    &reactor,
+                        TCPSocketV4                &listener,
+                        std::uint32_t const         count,
+                        std::atomic<std::uint32_t> &closed) noexcept
+    {
+        for (auto i = 0U; i < count; ++i)
+        {
+            auto connection = co_await listener.asyncAccept(reactor, nullptr);
+            if (!connection.good())
+            {
+                co_return;
+            }
+            connection.setNoDelay(true);
+            spawn(echo(reactor, std::move(connection), closed));
+        }
+    }
+
+    /// @brief Connects to the server and exchanges the given number of messages, one at a time.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param address The address of the server.
+    /// @param roundTrips The number of messages to exchange.
+    /// @param completed Incremented per completed round trip.
+    /// @param finished Incremented once the client is done.
+    static Task<> client(Reactor                     &reactor,
+                         Address<IPVersion::V4> const address,
+                         std::uint32_t const          roundTrips,
+                         std::atomic<std::uint64_t>  &completed,
+                         std::atomic<std::uint32_t>  &finished) noexcept
+    {
+        TCPSocketV4 socket{};
+        socket.setNonblocking(true);
+        socket.setNoDelay(true);
+
+        std::array<std::byte, MessageSize> buffer{};
+        if (!(co_await socket.asyncConnect(reactor, address)).isError())
+        {
+            for (auto i = 0U; i < roundTrips; ++i)
+            {
+                if ((co_await socket.asyncSend(reactor, buffer)).isError())
+                {
+                    break;
+                }
+                std::size_t received{};
+                while (received < buffer.size())
+                {
+                    auto const result = co_await socket.asyncReceive(reactor, std::span{buffer}.subspan(received));
+                    if (result.isError() || result.value().empty())
+                    {
+                        break;
+                    }
+                    received += result.value().size();
+                }
+                ++completed;
+            }
+        }
+        socket.close();
+        ++finished;
+    }
+
+    /// @brief Runs the round trips over the given number of connections, all in flight at the same time.
+    ///
+    /// @param connections The number of connections.
+    /// @param workers The number of workers resuming the coroutines, 0 to resume them on the reactor thread.
+    void run(std::uint32_t const connections, std::size_t const workers) noexcept
+    {
+        ThreadPool pool{std::max<std::size_t>(workers, 1U)};
+        Reactor    reactor{(workers == 0U) ? nullptr : &pool};
+
+        TCPSocketV4                     listener{};
+        std::uniform_int_distribution<> distrib{50001, 60000};
+        Address<IPVersion::V4>          address{{127U, 0U, 0U, 1U}, 0U};
+        bool                            bound{};
+        listener.setReuseAddr(true);
+        for (uint16_t i = 0U; (i < 5U) && !bound; ++i)
+        {
+            address.port = static_cast<std::uint16_t>(distrib(randomEngine));
+            bound        = listener.bind(address);
+        }
+        ASSERT_TRUE(bound);
+        ASSERT_TRUE(listener.listen(connections));
+        ASSERT_TRUE(listener.setNonblocking(true));
+
+        std::atomic<std::uint64_t> completed{};
+        std::atomic<std::uint32_t> finished{};
+        std::atomic<std::uint32_t> closed{};
+
+        auto const start = BenchmarkClock::now();
+        spawn(serve(reactor, listener, connections, closed));
+        for (auto i = 0U; i < connections; ++i)
+        {
+            spawn(client(reactor, address, RoundTrips / connections, completed, finished));
+        }
+        while ((finished < connections) && ((BenchmarkClock::now() - start) < std::chrono::seconds{30U}))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1U});
+        }
+        auto const duration = BenchmarkClock::now() - start;
+
+        // the server side has to be done as well before the reactor goes away
+        while ((closed < connections) && ((BenchmarkClock::now() - start) < std::chrono::seconds{30U}))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1U});
+        }
+        EXPECT_EQ(finished, connections);
+        EXPECT_EQ(closed, connections);
+        reportRate(std::to_string(connections) + " connection(s), " +
+                       ((workers == 0U) ? std::string{"resumed on the reactor"}
+                                        : (std::to_string(workers) + " worker(s)")),
+                   completed,
+                   duration);
+    }
+
+    std::mt19937 randomEngine{1337};
+};
+
+TEST_F(NetworkReactor, RoundTripsOnReactorThread)
+{
+    for (auto const connections : {1U, 100U, 1000U})
+    {
+        run(connections, 0U);
+    }
+}
+
+TEST_F(NetworkReactor, RoundTripsOnThreadPool)
+{
+    auto const workers = std::max<std::size_t>(std::thread::hardware_concurrency(), 2U);
+    for (auto const connections : {1U, 100U, 1000U})
+    {
+        run(connections, workers);
+    }
+}
+
+} // namespace Terrahertz::Benchmarks
@@ -0,0 +1,103 @@
+#include "THzCommon/network/shardedacceptor.hpp"
+
+#include "../benchmarkhelper.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+
+struct NetworkShardedAcceptor : public testing::Test
+{
+    using TCPSocketV4 = TCPSocket<IPVersion::V4>;
+    using AcceptorV4  = ShardedAcceptor<IPVersion::V4>;
+
+    /// @brief The number of threads opening connections.
+    static constexpr std::size_t ClientThreads = 4U;
+
+    /// @brief The number of connections opened by each client thread per run.
+    static constexpr std::size_t ConnectionsPerClient = 1000U;
+
+    /// @brief Opens the connections using multiple threads and waits until all have been accepted.
+    ///
+    /// @param shards The number of shards of the acceptor.
+    void run(std::size_t const shards) noexcept
+    {
+        // the connection is dropped right away, only the accept path is measured
+        AcceptorV4 acceptor{shards, [](TCPSocketV4 &&connection, Address<IPVersion::V4> const &, std::size_t) {
+            connection.close();
+        }};
+
+        std::uniform_int_distribution<> distrib{40001, 50000};
+        Address<IPVersion::V4>          address{{127U, 0U, 0U, 1U}, 0U};
+        bool                            started{};
+        for (uint16_t i = 0U; (i < 5U) && !started; ++i)
+        {
+            address.port = static_cast<std::uint16_t>(distrib(randomEngine));
+            started      = acceptor.start(address, 1024U);
+        }
+        if (!started)
+        {
+            GTEST_SKIP() << "SO_REUSEPORT not supported.";
+        }
+
+        auto const total = ClientThreads * ConnectionsPerClient;
+        auto const start = BenchmarkClock::now();
+
+        std::vector<std::thread> clients{};
+        for (auto t = 0U; t < ClientThreads; ++t)
+        {
+            clients.emplace_back([&]() noexcept {
+                for (auto i = 0U; i < ConnectionsPerClient; ++i)
+                {
+                    TCPSocketV4 client{};
+                    client.connect(address);
+                }
+            });
+        }
+        for (auto &client : clients)
+        {
+            client.join();
+        }
+
+        std::uint64_t accepted{};
+        while (accepted < total)
+        {
+            auto const perShard = acceptor.acceptedConnectionsPerShard();
+            accepted            = std::accumulate(perShard.begin(), perShard.end(), std::uint64_t{});
+            if ((BenchmarkClock::now() - start) > std::chrono::seconds{10U})
+            {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        auto const duration = BenchmarkClock::now() - start;
+        EXPECT_EQ(accepted, total);
+
+        auto const perShard = acceptor.acceptedConnectionsPerShard();
+
+        auto const [least, most] = std::minmax_element(perShard.begin(), perShard.end());
+        reportRate("TCP accept with " + std::to_string(shards) + " shard(s), per shard " + std::to_string(*least) +
+                       " to " + std::to_string(*most),
+                   accepted,
+                   duration);
+    }
+
+    std::mt19937 randomEngine{1337};
+};
+
+TEST_F(NetworkShardedAcceptor, AcceptRateByShardCount)
+{
+    auto const hardwareThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+    for (std::size_t shards = 1U; shards <= hardwareThreads; shards *= 2U)
+    {
+        run(shards);
+    }
+}
+
+} // namespace Terrahertz::Benchmarks
@@ -0,0 +1,114 @@
+#include "THzCommon/network/udpsocket.hpp"
+
+#include "../benchmarkhelper.hpp"
+#include "THzCommon/network/address.hpp"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace Terrahertz::Benchmarks {
+
+struct NetworkUDPSocket : public testing::Test
+{
+    using UDPSocketV4 = UDPSocket<IPVersion::V4>;
+    using DatagramV4  = Datagram<IPVersion::V4>;
+
+    /// @brief The number of datagrams sent before the receiver drains them.
+    static constexpr std::size_t Burst = 32U;
+
+    /// @brief The number of bursts per benchmark run.
+    static constexpr std::size_t Rounds = 4096U;
+
+    /// @brief The size of each datagram [bytes].
+    static constexpr std::size_t PayloadSize = 64U;
+
+    /// @brief Tries to bind the given socket to a local address.
+    ///
+    /// @param socket The socket to bind.
+    /// @return The address the socket was bind to, if successful.
+    std::optional<Address<IPVersion::V4>> tryBind(UDPSocketV4 &socket) noexcept
+    {
+        std::uniform_int_distribution<> distrib{20000, 40000};
+        for (uint16_t i = 0U; i < 5U; ++i)
+        {
+            auto const                   port = static_cast<std::uint16_t>(distrib(randomEngine));
+            Address<IPVersion::V4> const address{{127U, 0U, 0U, 1U}, port};
+            if (socket.bind(address))
+            {
+                return address;
+            }
+        }
+        return {};
+    }
+
+    std::mt19937 randomEngine{1337};
+
+    UDPSocketV4 sender{};
+
+    UDPSocketV4 receiver{};
+
+    std::array<std::array<std::byte, PayloadSize>, Burst> buffers{};
+};
+
+TEST_F(NetworkUDPSocket, SingleDatagramLoopback)
+{
+    ASSERT_TRUE(tryBind(sender));
+    auto const receiverAddress = tryBind(receiver);
+    ASSERT_TRUE(receiverAddress);
+
+    std::size_t packets{};
+    auto const  start = BenchmarkClock::now();
+    for (std::size_t round = 0U; round < Rounds; ++round)
+    {
+        for (auto const &buffer : buffers)
+        {
+            ASSERT_FALSE(sender.sendTo(*receiverAddress, buffer).isError());
+        }
+        for (auto &buffer : buffers)
+        {
+            ASSERT_FALSE(receiver.receiveFrom(nullptr, buffer).isError());
+            ++packets;
+        }
+    }
+    reportRate("UDP single sendTo/receiveFrom", packets, BenchmarkClock::now() - start);
+}
+
+TEST_F(NetworkUDPSocket, BatchedDatagramLoopback)
+{
+    ASSERT_TRUE(tryBind(sender));
+    auto const receiverAddress = tryBind(receiver);
+    ASSERT_TRUE(receiverAddress);
+
+    std::array<DatagramV4, Burst> datagrams{};
+    for (auto i = 0U; i < Burst; ++i)
+    {
+        datagrams[i].address = *receiverAddress;
+        datagrams[i].buffer  = buffers[i];
+    }
+
+    std::size_t packets{};
+    auto const  start = BenchmarkClock::now();
+    for (std::size_t round = 0U; round < Rounds; ++round)
+    {
+        auto const sent = sender.sendBatch(datagrams);
+        ASSERT_FALSE(sent.isError());
+        ASSERT_EQ(sent.value(), Burst);
+
+        std::size_t received{};
+        while (received < Burst)
+        {
+            auto const result = receiver.receiveBatch(std::span<DatagramV4>{datagrams}.subspan(received));
+            ASSERT_FALSE(result.isError());
+            received += result.value();
+        }
+        for (auto &datagram : datagrams)
+        {
+            datagram.address = *receiverAddress;
+        }
+        packets += received;
+    }
+    reportRate("UDP batched sendBatch/receiveBatch", packets, BenchmarkClock::now() - start);
+}
+
+} // namespace Terrahertz::Benchmarks
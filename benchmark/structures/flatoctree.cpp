@@ -0,0 +1,93 @@
+#include "THzCommon/structures/flatoctree.hpp"
+
+#include "../benchmarkhelper.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+
+struct StructuresFlatOctree : public testing::Test
+{
+    using Coordinate = std::uint16_t;
+    using Reference  = Octree<Coordinate, std::uint32_t, std::uint32_t>;
+    using Flat       = FlatOctree<Coordinate, std::uint32_t, std::uint32_t>;
+
+    /// @brief The number of points added to the trees.
+    static constexpr std::size_t Count = 10000000U;
+
+    /// @brief The maximum number of entries per node.
+    static constexpr std::uint32_t MaxEntries = 32U;
+
+    /// @brief The maximum depth of the trees.
+    static constexpr std::uint8_t MaxDepth = 10U;
+
+    /// @brief Creates the points added to the trees, spread evenly over the whole space.
+    ///
+    /// @return The points.
+    static std::vector<Reference::Entry> createPoints() noexcept
+    {
+        std::mt19937                              rng{42U};
+        std::uniform_int_distribution<Coordinate> coordinate{};
+        std::vector<Reference::Entry>             points(Count);
+        for (std::uint32_t i = 0U; i < Count; ++i)
+        {
+            points[i] = Reference::Entry{coordinate(rng), coordinate(rng), coordinate(rng), i};
+        }
+        return points;
+    }
+
+    /// @brief Adds all points to the given tree and sums up their values.
+    ///
+    /// @param name The name of the run.
+    /// @param tree The tree to fill.
+    template <typename TTree>
+    void run(std::string_view const name, TTree &tree) noexcept
+    {
+        auto start = BenchmarkClock::now();
+        for (auto const &point : points)
+        {
+            tree.addEntry(point);
+        }
+        reportRate(std::string{name} + " add", Count, BenchmarkClock::now() - start);
+
+        std::uint64_t sum{};
+        auto          analyze = [&](Reference::Entry const &e) noexcept { sum += e.value; };
+        start                 = BenchmarkClock::now();
+        tree.analyzeEntries(analyze);
+        reportRate(std::string{name} + " analyze", Count, BenchmarkClock::now() - start);
+        EXPECT_EQ(sum, (std::uint64_t{Count} * (Count - 1U)) / 2U);
+        EXPECT_EQ(tree.totalEntries(), Count);
+    }
+
+    std::vector<Reference::Entry> points{createPoints()};
+};
+
+TEST_F(StructuresFlatOctree, Octree)
+{
+    auto tree = std::make_unique<Reference>(32768U, 32768U, 32768U, 65536U, MaxEntries, MaxDepth);
+    run("Octree", *tree);
+
+    auto const start = BenchmarkClock::now();
+    tree->reset();
+    reportRate("Octree reset", 1U, BenchmarkClock::now() - start);
+    run("Octree rebuild", *tree);
+}
+
+TEST_F(StructuresFlatOctree, FlatOctree)
+{
+    Flat tree{32768U, 32768U, 32768U, 65536U, MaxEntries, MaxDepth};
+    run("FlatOctree", tree);
+
+    auto const start = BenchmarkClock::now();
+    tree.reset();
+    reportRate("FlatOctree reset", 1U, BenchmarkClock::now() - start);
+    run("FlatOctree rebuild", tree);
+}
+
+} // namespace Terrahertz::Benchmarks
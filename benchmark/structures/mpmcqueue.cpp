@@ -0,0 +1,152 @@
+#include "THzCommon/structures/mpmcqueue.hpp"
+
+#include "../benchmarkhelper.hpp"
+#include "THzCommon/structures/queue.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+
+struct StructuresMpmcQueue : public testing::Test
+{
+    /// @brief The number of values handed over per run.
+    static constexpr std::uint64_t Count = 4000000U;
+
+    /// @brief The capacity of the queues.
+    static constexpr std::size_t Capacity = 1024U;
+
+    /// @brief Runs the given number of producers and consumers, each handling the same share of the values.
+    ///
+    /// @param name The name of the run.
+    /// @param threads The number of producers and of consumers.
+    /// @param push Pushes a single value.
+    /// @param pop Pops a single value.
+    template <typename TPush, typename TPop>
+    void run(std::string const &name, std::size_t const threads, TPush push, TPop pop) noexcept
+    {
+        auto const perThread = Count / threads;
+
+        std::atomic<std::uint64_t> sum{};
+        std::vector<std::thread>   workers{};
+
+        auto const start = BenchmarkClock::now();
+        for (std::size_t t = 0U; t < threads; ++t)
+        {
+            workers.emplace_back([&]() noexcept {
+                for (std::uint64_t i = 0U; i < perThread; ++i)
+                {
+                    push(i);
+                }
+            });
+            workers.emplace_back([&]() noexcept {
+                std::uint64_t localSum{};
+                for (std::uint64_t i = 0U; i < perThread; ++i)
+                {
+                    localSum += pop();
+                }
+                sum += localSum;
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        auto const duration = BenchmarkClock::now() - start;
+
+        EXPECT_EQ(sum, threads * ((perThread * (perThread - 1U)) / 2U));
+        reportRate(name + " with " + std::to_string(threads) + " producer(s) and consumer(s)",
+                   threads * perThread,
+                   duration);
+    }
+
+    /// @brief Returns the thread counts to measure, doubling from 1 up to the number of hardware threads.
+    ///
+    /// @return The thread counts to measure.
+    static std::vector<std::size_t> threadCounts() noexcept
+    {
+        std::vector<std::size_t> counts{};
+        auto const               hardwareThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 2U);
+        for (std::size_t threads = 1U; threads <= hardwareThreads; threads *= 2U)
+        {
+            counts.emplace_back(threads);
+        }
+        return counts;
+    }
+};
+
+TEST_F(StructuresMpmcQueue, MutexQueue)
+{
+    for (auto const threads : threadCounts())
+    {
+        auto                    queue = std::make_unique<Queue<std::uint64_t, Capacity>>();
+        std::mutex              mutex{};
+        std::condition_variable notFull{};
+        std::condition_variable notEmpty{};
+
+        auto const push = [&](std::uint64_t const value) noexcept {
+            std::unique_lock<std::mutex> lock{mutex};
+            notFull.wait(lock, [&]() noexcept { return queue->filled() < queue->size(); });
+            queue->push(value);
+            notEmpty.notify_one();
+        };
+        auto const pop = [&]() noexcept {
+            std::unique_lock<std::mutex> lock{mutex};
+            notEmpty.wait(lock, [&]() noexcept { return !queue->empty(); });
+            auto const value = queue->firstSpan()[0U];
+            queue->pop(1U);
+            notFull.notify_one();
+            return value;
+        };
+        run("mutex protected Queue", threads, push, pop);
+    }
+}
+
+TEST_F(StructuresMpmcQueue, Blocking)
+{
+    for (auto const threads : threadCounts())
+    {
+        auto queue = std::make_unique<MpmcQueue<std::uint64_t, Capacity>>();
+
+        auto const push = [&](std::uint64_t const value) noexcept { queue->push(value); };
+        auto const pop  = [&]() noexcept {
+            std::uint64_t value{};
+            queue->pop(value);
+            return value;
+        };
+        run("MpmcQueue push/pop", threads, push, pop);
+    }
+}
+
+TEST_F(StructuresMpmcQueue, NonBlocking)
+{
+    for (auto const threads : threadCounts())
+    {
+        auto queue = std::make_unique<MpmcQueue<std::uint64_t, Capacity>>();
+
+        auto const push = [&](std::uint64_t const value) noexcept {
+            while (!queue->try_push(value))
+            {
+                std::this_thread::yield();
+            }
+        };
+        auto const pop = [&]() noexcept {
+            std::uint64_t value{};
+            while (!queue->try_pop(value))
+            {
+                std::this_thread::yield();
+            }
+            return value;
+        };
+        run("MpmcQueue try_push/try_pop", threads, push, pop);
+    }
+}
+
+} // namespace Terrahertz::Benchmarks
@@ -0,0 +1,240 @@
+#include "THzCommon/structures/octree.hpp"
+
+#include "../benchmarkhelper.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+
+struct StructuresOctree : public testing::Test
+{
+    using TestOctreeType = Octree<std::uint16_t, std::uint32_t, std::uint32_t>;
+
+    /// @brief The number of points stored in the tree.
+    static constexpr std::size_t Count = 10000000U;
+
+    /// @brief The number of times the tree is rebuilt, like once per frame.
+    static constexpr std::size_t Rounds = 3U;
+
+    /// @brief Creates the points stored in the tree, spread evenly over the whole space.
+    ///
+    /// @return The points.
+    static std::vector<TestOctreeType::Entry> createPoints() noexcept
+    {
+        std::mt19937                                 rng{42U};
+        std::uniform_int_distribution<std::uint16_t> coordinate{};
+        std::vector<TestOctreeType::Entry>           points(Count);
+        for (std::uint32_t i = 0U; i < Count; ++i)
+        {
+            points[i] = TestOctreeType::Entry{coordinate(rng), coordinate(rng), coordinate(rng), i};
+        }
+        return points;
+    }
+
+    /// @brief Rebuilds the tree a few times using the given function.
+    ///
+    /// @param name The name of the run.
+    /// @param fill The function filling the tree.
+    template <typename TFunction>
+    void run(std::string_view const name, TFunction const &fill) noexcept
+    {
+        auto const start = BenchmarkClock::now();
+        for (std::size_t round = 0U; round < Rounds; ++round)
+        {
+            fill();
+            EXPECT_EQ(tree->totalEntries(), Count);
+        }
+        reportRate(name, Count * Rounds, BenchmarkClock::now() - start);
+    }
+
+    /// @brief Runs box, sphere and nearest neighbour queries on the given tree.
+    ///
+    /// @param prefix The prefix of the names of the runs.
+    /// @param queried The tree to query.
+    template <typename TTree>
+    void queries(std::string_view const prefix, TTree const &queried) noexcept
+    {
+        constexpr std::size_t Queries{100000U};
+
+        std::mt19937                                 rng{7U};
+        std::uniform_int_distribution<std::uint16_t> coordinate{0U, 65000U};
+
+        std::uint64_t found{};
+        auto          count = [&](typename TTree::Entry const &) noexcept { ++found; };
+        auto          start = BenchmarkClock::now();
+        for (std::size_t i = 0U; i < Queries; ++i)
+        {
+            typename TTree::Box box{coordinate(rng), coordinate(rng), coordinate(rng)};
+            box.maxX = static_cast<std::uint16_t>(box.minX + 500U);
+            box.maxY = static_cast<std::uint16_t>(box.minY + 500U);
+            box.maxZ = static_cast<std::uint16_t>(box.minZ + 500U);
+            queried.queryBox(box, count);
+        }
+        reportRate(std::string{prefix} + "queryBox", Queries, BenchmarkClock::now() - start);
+        EXPECT_GT(found, 0U);
+
+        found = 0U;
+        start = BenchmarkClock::now();
+        for (std::size_t i = 0U; i < Queries; ++i)
+        {
+            queried.querySphere(coordinate(rng), coordinate(rng), coordinate(rng), 500, count);
+        }
+        reportRate(std::string{prefix} + "querySphere", Queries, BenchmarkClock::now() - start);
+        EXPECT_GT(found, 0U);
+
+        std::array<typename TTree::Neighbour, 8U> neighbours{};
+        start = BenchmarkClock::now();
+        for (std::size_t i = 0U; i < Queries; ++i)
+        {
+            found += queried.queryNearest(coordinate(rng), coordinate(rng), coordinate(rng), neighbours);
+        }
+        reportRate(std::string{prefix} + "queryNearest k=8", Queries, BenchmarkClock::now() - start);
+    }
+
+    std::vector<TestOctreeType::Entry> points{createPoints()};
+
+    std::unique_ptr<TestOctreeType> tree{std::make_unique<TestOctreeType>(32768U, 32768U, 32768U, 65536U, 32U, 10U)};
+};
+
+TEST_F(StructuresOctree, AddEntry)
+{
+    run("addEntry", [this]() noexcept {
+        tree->reset();
+        for (auto const &point : points)
+        {
+            tree->addEntry(point);
+        }
+    });
+}
+
+TEST_F(StructuresOctree, Build)
+{
+    run("build", [this]() noexcept { tree->build(points); });
+}
+
+TEST_F(StructuresOctree, BuildParallel)
+{
+    ThreadPool pool{std::max(std::thread::hardware_concurrency(), 2U)};
+    run("build parallel", [&]() noexcept { tree->build(points, &pool); });
+}
+
+TEST_F(StructuresOctree, MoveEntry)
+{
+    // a share of the points moves a little every tick, instead of rebuilding the tree
+    constexpr std::size_t Moved{Count / 100U};
+
+    tree->build(points);
+    std::mt19937                                rng{11U};
+    std::uniform_int_distribution<std::size_t>  index{0U, Count - 1U};
+    std::uniform_int_distribution<std::int32_t> step{-64, 64};
+
+    auto const nudge = [&](std::uint16_t const value) noexcept {
+        return static_cast<std::uint16_t>(std::clamp(value + step(rng), 0, 65535));
+    };
+
+    std::size_t moved{};
+    auto const  start = BenchmarkClock::now();
+    for (std::size_t round = 0U; round < Rounds; ++round)
+    {
+        for (std::size_t i = 0U; i < Moved; ++i)
+        {
+            auto &point = points[index(rng)];
+            auto  x     = nudge(point.x);
+            auto  y     = nudge(point.y);
+            auto  z     = nudge(point.z);
+            moved += tree->moveEntry(point, x, y, z) ? 1U : 0U;
+            point.x = x;
+            point.y = y;
+            point.z = z;
+        }
+        tree->recalculate();
+    }
+    reportRate("moveEntry", Moved * Rounds, BenchmarkClock::now() - start);
+    EXPECT_EQ(moved, Moved * Rounds);
+    EXPECT_EQ(tree->totalEntries(), Count);
+}
+
+TEST_F(StructuresOctree, Analyze)
+{
+    tree->build(points);
+    ThreadPool pool{std::max(std::thread::hardware_concurrency(), 2U)};
+
+    std::uint64_t sum{};
+    auto          add   = [&](TestOctreeType::Entry const &e) noexcept { sum += e.value; };
+    auto          start = BenchmarkClock::now();
+    for (std::size_t round = 0U; round < Rounds; ++round)
+    {
+        tree->analyzeEntries(add);
+    }
+    reportRate("analyzeEntries", Count * Rounds, BenchmarkClock::now() - start);
+
+    std::uint64_t parallelSum{};
+    start = BenchmarkClock::now();
+    for (std::size_t round = 0U; round < Rounds; ++round)
+    {
+        parallelSum += tree->parallelAnalyzeEntries(
+            pool,
+            std::uint64_t{},
+            [](std::uint64_t &result, TestOctreeType::Entry const &e) noexcept { result += e.value; },
+            [](std::uint64_t const a, std::uint64_t const b) noexcept { return a + b; });
+    }
+    reportRate("parallelAnalyzeEntries", Count * Rounds, BenchmarkClock::now() - start);
+    EXPECT_EQ(sum, parallelSum);
+}
+
+TEST_F(StructuresOctree, Queries)
+{
+    tree->build(points);
+    queries("", *tree);
+
+    // a scan of all points for comparison
+    constexpr std::size_t                        Scans{10U};
+    std::mt19937                                 rng{7U};
+    std::uniform_int_distribution<std::uint16_t> coordinate{0U, 65000U};
+    std::uint64_t                                found{};
+    auto const                                   start = BenchmarkClock::now();
+    for (std::size_t i = 0U; i < Scans; ++i)
+    {
+        TestOctreeType::Box const box{coordinate(rng), coordinate(rng), coordinate(rng), 65535U, 65535U, 65535U};
+        for (auto const &point : points)
+        {
+            found += ((point.x >= box.minX) && (point.y >= box.minY) && (point.z >= box.minZ)) ? 1U : 0U;
+        }
+    }
+    reportRate("linear scan", Scans, BenchmarkClock::now() - start);
+    EXPECT_GT(found, 0U);
+}
+
+TEST_F(StructuresOctree, QueriesStructureOfArrays)
+{
+    using SoAOctreeType = Octree<std::uint16_t, std::uint32_t, std::uint32_t, OctreeLayout::StructureOfArrays>;
+
+    auto soaTree = std::make_unique<SoAOctreeType>(32768U, 32768U, 32768U, 65536U, 32U, 10U);
+    soaTree->build(points);
+    queries("SoA ", *soaTree);
+}
+
+TEST_F(StructuresOctree, QueriesLargeLeaves)
+{
+    using SoAOctreeType = Octree<std::uint16_t, std::uint32_t, std::uint32_t, OctreeLayout::StructureOfArrays>;
+
+    // most of the time is spent scanning the entries of the leaves
+    tree->reset(32768U, 32768U, 32768U, 65536U, 4096U, 10U);
+    tree->build(points);
+    queries("large leaves ", *tree);
+
+    auto soaTree = std::make_unique<SoAOctreeType>(32768U, 32768U, 32768U, 65536U, 4096U, 10U);
+    soaTree->build(points);
+    queries("large leaves SoA ", *soaTree);
+}
+
+} // namespace Terrahertz::Benchmarks
@@ -0,0 +1,199 @@
+#include "THzCommon/structures/spscringbuffer.hpp"
+
+#include "../benchmarkhelper.hpp"
+#include "THzCommon/structures/queue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string_view>
+#include <thread>
+
+namespace Terrahertz::Benchmarks {
+
+struct StructuresSpscRingBuffer : public testing::Test
+{
+    /// @brief The number of values handed from the producer to the consumer per run.
+    static constexpr std::uint64_t Count = 20000000U;
+
+    /// @brief The capacity of the buffers.
+    static constexpr std::size_t Capacity = 1024U;
+
+    /// @brief The number of values per batch.
+    static constexpr std::size_t BatchSize = 64U;
+
+    /// @brief Runs the given producer on a second thread and the given consumer on this one.
+    ///
+    /// @remarks Both sides yield if they can not make progress, so the benchmark also works on a single core.
+    /// @param name The name of the run.
+    /// @param producer The function producing the values.
+    /// @param consumer The function consuming the values, returns the sum of all values.
+    template <typename TProducer, typename TConsumer>
+    void run(std::string_view const name, TProducer &&producer, TConsumer &&consumer) noexcept
+    {
+        auto const start = BenchmarkClock::now();
+
+        std::thread thread{producer};
+        auto const  sum = consumer();
+        thread.join();
+
+        auto const duration = BenchmarkClock::now() - start;
+        EXPECT_EQ(sum, (Count * (Count - 1U)) / 2U);
+        reportRate(name, Count, duration);
+    }
+};
+
+TEST_F(StructuresSpscRingBuffer, MutexQueue)
+{
+    auto       queue = std::make_unique<Queue<std::uint64_t, Capacity>>();
+    std::mutex mutex{};
+
+    auto const producer = [&]() noexcept {
+        for (std::uint64_t next = 0U; next < Count;)
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            if (queue->filled() < queue->size())
+            {
+                queue->push(next++);
+            }
+            else
+            {
+                lock.unlock();
+                std::this_thread::yield();
+            }
+        }
+    };
+    auto const consumer = [&]() noexcept {
+        std::uint64_t sum{};
+        for (std::uint64_t received = 0U; received < Count;)
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+
+            auto const data = queue->firstSpan();
+            sum             = std::accumulate(data.begin(), data.end(), sum);
+            received += data.size();
+            queue->pop(data.size());
+            if (data.empty())
+            {
+                lock.unlock();
+                std::this_thread::yield();
+            }
+        }
+        return sum;
+    };
+    run("mutex protected Queue", producer, consumer);
+}
+
+TEST_F(StructuresSpscRingBuffer, SingleValues)
+{
+    auto buffer = std::make_unique<SpscRingBuffer<std::uint64_t, Capacity>>();
+
+    auto const producer = [&]() noexcept {
+        for (std::uint64_t next = 0U; next < Count;)
+        {
+            if (buffer->push(next))
+            {
+                ++next;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+    auto const consumer = [&]() noexcept {
+        std::uint64_t sum{};
+        std::uint64_t value{};
+        for (std::uint64_t received = 0U; received < Count;)
+        {
+            if (buffer->pop(value))
+            {
+                sum += value;
+                ++received;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        return sum;
+    };
+    run("SpscRingBuffer push/pop single values", producer, consumer);
+}
+
+TEST_F(StructuresSpscRingBuffer, Batches)
+{
+    auto buffer = std::make_unique<SpscRingBuffer<std::uint64_t, Capacity>>();
+
+    auto const producer = [&]() noexcept {
+        std::array<std::uint64_t, BatchSize> batch{};
+        for (std::uint64_t next = 0U; next < Count;)
+        {
+            auto const count = std::min<std::uint64_t>(BatchSize, Count - next);
+            std::iota(batch.begin(), batch.begin() + count, next);
+            auto const pushed = buffer->push(std::span<std::uint64_t const>{batch}.first(count));
+            if (pushed == 0U)
+            {
+                std::this_thread::yield();
+            }
+            next += pushed;
+        }
+    };
+    auto const consumer = [&]() noexcept {
+        std::array<std::uint64_t, BatchSize> batch{};
+        std::uint64_t                        sum{};
+        for (std::uint64_t received = 0U; received < Count;)
+        {
+            auto const count = buffer->pop(std::span{batch});
+            sum              = std::accumulate(batch.begin(), batch.begin() + count, sum);
+            if (count == 0U)
+            {
+                std::this_thread::yield();
+            }
+            received += count;
+        }
+        return sum;
+    };
+    run("SpscRingBuffer push/pop batches of 64", producer, consumer);
+}
+
+TEST_F(StructuresSpscRingBuffer, ReserveAndPeek)
+{
+    auto buffer = std::make_unique<SpscRingBuffer<std::uint64_t, Capacity>>();
+
+    auto const producer = [&]() noexcept {
+        for (std::uint64_t next = 0U; next < Count;)
+        {
+            auto const region = buffer->reserve(std::min<std::uint64_t>(BatchSize, Count - next));
+            std::iota(region.begin(), region.end(), next);
+            if (region.empty())
+            {
+                std::this_thread::yield();
+            }
+            buffer->commit(region.size());
+            next += region.size();
+        }
+    };
+    auto const consumer = [&]() noexcept {
+        std::uint64_t sum{};
+        for (std::uint64_t received = 0U; received < Count;)
+        {
+            auto const region = buffer->peek(BatchSize);
+            sum               = std::accumulate(region.begin(), region.end(), sum);
+            if (region.empty())
+            {
+                std::this_thread::yield();
+            }
+            buffer->consume(region.size());
+            received += region.size();
+        }
+        return sum;
+    };
+    run("SpscRingBuffer reserve/commit and peek/consume", producer, consumer);
+}
+
+} // namespace Terrahertz::Benchmarks
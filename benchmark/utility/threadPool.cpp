@@ -0,0 +1,127 @@
+#include "THzCommon/utility/threadPool.hpp"
+
+#include "../benchmarkhelper.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+
+struct UtilityThreadPool : public testing::Test
+{
+    /// @brief The number of values summed up per run.
+    static constexpr std::size_t Count = 1U << 24U;
+
+    /// @brief The number of values below which the recursive sum stops forking.
+    static constexpr std::size_t Grain = 4096U;
+
+    /// @brief The width of the image processed per run.
+    static constexpr std::uint32_t Width = 1920U;
+
+    /// @brief The height of the image processed per run.
+    static constexpr std::uint32_t Height = 1080U;
+
+    /// @brief Sums up the values recursively, forking a job for the upper half of each range.
+    ///
+    /// @param pool The pool to fork the jobs into.
+    /// @param values The values to sum up.
+    /// @param begin The first index of the range.
+    /// @param end The index after the last index of the range.
+    /// @return The sum of the values of the range.
+    static std::uint64_t sum(ThreadPool                       &pool,
+                             std::vector<std::uint32_t> const &values,
+                             std::size_t const                 begin,
+                             std::size_t const                 end) noexcept
+    {
+        if ((end - begin) <= Grain)
+        {
+            return std::accumulate(values.begin() + begin, values.begin() + end, std::uint64_t{});
+        }
+        auto const middle = begin + ((end - begin) / 2U);
+        auto       upper  = pool.submit([&pool, &values, middle, end]() noexcept {
+            return sum(pool, values, middle, end);
+        });
+        auto const lower  = sum(pool, values, begin, middle);
+        return lower + upper.get();
+    }
+
+    /// @brief Returns the worker counts to measure, doubling from 1 up to the number of hardware threads.
+    ///
+    /// @return The worker counts to measure.
+    static std::vector<std::size_t> workerCounts() noexcept
+    {
+        std::vector<std::size_t> counts{};
+        auto const               hardwareThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 2U);
+        for (std::size_t workers = 1U; workers <= hardwareThreads; workers *= 2U)
+        {
+            counts.emplace_back(workers);
+        }
+        return counts;
+    }
+};
+
+TEST_F(UtilityThreadPool, RecursiveSum)
+{
+    std::vector<std::uint32_t> values(Count);
+    std::iota(values.begin(), values.end(), 0U);
+    auto const expected = (std::uint64_t{Count} * (Count - 1U)) / 2U;
+
+    auto const start  = BenchmarkClock::now();
+    auto const result = std::accumulate(values.begin(), values.end(), std::uint64_t{});
+    reportRate("sequential sum", Count, BenchmarkClock::now() - start);
+    EXPECT_EQ(result, expected);
+
+    for (auto const workers : workerCounts())
+    {
+        ThreadPool pool{workers};
+
+        auto const forkStart = BenchmarkClock::now();
+        auto       future    = pool.submit([&]() noexcept { return sum(pool, values, 0U, values.size()); });
+        EXPECT_EQ(future.get(), expected);
+        reportRate("fork-join sum with " + std::to_string(workers) + " worker(s)",
+                   Count,
+                   BenchmarkClock::now() - forkStart);
+    }
+}
+
+TEST_F(UtilityThreadPool, ParallelForRange2D)
+{
+    std::vector<float> image(Width * Height);
+
+    // enough work per pixel for the distribution not to dominate
+    auto const shade = [&](Range2D::Position const position) noexcept {
+        auto const x    = static_cast<float>(position.x) / Width;
+        auto const y    = static_cast<float>(position.y) / Height;
+        image[position] = std::sin(x * 31.0F) * std::cos(y * 17.0F) + std::sqrt(x * x + y * y);
+    };
+
+    auto const start = BenchmarkClock::now();
+    for (auto const position : Range2D{Width, Height})
+    {
+        shade(position);
+    }
+    reportRate("sequential Range2D", image.size(), BenchmarkClock::now() - start);
+    auto const reference = image;
+
+    for (auto const workers : workerCounts())
+    {
+        ThreadPool pool{workers};
+        std::fill(image.begin(), image.end(), 0.0F);
+
+        auto const parallelStart = BenchmarkClock::now();
+        pool.parallelFor(Range2D{Width, Height}, shade);
+        reportRate("parallelFor Range2D with " + std::to_string(workers) + " worker(s)",
+                   image.size(),
+                   BenchmarkClock::now() - parallelStart);
+        EXPECT_EQ(image, reference);
+    }
+}
+
+} // namespace Terrahertz::Benchmarks
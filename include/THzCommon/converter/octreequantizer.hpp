@@ -0,0 +1,196 @@
+#ifndef THZ_COMMON_CONVERTER_OCTREEQUANTIZER_HPP
+#define THZ_COMMON_CONVERTER_OCTREEQUANTIZER_HPP
+
+#include "THzCommon/structures/octree.hpp"
+#include "THzCommon/utility/threadPool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <gsl/span>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Reduces the colors of images to a palette, clustering the colors in an Octree.
+///
+/// @remarks The pixels of one or more images are streamed in using addPixels, which counts them in a histogram of
+/// BinBits per channel. reducePalette clusters the counted colors in an Octree and merges its least populated leaves
+/// until the requested number of colors is left. mapPixels then replaces each pixel by the index of the closest color
+/// of the palette, looking the color up once per bin of the histogram. The first three bytes of each pixel are used
+/// as the channels of its color, further bytes (like alpha) are ignored.
+class OctreeQuantizer
+{
+public:
+    /// @brief A color of the palette.
+    struct Color
+    {
+        /// @brief The first channel of the color.
+        std::uint8_t red{};
+
+        /// @brief The second channel of the color.
+        std::uint8_t green{};
+
+        /// @brief The third channel of the color.
+        std::uint8_t blue{};
+
+        /// @brief Compares two colors.
+        ///
+        /// @param other The color to compare with.
+        /// @return True if all channels are equal, false otherwise.
+        bool operator==(Color const &other) const noexcept = default;
+    };
+
+    /// @brief The number of bits per channel distinguishing the bins of the histogram.
+    static constexpr std::uint8_t BinBits{5U};
+
+    /// @brief The number of bins of the histogram.
+    static constexpr size_t BinCount{size_t{1U} << (3U * BinBits)};
+
+    /// @brief The number of rows of the tiles the pixels are split into, each job processing whole tiles.
+    static constexpr std::uint32_t TileRows{16U};
+
+    /// @brief The maximum number of pixels counted by one job, so the sums of the channels fit into 32 bits.
+    static constexpr size_t MaxChunkPixels{size_t{1U} << 24U};
+
+    /// @brief The maximum number of colors of the palette.
+    static constexpr size_t MaxColors{256U};
+
+    /// @brief Initializes a new OctreeQuantizer.
+    ///
+    /// @param pool The pool to process the pixels in parallel with, nullptr to process them on the calling thread.
+    OctreeQuantizer(ThreadPool *pool = nullptr) noexcept;
+
+    /// @brief Counts the colors of the given pixels.
+    ///
+    /// @param pixels The pixels of the image, row by row.
+    /// @param width The width of the image [pixels].
+    /// @param height The height of the image [pixels].
+    /// @param bytesPerPixel The number of bytes per pixel, at least 3.
+    /// @return True if the pixels were counted, false if the parameters are invalid.
+    /// @remarks Can be called repeatedly to stream in large images piece by piece or several images sharing a palette.
+    bool addPixels(gsl::span<std::uint8_t const> pixels,
+                   std::uint32_t                 width,
+                   std::uint32_t                 height,
+                   std::uint32_t                 bytesPerPixel = 3U) noexcept;
+
+    /// @brief Returns the number of pixels counted since the last reset.
+    ///
+    /// @return The number of pixels counted.
+    std::uint64_t pixelCount() const noexcept;
+
+    /// @brief Creates the palette from the colors counted.
+    ///
+    /// @param colors The maximum number of colors of the palette, clamped to [1, MaxColors].
+    /// @return The palette, empty if no pixels were counted.
+    /// @remarks The palette keeps all colors if there are fewer than requested.
+    gsl::span<Color const> reducePalette(size_t colors) noexcept;
+
+    /// @brief Returns the palette created by the last call of reducePalette.
+    ///
+    /// @return The palette.
+    gsl::span<Color const> palette() const noexcept;
+
+    /// @brief Replaces each of the given pixels by the index of the closest color of the palette.
+    ///
+    /// @param pixels The pixels of the image, row by row.
+    /// @param width The width of the image [pixels].
+    /// @param height The height of the image [pixels].
+    /// @param bytesPerPixel The number of bytes per pixel, at least 3.
+    /// @param indices Output: The buffer to write the palette index of each pixel to.
+    /// @return True if the pixels were mapped, false if the parameters are invalid or there is no palette.
+    /// @remarks The closest color of each bin is cached and reused by every pixel in the bin. Bins counted before the
+    /// palette was created are looked up using their average color, all others using their center.
+    bool mapPixels(gsl::span<std::uint8_t const> pixels,
+                   std::uint32_t                 width,
+                   std::uint32_t                 height,
+                   std::uint32_t                 bytesPerPixel,
+                   gsl::span<std::uint8_t>       indices) noexcept;
+
+    /// @brief Returns the index of the color of the palette closest to the given color.
+    ///
+    /// @param color The color to look up.
+    /// @return The index of the closest color, 0 if there is no palette.
+    std::uint8_t paletteIndex(Color color) noexcept;
+
+    /// @brief Forgets all pixels counted, keeping the palette.
+    void reset() noexcept;
+
+private:
+    /// @brief The pixels counted in a bin of the histogram, summing up the channels.
+    struct Bin
+    {
+        /// @brief The number of pixels in the bin.
+        std::uint64_t count{};
+
+        /// @brief The sum of the first channel of the pixels.
+        std::uint64_t red{};
+
+        /// @brief The sum of the second channel of the pixels.
+        std::uint64_t green{};
+
+        /// @brief The sum of the third channel of the pixels.
+        std::uint64_t blue{};
+    };
+
+    /// @brief The pixels counted in a bin by a single job.
+    struct PartialBin
+    {
+        /// @brief The number of pixels in the bin.
+        std::uint32_t count{};
+
+        /// @brief The sum of the first channel of the pixels.
+        std::uint32_t red{};
+
+        /// @brief The sum of the second channel of the pixels.
+        std::uint32_t green{};
+
+        /// @brief The sum of the third channel of the pixels.
+        std::uint32_t blue{};
+    };
+
+    /// @brief The octree clustering the bins by their average colors.
+    using ColorTree = Octree<std::uint8_t, std::uint16_t, Bin>;
+
+    /// @brief The octree holding the colors of the palette, the value being the index of the color.
+    using PaletteTree = Octree<std::uint8_t, std::uint16_t, std::uint8_t>;
+
+    /// @brief Marks a bin whose closest color of the palette has not been looked up yet.
+    static constexpr std::uint16_t Unknown{0xFFFFU};
+
+    /// @brief Returns the index of the closest color of the palette, using the cache of the bin.
+    ///
+    /// @param bin The index of the bin of the color.
+    /// @param red The first channel of the color to look up if the bin is not cached yet.
+    /// @param green The second channel of the color to look up if the bin is not cached yet.
+    /// @param blue The third channel of the color to look up if the bin is not cached yet.
+    /// @return The index of the closest color of the palette.
+    std::uint8_t lookup(size_t bin, std::uint8_t red, std::uint8_t green, std::uint8_t blue) noexcept;
+
+    /// @brief The pool to process the pixels in parallel with, may be nullptr.
+    ThreadPool *_pool{};
+
+    /// @brief The histogram of all pixels counted.
+    std::vector<Bin> _bins{};
+
+    /// @brief The histograms of the jobs of addPixels, kept to avoid allocating them for every call.
+    std::vector<std::vector<PartialBin>> _partialBins{};
+
+    /// @brief The number of pixels counted.
+    std::uint64_t _pixelCount{};
+
+    /// @brief The octree clustering the colors counted.
+    ColorTree _colorTree{128U, 128U, 128U, 256U, 1U, 8U};
+
+    /// @brief The octree finding the closest color of the palette.
+    PaletteTree _paletteTree{128U, 128U, 128U, 256U, 4U, 8U};
+
+    /// @brief The colors of the palette.
+    std::vector<Color> _palette{};
+
+    /// @brief The index of the closest color of the palette for every bin, Unknown if not looked up yet.
+    std::vector<std::atomic<std::uint16_t>> _lookup;
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_CONVERTER_OCTREEQUANTIZER_HPP
@@ -0,0 +1,131 @@
+#ifndef THZ_COMMON_MEMORY_BACKINGSTORAGE_HPP
+#define THZ_COMMON_MEMORY_BACKINGSTORAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief The kind of pages backing the memory of a BackingStorage.
+enum class PageKind : std::uint8_t
+{
+    /// @brief Regular pages of the system.
+    Regular,
+
+    /// @brief Regular pages, advised to be merged into huge pages by the kernel.
+    TransparentHuge,
+
+    /// @brief Huge pages reserved by the administrator (MAP_HUGETLB).
+    Huge
+};
+
+/// @brief Describes how the memory of a BackingStorage is obtained.
+struct StoragePolicy final
+{
+    /// @brief The kind of pages backing the memory.
+    PageKind pages{PageKind::Regular};
+
+    /// @brief True to pin the memory, so it is never swapped out.
+    bool locked{};
+
+    /// @brief The NUMA node to bind the memory to, -1 to leave the placement to the system.
+    int numaNode{-1};
+};
+
+/// @brief Region of memory mapped from the system according to a StoragePolicy.
+///
+/// @remarks Every feature of the policy the system does not support falls back gracefully: huge pages to transparent
+/// huge pages to regular ones, pinning and binding are skipped. applied() tells what has been put into effect. Off
+/// Linux the memory is taken from the heap and the policy is ignored.
+class BackingStorage
+{
+public:
+    /// @brief The size of a huge page [bytes].
+    static constexpr std::size_t HugePageSize{2U * 1024U * 1024U};
+
+    /// @brief Initializes a new empty BackingStorage.
+    BackingStorage() noexcept = default;
+
+    /// @brief Initializes a new BackingStorage, mapping the memory.
+    ///
+    /// @param size The minimum size of the region [bytes], rounded up to the size of the pages.
+    /// @param policy The policy to map the memory with.
+    BackingStorage(std::size_t size, StoragePolicy const &policy = {}) noexcept;
+
+    /// @brief No copy construction allowed.
+    BackingStorage(BackingStorage const &) = delete;
+
+    /// @brief Takes over the region of the other storage.
+    ///
+    /// @param other The storage to take the region from, empty afterwards.
+    BackingStorage(BackingStorage &&other) noexcept;
+
+    /// @brief No copy assignment allowed.
+    BackingStorage &operator=(BackingStorage const &) = delete;
+
+    /// @brief Releases the current region and takes over the one of the other storage.
+    ///
+    /// @param other The storage to take the region from, empty afterwards.
+    /// @return This storage.
+    BackingStorage &operator=(BackingStorage &&other) noexcept;
+
+    /// @brief Releases the region.
+    ~BackingStorage() noexcept;
+
+    /// @brief Checks if the storage holds a region.
+    ///
+    /// @return True if a region has been mapped, false otherwise.
+    [[nodiscard]] bool good() const noexcept { return _data != nullptr; }
+
+    /// @brief Returns the start of the region.
+    ///
+    /// @return The start of the region, nullptr if there is none.
+    [[nodiscard]] char *data() const noexcept { return _data; }
+
+    /// @brief Returns the size of the region.
+    ///
+    /// @return The size of the region [bytes].
+    [[nodiscard]] std::size_t size() const noexcept { return _size; }
+
+    /// @brief Returns the part of the policy that has been put into effect.
+    ///
+    /// @return The applied policy.
+    [[nodiscard]] StoragePolicy const &applied() const noexcept { return _applied; }
+
+    /// @brief Returns the number of bytes of the region resident on each NUMA node.
+    ///
+    /// @return The resident bytes, indexed by node, empty if the system cannot tell.
+    /// @remarks Pages never touched are not resident anywhere yet. Queries every page, so use it for reporting only.
+    [[nodiscard]] std::vector<std::size_t> residentPerNode() const noexcept;
+
+    /// @brief Returns the size of the region mapped for the given size and policy.
+    ///
+    /// @param size The minimum size of the region [bytes].
+    /// @param policy The policy to map the memory with.
+    /// @return The size of the region, assuming the kind of pages is supported [bytes].
+    [[nodiscard]] static std::size_t mappedSize(std::size_t size, StoragePolicy const &policy) noexcept;
+
+    /// @brief Adds the resident bytes of the given list to the given totals.
+    ///
+    /// @param totals The totals per node to add to.
+    /// @param resident The resident bytes per node to add.
+    static void accumulate(std::vector<std::size_t> &totals, std::vector<std::size_t> const &resident) noexcept;
+
+private:
+    /// @brief Releases the region.
+    void release() noexcept;
+
+    /// @brief The start of the region.
+    char *_data{};
+
+    /// @brief The size of the region.
+    std::size_t _size{};
+
+    /// @brief The part of the policy that has been put into effect.
+    StoragePolicy _applied{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_MEMORY_BACKINGSTORAGE_HPP
@@ -0,0 +1,149 @@
+#ifndef THZ_COMMON_MEMORY_FIXEDBLOCKPOOL_HPP
+#define THZ_COMMON_MEMORY_FIXEDBLOCKPOOL_HPP
+
+#include "THzCommon/memory/backingstorage.hpp"
+#include "THzCommon/memory/imemorypool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Lock-free memory pool handing out blocks of a fixed size from a single preallocated arena.
+///
+/// @remarks The free blocks form a singly linked list whose head is a tagged index: the lower 32 bits hold the index
+/// of the first free block, the upper 32 bits a counter changed by every update, which prevents the ABA problem of
+/// a plain compare-and-swap. The links are kept next to the arena, so a thread reading a stale link never touches
+/// memory already handed out to someone else. Allocating and deallocating are O(1) and safe from any thread.
+class FixedBlockPool : public IMemoryPool
+{
+public:
+    /// @brief The size of a cache line, the shared counters are aligned to it.
+    static constexpr std::size_t CacheLineSize{64U};
+
+    /// @brief The maximum number of blocks a pool can manage.
+    static constexpr std::size_t MaxBlockCount{0xFFFFFFFEU};
+
+    /// @brief Initializes a new FixedBlockPool, allocating the whole arena up front.
+    ///
+    /// @param blockSize The minimum size of a block [bytes], rounded up to keep every block aligned.
+    /// @param blockCount The number of blocks in the pool, at most MaxBlockCount.
+    /// @param policy The policy to map the arena with.
+    /// @exception bad_alloc In case the arena could not be allocated or its size overflows.
+    FixedBlockPool(std::size_t blockSize, std::size_t blockCount, StoragePolicy const &policy = {}) noexcept(false);
+
+    /// @brief No copy construction allowed.
+    FixedBlockPool(FixedBlockPool const &) = delete;
+
+    /// @brief No move construction allowed.
+    FixedBlockPool(FixedBlockPool &&) = delete;
+
+    /// @brief No copy assignment allowed.
+    FixedBlockPool &operator=(FixedBlockPool const &) = delete;
+
+    /// @brief No move assignment allowed.
+    FixedBlockPool &operator=(FixedBlockPool &&) = delete;
+
+    /// @brief Releases the arena, all blocks have to be deallocated beforehand.
+    ~FixedBlockPool() noexcept override = default;
+
+    /// @brief Allocates a single block.
+    ///
+    /// @param n The number of bytes to allocate, at most blockSize().
+    /// @return Pointer to the first byte of the block.
+    /// @exception bad_alloc In case n exceeds the size of a block or the pool is exhausted.
+    char *allocate(size_t n) noexcept(false) override;
+
+    /// @brief Allocates a single block without throwing.
+    ///
+    /// @return Pointer to the first byte of the block, nullptr if the pool is exhausted.
+    char *tryAllocate() noexcept;
+
+    /// @brief Returns the given block to the pool.
+    ///
+    /// @param p The pointer to the first byte of the block, nullptr is ignored.
+    /// @param n The size the block was allocated with [bytes].
+    /// @remarks Pointers not owned by the pool or not pointing to the start of a block are asserted in debug builds
+    /// and ignored otherwise.
+    void deallocate(char *p, size_t n) noexcept override;
+
+    /// @copydoc IMemoryPool::usedSpace
+    /// @remarks Counts whole blocks, no matter how many bytes were requested.
+    size_t usedSpace() const noexcept override;
+
+    /// @copydoc IMemoryPool::totalSpace
+    size_t totalSpace() const noexcept override;
+
+    /// @brief Returns the size of a single block.
+    ///
+    /// @return The size of a single block [bytes].
+    std::size_t blockSize() const noexcept;
+
+    /// @brief Returns the number of blocks in the pool.
+    ///
+    /// @return The number of blocks in the pool.
+    std::size_t blockCount() const noexcept;
+
+    /// @brief Returns the number of blocks currently allocated.
+    ///
+    /// @return The number of blocks currently allocated.
+    std::size_t usedBlocks() const noexcept;
+
+    /// @brief Checks if the given pointer points into the arena of the pool.
+    ///
+    /// @param p The pointer to check.
+    /// @return True if the pointer belongs to the pool, false otherwise.
+    bool owns(char const *p) const noexcept;
+
+    /// @brief Returns the storage backing the arena.
+    ///
+    /// @return The storage backing the arena.
+    BackingStorage const &storage() const noexcept;
+
+    /// @brief Returns the number of bytes of the arena resident on each NUMA node.
+    ///
+    /// @return The resident bytes, indexed by node, empty if the system cannot tell.
+    /// @remarks Blocks never handed out are usually not resident yet.
+    std::vector<std::size_t> residentPerNode() const noexcept;
+
+private:
+    /// @brief Marks the end of the list of free blocks.
+    static constexpr std::uint32_t NoBlock{0xFFFFFFFFU};
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "The tagged head requires lock-free atomics.");
+
+    /// @brief Combines an index with the tag following the one of the given head.
+    ///
+    /// @param head The current head of the list.
+    /// @param index The index of the new first block.
+    /// @return The new head of the list.
+    static std::uint64_t retag(std::uint64_t head, std::uint32_t index) noexcept;
+
+    /// @brief The size of a single block [bytes].
+    std::size_t _blockSize;
+
+    /// @brief The number of blocks in the pool.
+    std::size_t _blockCount;
+
+    /// @brief The storage of the arena.
+    BackingStorage _storage{};
+
+    /// @brief The memory the blocks are handed out from.
+    char *_arena{};
+
+    /// @brief The index of the next free block, per block.
+    std::unique_ptr<std::atomic<std::uint32_t>[]> _links{};
+
+    /// @brief The tagged index of the first free block.
+    alignas(CacheLineSize) std::atomic<std::uint64_t> _head{};
+
+    /// @brief The number of blocks currently allocated.
+    alignas(CacheLineSize) std::atomic<std::size_t> _usedBlocks{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_MEMORY_FIXEDBLOCKPOOL_HPP
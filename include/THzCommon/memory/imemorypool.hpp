@@ -9,6 +9,9 @@ namespace Terrahertz {
 class IMemoryPool
 {
 public:
+    /// @brief Releases the resources of the MemoryPool.
+    virtual ~IMemoryPool() noexcept = default;
+
     /// @brief Allocates a certain amount of bytes from the MemoryPool.
     ///
     /// @param n The number of bytes to allocate.
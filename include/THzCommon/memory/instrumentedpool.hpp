@@ -0,0 +1,227 @@
+#ifndef THZ_COMMON_MEMORY_INSTRUMENTEDPOOL_HPP
+#define THZ_COMMON_MEMORY_INSTRUMENTEDPOOL_HPP
+
+#include "THzCommon/logging/logging.hpp"
+#include "THzCommon/memory/imemorypool.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Name provider for the memory project.
+struct MemoryProject
+{
+    static constexpr char const *name() noexcept { return "THzCommon.Memory"; }
+};
+
+/// @brief The allocations made at one call site and not deallocated yet.
+struct AllocationSite final
+{
+    /// @brief The location of the call.
+    std::source_location location{};
+
+    /// @brief The number of outstanding allocations.
+    std::size_t allocations{};
+
+    /// @brief The number of outstanding bytes.
+    std::size_t bytes{};
+};
+
+/// @brief Snapshot of the statistics of an InstrumentedPool.
+struct PoolStatistics final
+{
+    /// @brief The number of buckets of the size histogram, covering all sizes up to 2^64.
+    static constexpr std::size_t SizeBucketCount{65U};
+
+    /// @brief The number of allocations per size, bucket i counts the sizes in (2^(i-1), 2^i].
+    std::array<std::uint64_t, SizeBucketCount> sizes{};
+
+    /// @brief The number of successful allocations.
+    std::uint64_t allocations{};
+
+    /// @brief The number of deallocations forwarded to the pool.
+    std::uint64_t deallocations{};
+
+    /// @brief The number of allocations the pool failed to serve.
+    std::uint64_t failures{};
+
+    /// @brief The number of deallocations of blocks not allocated or already deallocated, only detected in debug.
+    std::uint64_t doubleFrees{};
+
+    /// @brief The number of deallocations with a size differing from the allocation, only detected in debug.
+    std::uint64_t sizeMismatches{};
+
+    /// @brief The sum of the sizes of all outstanding allocations [bytes].
+    std::size_t requestedBytes{};
+
+    /// @brief The highest value of requestedBytes [bytes].
+    std::size_t peakRequestedBytes{};
+
+    /// @brief The used space of the pool [bytes].
+    std::size_t usedSpace{};
+
+    /// @brief The total space of the pool [bytes].
+    std::size_t totalSpace{};
+
+    /// @brief The time covered by the statistics.
+    std::chrono::nanoseconds elapsed{};
+
+    /// @brief The outstanding allocations per call site, only recorded in debug.
+    std::vector<AllocationSite> sites{};
+
+    /// @brief Returns the number of allocations per second.
+    ///
+    /// @return The allocation rate [1/s], 0.0 if no time has passed.
+    double allocationRate() const noexcept;
+};
+
+/// @brief Decorator of any IMemoryPool, recording how it is used.
+///
+/// @remarks Recording the histogram, counters and peak is lock-free. In debug builds every outstanding allocation
+/// is additionally tracked in a map guarded by a mutex, attributing it to the call site passed to allocateAt. This
+/// catches double frees, which are logged and not forwarded, as well as size mismatches, which are logged and
+/// forwarded with the size of the allocation.
+class InstrumentedPool : public IMemoryPool
+{
+public:
+    /// @brief Checks if outstanding allocations are tracked, which is the case in debug builds.
+    ///
+    /// @return True if allocations are tracked, false otherwise.
+    static bool tracksAllocations() noexcept;
+
+    /// @brief Initializes a new InstrumentedPool.
+    ///
+    /// @param pool The pool to forward all calls to, has to outlive the decorator.
+    /// @param logger The logger to report misuse to.
+    InstrumentedPool(IMemoryPool &pool, Logger &logger = Logger::globalInstance()) noexcept;
+
+    /// @brief No copy construction allowed.
+    InstrumentedPool(InstrumentedPool const &) = delete;
+
+    /// @brief No move construction allowed.
+    InstrumentedPool(InstrumentedPool &&) = delete;
+
+    /// @brief No copy assignment allowed.
+    InstrumentedPool &operator=(InstrumentedPool const &) = delete;
+
+    /// @brief No move assignment allowed.
+    InstrumentedPool &operator=(InstrumentedPool &&) = delete;
+
+    /// @brief Finalizes the decorator, logging every call site with outstanding allocations as a leak.
+    ~InstrumentedPool() noexcept override;
+
+    /// @copydoc IMemoryPool::allocate
+    /// @remarks Allocations made through this method are attributed to an unknown call site.
+    char *allocate(size_t n) noexcept(false) override;
+
+    /// @brief Allocates a certain amount of bytes from the pool, attributing it to the given call site.
+    ///
+    /// @param n The number of bytes to allocate.
+    /// @param location The call site of the allocation.
+    /// @return Pointer to the first byte of the allocated memory block.
+    /// @exception bad_alloc In case the memory could not be allocated.
+    char *allocateAt(size_t n, std::source_location location = std::source_location::current()) noexcept(false);
+
+    /// @copydoc IMemoryPool::deallocate
+    void deallocate(char *p, size_t n) noexcept override;
+
+    /// @copydoc IMemoryPool::usedSpace
+    size_t usedSpace() const noexcept override;
+
+    /// @copydoc IMemoryPool::totalSpace
+    size_t totalSpace() const noexcept override;
+
+    /// @brief Returns the current statistics.
+    ///
+    /// @return The current statistics.
+    PoolStatistics snapshot() const noexcept;
+
+    /// @brief Resets the histogram, counters and start time, the peak restarts from the outstanding bytes.
+    void reset() noexcept;
+
+private:
+    /// @brief The allocation of a block, as tracked in debug builds.
+    struct Allocation
+    {
+        /// @brief The number of bytes requested.
+        std::size_t size{};
+
+        /// @brief The call site of the allocation.
+        std::source_location location{};
+    };
+
+    /// @brief Records an allocation that has been served.
+    ///
+    /// @param p The pointer to the first byte in the block.
+    /// @param n The size of the block [bytes].
+    /// @param location The call site of the allocation.
+    void recordAllocation(char *p, std::size_t n, std::source_location const &location) noexcept;
+
+    /// @brief The pool all calls are forwarded to.
+    IMemoryPool &_pool;
+
+    /// @brief The logger to report misuse to.
+    Logger &_logger;
+
+    /// @brief The number of allocations per size.
+    std::array<std::atomic<std::uint64_t>, PoolStatistics::SizeBucketCount> _sizes{};
+
+    /// @brief The number of successful allocations.
+    std::atomic<std::uint64_t> _allocations{};
+
+    /// @brief The number of deallocations forwarded to the pool.
+    std::atomic<std::uint64_t> _deallocations{};
+
+    /// @brief The number of allocations the pool failed to serve.
+    std::atomic<std::uint64_t> _failures{};
+
+    /// @brief The number of deallocations of unknown blocks.
+    std::atomic<std::uint64_t> _doubleFrees{};
+
+    /// @brief The number of deallocations with a mismatching size.
+    std::atomic<std::uint64_t> _sizeMismatches{};
+
+    /// @brief The sum of the sizes of all outstanding allocations [bytes].
+    std::atomic<std::size_t> _requestedBytes{};
+
+    /// @brief The highest value of _requestedBytes [bytes].
+    std::atomic<std::size_t> _peakRequestedBytes{};
+
+    /// @brief The start of the period covered by the statistics [ns since epoch of the steady clock].
+    std::atomic<std::int64_t> _start{};
+
+    /// @brief Guards _outstanding.
+    mutable std::mutex _mutex{};
+
+    /// @brief The outstanding allocations, only tracked in debug builds.
+    std::unordered_map<char *, Allocation> _outstanding{};
+};
+
+/// @brief Formats the given statistics as a single line of text, leaving out the call sites.
+///
+/// @param statistics The statistics to format.
+/// @return The formatted statistics.
+std::string toString(PoolStatistics const &statistics) noexcept;
+
+/// @brief Writes the given statistics to the given logger, followed by a line for every call site.
+///
+/// @param statistics The statistics to write.
+/// @param poolName The name identifying the pool in the log.
+/// @param logger The logger to write to.
+void logStatistics(PoolStatistics const &statistics,
+                   std::string_view      poolName,
+                   Logger               &logger = Logger::globalInstance()) noexcept;
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_MEMORY_INSTRUMENTEDPOOL_HPP
@@ -0,0 +1,232 @@
+#ifndef THZ_COMMON_MEMORY_MONOTONICARENA_HPP
+#define THZ_COMMON_MEMORY_MONOTONICARENA_HPP
+
+#include "THzCommon/memory/imemorypool.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace Terrahertz {
+
+/// @brief Memory pool handing out memory by bumping a pointer through a chain of blocks.
+///
+/// @remarks Deallocating does nothing, the memory is reclaimed all at once by reset() or by rewinding to a marker.
+/// Blocks are kept for reuse until release() is called, so an arena that is reset after every request stops
+/// allocating from the system once it has grown to the size the requests need. Not thread safe.
+class MonotonicArena : public IMemoryPool
+{
+    /// @brief Header in front of every block of the chain.
+    struct alignas(std::max_align_t) Block
+    {
+        /// @brief The next block of the chain.
+        Block *next;
+
+        /// @brief The number of bytes following the header.
+        std::size_t size;
+    };
+
+public:
+    /// @brief The default size of the blocks taken from the system [bytes].
+    static constexpr std::size_t DefaultBlockSize{65536U};
+
+    /// @brief A position of the arena to rewind to.
+    struct Marker final
+    {
+        /// @brief The block the position is in.
+        Block *block{};
+
+        /// @brief The offset of the position in the block.
+        std::size_t offset{};
+
+        /// @brief The used space at the position.
+        std::size_t used{};
+    };
+
+    /// @brief Initializes a new MonotonicArena, the first block is allocated with the first allocation.
+    ///
+    /// @param blockSize The size of the blocks taken from the system [bytes], larger allocations get a block of their
+    /// own.
+    /// @param capacity The maximum amount of memory taken from the system [bytes].
+    MonotonicArena(std::size_t blockSize = DefaultBlockSize,
+                   std::size_t capacity  = std::numeric_limits<std::size_t>::max()) noexcept;
+
+    /// @brief No copy construction allowed.
+    MonotonicArena(MonotonicArena const &) = delete;
+
+    /// @brief No move construction allowed.
+    MonotonicArena(MonotonicArena &&) = delete;
+
+    /// @brief No copy assignment allowed.
+    MonotonicArena &operator=(MonotonicArena const &) = delete;
+
+    /// @brief No move assignment allowed.
+    MonotonicArena &operator=(MonotonicArena &&) = delete;
+
+    /// @brief Returns all blocks to the system.
+    ~MonotonicArena() noexcept override;
+
+    /// @copydoc IMemoryPool::allocate
+    /// @remarks The memory is aligned to std::max_align_t.
+    char *allocate(size_t n) noexcept(false) override;
+
+    /// @brief Allocates a certain amount of bytes with the given alignment.
+    ///
+    /// @param n The number of bytes to allocate.
+    /// @param alignment The alignment of the memory, has to be a power of two.
+    /// @return Pointer to the first byte of the allocated memory.
+    /// @exception bad_alloc In case the capacity is exhausted or the system is out of memory.
+    char *allocate(std::size_t n, std::size_t alignment) noexcept(false);
+
+    /// @brief Does nothing, the memory is reclaimed by reset() or rewind().
+    void deallocate(char *p, size_t n) noexcept override;
+
+    /// @copydoc IMemoryPool::usedSpace
+    /// @remarks Includes the padding inserted for alignment.
+    size_t usedSpace() const noexcept override;
+
+    /// @copydoc IMemoryPool::totalSpace
+    /// @remarks The size of all blocks taken from the system so far.
+    size_t totalSpace() const noexcept override;
+
+    /// @brief Returns the current position of the arena.
+    ///
+    /// @return The marker of the current position.
+    Marker mark() const noexcept;
+
+    /// @brief Reclaims everything allocated since the marker was taken.
+    ///
+    /// @param marker The marker to rewind to, it has to be taken after the last reset() or release().
+    void rewind(Marker const &marker) noexcept;
+
+    /// @brief Reclaims all memory handed out, keeping the blocks for reuse.
+    void reset() noexcept;
+
+    /// @brief Reclaims all memory handed out and returns the blocks to the system.
+    void release() noexcept;
+
+private:
+    /// @brief Makes the next block of the chain, holding at least the given number of bytes, the current one.
+    ///
+    /// @param minimum The minimum size of the block [bytes].
+    /// @exception bad_alloc In case the capacity is exhausted or the system is out of memory.
+    void advance(std::size_t minimum) noexcept(false);
+
+    /// @brief The size of the blocks taken from the system.
+    std::size_t _blockSize;
+
+    /// @brief The maximum amount of memory taken from the system.
+    std::size_t _capacity;
+
+    /// @brief The first block of the chain.
+    Block *_first{};
+
+    /// @brief The block allocations are served from.
+    Block *_current{};
+
+    /// @brief The offset of the next free byte in the current block.
+    std::size_t _offset{};
+
+    /// @brief The number of bytes handed out since the last reset.
+    std::size_t _used{};
+
+    /// @brief The number of bytes taken from the system.
+    std::size_t _reserved{};
+};
+
+/// @brief Rewinds an arena to the position it had when the scope was entered.
+class ArenaScope
+{
+public:
+    /// @brief Enters a new scope.
+    ///
+    /// @param arena The arena to rewind once the scope is left.
+    ArenaScope(MonotonicArena &arena) noexcept : _arena{arena}, _marker{arena.mark()} {}
+
+    /// @brief No copy construction allowed.
+    ArenaScope(ArenaScope const &) = delete;
+
+    /// @brief No move construction allowed.
+    ArenaScope(ArenaScope &&) = delete;
+
+    /// @brief No copy assignment allowed.
+    ArenaScope &operator=(ArenaScope const &) = delete;
+
+    /// @brief No move assignment allowed.
+    ArenaScope &operator=(ArenaScope &&) = delete;
+
+    /// @brief Leaves the scope, reclaiming everything allocated within.
+    ~ArenaScope() noexcept { _arena.rewind(_marker); }
+
+private:
+    /// @brief The arena to rewind.
+    MonotonicArena &_arena;
+
+    /// @brief The position to rewind to.
+    MonotonicArena::Marker _marker;
+};
+
+/// @brief Allocator for standard containers, allocating from a MonotonicArena.
+///
+/// @tparam TValueType The type of values to allocate.
+template <typename TValueType>
+class ArenaAllocator
+{
+public:
+    /// @brief The type of values to allocate.
+    using value_type = TValueType;
+
+    /// @brief Initializes a new ArenaAllocator.
+    ///
+    /// @param arena The arena to allocate from, has to outlive all memory allocated.
+    ArenaAllocator(MonotonicArena &arena) noexcept : _arena{&arena} {}
+
+    /// @brief Initializes a new ArenaAllocator using the same arena as the given one.
+    ///
+    /// @tparam TOther The value type of the other allocator.
+    /// @param other The allocator to copy the arena from.
+    template <typename TOther>
+    ArenaAllocator(ArenaAllocator<TOther> const &other) noexcept : _arena{&other.arena()}
+    {}
+
+    /// @brief Allocates memory for the given number of values.
+    ///
+    /// @param n The number of values.
+    /// @return Pointer to the memory.
+    /// @exception bad_alloc In case the arena is exhausted.
+    TValueType *allocate(std::size_t const n) noexcept(false)
+    {
+        if (n > (std::numeric_limits<std::size_t>::max() / sizeof(TValueType)))
+        {
+            throw std::bad_array_new_length{};
+        }
+        return reinterpret_cast<TValueType *>(_arena->allocate(n * sizeof(TValueType), alignof(TValueType)));
+    }
+
+    /// @brief Does nothing, the memory is reclaimed together with the arena.
+    void deallocate(TValueType *, std::size_t) noexcept {}
+
+    /// @brief Returns the arena the allocator allocates from.
+    ///
+    /// @return The arena.
+    MonotonicArena &arena() const noexcept { return *_arena; }
+
+    /// @brief Checks if both allocators use the same arena.
+    ///
+    /// @tparam TOther The value type of the other allocator.
+    /// @param other The other allocator.
+    /// @return True if both use the same arena, false otherwise.
+    template <typename TOther>
+    bool operator==(ArenaAllocator<TOther> const &other) const noexcept
+    {
+        return _arena == &other.arena();
+    }
+
+private:
+    /// @brief The arena to allocate from.
+    MonotonicArena *_arena;
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_MEMORY_MONOTONICARENA_HPP
@@ -0,0 +1,56 @@
+#ifndef THZ_COMMON_MEMORY_POOLMEMORYRESOURCE_HPP
+#define THZ_COMMON_MEMORY_POOLMEMORYRESOURCE_HPP
+
+#include "THzCommon/memory/imemorypool.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace Terrahertz {
+
+/// @brief Adapter making any IMemoryPool usable as std::pmr::memory_resource, e.g. for std::pmr::vector.
+///
+/// @remarks Allocations with an alignment above the one of std::max_align_t take alignment + sizeof(std::size_t)
+/// additional bytes from the pool, the offset to the block is stored right in front of the returned memory.
+class PoolMemoryResource : public std::pmr::memory_resource
+{
+public:
+    /// @brief Initializes a new PoolMemoryResource.
+    ///
+    /// @param pool The pool to allocate from, has to outlive the resource.
+    PoolMemoryResource(IMemoryPool &pool) noexcept;
+
+    /// @brief Returns the pool the resource allocates from.
+    ///
+    /// @return The pool the resource allocates from.
+    IMemoryPool &pool() const noexcept;
+
+private:
+    /// @brief Allocates memory from the pool.
+    ///
+    /// @param bytes The number of bytes to allocate.
+    /// @param alignment The alignment of the memory.
+    /// @return Pointer to the allocated memory.
+    /// @exception bad_alloc In case the pool is exhausted.
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    /// @brief Returns memory to the pool.
+    ///
+    /// @param p Pointer to the memory.
+    /// @param bytes The number of bytes the memory was allocated with.
+    /// @param alignment The alignment the memory was allocated with.
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+
+    /// @brief Checks if memory allocated by this resource can be deallocated by the other one and vice versa.
+    ///
+    /// @param other The other resource.
+    /// @return True if both resources use the same pool, false otherwise.
+    bool do_is_equal(std::pmr::memory_resource const &other) const noexcept override;
+
+    /// @brief The pool to allocate from.
+    IMemoryPool *_pool;
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_MEMORY_POOLMEMORYRESOURCE_HPP
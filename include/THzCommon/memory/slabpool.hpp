@@ -0,0 +1,143 @@
+#ifndef THZ_COMMON_MEMORY_SLABPOOL_HPP
+#define THZ_COMMON_MEMORY_SLABPOOL_HPP
+
+#include "THzCommon/memory/backingstorage.hpp"
+#include "THzCommon/memory/imemorypool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Terrahertz {
+namespace Internal {
+
+/// @brief The state of a SlabPool, shared with the magazines of the threads using it.
+struct SlabPoolState;
+
+} // namespace Internal
+
+/// @brief Usage of a single size class of a SlabPool.
+struct SizeClassStatistics final
+{
+    /// @brief The size of the blocks of the class [bytes].
+    std::size_t blockSize{};
+
+    /// @brief The number of blocks carved from the slabs of the class.
+    std::size_t reservedBlocks{};
+
+    /// @brief The number of blocks currently handed out to threads, either in use or cached in their magazines.
+    std::size_t takenBlocks{};
+
+    /// @brief The largest number of blocks handed out to threads at the same time.
+    std::size_t highWaterBlocks{};
+};
+
+/// @brief Snapshot of the usage of a SlabPool.
+struct SlabPoolStatistics final
+{
+    /// @brief The sum of the sizes passed to allocate for all blocks currently allocated [bytes].
+    std::size_t requestedBytes{};
+
+    /// @brief The size of all blocks currently allocated, including the mapped large allocations [bytes].
+    std::size_t usedBytes{};
+
+    /// @brief The memory taken from the system, slabs and large allocations [bytes].
+    std::size_t reservedBytes{};
+
+    /// @brief The memory mapped for large allocations [bytes].
+    std::size_t largeBytes{};
+
+    /// @brief The statistics of every size class, smallest first.
+    std::vector<SizeClassStatistics> classes{};
+
+    /// @brief The reserved bytes resident on each NUMA node, indexed by node, empty if the system cannot tell.
+    std::vector<std::size_t> residentPerNode{};
+
+    /// @brief Returns the share of the reserved memory not holding requested bytes.
+    ///
+    /// @return The fragmentation in the range [0.0, 1.0], 0.0 if nothing has been reserved.
+    /// @remarks Covers internal fragmentation from rounding up to the size class as well as free blocks.
+    double fragmentation() const noexcept;
+};
+
+/// @brief Memory pool for variable sized allocations, sorted into power-of-two size classes.
+///
+/// @remarks Each size class carves its blocks from slabs taken from the system and keeps the free ones in a list
+/// guarded by a mutex. Every thread has a magazine per class in front of that list, so most calls neither lock nor
+/// touch memory shared with other threads. Magazines exchange half their capacity with the class at once. Allocations
+/// larger than MaxClassSize are mapped from the system directly. Slabs are only released with the pool, with huge
+/// pages they span a huge page each.
+class SlabPool : public IMemoryPool
+{
+public:
+    /// @brief The size of the smallest class [bytes].
+    static constexpr std::size_t MinClassSize{16U};
+
+    /// @brief The size of the largest class [bytes], larger allocations are mapped directly.
+    static constexpr std::size_t MaxClassSize{32768U};
+
+    /// @brief The number of size classes.
+    static constexpr std::size_t ClassCount{12U};
+
+    /// @brief The size of the slabs the blocks are carved from [bytes].
+    static constexpr std::size_t SlabSize{262144U};
+
+    /// @brief The number of blocks a magazine caches per class.
+    static constexpr std::size_t MagazineSize{32U};
+
+    /// @brief Initializes a new SlabPool.
+    ///
+    /// @param capacity The maximum amount of memory taken from the system [bytes].
+    /// @param policy The policy to map the slabs and large allocations with.
+    SlabPool(std::size_t capacity, StoragePolicy const &policy = {}) noexcept;
+
+    /// @brief No copy construction allowed.
+    SlabPool(SlabPool const &) = delete;
+
+    /// @brief No move construction allowed.
+    SlabPool(SlabPool &&) = delete;
+
+    /// @brief No copy assignment allowed.
+    SlabPool &operator=(SlabPool const &) = delete;
+
+    /// @brief No move assignment allowed.
+    SlabPool &operator=(SlabPool &&) = delete;
+
+    /// @brief Releases all memory of the pool, all blocks have to be deallocated beforehand.
+    ~SlabPool() noexcept override;
+
+    /// @copydoc IMemoryPool::allocate
+    /// @remarks The memory is aligned to at least MinClassSize.
+    char *allocate(size_t n) noexcept(false) override;
+
+    /// @copydoc IMemoryPool::deallocate
+    /// @remarks The size has to match the one the block was allocated with.
+    void deallocate(char *p, size_t n) noexcept override;
+
+    /// @copydoc IMemoryPool::usedSpace
+    /// @remarks Counts the size of the blocks, not the requested number of bytes.
+    size_t usedSpace() const noexcept override;
+
+    /// @copydoc IMemoryPool::totalSpace
+    size_t totalSpace() const noexcept override;
+
+    /// @brief Returns a snapshot of the usage of the pool.
+    ///
+    /// @return The statistics of the pool.
+    SlabPoolStatistics statistics() const noexcept;
+
+    /// @brief Returns the index of the size class serving the given number of bytes.
+    ///
+    /// @param n The number of bytes.
+    /// @return The index of the size class, ClassCount for large allocations.
+    static std::size_t classIndex(std::size_t n) noexcept;
+
+private:
+    /// @brief The state of the pool.
+    std::shared_ptr<Internal::SlabPoolState> _state;
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_MEMORY_SLABPOOL_HPP
@@ -22,6 +22,12 @@ struct Address final
 
     /// @brief The port of the application.
     std::uint16_t port{};
+
+    /// @brief Compares this address to another one, ordering by IP address first and port second.
+    ///
+    /// @param other The other address to compare this one with.
+    /// @return The ordering of the addresses.
+    auto operator<=>(Address const &other) const noexcept = default;
 };
 
 using IPV_Addresses = std::vector<std::variant<Internal::IPV4Address, Internal::IPV6Address>>;
@@ -0,0 +1,215 @@
+#ifndef THZ_COMMON_NETWORK_CONNECTIONPOOL_HPP
+#define THZ_COMMON_NETWORK_CONNECTIONPOOL_HPP
+
+#include "THzCommon/configuration/configuration.hpp"
+#include "THzCommon/network/address.hpp"
+#include "THzCommon/network/tcpsocket.hpp"
+#include "THzCommon/utility/workerThread.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Settings of a ConnectionPool.
+struct ConnectionPoolSettings final
+{
+    /// @brief True if TCP_NODELAY shall be set on new connections.
+    bool noDelay{true};
+
+    /// @brief True if SO_KEEPALIVE shall be set on new connections.
+    bool keepAlive{true};
+
+    /// @brief The maximum number of connections to a single endpoint.
+    std::size_t maxPerEndpoint{8U};
+
+    /// @brief The maximum number of connections in total.
+    std::size_t maxTotal{64U};
+
+    /// @brief The time after which an unused connection gets closed.
+    std::chrono::milliseconds idleTimeout{30000U};
+
+    /// @brief Reads the settings from the given configuration.
+    ///
+    /// @param configuration The configuration containing the settings.
+    /// @remarks Known keys are no_delay, keep_alive, max_per_endpoint, max_total and idle_timeout_ms.
+    /// Missing or invalid values keep their current value.
+    void load(Configuration const &configuration) noexcept;
+};
+
+/// @brief Thread-safe pool of established client connections, keyed by the address of the server.
+///
+/// @tparam TVersion The version of the internet protocol.
+template <IPVersion TVersion>
+class ConnectionPool
+{
+public:
+    /// @brief Grants exclusive use of a pooled connection, handing it back to the pool on destruction.
+    class Lease
+    {
+    public:
+        /// @brief Default initializes a Lease without a connection.
+        Lease() noexcept = default;
+
+        /// @brief No copy construction allowed.
+        Lease(Lease const &) = delete;
+
+        /// @brief Initializes a lease by taking over the connection of another one.
+        ///
+        /// @param other The lease to move from.
+        Lease(Lease &&other) noexcept;
+
+        /// @brief No copy assignment allowed.
+        Lease &operator=(Lease const &) = delete;
+
+        /// @brief Hands back the current connection and takes over the connection of another lease.
+        ///
+        /// @param other The lease to move from.
+        /// @return This lease.
+        Lease &operator=(Lease &&other) noexcept;
+
+        /// @brief Hands the connection back to the pool.
+        ~Lease() noexcept;
+
+        /// @brief Checks if the lease holds a usable connection.
+        ///
+        /// @return True if the connection can be used, false otherwise.
+        bool good() noexcept;
+
+        /// @brief Provides access to the socket of the connection.
+        ///
+        /// @return The socket of the connection.
+        /// @remarks Must only be called if the lease is good.
+        TCPSocket<TVersion> &socket() noexcept;
+
+        /// @brief Closes the connection, so it will not be reused.
+        void invalidate() noexcept;
+
+    private:
+        friend class ConnectionPool;
+
+        /// @brief Initializes a new Lease.
+        ///
+        /// @param pool The pool the connection belongs to.
+        /// @param address The address of the server.
+        /// @param socket The socket of the connection.
+        Lease(ConnectionPool *pool, Address<TVersion> const &address, TCPSocket<TVersion> &&socket) noexcept;
+
+        /// @brief Hands the connection back to the pool, if there is one.
+        void giveBack() noexcept;
+
+        /// @brief The pool the connection belongs to.
+        ConnectionPool *_pool{};
+
+        /// @brief The address of the server.
+        Address<TVersion> _address{};
+
+        /// @brief The socket of the connection.
+        std::optional<TCPSocket<TVersion>> _socket{};
+    };
+
+    /// @brief Initializes a new ConnectionPool.
+    ///
+    /// @param settings The settings of the pool.
+    ConnectionPool(ConnectionPoolSettings const &settings = {}) noexcept;
+
+    /// @brief No copy construction allowed.
+    ConnectionPool(ConnectionPool const &) = delete;
+
+    /// @brief No move construction allowed, as leases refer to the pool.
+    ConnectionPool(ConnectionPool &&) = delete;
+
+    /// @brief No copy assignment allowed.
+    ConnectionPool &operator=(ConnectionPool const &) = delete;
+
+    /// @brief No move assignment allowed, as leases refer to the pool.
+    ConnectionPool &operator=(ConnectionPool &&) = delete;
+
+    /// @brief Stops the maintenance and closes all idle connections.
+    /// @remarks All leases have to be destroyed before the pool.
+    ~ConnectionPool() noexcept;
+
+    /// @brief Returns an established connection to the given server, reusing an idle one if possible.
+    ///
+    /// @param address The address of the server.
+    /// @return The lease of the connection, not good if no connection could be established within the limits.
+    Lease acquire(Address<TVersion> const &address) noexcept;
+
+    /// @brief Closes all idle connections that timed out or were closed by the server.
+    ///
+    /// @return The number of closed connections.
+    std::size_t checkHealth() noexcept;
+
+    /// @brief Starts a thread calling checkHealth periodically.
+    ///
+    /// @param interval The time between two health checks.
+    void startMaintenance(std::chrono::milliseconds interval) noexcept;
+
+    /// @brief Returns the number of idle connections.
+    ///
+    /// @return The number of idle connections.
+    std::size_t idleConnections() const noexcept;
+
+    /// @brief Returns the number of leased connections.
+    ///
+    /// @return The number of leased connections.
+    std::size_t leasedConnections() const noexcept;
+
+private:
+    /// @brief A connection waiting to be reused.
+    struct IdleConnection
+    {
+        /// @brief The socket of the connection.
+        TCPSocket<TVersion> socket;
+
+        /// @brief The time the connection was handed back.
+        std::chrono::steady_clock::time_point since;
+    };
+
+    /// @brief The connections to a single server.
+    struct Endpoint
+    {
+        /// @brief The idle connections to the server, the most recently used one is at the back.
+        std::vector<IdleConnection> idle{};
+
+        /// @brief The number of leased connections.
+        std::size_t leased{};
+    };
+
+    /// @brief Takes back a leased connection.
+    ///
+    /// @param address The address of the server.
+    /// @param socket The socket of the connection, closed if it shall not be reused.
+    void giveBack(Address<TVersion> const &address, std::optional<TCPSocket<TVersion>> &socket) noexcept;
+
+    /// @brief Closes the least recently used idle connection of any endpoint, to make room for a new one.
+    ///
+    /// @return True if a connection was closed, false if there was none.
+    bool evictIdle() noexcept;
+
+    /// @brief The settings of the pool.
+    ConnectionPoolSettings _settings;
+
+    /// @brief Mutex protecting the endpoints.
+    mutable std::mutex _mutex{};
+
+    /// @brief The connections per server.
+    std::map<Address<TVersion>, Endpoint> _endpoints{};
+
+    /// @brief The total number of connections.
+    std::size_t _total{};
+
+    /// @brief The thread performing the periodic health checks.
+    WorkerThread _maintenance{};
+};
+
+extern template class ConnectionPool<IPVersion::V4>;
+extern template class ConnectionPool<IPVersion::V6>;
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_NETWORK_CONNECTIONPOOL_HPP
@@ -0,0 +1,196 @@
+#ifndef THZ_COMMON_NETWORK_MESSAGEFRAMER_HPP
+#define THZ_COMMON_NETWORK_MESSAGEFRAMER_HPP
+
+#include "THzCommon/memory/imemorypool.hpp"
+#include "THzCommon/network/tcpsocket.hpp"
+#include "THzCommon/utility/result.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Terrahertz {
+
+/// @brief The encodings available for the length prefix of a framed message.
+enum class LengthPrefix
+{
+    /// @brief 16-bit unsigned integer in network byte order.
+    Fixed16 = 0U,
+
+    /// @brief 32-bit unsigned integer in network byte order.
+    Fixed32 = 1U,
+
+    /// @brief Variable length integer using 7 bits per byte, least significant group first.
+    VarInt = 2U
+};
+
+/// @brief Decides when coalesced outgoing messages are handed to the socket.
+struct FlushPolicy final
+{
+    /// @brief The number of pending bytes at which the messages are sent [bytes].
+    std::size_t flushThreshold{1400U};
+
+    /// @brief The maximum time a message waits for others to be coalesced with, 0 to disable coalescing.
+    ///
+    /// @remarks There is no timer, the delay is only checked by MessageFramer::send and MessageFramer::flushIfDue.
+    /// Callers that stop sending have to call flushIfDue periodically or flush, otherwise messages wait indefinitely.
+    std::chrono::microseconds maxDelay{200U};
+};
+
+/// @brief Sends and receives length prefixed messages over a TCPSocket.
+///
+/// @tparam TVersion The version of the internet protocol.
+/// @remarks Received messages are stored in buffers drawn from the given memory pool,
+/// they have to be handed back using release once they have been processed.
+template <IPVersion TVersion>
+class MessageFramer
+{
+public:
+    /// @brief Initializes a new MessageFramer.
+    ///
+    /// @param socket The connected socket to send and receive messages with.
+    /// @param pool The pool to draw the message and transfer buffers from.
+    /// @param prefix The encoding of the length prefix.
+    /// @param receiveBufferSize The size of the buffer used to read from the socket [bytes].
+    /// @param maxMessageSize The maximum size of a received message [bytes].
+    /// @param policy The policy for coalescing outgoing messages.
+    /// @exception bad_alloc In case the transfer buffers could not be drawn from the pool.
+    MessageFramer(TCPSocket<TVersion> &socket,
+                  IMemoryPool         &pool,
+                  LengthPrefix         prefix            = LengthPrefix::Fixed32,
+                  std::size_t          receiveBufferSize = 65536U,
+                  std::size_t          maxMessageSize    = 16777216U,
+                  FlushPolicy          policy            = {}) noexcept(false);
+
+    /// @brief No copy construction allowed.
+    MessageFramer(MessageFramer const &) = delete;
+
+    /// @brief No copy assignment allowed.
+    MessageFramer &operator=(MessageFramer const &) = delete;
+
+    /// @brief Returns the transfer buffers to the pool, pending messages that were not flushed are discarded.
+    ~MessageFramer() noexcept;
+
+    /// @brief Checks if a complete message can be returned by receive without calling the socket.
+    ///
+    /// @return True if a complete message is buffered, false otherwise.
+    bool messageBuffered() const noexcept;
+
+    /// @brief Receives the next complete message, reading from the socket until one is available.
+    ///
+    /// @return The message, EMSGSIZE if it exceeds the maximum message size, ECONNRESET if the peer closed,
+    /// EBADMSG if the stream holds a malformed prefix.
+    /// @remarks Every read takes as much data as fits into the receive buffer, large messages are read directly
+    /// into their own buffer. If the socket fails (e.g. EAGAIN, EINTR or a timeout) the data read so far is kept and
+    /// the next call continues where this one stopped. An oversized message is skipped, the next call skips the
+    /// rest of it before returning the following message. A malformed prefix fails all further calls.
+    Result<std::span<std::byte>> receive() noexcept;
+
+    /// @brief Returns the buffer of a received message to the pool.
+    ///
+    /// @param message The message returned by receive.
+    void release(std::span<std::byte> message) noexcept;
+
+    /// @brief Sends the given message, coalescing it with others according to the flush policy.
+    ///
+    /// @param message The message to send.
+    /// @return The size of the message, EMSGSIZE if the length can not be encoded using the prefix, EPIPE if the
+    /// stream was broken by an earlier call.
+    /// @remarks Messages too large for the send buffer are handed to the socket directly. If the socket fails after
+    /// part of such a message has been sent, the stream can not be continued and all further sends fail with EPIPE.
+    Result<std::size_t> send(std::span<std::byte const> message) noexcept;
+
+    /// @brief Sends all pending messages.
+    ///
+    /// @return The number of bytes handed to the socket.
+    /// @remarks If the socket fails, the bytes already sent are remembered and the next call continues after them.
+    Result<std::size_t> flush() noexcept;
+
+    /// @brief Sends all pending messages, if the oldest one has waited for longer than allowed by the policy.
+    ///
+    /// @return The number of bytes handed to the socket.
+    /// @remarks Has to be called periodically while messages are pending, see FlushPolicy::maxDelay.
+    Result<std::size_t> flushIfDue() noexcept;
+
+    /// @brief Returns the number of bytes waiting to be sent.
+    ///
+    /// @return The number of bytes waiting to be sent.
+    std::size_t pending() const noexcept;
+
+private:
+    /// @brief Hands all given buffers to the socket, retrying on partial sends.
+    ///
+    /// @param buffers The buffers to send, will be modified.
+    /// @param sent Output: The number of bytes sent, also if the socket failed.
+    /// @return The number of bytes sent.
+    Result<std::size_t> sendAll(std::span<std::span<std::byte const>> buffers, std::size_t &sent) noexcept;
+
+    /// @brief Reads the rest of the message being received directly into its buffer.
+    ///
+    /// @return The complete message.
+    Result<std::span<std::byte>> receiveRemaining() noexcept;
+
+    /// @brief Skips the rest of an oversized message.
+    ///
+    /// @return The number of bytes skipped, once the whole message has been skipped.
+    Result<std::size_t> discardRemaining() noexcept;
+
+    /// @brief The socket to send and receive messages with.
+    TCPSocket<TVersion> &_socket;
+
+    /// @brief The pool to draw the message and transfer buffers from.
+    IMemoryPool &_pool;
+
+    /// @brief The encoding of the length prefix.
+    LengthPrefix _prefix;
+
+    /// @brief The maximum size of a received message [bytes].
+    std::size_t _maxMessageSize;
+
+    /// @brief The policy for coalescing outgoing messages.
+    FlushPolicy _policy;
+
+    /// @brief The buffer used to read from the socket.
+    std::span<std::byte> _receiveBuffer{};
+
+    /// @brief The position of the first unprocessed byte in the receive buffer.
+    std::size_t _receiveBegin{};
+
+    /// @brief The position after the last received byte in the receive buffer.
+    std::size_t _receiveEnd{};
+
+    /// @brief The buffer used to coalesce outgoing messages.
+    std::span<std::byte> _sendBuffer{};
+
+    /// @brief The number of bytes waiting in the send buffer.
+    std::size_t _pending{};
+
+    /// @brief The number of pending bytes already handed to the socket by a failed flush.
+    std::size_t _sent{};
+
+    /// @brief Flag signalling that a large message was only sent partially, so the stream can not be continued.
+    bool _broken{};
+
+    /// @brief The buffer of the message being read directly from the socket.
+    std::span<std::byte> _partial{};
+
+    /// @brief The number of bytes of the message being read that have been received already.
+    std::size_t _partialReceived{};
+
+    /// @brief The number of bytes of an oversized message left to skip.
+    std::size_t _discard{};
+
+    /// @brief Flag signalling that a malformed prefix was received, so the stream can not be continued.
+    bool _malformed{};
+
+    /// @brief The time the oldest pending message was queued.
+    std::chrono::steady_clock::time_point _oldestPending{};
+};
+
+extern template class MessageFramer<IPVersion::V4>;
+extern template class MessageFramer<IPVersion::V6>;
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_NETWORK_MESSAGEFRAMER_HPP
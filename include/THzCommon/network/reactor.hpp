@@ -0,0 +1,170 @@
+#ifndef THZ_COMMON_NETWORK_REACTOR_HPP
+#define THZ_COMMON_NETWORK_REACTOR_HPP
+
+#include "THzCommon/network/common.hpp"
+#include "THzCommon/utility/result.hpp"
+#include "THzCommon/utility/threadPool.hpp"
+#include "THzCommon/utility/workerThread.hpp"
+
+#include <coroutine>
+#include <cstdint>
+#include <unordered_map>
+
+namespace Terrahertz {
+
+/// @brief Waits for sockets to become readable or writable and resumes the coroutines waiting for them.
+///
+/// @remarks Uses epoll on a thread of its own, only supported on Linux. Each socket can have one pending wait for
+/// reading and one for writing at the same time, so a coroutine can send while another one receives.
+class Reactor
+{
+public:
+    /// @brief Awaiter suspending a coroutine until a socket is ready.
+    class Readiness
+    {
+    public:
+        /// @brief Initializes a new Readiness.
+        ///
+        /// @param reactor The reactor to wait with.
+        /// @param handle The handle of the socket to wait for.
+        /// @param write True to wait until the socket is writable, false to wait until it is readable.
+        Readiness(Reactor &reactor, Internal::SocketHandleType handle, bool write) noexcept;
+
+        /// @brief The caller only waits after the socket turned out not to be ready.
+        ///
+        /// @return Always false.
+        bool await_ready() const noexcept { return false; }
+
+        /// @brief Registers the coroutine with the reactor.
+        ///
+        /// @param coroutine The coroutine to resume once the socket is ready.
+        /// @return True if the coroutine is suspended, false if the registration failed.
+        bool await_suspend(std::coroutine_handle<> coroutine) noexcept;
+
+        /// @brief Returns the result of the wait.
+        ///
+        /// @return 0 if the socket is ready, the error code if the registration failed, ECANCELED if the reactor
+        /// stopped while waiting.
+        errno_t await_resume() const noexcept { return _error; }
+
+    private:
+        friend class Reactor;
+
+        /// @brief The reactor to wait with.
+        Reactor *_reactor;
+
+        /// @brief The handle of the socket to wait for.
+        Internal::SocketHandleType _handle;
+
+        /// @brief True to wait until the socket is writable, false to wait until it is readable.
+        bool _write;
+
+        /// @brief The coroutine to resume.
+        std::coroutine_handle<> _coroutine{};
+
+        /// @brief The error code of the registration.
+        errno_t _error{};
+    };
+
+    /// @brief The maximum number of events handled per wakeup of the reactor thread.
+    static constexpr int EventsPerWakeUp{64};
+
+    /// @brief Initializes a new Reactor and starts its thread.
+    ///
+    /// @param pool The pool to resume the coroutines on, nullptr to resume them on the thread of the reactor.
+    Reactor(ThreadPool *pool = nullptr) noexcept;
+
+    /// @brief No copy construction allowed.
+    Reactor(Reactor const &) = delete;
+
+    /// @brief No move construction allowed.
+    Reactor(Reactor &&) = delete;
+
+    /// @brief No copy assignment allowed.
+    Reactor &operator=(Reactor const &) = delete;
+
+    /// @brief No move assignment allowed.
+    Reactor &operator=(Reactor &&) = delete;
+
+    /// @brief Stops the reactor.
+    ~Reactor() noexcept;
+
+    /// @brief Checks if the reactor is running.
+    ///
+    /// @return True if the reactor is running, false otherwise.
+    bool good() const noexcept;
+
+    /// @brief Suspends the awaiting coroutine until the socket is readable.
+    ///
+    /// @param handle The handle of the socket.
+    /// @return The awaiter, resuming with 0 or the error code of the registration.
+    Readiness readable(Internal::SocketHandleType handle) noexcept { return Readiness{*this, handle, false}; }
+
+    /// @brief Suspends the awaiting coroutine until the socket is writable.
+    ///
+    /// @param handle The handle of the socket.
+    /// @return The awaiter, resuming with 0 or the error code of the registration.
+    Readiness writable(Internal::SocketHandleType handle) noexcept { return Readiness{*this, handle, true}; }
+
+    /// @brief Stops the thread of the reactor.
+    ///
+    /// @remarks Coroutines still waiting are resumed with ECANCELED, later waits fail with ECANCELED.
+    void stop() noexcept;
+
+private:
+    /// @brief The coroutines waiting for a socket.
+    struct Registration
+    {
+        /// @brief The awaiter waiting until the socket is readable, nullptr if there is none.
+        Readiness *reader{};
+
+        /// @brief The awaiter waiting until the socket is writable, nullptr if there is none.
+        Readiness *writer{};
+    };
+
+    /// @brief Returns the epoll events to wait for, given the awaiters of a socket.
+    ///
+    /// @param registration The awaiters of the socket.
+    /// @return The events to wait for.
+    static std::uint32_t events(Registration const &registration) noexcept;
+
+    /// @brief Arms the registration of the socket for a single event.
+    ///
+    /// @param readiness The awaiter to resume once the event occurs.
+    /// @return 0 if successful, EBUSY if the socket already has a wait of the same kind, the error code otherwise.
+    errno_t arm(Readiness &readiness) noexcept;
+
+    /// @brief Updates the registration of the socket in epoll to wait for all pending awaiters.
+    ///
+    /// @param handle The handle of the socket.
+    /// @param registration The awaiters of the socket.
+    /// @return 0 if successful, the error code otherwise.
+    errno_t update(Internal::SocketHandleType handle, Registration const &registration) noexcept;
+
+    /// @brief Resumes the given coroutine, on the pool if there is one.
+    ///
+    /// @param coroutine The coroutine to resume.
+    void resume(std::coroutine_handle<> coroutine) noexcept;
+
+    /// @brief Waits for events and resumes the waiting coroutines until shutdown.
+    void run() noexcept;
+
+    /// @brief The pool to resume the coroutines on.
+    ThreadPool *_pool;
+
+    /// @brief The descriptor of the epoll instance.
+    int _poller{-1};
+
+    /// @brief The descriptor of the eventfd waking up the thread for shutdown.
+    int _wakeUp{-1};
+
+    /// @brief The thread of the reactor, its mutex guards the registrations.
+    WorkerThread _thread{};
+
+    /// @brief The awaiters of the sockets with pending waits.
+    std::unordered_map<Internal::SocketHandleType, Registration> _registrations{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_NETWORK_REACTOR_HPP
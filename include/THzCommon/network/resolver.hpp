@@ -0,0 +1,179 @@
+#ifndef THZ_COMMON_NETWORK_RESOLVER_HPP
+#define THZ_COMMON_NETWORK_RESOLVER_HPP
+
+#include "THzCommon/network/address.hpp"
+#include "THzCommon/utility/workerThread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Settings of a Resolver.
+struct ResolverSettings final
+{
+    /// @brief The number of threads performing lookups.
+    std::size_t workerCount{2U};
+
+    /// @brief The maximum number of cached lookups.
+    std::size_t capacity{256U};
+
+    /// @brief The time a successful lookup is cached.
+    std::chrono::milliseconds timeToLive{60000U};
+
+    /// @brief The time a failed lookup is cached.
+    std::chrono::milliseconds negativeTimeToLive{5000U};
+};
+
+/// @brief Resolves host names asynchronously, caching the results.
+///
+/// @remarks Concurrent lookups of the same host are coalesced into a single call of the lookup function.
+class Resolver
+{
+public:
+    /// @brief The result of a lookup, empty if the host could not be resolved.
+    using Addresses = std::optional<IPV_Addresses>;
+
+    /// @brief Function performing the actual lookup.
+    using LookupFunction = std::function<Addresses(std::string_view)>;
+
+    /// @brief Function called with the result of a lookup.
+    using Callback = std::function<void(Addresses const &)>;
+
+    /// @brief Initializes a new Resolver using resolveIPAddresses for lookups.
+    ///
+    /// @param settings The settings of the resolver.
+    Resolver(ResolverSettings const &settings = {}) noexcept;
+
+    /// @brief Initializes a new Resolver using the given lookup function.
+    ///
+    /// @param settings The settings of the resolver.
+    /// @param lookup The function performing the lookups.
+    Resolver(ResolverSettings const &settings, LookupFunction lookup) noexcept;
+
+    /// @brief No copy construction allowed.
+    Resolver(Resolver const &) = delete;
+
+    /// @brief No copy assignment allowed.
+    Resolver &operator=(Resolver const &) = delete;
+
+    /// @brief Stops the workers, lookups still waiting in the queues are completed as failed.
+    ~Resolver() noexcept;
+
+    /// @brief Resolves the given host.
+    ///
+    /// @param host The name or numeric address of the host.
+    /// @return The future result of the lookup, already available if the host was cached.
+    std::shared_future<Addresses> resolve(std::string_view host) noexcept;
+
+    /// @brief Resolves the given host and passes the result to the given callback.
+    ///
+    /// @param host The name or numeric address of the host.
+    /// @param callback The callback to pass the result to.
+    /// @remarks The callback is called by the calling thread if the host was cached, by a worker otherwise.
+    void resolve(std::string_view host, Callback callback) noexcept;
+
+    /// @brief Returns the number of cached lookups, including expired ones not yet evicted.
+    ///
+    /// @return The number of cached lookups.
+    std::size_t cacheSize() const noexcept;
+
+    /// @brief Removes all lookups from the cache.
+    void clearCache() noexcept;
+
+private:
+    /// @brief A cached lookup.
+    struct CacheEntry
+    {
+        /// @brief The host that was looked up.
+        std::string host;
+
+        /// @brief The result of the lookup.
+        Addresses addresses;
+
+        /// @brief The time the entry expires.
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    /// @brief A lookup in progress.
+    struct PendingLookup
+    {
+        /// @brief The promise of the result.
+        std::promise<Addresses> promise{};
+
+        /// @brief The future handed to all waiting callers.
+        std::shared_future<Addresses> future{};
+
+        /// @brief The callbacks waiting for the result.
+        std::vector<Callback> callbacks{};
+    };
+
+    /// @brief A thread performing lookups.
+    struct Worker
+    {
+        /// @brief The thread and its synchronization primitives.
+        WorkerThread control{};
+
+        /// @brief The hosts to look up, protected by the mutex of the control.
+        std::deque<std::string> queue{};
+    };
+
+    /// @brief Returns the cached result or starts a new lookup, if none is pending yet.
+    ///
+    /// @param host The host to resolve.
+    /// @param callback The callback to pass the result to, may be empty.
+    /// @return The future result of the lookup.
+    std::shared_future<Addresses> enqueue(std::string_view host, Callback callback) noexcept;
+
+    /// @brief Performs the lookups queued for the given worker until shutdown.
+    ///
+    /// @param worker The worker to serve.
+    void serve(Worker &worker) noexcept;
+
+    /// @brief Caches the result of a lookup and hands it to all waiting callers.
+    ///
+    /// @param host The host that was looked up.
+    /// @param addresses The result of the lookup.
+    /// @param cache True to store the result in the cache, false otherwise.
+    void complete(std::string const &host, Addresses const &addresses, bool cache) noexcept;
+
+    /// @brief The settings of the resolver.
+    ResolverSettings _settings;
+
+    /// @brief The function performing the lookups.
+    LookupFunction _lookup;
+
+    /// @brief Mutex protecting the cache and the pending lookups.
+    mutable std::mutex _mutex{};
+
+    /// @brief The cached lookups, the most recently used one at the front.
+    std::list<CacheEntry> _cache{};
+
+    /// @brief Index of the cached lookups by host.
+    std::map<std::string, std::list<CacheEntry>::iterator, std::less<>> _index{};
+
+    /// @brief The lookups in progress by host.
+    std::map<std::string, PendingLookup, std::less<>> _pending{};
+
+    /// @brief The threads performing the lookups.
+    std::vector<std::unique_ptr<Worker>> _workers{};
+
+    /// @brief The index of the worker to hand the next lookup to.
+    std::atomic_size_t _nextWorker{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_NETWORK_RESOLVER_HPP
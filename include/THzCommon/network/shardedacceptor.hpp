@@ -0,0 +1,134 @@
+#ifndef THZ_COMMON_NETWORK_SHARDEDACCEPTOR_HPP
+#define THZ_COMMON_NETWORK_SHARDEDACCEPTOR_HPP
+
+#include "THzCommon/network/address.hpp"
+#include "THzCommon/network/tcpsocket.hpp"
+#include "THzCommon/utility/workerThread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Accepts TCP connections on multiple threads, each with its own listening socket bound to the same address.
+///
+/// @tparam TVersion The version of the internet protocol.
+/// @remarks Relies on SO_REUSEPORT to let the system distribute incoming connections across the shards.
+template <IPVersion TVersion>
+class ShardedAcceptor
+{
+public:
+    /// @brief Function taking over an accepted connection and its peer address, called by the thread of the shard that
+    /// accepted it.
+    using Handler =
+        std::function<void(TCPSocket<TVersion> &&connection, Address<TVersion> const &peer, std::size_t shard)>;
+
+    /// @brief The time a shard waits for connections before checking for shutdown.
+    static constexpr std::chrono::milliseconds PollInterval{50U};
+
+    /// @brief Initializes a new ShardedAcceptor.
+    ///
+    /// @param shardCount The number of shards, 0 to use one per hardware thread.
+    /// @param handler The function taking over accepted connections.
+    /// @param pinThreads True to pin the thread of each shard to its own core, false otherwise.
+    /// @remarks The cores are taken from the affinity mask of the process, shards share cores if there are fewer.
+    ShardedAcceptor(std::size_t shardCount, Handler handler, bool pinThreads = true) noexcept;
+
+    /// @brief No copy construction allowed.
+    ShardedAcceptor(ShardedAcceptor const &) = delete;
+
+    /// @brief No copy assignment allowed.
+    ShardedAcceptor &operator=(ShardedAcceptor const &) = delete;
+
+    /// @brief Stops all shards.
+    ~ShardedAcceptor() noexcept;
+
+    /// @brief Binds a listening socket per shard to the given address and starts accepting connections.
+    ///
+    /// @param address The address to accept connections on.
+    /// @param backlog The backlog of each listening socket.
+    /// @return True if all shards are accepting connections, false otherwise (e.g. SO_REUSEPORT not supported).
+    /// @remarks If the port of the address is 0, the first shard binds an ephemeral port which all other shards share,
+    /// see address().
+    bool start(Address<TVersion> const &address, std::uint32_t backlog = 128U) noexcept;
+
+    /// @brief Stops all shards and closes their listening sockets.
+    void stop() noexcept;
+
+    /// @brief Returns the address the shards accept connections on.
+    ///
+    /// @return The address including the port actually bound, only valid while running.
+    Address<TVersion> address() const noexcept;
+
+    /// @brief Returns whether the thread of the given shard is pinned to a core.
+    ///
+    /// @param shard The index of the shard.
+    /// @return True if the thread is pinned, false if pinning is disabled, failed or the shard was never started.
+    bool isPinned(std::size_t shard) const noexcept;
+
+    /// @brief Returns the number of shards.
+    ///
+    /// @return The number of shards.
+    std::size_t shardCount() const noexcept;
+
+    /// @brief Returns the number of connections accepted by the given shard.
+    ///
+    /// @param shard The index of the shard.
+    /// @return The number of connections accepted by the shard.
+    std::uint64_t acceptedConnections(std::size_t shard) const noexcept;
+
+    /// @brief Returns the number of connections accepted by each shard, to monitor the balance between them.
+    ///
+    /// @return The number of connections accepted per shard.
+    std::vector<std::uint64_t> acceptedConnectionsPerShard() const noexcept;
+
+private:
+    /// @brief A listening socket and the thread accepting connections on it.
+    struct Shard
+    {
+        /// @brief The thread and its synchronization primitives.
+        WorkerThread control{};
+
+        /// @brief The socket listening for connections.
+        TCPSocket<TVersion> listener{};
+
+        /// @brief The number of accepted connections.
+        std::atomic<std::uint64_t> accepted{};
+
+        /// @brief True if the thread of the shard is pinned to a core.
+        std::atomic_bool pinned{};
+    };
+
+    /// @brief Accepts connections on the given shard until shutdown.
+    ///
+    /// @param index The index of the shard.
+    /// @param core The core to pin the thread of the shard to, ignored if pinning is disabled.
+    void serve(std::size_t index, std::size_t core) noexcept;
+
+    /// @brief The function taking over accepted connections.
+    Handler _handler;
+
+    /// @brief True to pin the thread of each shard to its own core, false otherwise.
+    bool _pinThreads;
+
+    /// @brief The shards.
+    std::vector<std::unique_ptr<Shard>> _shards{};
+
+    /// @brief The address the shards accept connections on.
+    Address<TVersion> _address{};
+
+    /// @brief True while the shards are accepting connections.
+    bool _running{};
+};
+
+extern template class ShardedAcceptor<IPVersion::V4>;
+extern template class ShardedAcceptor<IPVersion::V6>;
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_NETWORK_SHARDEDACCEPTOR_HPP
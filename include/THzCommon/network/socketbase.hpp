@@ -3,8 +3,13 @@
 
 #include "THzCommon/network/address.hpp"
 #include "THzCommon/network/common.hpp"
+#include "THzCommon/network/socketinstrumentation.hpp"
 #include "THzCommon/utility/result.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
 namespace Terrahertz {
 namespace Internal {
 
@@ -12,7 +17,8 @@ namespace Internal {
 ///
 /// @tparam TVersion The version of the internet protocol.
 /// @tparam TProtocol The protocol on top of the internet protocol (UDP/TCP).
-template <IPVersion TVersion, Protocol TProtocol>
+/// @tparam TInstrumentation The policy recording the send and receive calls, NoInstrumentation adds no overhead.
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation = NoInstrumentation>
 class SocketBase
 {
 public:
@@ -61,6 +67,99 @@ public:
     /// @return The current state of the reuse_addr option of this socket.
     Result<bool> getReuseAddr() noexcept;
 
+    /// @brief Sets the SO_REUSEPORT option of this socket, allowing multiple sockets to bind to the same port.
+    ///
+    /// @param reuse The value SO_REUSEPORT shall be set to.
+    /// @return True if the operation was successfull, false otherwise.
+    /// @remarks Incoming connections/datagrams are distributed across all sockets bound to the port.
+    bool setReusePort(bool reuse) noexcept;
+
+    /// @brief Returns the current state of the SO_REUSEPORT option of this socket.
+    ///
+    /// @return The current state of the SO_REUSEPORT option of this socket.
+    Result<bool> getReusePort() noexcept;
+
+    /// @brief Sets the size of the receive buffer of this socket (SO_RCVBUF).
+    ///
+    /// @param size The requested size of the buffer [bytes].
+    /// @return True if the operation was successfull, false otherwise.
+    bool setReceiveBufferSize(std::size_t size) noexcept;
+
+    /// @brief Returns the size of the receive buffer of this socket (SO_RCVBUF).
+    ///
+    /// @return The size of the buffer [bytes], Linux reports double the requested size to account for overhead.
+    Result<std::size_t> getReceiveBufferSize() noexcept;
+
+    /// @brief Sets the size of the send buffer of this socket (SO_SNDBUF).
+    ///
+    /// @param size The requested size of the buffer [bytes].
+    /// @return True if the operation was successfull, false otherwise.
+    bool setSendBufferSize(std::size_t size) noexcept;
+
+    /// @brief Returns the size of the send buffer of this socket (SO_SNDBUF).
+    ///
+    /// @return The size of the buffer [bytes], Linux reports double the requested size to account for overhead.
+    Result<std::size_t> getSendBufferSize() noexcept;
+
+    /// @brief Sets the time a blocking receive busy polls the device queue before sleeping (SO_BUSY_POLL).
+    ///
+    /// @param duration The time to busy poll, 0 to disable busy polling.
+    /// @return True if the operation was successfull, false otherwise.
+    /// @remarks Only supported on Linux.
+    bool setBusyPoll(std::chrono::microseconds duration) noexcept;
+
+    /// @brief Returns the time a blocking receive busy polls the device queue before sleeping (SO_BUSY_POLL).
+    ///
+    /// @return The time to busy poll, EOPNOTSUPP if not supported.
+    Result<std::chrono::microseconds> getBusyPoll() noexcept;
+
+    /// @brief Sets the priority of the packets sent by this socket (SO_PRIORITY).
+    ///
+    /// @param priority The priority, values above 6 require CAP_NET_ADMIN.
+    /// @return True if the operation was successfull, false otherwise.
+    /// @remarks Only supported on Linux.
+    bool setPriority(std::uint32_t priority) noexcept;
+
+    /// @brief Returns the priority of the packets sent by this socket (SO_PRIORITY).
+    ///
+    /// @return The priority, EOPNOTSUPP if not supported.
+    Result<std::uint32_t> getPriority() noexcept;
+
+    /// @brief Sets the type of service field of the packets sent by this socket (IP_TOS/IPV6_TCLASS).
+    ///
+    /// @param typeOfService The DSCP and ECN bits of the field.
+    /// @return True if the operation was successfull, false otherwise.
+    bool setTypeOfService(std::uint8_t typeOfService) noexcept;
+
+    /// @brief Returns the type of service field of the packets sent by this socket (IP_TOS/IPV6_TCLASS).
+    ///
+    /// @return The DSCP and ECN bits of the field.
+    Result<std::uint8_t> getTypeOfService() noexcept;
+
+    /// @brief Sets the SO_TIMESTAMPING flags of this socket.
+    ///
+    /// @param flags The combination of SOF_TIMESTAMPING_* flags.
+    /// @return True if the operation was successfull, false otherwise.
+    /// @remarks Only supported on Linux.
+    bool setTimestamping(std::uint32_t flags) noexcept;
+
+    /// @brief Returns the SO_TIMESTAMPING flags of this socket.
+    ///
+    /// @return The combination of SOF_TIMESTAMPING_* flags, EOPNOTSUPP if not supported.
+    Result<std::uint32_t> getTimestamping() noexcept;
+
+    /// @brief Sets the non-blocking mode of this socket.
+    ///
+    /// @param nonblocking True to make all calls return immediately, false to make them wait.
+    /// @return True if the operation was successfull, false otherwise.
+    /// @remarks Calls that would block on a non-blocking socket fail with EAGAIN/EWOULDBLOCK.
+    bool setNonblocking(bool nonblocking) noexcept;
+
+    /// @brief Returns the non-blocking mode of this socket.
+    ///
+    /// @return True if the socket is non-blocking, EOPNOTSUPP if the mode can not be queried.
+    Result<bool> getNonblocking() noexcept;
+
     /// @brief Closes the socket.
     void close() noexcept;
 
@@ -69,6 +168,16 @@ public:
     /// @return True if the socket can be used, false otherwise.
     bool good() noexcept;
 
+    /// @brief Returns the instrumentation of this socket.
+    ///
+    /// @return The instrumentation of this socket.
+    [[nodiscard]] TInstrumentation &instrumentation() noexcept { return _instrumentation; }
+
+    /// @brief Returns the instrumentation of this socket.
+    ///
+    /// @return The instrumentation of this socket.
+    [[nodiscard]] TInstrumentation const &instrumentation() const noexcept { return _instrumentation; }
+
 protected:
     /// @brief Initializes a new SocketBase from an already existing handle.
     ///
@@ -77,12 +186,19 @@ protected:
 
     /// @brief The native handle of the managed socket.
     SocketHandleType _handle;
+
+    /// @brief The instrumentation recording the send and receive calls.
+    [[no_unique_address]] TInstrumentation _instrumentation{};
 };
 
 extern template class SocketBase<IPVersion::V4, Protocol::UDP>;
 extern template class SocketBase<IPVersion::V4, Protocol::TCP>;
 extern template class SocketBase<IPVersion::V6, Protocol::UDP>;
 extern template class SocketBase<IPVersion::V6, Protocol::TCP>;
+extern template class SocketBase<IPVersion::V4, Protocol::UDP, SocketInstrumentation>;
+extern template class SocketBase<IPVersion::V4, Protocol::TCP, SocketInstrumentation>;
+extern template class SocketBase<IPVersion::V6, Protocol::UDP, SocketInstrumentation>;
+extern template class SocketBase<IPVersion::V6, Protocol::TCP, SocketInstrumentation>;
 
 } // namespace Internal
 } // namespace Terrahertz
@@ -0,0 +1,249 @@
+#ifndef THZ_COMMON_NETWORK_SOCKETINSTRUMENTATION_HPP
+#define THZ_COMMON_NETWORK_SOCKETINSTRUMENTATION_HPP
+
+#include "THzCommon/logging/logging.hpp"
+#include "THzCommon/utility/result.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Terrahertz {
+
+/// @brief Name provider for the network project.
+struct NetworkProject
+{
+    static constexpr char const *name() noexcept { return "THzCommon.Network"; }
+};
+
+/// @brief The socket operations distinguished by the instrumentation.
+enum class SocketOperation : std::uint8_t
+{
+    /// @brief Sending data (send, sendTo, ...).
+    Send = 0U,
+
+    /// @brief Receiving data (receive, receiveFrom, ...).
+    Receive = 1U
+};
+
+/// @brief Histogram of latencies using buckets growing by powers of two, each split into linear sub-buckets.
+///
+/// @remarks The relative error of the reported values is below 12.5%, recording is lock-free.
+class LatencyHistogram
+{
+public:
+    /// @brief The number of bits used to split each power of two into sub-buckets.
+    static constexpr std::size_t SubBucketBits{3U};
+
+    /// @brief The number of sub-buckets per power of two.
+    static constexpr std::size_t SubBucketCount{1U << SubBucketBits};
+
+    /// @brief The number of buckets needed to cover all 64-bit values.
+    static constexpr std::size_t BucketCount{(64U - SubBucketBits + 1U) * SubBucketCount};
+
+    /// @brief Default initializes an empty histogram.
+    LatencyHistogram() noexcept = default;
+
+    /// @brief Initializes a new histogram as a copy of another one.
+    ///
+    /// @param other The histogram to copy.
+    LatencyHistogram(LatencyHistogram const &other) noexcept;
+
+    /// @brief Copies the content of another histogram into this one.
+    ///
+    /// @param other The histogram to copy.
+    /// @return This histogram.
+    LatencyHistogram &operator=(LatencyHistogram const &other) noexcept;
+
+    /// @brief Adds the given latency to the histogram.
+    ///
+    /// @param latency The latency to add.
+    void record(std::chrono::nanoseconds latency) noexcept;
+
+    /// @brief Returns the number of recorded latencies.
+    ///
+    /// @return The number of recorded latencies.
+    std::uint64_t count() const noexcept;
+
+    /// @brief Returns the latency below which the given share of the recorded latencies lies.
+    ///
+    /// @param percentile The share of latencies [0.0, 100.0].
+    /// @return The highest latency of the bucket containing the percentile, 0 if the histogram is empty.
+    std::chrono::nanoseconds percentile(double percentile) const noexcept;
+
+    /// @brief Returns the highest recorded latency.
+    ///
+    /// @return The highest recorded latency.
+    std::chrono::nanoseconds max() const noexcept;
+
+    /// @brief Removes all recorded latencies.
+    void reset() noexcept;
+
+    /// @brief Returns the bucket the given value is counted in.
+    ///
+    /// @param value The value to find the bucket for.
+    /// @return The index of the bucket.
+    static std::size_t bucketOf(std::uint64_t value) noexcept;
+
+    /// @brief Returns the highest value counted in the given bucket.
+    ///
+    /// @param bucket The index of the bucket.
+    /// @return The highest value counted in the bucket.
+    static std::uint64_t highestValueOf(std::size_t bucket) noexcept;
+
+private:
+    /// @brief The number of latencies per bucket.
+    std::array<std::atomic<std::uint64_t>, BucketCount> _buckets{};
+
+    /// @brief The number of recorded latencies.
+    std::atomic<std::uint64_t> _count{};
+
+    /// @brief The highest recorded latency [ns].
+    std::atomic<std::uint64_t> _max{};
+};
+
+/// @brief Snapshot of the statistics of one socket operation.
+struct OperationStatistics final
+{
+    /// @brief The number of successful calls.
+    std::uint64_t messages{};
+
+    /// @brief The number of transferred bytes.
+    std::uint64_t bytes{};
+
+    /// @brief The number of calls failing with EAGAIN/EWOULDBLOCK.
+    std::uint64_t wouldBlock{};
+
+    /// @brief The number of calls failing with any other error.
+    std::uint64_t errors{};
+
+    /// @brief The median latency of all calls.
+    std::chrono::nanoseconds p50{};
+
+    /// @brief The 90th percentile of the latency of all calls.
+    std::chrono::nanoseconds p90{};
+
+    /// @brief The 99th percentile of the latency of all calls.
+    std::chrono::nanoseconds p99{};
+
+    /// @brief The 99.9th percentile of the latency of all calls.
+    std::chrono::nanoseconds p999{};
+
+    /// @brief The highest latency of all calls.
+    std::chrono::nanoseconds max{};
+};
+
+/// @brief Snapshot of the statistics of a socket.
+struct SocketStatistics final
+{
+    /// @brief The statistics of sending data.
+    OperationStatistics send{};
+
+    /// @brief The statistics of receiving data.
+    OperationStatistics receive{};
+};
+
+/// @brief Instrumentation policy of sockets recording nothing, used by default.
+struct NoInstrumentation final
+{
+    /// @brief Marks the start of an operation.
+    struct Measurement final
+    {};
+
+    /// @brief Starts measuring an operation.
+    ///
+    /// @return The start of the operation.
+    static Measurement start() noexcept { return {}; }
+
+    /// @brief Records the outcome of an operation.
+    void record(SocketOperation, Measurement, std::size_t, errno_t) noexcept {}
+};
+
+/// @brief Instrumentation policy of sockets recording counters and latencies of all send and receive calls.
+class SocketInstrumentation
+{
+public:
+    /// @brief Marks the start of an operation.
+    using Measurement = std::chrono::steady_clock::time_point;
+
+    /// @brief Starts measuring an operation.
+    ///
+    /// @return The start of the operation.
+    static Measurement start() noexcept { return std::chrono::steady_clock::now(); }
+
+    /// @brief Records the outcome of an operation.
+    ///
+    /// @param operation The type of the operation.
+    /// @param start The start of the operation.
+    /// @param bytes The number of transferred bytes.
+    /// @param error The error the operation failed with, 0 if successful.
+    void record(SocketOperation operation, Measurement start, std::size_t bytes, errno_t error) noexcept;
+
+    /// @brief Returns the current statistics.
+    ///
+    /// @return The current statistics.
+    SocketStatistics snapshot() const noexcept;
+
+    /// @brief Resets all statistics.
+    void reset() noexcept;
+
+private:
+    /// @brief The counters of one operation.
+    struct Counters
+    {
+        /// @brief Initializes new counters.
+        Counters() noexcept = default;
+
+        /// @brief Initializes new counters as a copy of others.
+        ///
+        /// @param other The counters to copy.
+        Counters(Counters const &other) noexcept;
+
+        /// @brief Copies other counters into these.
+        ///
+        /// @param other The counters to copy.
+        /// @return These counters.
+        Counters &operator=(Counters const &other) noexcept;
+
+        /// @brief The number of successful calls.
+        std::atomic<std::uint64_t> messages{};
+
+        /// @brief The number of transferred bytes.
+        std::atomic<std::uint64_t> bytes{};
+
+        /// @brief The number of calls failing with EAGAIN/EWOULDBLOCK.
+        std::atomic<std::uint64_t> wouldBlock{};
+
+        /// @brief The number of calls failing with any other error.
+        std::atomic<std::uint64_t> errors{};
+
+        /// @brief The latencies of all calls.
+        LatencyHistogram latency{};
+    };
+
+    /// @brief The counters per operation.
+    std::array<Counters, 2U> _operations{};
+};
+
+/// @brief Formats the given statistics as a single line of text.
+///
+/// @param statistics The statistics to format.
+/// @return The formatted statistics.
+std::string toString(SocketStatistics const &statistics) noexcept;
+
+/// @brief Writes the given statistics to the given logger.
+///
+/// @param statistics The statistics to write.
+/// @param socketName The name identifying the socket in the log.
+/// @param logger The logger to write to.
+void logStatistics(SocketStatistics const &statistics,
+                   std::string_view         socketName,
+                   Logger                  &logger = Logger::globalInstance()) noexcept;
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_NETWORK_SOCKETINSTRUMENTATION_HPP
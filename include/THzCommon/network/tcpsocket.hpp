@@ -2,27 +2,47 @@
 #define THZ_COMMON_NETWORK_TCPSOCKET_HPP
 
 #include "THzCommon/network/address.hpp"
+#include "THzCommon/network/reactor.hpp"
 #include "THzCommon/network/socketbase.hpp"
 #include "THzCommon/utility/result.hpp"
+#include "THzCommon/utility/task.hpp"
 
 #include <cstddef>
 #include <span>
 
 namespace Terrahertz {
 
+/// @brief Range of zero-copy sends the system has finished with.
+struct ZeroCopyCompletion final
+{
+    /// @brief The number of the first completed zero-copy send, sends are counted from 0 per socket.
+    std::uint32_t first{};
+
+    /// @brief The number of the last completed zero-copy send.
+    std::uint32_t last{};
+
+    /// @brief True if the system had to copy the data after all (e.g. for loopback connections).
+    bool copied{};
+};
+
 /// @brief Encapsulates necesarry code to send and receive data via Transmission Control Protocol (TCP).
 ///
 /// @tparam TVersion The version of the internet protocol.
-template <IPVersion TVersion>
-class TCPSocket : public Internal::SocketBase<TVersion, Protocol::TCP>
+/// @tparam TInstrumentation The policy recording the send and receive calls, NoInstrumentation adds no overhead.
+template <IPVersion TVersion, typename TInstrumentation = NoInstrumentation>
+class TCPSocket : public Internal::SocketBase<TVersion, Protocol::TCP, TInstrumentation>
 {
-    using base_t = Internal::SocketBase<TVersion, Protocol::TCP>;
+    using base_t = Internal::SocketBase<TVersion, Protocol::TCP, TInstrumentation>;
 
 public:
+    /// @brief The maximum number of buffers used per receivev/sendv call.
+    static constexpr std::size_t VectorLimit{64U};
+
     using base_t::base_t;
     using base_t::bind;
     using base_t::close;
     using base_t::good;
+    using base_t::instrumentation;
 
     /// @brief Sets socket up to listen for connections.
     ///
@@ -47,6 +67,40 @@ public:
     /// @return True if connecting was successful, false otherwise.
     bool connect(Address<TVersion> const &address) noexcept;
 
+    /// @brief Sets the TCP_NODELAY option of this socket, disabling the Nagle algorithm.
+    ///
+    /// @param noDelay The value TCP_NODELAY shall be set to.
+    /// @return True if the operation was successfull, false otherwise.
+    bool setNoDelay(bool noDelay) noexcept;
+
+    /// @brief Returns the current state of the TCP_NODELAY option of this socket.
+    ///
+    /// @return The current state of the TCP_NODELAY option of this socket.
+    Result<bool> getNoDelay() noexcept;
+
+    /// @brief Sets the SO_KEEPALIVE option of this socket.
+    ///
+    /// @param keepAlive The value SO_KEEPALIVE shall be set to.
+    /// @return True if the operation was successfull, false otherwise.
+    bool setKeepAlive(bool keepAlive) noexcept;
+
+    /// @brief Returns the current state of the SO_KEEPALIVE option of this socket.
+    ///
+    /// @return The current state of the SO_KEEPALIVE option of this socket.
+    Result<bool> getKeepAlive() noexcept;
+
+    /// @brief Sets the TCP_QUICKACK option of this socket, sending acknowledgements immediately.
+    ///
+    /// @param quickAck The value TCP_QUICKACK shall be set to.
+    /// @return True if the operation was successfull, false otherwise.
+    /// @remarks Only supported on Linux, the kernel may reset the option during the lifetime of the connection.
+    bool setQuickAck(bool quickAck) noexcept;
+
+    /// @brief Returns the current state of the TCP_QUICKACK option of this socket.
+    ///
+    /// @return The current state of the TCP_QUICKACK option of this socket, EOPNOTSUPP if not supported.
+    Result<bool> getQuickAck() noexcept;
+
     /// @brief Shuts down the connection, partially or entirely.
     ///
     /// @param what What part of the connection to shut down.
@@ -74,10 +128,77 @@ public:
     /// @param buffer The buffer containing the data to send.
     /// @return The number of transmitted bytes.
     Result<std::size_t> send(std::span<std::byte const> buffer) noexcept;
+
+    /// @brief Receives data from the connected peer, scattering it over the given buffers in order.
+    ///
+    /// @param buffers The buffers for the received data.
+    /// @return The number of received bytes.
+    /// @remarks At most VectorLimit buffers are used per call.
+    Result<std::size_t> receivev(std::span<std::span<std::byte> const> buffers) noexcept;
+
+    /// @brief Sends the data of all given buffers in order to the connected peer, using a single system call.
+    ///
+    /// @param buffers The buffers containing the data to send.
+    /// @return The number of transmitted bytes.
+    /// @remarks At most VectorLimit buffers are used per call.
+    Result<std::size_t> sendv(std::span<std::span<std::byte const> const> buffers) noexcept;
+
+    /// @brief Enables or disables zero-copy sends on this socket, required before calling sendvZeroCopy.
+    ///
+    /// @param enable True to enable zero-copy sends, false to disable them.
+    /// @return True if the operation was successfull, false otherwise (e.g. not supported by the system).
+    bool setZeroCopy(bool enable) noexcept;
+
+    /// @brief Sends the data of all given buffers to the connected peer without copying it into the kernel.
+    ///
+    /// @param buffers The buffers containing the data to send.
+    /// @return The number of transmitted bytes.
+    /// @remarks The buffers must not be changed or released before the completion of the send has been reported
+    /// by pollZeroCopyCompletion. Only worthwhile for large payloads (>10 KiB).
+    Result<std::size_t> sendvZeroCopy(std::span<std::span<std::byte const> const> buffers) noexcept;
+
+    /// @brief Reads the next completion notification for zero-copy sends without blocking.
+    ///
+    /// @return The range of completed sends, EAGAIN if there is no notification pending.
+    Result<ZeroCopyCompletion> pollZeroCopyCompletion() noexcept;
+
+    /// @brief Accepts an incoming connection, suspending the awaiting coroutine while there is none.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param address The address of the connecting client, nullptr if irrelevant.
+    /// @return The non-blocking socket for the new connection, socket will not be good if the call fails.
+    /// @remarks This socket has to be non-blocking and listening.
+    Task<TCPSocket> asyncAccept(Reactor &reactor, Address<TVersion> *address) noexcept;
+
+    /// @brief Connects to a server, suspending the awaiting coroutine until the connection is established.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param address The address of the server to connect to.
+    /// @return True if connecting was successful, the error code otherwise.
+    /// @remarks This socket has to be non-blocking.
+    Task<Result<bool>> asyncConnect(Reactor &reactor, Address<TVersion> const &address) noexcept;
+
+    /// @brief Receives data from the connected peer, suspending the awaiting coroutine while there is none.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param buffer The buffer for the received data.
+    /// @return The part of the buffer that was filled with received data, empty if the peer closed the connection.
+    /// @remarks This socket has to be non-blocking.
+    Task<Result<std::span<std::byte>>> asyncReceive(Reactor &reactor, std::span<std::byte> buffer) noexcept;
+
+    /// @brief Sends the entire buffer to the connected peer, suspending the awaiting coroutine while it would block.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param buffer The buffer containing the data to send.
+    /// @return The number of transmitted bytes, equal to the size of the buffer unless the call fails.
+    /// @remarks This socket has to be non-blocking.
+    Task<Result<std::size_t>> asyncSend(Reactor &reactor, std::span<std::byte const> buffer) noexcept;
 };
 
 extern template class TCPSocket<IPVersion::V4>;
 extern template class TCPSocket<IPVersion::V6>;
+extern template class TCPSocket<IPVersion::V4, SocketInstrumentation>;
+extern template class TCPSocket<IPVersion::V6, SocketInstrumentation>;
 
 } // namespace Terrahertz
 
@@ -2,27 +2,53 @@
 #define THZ_COMMON_NETWORK_UDPSOCKET_HPP
 
 #include "THzCommon/network/address.hpp"
+#include "THzCommon/network/reactor.hpp"
 #include "THzCommon/network/socketbase.hpp"
 #include "THzCommon/utility/result.hpp"
+#include "THzCommon/utility/task.hpp"
 
 #include <cstddef>
 #include <span>
 
 namespace Terrahertz {
 
-/// @brief Encapsulates necesarry code to send and receive data via User Datagram Protocol (UDP).
+/// @brief A single datagram used for batched transmission via UDPSocket.
 ///
 /// @tparam TVersion The version of the internet protocol.
 template <IPVersion TVersion>
-class UDPSocket : public Internal::SocketBase<TVersion, Protocol::UDP>
+struct Datagram final
 {
-    using base_t = Internal::SocketBase<TVersion, Protocol::UDP>;
+    /// @brief The address the datagram was received from or is sent to.
+    Address<TVersion> address{};
+
+    /// @brief The buffer holding the payload of the datagram.
+    std::span<std::byte> buffer{};
+
+    /// @brief The number of bytes received into the buffer.
+    std::size_t length{};
+
+    /// @brief The size of the segments the buffer is split into by the kernel, 0 for a single datagram.
+    ///
+    /// @remarks On send a value other than 0 requests UDP segmentation offload for this buffer,
+    /// on receive it is set to the size of the segments coalesced by UDP receive offload.
+    std::uint16_t segmentSize{};
+};
+
+/// @brief Encapsulates necesarry code to send and receive data via User Datagram Protocol (UDP).
+///
+/// @tparam TVersion The version of the internet protocol.
+/// @tparam TInstrumentation The policy recording the send and receive calls, NoInstrumentation adds no overhead.
+template <IPVersion TVersion, typename TInstrumentation = NoInstrumentation>
+class UDPSocket : public Internal::SocketBase<TVersion, Protocol::UDP, TInstrumentation>
+{
+    using base_t = Internal::SocketBase<TVersion, Protocol::UDP, TInstrumentation>;
 
 public:
     using base_t::base_t;
     using base_t::bind;
     using base_t::close;
     using base_t::good;
+    using base_t::instrumentation;
 
     /// @brief Checks if receiveFrom would block.
     ///
@@ -47,10 +73,56 @@ public:
     /// @param buffer A span to read the data to send from.
     /// @return The number of transmitted bytes.
     Result<std::size_t> sendTo(Address<TVersion> const &address, std::span<std::byte const> buffer) noexcept;
+
+    /// @brief Receives multiple datagrams using as few system calls as possible.
+    ///
+    /// @param datagrams The datagrams to receive into, address, length and segmentSize are set on success.
+    /// @return The number of datagrams received.
+    /// @remarks Blocks until at least one datagram is received, then takes what is available without blocking.
+    Result<std::size_t> receiveBatch(std::span<Datagram<TVersion>> datagrams) noexcept;
+
+    /// @brief Sends multiple datagrams using as few system calls as possible.
+    ///
+    /// @param datagrams The datagrams to send, the whole buffer of each datagram is sent.
+    /// @return The number of datagrams sent.
+    Result<std::size_t> sendBatch(std::span<Datagram<TVersion> const> datagrams) noexcept;
+
+    /// @brief Enables or disables UDP receive offload, allowing the kernel to coalesce datagrams.
+    ///
+    /// @param enable True to enable receive offload, false to disable it.
+    /// @return True if the operation was successfull, false otherwise (e.g. not supported by the system).
+    bool setReceiveOffload(bool enable) noexcept;
+
+    /// @brief Returns the current state of UDP receive offload.
+    ///
+    /// @return True if receive offload is enabled, EOPNOTSUPP if not supported by the system.
+    Result<bool> getReceiveOffload() noexcept;
+
+    /// @brief Receives data from somewhere, suspending the awaiting coroutine while there is none.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param address The address the data was received from, nullptr if address is irrelevant.
+    /// @param buffer A span to put the received data into.
+    /// @return The part of the buffer that was filled with received data.
+    /// @remarks This socket has to be non-blocking.
+    Task<Result<std::span<std::byte>>>
+    asyncReceiveFrom(Reactor &reactor, Address<TVersion> *address, std::span<std::byte> buffer) noexcept;
+
+    /// @brief Sends data to the given address, suspending the awaiting coroutine while it would block.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param address The address to send the data to.
+    /// @param buffer A span to read the data to send from.
+    /// @return The number of transmitted bytes.
+    /// @remarks This socket has to be non-blocking.
+    Task<Result<std::size_t>>
+    asyncSendTo(Reactor &reactor, Address<TVersion> const &address, std::span<std::byte const> buffer) noexcept;
 };
 
 extern template class UDPSocket<IPVersion::V4>;
 extern template class UDPSocket<IPVersion::V6>;
+extern template class UDPSocket<IPVersion::V4, SocketInstrumentation>;
+extern template class UDPSocket<IPVersion::V6, SocketInstrumentation>;
 
 } // namespace Terrahertz
 
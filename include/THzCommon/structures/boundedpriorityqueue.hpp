@@ -0,0 +1,114 @@
+#ifndef THZ_COMMON_STRUCTURES_BOUNDEDPRIORITYQUEUE_HPP
+#define THZ_COMMON_STRUCTURES_BOUNDEDPRIORITYQUEUE_HPP
+
+#include <algorithm>
+#include <functional>
+#include <gsl/span>
+#include <utility>
+
+namespace Terrahertz {
+
+/// @brief Priority queue keeping only the smallest values pushed, stored in a buffer provided by the caller.
+///
+/// @tparam TValueType The type of values stored in the queue.
+/// @tparam TCompare The type of the comparison, defining which value is smaller.
+/// @remarks The values form a max-heap, so the largest value kept is the one replaced by a smaller value once the
+/// buffer is full. Used to find the k best candidates without allocating.
+template <typename TValueType, typename TCompare = std::less<TValueType>>
+class BoundedPriorityQueue
+{
+public:
+    /// @brief The value type of the queue.
+    using value_type = TValueType;
+
+    /// @brief Initializes a new BoundedPriorityQueue.
+    ///
+    /// @param buffer The buffer to store the values in, its size is the number of values kept.
+    /// @param compare The comparison defining which value is smaller.
+    BoundedPriorityQueue(gsl::span<TValueType> const buffer, TCompare compare = {}) noexcept
+        : _buffer{buffer}, _compare{std::move(compare)}
+    {}
+
+    /// @brief Pushes the given value, if it is smaller than the largest value kept or the queue is not full.
+    ///
+    /// @param value The value to push.
+    /// @return True if the value is kept, false otherwise.
+    bool push(TValueType const &value) noexcept
+    {
+        if (!full())
+        {
+            _buffer[_filled] = value;
+            ++_filled;
+            std::push_heap(_buffer.begin(), _buffer.begin() + _filled, _compare);
+            return true;
+        }
+        if (_filled == 0U || !_compare(value, _buffer[0U]))
+        {
+            return false;
+        }
+        std::pop_heap(_buffer.begin(), _buffer.begin() + _filled, _compare);
+        _buffer[_filled - 1U] = value;
+        std::push_heap(_buffer.begin(), _buffer.begin() + _filled, _compare);
+        return true;
+    }
+
+    /// @brief Removes the largest value kept.
+    ///
+    /// @remarks Nothing changes if the queue is empty.
+    void pop() noexcept
+    {
+        if (_filled > 0U)
+        {
+            std::pop_heap(_buffer.begin(), _buffer.begin() + _filled, _compare);
+            --_filled;
+        }
+    }
+
+    /// @brief Returns the largest value kept.
+    ///
+    /// @return Pointer to the largest value, nullptr if the queue is empty.
+    TValueType const *top() const noexcept { return (_filled > 0U) ? &_buffer[0U] : nullptr; }
+
+    /// @brief Clears the queue.
+    void clear() noexcept { _filled = 0U; }
+
+    /// @brief Checks if the queue is full, so pushing a value requires it to be smaller than top().
+    ///
+    /// @return True if the queue is full, false otherwise.
+    bool full() const noexcept { return _filled == _buffer.size(); }
+
+    /// @brief Returns the number of values kept.
+    ///
+    /// @return The number of values kept.
+    size_t filled() const noexcept { return _filled; }
+
+    /// @brief Returns the maximum number of values kept.
+    ///
+    /// @return The maximum number of values kept.
+    size_t size() const noexcept { return _buffer.size(); }
+
+    /// @brief Sorts the values kept in ascending order and clears the queue.
+    ///
+    /// @return The part of the buffer holding the sorted values.
+    gsl::span<TValueType> release() noexcept
+    {
+        auto const values = _buffer.subspan(0U, _filled);
+        std::sort_heap(values.begin(), values.end(), _compare);
+        _filled = 0U;
+        return values;
+    }
+
+private:
+    /// @brief The buffer storing the values.
+    gsl::span<TValueType> _buffer{};
+
+    /// @brief The number of values kept.
+    size_t _filled{};
+
+    /// @brief The comparison defining which value is smaller.
+    TCompare _compare{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_STRUCTURES_BOUNDEDPRIORITYQUEUE_HPP
@@ -0,0 +1,523 @@
+#ifndef THZ_COMMON_STRUCTURES_FLATOCTREE_HPP
+#define THZ_COMMON_STRUCTURES_FLATOCTREE_HPP
+
+#include "THzCommon/structures/octree.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <gsl/span>
+#include <limits>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Octree storing all nodes in a single array and all entries in a single pooled buffer.
+///
+/// @remarks The eight children of a node are stored next to each other, addressed by the index of the first one.
+/// Entries are stored in blocks of maxEntries, every node holding entries owns a chain of blocks. The blocks of split
+/// nodes are reused and reset() keeps all memory, so rebuilding a tree of similar size does not allocate. Adding
+/// entries invalidates all pointers to nodes.
+/// @tparam TCoordinateType The type used for the coordinates inside the octree space.
+/// @tparam TSizeType The type used to measure the octree space (needs to be bigger than TCoordinateType).
+/// @tparam TDataType The data type of the elements inside the octree.
+template <typename TCoordinateType, typename TSizeType, typename TDataType>
+class FlatOctree
+{
+public:
+    /// @brief Represents an entry in the octree.
+    using Entry = typename Octree<TCoordinateType, TSizeType, TDataType>::Entry;
+
+    /// @brief Shortcut to this type.
+    using MyType = FlatOctree<TCoordinateType, TSizeType, TDataType>;
+
+    /// @brief The index marking the absence of children or blocks.
+    static constexpr std::uint32_t NoIndex = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief A node of the octree.
+    class Node
+    {
+    public:
+        /// @brief Initializes a new Node at the given position.
+        ///
+        /// @param centerX The geometric center of the node on the x-axis.
+        /// @param centerY The geometric center of the node on the y-axis.
+        /// @param centerZ The geometric center of the node on the z-axis.
+        /// @param size The size of the node in all directions.
+        /// @param maxDepth The maximum depth of the subtree below the node.
+        Node(TCoordinateType centerX,
+             TCoordinateType centerY,
+             TCoordinateType centerZ,
+             TSizeType       size,
+             uint8_t         maxDepth) noexcept
+            : _centerX{centerX}, _centerY{centerY}, _centerZ{centerZ}, _size{size}, _maxDepth{maxDepth}
+        {}
+
+        /// @brief Returns the center of the node on the x axis.
+        ///
+        /// @return The center of the node on the x axis.
+        TCoordinateType getCenterX() const noexcept { return _centerX; }
+
+        /// @brief Returns the center of the node on the y axis.
+        ///
+        /// @return The center of the node on the y axis.
+        TCoordinateType getCenterY() const noexcept { return _centerY; }
+
+        /// @brief Returns the center of the node on the z axis.
+        ///
+        /// @return The center of the node on the z axis.
+        TCoordinateType getCenterZ() const noexcept { return _centerZ; }
+
+        /// @brief Returns the size of the node.
+        ///
+        /// @return The size of the node.
+        TSizeType getSize() const noexcept { return _size; }
+
+        /// @brief Return the maximum depth of the subtree below the node.
+        ///
+        /// @return The maximum depth of the subtree below the node.
+        uint8_t getMaxDepth() const noexcept { return _maxDepth; }
+
+        /// @brief Returns the number of entries this node or its children have in total.
+        ///
+        /// @return The number of entries this node or its children have in total.
+        size_t totalEntries() const noexcept { return _totalEntries; }
+
+    private:
+        friend class FlatOctree;
+
+        /// @brief Turns the given position into the offset of the child containing it.
+        ///
+        /// @param x The position on the X-axis.
+        /// @param y The position on the Y-axis.
+        /// @param z The position on the Z-axis.
+        /// @return The offset of the child from the first child.
+        std::uint32_t positionToIndex(TCoordinateType x, TCoordinateType y, TCoordinateType z) const noexcept
+        {
+            return (x >= _centerX ? 0x1U : 0x0U) | (y >= _centerY ? 0x2U : 0x0U) | (z >= _centerZ ? 0x4U : 0x0U);
+        }
+
+        /// @brief The geometric center of the node on the x-axis.
+        TCoordinateType _centerX{};
+
+        /// @brief The geometric center of the node on the y-axis.
+        TCoordinateType _centerY{};
+
+        /// @brief The geometric center of the node on the z-axis.
+        TCoordinateType _centerZ{};
+
+        /// @brief The size of the node in all directions.
+        TSizeType _size{};
+
+        /// @brief The maximum depth of the subtree below the node.
+        uint8_t _maxDepth{};
+
+        /// @brief The index of the first of the eight children, NoIndex if the node has not been split.
+        std::uint32_t _firstChild{NoIndex};
+
+        /// @brief The index of the first block of entries of the node, NoIndex if it holds no entries.
+        std::uint32_t _firstBlock{NoIndex};
+
+        /// @brief The index of the last block of entries of the node, NoIndex if it holds no entries.
+        std::uint32_t _lastBlock{NoIndex};
+
+        /// @brief The number of entries stored in the node itself.
+        std::uint32_t _entryCount{};
+
+        /// @brief The total number of entries in this node or its children.
+        size_t _totalEntries{};
+    };
+
+    /// @brief A vector of pointers to constant nodes of a FlatOctree.
+    using CNodePointerVector = std::vector<Node const *>;
+
+    /// @brief Default initializes a new FlatOctree.
+    FlatOctree() noexcept { reset(TCoordinateType{}, TCoordinateType{}, TCoordinateType{}, TSizeType{}, 0U, 0U); }
+
+    /// @brief Initializes a new FlatOctree at the given position.
+    ///
+    /// @param centerX The geometric center of the node on the x-axis.
+    /// @param centerY The geometric center of the node on the y-axis.
+    /// @param centerZ The geometric center of the node on the z-axis.
+    /// @param size The size of the node in all directions.
+    /// @param maxEntries The maximum number of entries in a node before it gets subdivided.
+    /// @param maxDepth The maximum depth of the tree.
+    FlatOctree(TCoordinateType centerX,
+               TCoordinateType centerY,
+               TCoordinateType centerZ,
+               TSizeType       size,
+               uint32_t        maxEntries,
+               uint8_t         maxDepth) noexcept
+    {
+        reset(centerX, centerY, centerZ, size, maxEntries, maxDepth);
+    }
+
+    /// @brief Returns the center of the octree on the x axis.
+    ///
+    /// @return The center of the octree on the x axis.
+    TCoordinateType getCenterX() const noexcept { return _nodes.front().getCenterX(); }
+
+    /// @brief Returns the center of the octree on the y axis.
+    ///
+    /// @return The center of the octree on the y axis.
+    TCoordinateType getCenterY() const noexcept { return _nodes.front().getCenterY(); }
+
+    /// @brief Returns the center of the octree on the z axis.
+    ///
+    /// @return The center of the octree on the z axis.
+    TCoordinateType getCenterZ() const noexcept { return _nodes.front().getCenterZ(); }
+
+    /// @brief Returns the size of the octree.
+    ///
+    /// @return The size of the octree.
+    TSizeType getSize() const noexcept { return _nodes.front().getSize(); }
+
+    /// @brief Returns the maximum number of entries in a node before it gets subdivided.
+    ///
+    /// @return The maximum number of entries in a node before it gets subdivided.
+    uint32_t getMaxEntries() const noexcept { return _maxEntries; }
+
+    /// @brief Return the maximum depth of the tree.
+    ///
+    /// @return The maximum depth of the tree.
+    uint8_t getMaxDepth() const noexcept { return _nodes.front().getMaxDepth(); }
+
+    /// @brief Returns the root node of the octree.
+    ///
+    /// @return The root node of the octree.
+    Node const &getRoot() const noexcept { return _nodes.front(); }
+
+    /// @brief Adds a new entry to the octree.
+    ///
+    /// @param e The entry to add.
+    void addEntry(Entry const &e) noexcept { insert(0U, e); }
+
+    /// @brief Adds a new entry to the octree.
+    ///
+    /// @param x The x coordinate of the entry.
+    /// @param y The y coordinate of the entry.
+    /// @param z The z coordinate of the entry.
+    /// @param value The value coordinate of the entry.
+    void addEntry(TCoordinateType x, TCoordinateType y, TCoordinateType z, TDataType value) noexcept
+    {
+        addEntry(Entry{x, y, z, value});
+    }
+
+    /// @brief Resets the octree, removing all nodes and entries and setting the given values.
+    ///
+    /// @param centerX The geometric center of the node on the x-axis.
+    /// @param centerY The geometric center of the node on the y-axis.
+    /// @param centerZ The geometric center of the node on the z-axis.
+    /// @param size The size of the node in all directions.
+    /// @param maxEntries The maximum number of entries in a node before it gets subdivided.
+    /// @param maxDepth The maximum depth of the tree.
+    void reset(TCoordinateType centerX,
+               TCoordinateType centerY,
+               TCoordinateType centerZ,
+               TSizeType       size,
+               uint32_t        maxEntries,
+               uint8_t         maxDepth) noexcept
+    {
+        _maxEntries = maxEntries;
+        _blockSize  = std::max<std::uint32_t>(maxEntries, 1U);
+        _nodes.clear();
+        _nodes.emplace_back(centerX, centerY, centerZ, size, maxDepth);
+        _entries.clear();
+        _blockNext.clear();
+        _freeBlocks.clear();
+    }
+
+    /// @brief Resets the octree, removing all nodes and entries while keeping the memory.
+    void reset() noexcept
+    {
+        auto const &root = _nodes.front();
+        reset(root._centerX, root._centerY, root._centerZ, root._size, _maxEntries, root._maxDepth);
+    }
+
+    /// @brief Returns the children of the given node, or an empty span if the node has no children.
+    ///
+    /// @param node The node to return the children of.
+    /// @return The children of the node, or an empty span if the node has no children.
+    gsl::span<Node const> getChildNodes(Node const &node) const noexcept
+    {
+        if (node._firstChild == NoIndex)
+        {
+            return {};
+        }
+        return {_nodes.data() + node._firstChild, 8U};
+    }
+
+    /// @brief Returns the children of the root node, or an empty span if the root has no children.
+    ///
+    /// @return The children of the root node, or an empty span if the root has no children.
+    gsl::span<Node const> getChildNodes() const noexcept { return getChildNodes(_nodes.front()); }
+
+    /// @brief Returns pointers to all nodes inside the octree.
+    ///
+    /// @param nodes Output: A vector to store the pointers to all nodes inside the octree.
+    void getNodes(CNodePointerVector &nodes) const noexcept { collectNodes(0U, nodes); }
+
+    /// @brief Returns pointers to all nodes inside the octree.
+    ///
+    /// @param nodes Output: A vector to store the pointers to all nodes inside the octree.
+    /// @param layer The layer from which the nodes shall be retrieved, 0 for the root, 1 for its children and so on.
+    void getNodes(CNodePointerVector &nodes, size_t const layer) const noexcept { collectNodes(0U, nodes, layer); }
+
+    /// @brief Returns a vector of pointers to all nodes inside the octree.
+    ///
+    /// @return A vector of pointers to all nodes inside the octree.
+    CNodePointerVector getNodes() const noexcept
+    {
+        CNodePointerVector nodes{};
+        getNodes(nodes);
+        return nodes;
+    }
+
+    /// @brief Returns a vector of pointers to all nodes inside the octree.
+    ///
+    /// @param layer The layer from which the nodes shall be retrieved, 0 for the root, 1 for its children and so on.
+    /// @return A vector of pointers to all nodes inside the octree.
+    CNodePointerVector getNodes(size_t const layer) const noexcept
+    {
+        CNodePointerVector nodes{};
+        getNodes(nodes, layer);
+        return nodes;
+    }
+
+    /// @brief Uses the given function to analyze the entries stored in the given node itself.
+    ///
+    /// @tparam TFunction The type of the function to analyze the entries.
+    /// @param node The node to analyze the entries of.
+    /// @param function The function to analyze the entries.
+    template <typename TFunction>
+    void analyzeEntries(Node const &node, TFunction &function) const noexcept
+    {
+        auto remaining = node._entryCount;
+        for (auto block = node._firstBlock; block != NoIndex; block = _blockNext[block])
+        {
+            auto const count = std::min(remaining, _blockSize);
+            auto const first = _entries.data() + static_cast<size_t>(block) * _blockSize;
+            for (auto entry = first; entry != (first + count); ++entry)
+            {
+                function(*entry);
+            }
+            remaining -= count;
+        }
+    }
+
+    /// @brief Uses the given function to analyze the entries of all nodes.
+    ///
+    /// @tparam TFunction The type of the function to analyze the entries.
+    /// @param function The function to analyze the entries.
+    template <typename TFunction>
+    void analyzeEntries(TFunction &function) const noexcept
+    {
+        analyzeSubtree(0U, function);
+    }
+
+    /// @brief Recalculates all meta data for faster processing.
+    ///
+    /// @remarks The totals are maintained while adding entries, so there is nothing to do.
+    void recalculate() noexcept {}
+
+    /// @brief Returns the number of entries in the octree.
+    ///
+    /// @return The number of entries in the octree.
+    size_t totalEntries() const noexcept { return _nodes.front()._totalEntries; }
+
+private:
+    /// @brief Adds an entry to the subtree of the given node.
+    ///
+    /// @param index The index of the node.
+    /// @param e The entry to add.
+    void insert(std::uint32_t index, Entry const &e) noexcept
+    {
+        for (;;)
+        {
+            auto &node = _nodes[index];
+            ++node._totalEntries;
+            if (node._firstChild == NoIndex)
+            {
+                if ((node._entryCount < _maxEntries) || (node._maxDepth == 0U))
+                {
+                    append(index, e);
+                    return;
+                }
+                split(index);
+            }
+            auto const &parent = _nodes[index];
+            index              = parent._firstChild + parent.positionToIndex(e.x, e.y, e.z);
+        }
+    }
+
+    /// @brief Stores an entry in the given node itself.
+    ///
+    /// @param index The index of the node.
+    /// @param e The entry to store.
+    void append(std::uint32_t const index, Entry const &e) noexcept
+    {
+        auto      &node   = _nodes[index];
+        auto const offset = node._entryCount % _blockSize;
+        if (offset == 0U)
+        {
+            auto const block = takeBlock();
+            if (node._lastBlock == NoIndex)
+            {
+                node._firstBlock = block;
+            }
+            else
+            {
+                _blockNext[node._lastBlock] = block;
+            }
+            node._lastBlock = block;
+        }
+        _entries[static_cast<size_t>(node._lastBlock) * _blockSize + offset] = e;
+        ++node._entryCount;
+    }
+
+    /// @brief Takes a block from the free list or appends a new one to the pool.
+    ///
+    /// @return The index of the block.
+    std::uint32_t takeBlock() noexcept
+    {
+        if (!_freeBlocks.empty())
+        {
+            auto const block = _freeBlocks.back();
+            _freeBlocks.pop_back();
+            _blockNext[block] = NoIndex;
+            return block;
+        }
+        auto const block = static_cast<std::uint32_t>(_blockNext.size());
+        _blockNext.push_back(NoIndex);
+        _entries.resize(_entries.size() + _blockSize);
+        return block;
+    }
+
+    /// @brief Splits the given node, moving its entries to the new children.
+    ///
+    /// @param index The index of the node.
+    void split(std::uint32_t const index) noexcept
+    {
+        // copied, as adding the children may move the nodes
+        auto const node        = _nodes[index];
+        auto const childSize   = node._size / 2;
+        auto const childOffset = childSize / 2;
+        auto const childDepth  = static_cast<uint8_t>(node._maxDepth - 1U);
+
+        auto const xp    = static_cast<TCoordinateType>(node._centerX + childOffset);
+        auto const xn    = static_cast<TCoordinateType>(node._centerX - childOffset);
+        auto const yp    = static_cast<TCoordinateType>(node._centerY + childOffset);
+        auto const yn    = static_cast<TCoordinateType>(node._centerY - childOffset);
+        auto const zp    = static_cast<TCoordinateType>(node._centerZ + childOffset);
+        auto const zn    = static_cast<TCoordinateType>(node._centerZ - childOffset);
+        auto const first = static_cast<std::uint32_t>(_nodes.size());
+        _nodes.emplace_back(xn, yn, zn, childSize, childDepth);
+        _nodes.emplace_back(xp, yn, zn, childSize, childDepth);
+        _nodes.emplace_back(xn, yp, zn, childSize, childDepth);
+        _nodes.emplace_back(xp, yp, zn, childSize, childDepth);
+        _nodes.emplace_back(xn, yn, zp, childSize, childDepth);
+        _nodes.emplace_back(xp, yn, zp, childSize, childDepth);
+        _nodes.emplace_back(xn, yp, zp, childSize, childDepth);
+        _nodes.emplace_back(xp, yp, zp, childSize, childDepth);
+
+        auto &parent       = _nodes[index];
+        parent._firstChild = first;
+        parent._firstBlock = NoIndex;
+        parent._lastBlock  = NoIndex;
+        parent._entryCount = 0U;
+
+        // each child receives at most maxEntries entries, so none of them is split again
+        auto remaining = node._entryCount;
+        for (auto block = node._firstBlock; block != NoIndex;)
+        {
+            auto const count = std::min(remaining, _blockSize);
+            for (std::uint32_t i = 0U; i < count; ++i)
+            {
+                auto const entry = _entries[static_cast<size_t>(block) * _blockSize + i];
+                insert(first + node.positionToIndex(entry.x, entry.y, entry.z), entry);
+            }
+            remaining -= count;
+            auto const next = _blockNext[block];
+            _freeBlocks.push_back(block);
+            block = next;
+        }
+    }
+
+    /// @brief Adds pointers to the given node and all nodes below it to the given vector.
+    ///
+    /// @param index The index of the node.
+    /// @param nodes Output: The vector to store the pointers in.
+    void collectNodes(std::uint32_t const index, CNodePointerVector &nodes) const noexcept
+    {
+        auto const &node = _nodes[index];
+        nodes.push_back(&node);
+        if (node._firstChild != NoIndex)
+        {
+            for (auto child = node._firstChild; child < (node._firstChild + 8U); ++child)
+            {
+                collectNodes(child, nodes);
+            }
+        }
+    }
+
+    /// @brief Adds pointers to the nodes of the given layer below the given node to the given vector.
+    ///
+    /// @param index The index of the node.
+    /// @param nodes Output: The vector to store the pointers in.
+    /// @param layer The layer relative to the node.
+    void collectNodes(std::uint32_t const index, CNodePointerVector &nodes, size_t const layer) const noexcept
+    {
+        auto const &node = _nodes[index];
+        if (layer == 0U)
+        {
+            nodes.push_back(&node);
+        }
+        else if (node._firstChild != NoIndex)
+        {
+            for (auto child = node._firstChild; child < (node._firstChild + 8U); ++child)
+            {
+                collectNodes(child, nodes, layer - 1U);
+            }
+        }
+    }
+
+    /// @brief Uses the given function to analyze the entries of the given node and all nodes below it.
+    ///
+    /// @tparam TFunction The type of the function to analyze the entries.
+    /// @param index The index of the node.
+    /// @param function The function to analyze the entries.
+    template <typename TFunction>
+    void analyzeSubtree(std::uint32_t const index, TFunction &function) const noexcept
+    {
+        auto const &node = _nodes[index];
+        analyzeEntries(node, function);
+        if (node._firstChild != NoIndex)
+        {
+            for (auto child = node._firstChild; child < (node._firstChild + 8U); ++child)
+            {
+                analyzeSubtree(child, function);
+            }
+        }
+    }
+
+    /// @brief The maximum number of entries in a node before it gets subdivided.
+    uint32_t _maxEntries{};
+
+    /// @brief The number of entries per block.
+    std::uint32_t _blockSize{1U};
+
+    /// @brief All nodes of the octree, the root first.
+    std::vector<Node> _nodes{};
+
+    /// @brief The pool of all entries, divided into blocks of _blockSize entries.
+    std::vector<Entry> _entries{};
+
+    /// @brief The index of the block following each block in the chain of its node.
+    std::vector<std::uint32_t> _blockNext{};
+
+    /// @brief The indices of the blocks not used by any node.
+    std::vector<std::uint32_t> _freeBlocks{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_STRUCTURES_FLATOCTREE_HPP
@@ -0,0 +1,220 @@
+#ifndef THZ_COMMON_STRUCTURES_MPMCQUEUE_HPP
+#define THZ_COMMON_STRUCTURES_MPMCQUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace Terrahertz {
+
+/// @brief Bounded lock-free queue for any number of producer and consumer threads.
+///
+/// @tparam TValueType The type of values stored in the queue.
+/// @tparam TCapacity The number of values the queue can hold, must be a power of two.
+/// @remarks Each slot carries a sequence number telling producers and consumers whose turn it is, so both sides
+/// only contend on their own position (D. Vyukov). The blocking variants yield a few times and then park on the
+/// sequence of the slot using std::atomic::wait.
+template <typename TValueType, std::size_t TCapacity>
+class MpmcQueue
+{
+    static_assert(std::has_single_bit(TCapacity), "The capacity must be a power of two.");
+    static_assert(TCapacity >= 2U, "The capacity must be at least two.");
+
+public:
+    /// @brief The value type of the queue.
+    using value_type = TValueType;
+
+    /// @brief The size of a cache line, used to keep the positions and the slots of producers and consumers apart.
+    static constexpr std::size_t CacheLineSize{64U};
+
+    /// @brief Default initializes a new MpmcQueue instance.
+    MpmcQueue() noexcept
+    {
+        for (std::size_t i = 0U; i < TCapacity; ++i)
+        {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Pushes a value to the back of the queue if there is space.
+    ///
+    /// @param value The value to push.
+    /// @return True if the value was pushed, false if the queue is full.
+    bool try_push(TValueType value) noexcept { return enqueue<false>(value); }
+
+    /// @brief Pushes a value to the back of the queue, waiting for space if the queue is full.
+    ///
+    /// @param value The value to push.
+    void push(TValueType value) noexcept { enqueue<true>(value); }
+
+    /// @brief Pops a value from the front of the queue if there is one.
+    ///
+    /// @param value The value to pop into.
+    /// @return True if a value was popped, false if the queue is empty.
+    /// @remarks May also fail while the producer of the next value has not finished writing it.
+    bool try_pop(TValueType &value) noexcept { return dequeue<false>(value); }
+
+    /// @brief Pops a value from the front of the queue, waiting for one if the queue is empty.
+    ///
+    /// @param value The value to pop into.
+    void pop(TValueType &value) noexcept { dequeue<true>(value); }
+
+    /// @brief Returns the number of values in the queue.
+    ///
+    /// @return The number of values in the queue.
+    /// @remarks Only a snapshot if called while other threads are working on the queue.
+    std::size_t filled() const noexcept
+    {
+        auto const head = _dequeuePosition.load(std::memory_order_acquire);
+        auto const tail = _enqueuePosition.load(std::memory_order_acquire);
+        return (tail > head) ? (tail - head) : 0U;
+    }
+
+    /// @brief Checks if the queue is empty.
+    ///
+    /// @return True if the queue is empty, false otherwise.
+    /// @remarks Only a snapshot if called while other threads are working on the queue.
+    bool empty() const noexcept { return filled() == 0U; }
+
+    /// @brief Returns the capacity of the queue.
+    ///
+    /// @return The capacity of the queue.
+    constexpr std::size_t size() const noexcept { return TCapacity; }
+
+private:
+    /// @brief Mask turning a position into an index of the slots.
+    static constexpr std::size_t Mask{TCapacity - 1U};
+
+    /// @brief The number of times a blocking call yields before parking the thread.
+    static constexpr std::size_t SpinLimit{32U};
+
+    /// @brief A single value of the queue.
+    ///
+    /// @remarks Each slot takes at least a cache line, so threads working on neighboring slots do not false-share.
+    struct alignas(CacheLineSize) Slot
+    {
+        /// @brief Equals the position for a producer to fill the slot and position + 1 for a consumer to empty it.
+        std::atomic<std::size_t> sequence{};
+
+        /// @brief The value stored in the slot.
+        TValueType value{};
+    };
+
+    /// @brief Waits until the sequence of the given slot changed, yielding a few times before parking the thread.
+    ///
+    /// @param slot The slot to wait for.
+    /// @param sequence The last seen sequence of the slot.
+    /// @param spins The number of times the caller already yielded, reset when parking.
+    static void waitFor(Slot &slot, std::size_t const sequence, std::size_t &spins) noexcept
+    {
+        if (spins < SpinLimit)
+        {
+            ++spins;
+            std::this_thread::yield();
+            return;
+        }
+        spins = 0U;
+        slot.sequence.wait(sequence, std::memory_order_acquire);
+    }
+
+    /// @brief Pushes a value to the back of the queue.
+    ///
+    /// @tparam TBlocking True to wait for space, false to fail right away.
+    /// @param value The value to push.
+    /// @return True if the value was pushed, false if the queue is full.
+    template <bool TBlocking>
+    bool enqueue(TValueType &value) noexcept
+    {
+        auto        position = _enqueuePosition.load(std::memory_order_relaxed);
+        std::size_t spins{};
+        for (;;)
+        {
+            auto      &slot     = _slots[position & Mask];
+            auto const sequence = slot.sequence.load(std::memory_order_acquire);
+            auto const distance = static_cast<std::intptr_t>(sequence - position);
+            if (distance == 0)
+            {
+                if (_enqueuePosition.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed))
+                {
+                    slot.value = std::move(value);
+                    slot.sequence.store(position + 1U, std::memory_order_release);
+                    slot.sequence.notify_all();
+                    return true;
+                }
+            }
+            else if (distance < 0)
+            {
+                // the slot still holds the value pushed one round earlier
+                if constexpr (!TBlocking)
+                {
+                    return false;
+                }
+                waitFor(slot, sequence, spins);
+                position = _enqueuePosition.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                position = _enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @brief Pops a value from the front of the queue.
+    ///
+    /// @tparam TBlocking True to wait for a value, false to fail right away.
+    /// @param value The value to pop into.
+    /// @return True if a value was popped, false if the queue is empty.
+    template <bool TBlocking>
+    bool dequeue(TValueType &value) noexcept
+    {
+        auto        position = _dequeuePosition.load(std::memory_order_relaxed);
+        std::size_t spins{};
+        for (;;)
+        {
+            auto      &slot     = _slots[position & Mask];
+            auto const sequence = slot.sequence.load(std::memory_order_acquire);
+            auto const distance = static_cast<std::intptr_t>(sequence - (position + 1U));
+            if (distance == 0)
+            {
+                if (_dequeuePosition.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed))
+                {
+                    value = std::move(slot.value);
+                    slot.sequence.store(position + TCapacity, std::memory_order_release);
+                    slot.sequence.notify_all();
+                    return true;
+                }
+            }
+            else if (distance < 0)
+            {
+                // the slot has not been filled yet
+                if constexpr (!TBlocking)
+                {
+                    return false;
+                }
+                waitFor(slot, sequence, spins);
+                position = _dequeuePosition.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                position = _dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @brief The position the next value is pushed to.
+    alignas(CacheLineSize) std::atomic<std::size_t> _enqueuePosition{};
+
+    /// @brief The position the next value is popped from.
+    alignas(CacheLineSize) std::atomic<std::size_t> _dequeuePosition{};
+
+    /// @brief The slots holding the values.
+    alignas(CacheLineSize) std::array<Slot, TCapacity> _slots{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_STRUCTURES_MPMCQUEUE_HPP
@@ -1,19 +1,527 @@
 #ifndef THZ_COMMON_STRUCTURES_OCTREE_HPP
 #define THZ_COMMON_STRUCTURES_OCTREE_HPP
 
+#include "THzCommon/structures/boundedpriorityqueue.hpp"
+#include "THzCommon/utility/threadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
 #include <cstdint>
 #include <gsl/span>
+#include <limits>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Terrahertz {
 
+/// @brief The ways an Octree can arrange the entries of its nodes in memory.
+enum class OctreeLayout
+{
+    /// @brief The entries are stored one after another.
+    ArrayOfStructures,
+
+    /// @brief Each member of the entries is stored in its own array, so scans over the entries vectorize.
+    StructureOfArrays
+};
+
+/// @brief Represents an entry in an Octree.
+///
+/// @tparam TCoordinateType The type used for the coordinates inside the octree space.
+/// @tparam TDataType The data type of the elements inside the octree.
+template <typename TCoordinateType, typename TDataType>
+struct OctreeEntry
+{
+    /// @brief The x coordinate of the entry.
+    TCoordinateType x{};
+
+    /// @brief The y coordinate of the entry.
+    TCoordinateType y{};
+
+    /// @brief The z coordinate of the entry.
+    TCoordinateType z{};
+
+    /// @brief The value of the entry.
+    TDataType value{};
+};
+
+namespace Internal {
+
+/// @brief Sort key of an entry during the bulk build of an Octree.
+struct MortonKey
+{
+    /// @brief The Morton code of the entry.
+    std::uint64_t code{};
+
+    /// @brief The index of the entry in the input.
+    size_t index{};
+};
+
+/// @brief Calls the function for each chunk, in parallel if a pool is given.
+///
+/// @tparam TFunction The type of the function, called with the index of the chunk.
+/// @param pool The pool to run the chunks on, nullptr to run them on the calling thread.
+/// @param chunks The number of chunks.
+/// @param function The function to call.
+template <typename TFunction>
+void forEachChunk(ThreadPool *const pool, size_t const chunks, TFunction const &function) noexcept
+{
+    if (pool != nullptr)
+    {
+        pool->parallelFor(0U, chunks, function, 1U);
+    }
+    else
+    {
+        for (size_t chunk = 0U; chunk < chunks; ++chunk)
+        {
+            function(chunk);
+        }
+    }
+}
+
+/// @brief Sorts the keys by their codes, using a stable least significant digit radix sort.
+///
+/// @param keys The keys to sort.
+/// @param scratch Buffer of the same size as keys.
+/// @param bits The number of low bits of the codes to sort by.
+/// @param pool The pool to sort in parallel with, nullptr to sort on the calling thread.
+inline void radixSort(std::vector<MortonKey> &keys,
+                      std::vector<MortonKey> &scratch,
+                      unsigned const          bits,
+                      ThreadPool *const       pool) noexcept
+{
+    constexpr size_t DigitBits{8U};
+    constexpr size_t DigitCount{1U << DigitBits};
+
+    // every chunk counts and scatters its own part, at positions reserved for it by the prefix sum
+    auto const count  = keys.size();
+    auto const chunks = (pool != nullptr) ? std::max<size_t>(pool->workerCount(), 1U) : 1U;
+    auto const begin  = [&](size_t const chunk) noexcept { return (count * chunk) / chunks; };
+
+    std::vector<std::array<size_t, DigitCount>> offsets(chunks);
+    for (unsigned shift = 0U; shift < bits; shift += DigitBits)
+    {
+        forEachChunk(pool, chunks, [&](size_t const chunk) noexcept {
+            auto &counts = offsets[chunk];
+            counts.fill(0U);
+            for (auto i = begin(chunk); i < begin(chunk + 1U); ++i)
+            {
+                ++counts[(keys[i].code >> shift) & (DigitCount - 1U)];
+            }
+        });
+
+        size_t offset{};
+        bool   uniform{};
+        for (size_t digit = 0U; digit < DigitCount; ++digit)
+        {
+            auto const start = offset;
+            for (auto &counts : offsets)
+            {
+                offset += std::exchange(counts[digit], offset);
+            }
+            uniform = uniform || ((offset - start) == count);
+        }
+        if (uniform)
+        {
+            // all keys share the digit, the pass would not change the order
+            continue;
+        }
+
+        forEachChunk(pool, chunks, [&](size_t const chunk) noexcept {
+            auto &positions = offsets[chunk];
+            for (auto i = begin(chunk); i < begin(chunk + 1U); ++i)
+            {
+                scratch[positions[(keys[i].code >> shift) & (DigitCount - 1U)]++] = keys[i];
+            }
+        });
+        keys.swap(scratch);
+    }
+}
+
+/// @brief The entries of an Octree node, stored one after another.
+///
+/// @tparam TEntry The type of the entries.
+/// @tparam TLayout The way the entries are arranged in memory.
+template <typename TEntry, OctreeLayout TLayout>
+class OctreeEntries
+{
+public:
+    /// @brief Returns the number of entries.
+    ///
+    /// @return The number of entries.
+    size_t size() const noexcept { return _entries.size(); }
+
+    /// @brief Checks if there are no entries.
+    ///
+    /// @return True if there are no entries, false otherwise.
+    bool empty() const noexcept { return _entries.empty(); }
+
+    /// @brief Removes all entries, keeping the memory.
+    void clear() noexcept { _entries.clear(); }
+
+    /// @brief Adds an entry.
+    ///
+    /// @param e The entry to add.
+    void push_back(TEntry const &e) noexcept { _entries.push_back(e); }
+
+    /// @brief Replaces all entries with the given ones.
+    ///
+    /// @param first The first entry.
+    /// @param last The end of the entries.
+    void assign(TEntry const *const first, TEntry const *const last) noexcept { _entries.assign(first, last); }
+
+    /// @brief Searches the given entry.
+    ///
+    /// @param e The entry to search.
+    /// @return The index of the first entry equal to the given one, size() if there is none.
+    size_t find(TEntry const &e) const noexcept
+    {
+        for (size_t index = 0U; index < _entries.size(); ++index)
+        {
+            auto const &entry = _entries[index];
+            if ((entry.x == e.x) && (entry.y == e.y) && (entry.z == e.z) && (entry.value == e.value))
+            {
+                return index;
+            }
+        }
+        return _entries.size();
+    }
+
+    /// @brief Overwrites the entry at the given index.
+    ///
+    /// @param index The index of the entry.
+    /// @param e The new entry.
+    void replace(size_t const index, TEntry const &e) noexcept { _entries[index] = e; }
+
+    /// @brief Removes the entry at the given index, moving the last entry into its place.
+    ///
+    /// @param index The index of the entry.
+    void erase(size_t const index) noexcept
+    {
+        _entries[index] = _entries.back();
+        _entries.pop_back();
+    }
+
+    /// @brief Returns the start of the entries.
+    ///
+    /// @return The start of the entries.
+    auto begin() const noexcept { return _entries.begin(); }
+
+    /// @brief Returns the end of the entries.
+    ///
+    /// @return The end of the entries.
+    auto end() const noexcept { return _entries.end(); }
+
+    /// @brief Calls the function for every entry the predicate accepts.
+    ///
+    /// @tparam TPredicate The type of the predicate, called with the coordinates of an entry.
+    /// @tparam TFunction The type of the function, called with the entries.
+    /// @param predicate The predicate selecting the entries.
+    /// @param function The function to call.
+    template <typename TPredicate, typename TFunction>
+    void filter(TPredicate const &predicate, TFunction &function) const noexcept
+    {
+        for (auto const &entry : _entries)
+        {
+            if (predicate(entry.x, entry.y, entry.z))
+            {
+                function(entry);
+            }
+        }
+    }
+
+    /// @brief Calls the function for every entry together with its distance.
+    ///
+    /// @tparam TDistance The type of the distance, called with the coordinates of an entry.
+    /// @tparam TFunction The type of the function, called with an entry and its distance.
+    /// @param distance The distance measuring the entries.
+    /// @param function The function to call.
+    template <typename TDistance, typename TFunction>
+    void measure(TDistance const &distance, TFunction &function) const noexcept
+    {
+        for (auto const &entry : _entries)
+        {
+            function(entry, distance(entry.x, entry.y, entry.z));
+        }
+    }
+
+private:
+    /// @brief The entries.
+    std::vector<TEntry> _entries{};
+};
+
+/// @brief The entries of an Octree node, each member stored in its own array.
+///
+/// @tparam TEntry The type of the entries.
+/// @remarks The entries are kept in blocks of BlockSize, each holding one array per member, so all arrays of a node
+/// share one allocation. filter and measure check whole blocks in loops of fixed length the compiler turns into
+/// vector instructions, ignoring the results for the unused end of the last block.
+template <typename TEntry>
+class OctreeEntries<TEntry, OctreeLayout::StructureOfArrays>
+{
+public:
+    /// @brief The type of the coordinates of the entries.
+    using CoordinateType = decltype(TEntry::x);
+
+    /// @brief The type of the values of the entries.
+    using DataType = decltype(TEntry::value);
+
+    /// @brief The number of entries in a block.
+    static constexpr size_t BlockSize{32U};
+
+    /// @brief Iterator assembling the entries from the arrays.
+    class Iterator
+    {
+    public:
+        /// @brief Initializes a new Iterator.
+        ///
+        /// @param entries The entries to iterate over.
+        /// @param index The index of the current entry.
+        Iterator(OctreeEntries const &entries, size_t const index) noexcept : _entries{&entries}, _index{index} {}
+
+        /// @brief Returns the current entry.
+        ///
+        /// @return The current entry.
+        TEntry operator*() const noexcept { return (*_entries)[_index]; }
+
+        /// @brief Moves to the next entry.
+        ///
+        /// @return This iterator.
+        Iterator &operator++() noexcept
+        {
+            ++_index;
+            return *this;
+        }
+
+        /// @brief Compares the iterator with another one.
+        ///
+        /// @param other The iterator to compare with.
+        /// @return True if both point to the same entry, false otherwise.
+        bool operator==(Iterator const &other) const noexcept { return _index == other._index; }
+
+    private:
+        /// @brief The entries to iterate over.
+        OctreeEntries const *_entries{};
+
+        /// @brief The index of the current entry.
+        size_t _index{};
+    };
+
+    /// @brief Returns the number of entries.
+    ///
+    /// @return The number of entries.
+    size_t size() const noexcept { return _size; }
+
+    /// @brief Checks if there are no entries.
+    ///
+    /// @return True if there are no entries, false otherwise.
+    bool empty() const noexcept { return _size == 0U; }
+
+    /// @brief Removes all entries, keeping the memory.
+    void clear() noexcept
+    {
+        _blocks.clear();
+        _size = 0U;
+    }
+
+    /// @brief Adds an entry.
+    ///
+    /// @param e The entry to add.
+    void push_back(TEntry const &e) noexcept
+    {
+        if ((_size % BlockSize) == 0U)
+        {
+            _blocks.emplace_back();
+        }
+        set(_size, e);
+        ++_size;
+    }
+
+    /// @brief Replaces all entries with the given ones.
+    ///
+    /// @param first The first entry.
+    /// @param last The end of the entries.
+    void assign(TEntry const *const first, TEntry const *const last) noexcept
+    {
+        _size = static_cast<size_t>(last - first);
+        _blocks.resize((_size + BlockSize - 1U) / BlockSize);
+        for (size_t index = 0U; index < _size; ++index)
+        {
+            set(index, first[index]);
+        }
+    }
+
+    /// @brief Returns the entry at the given index.
+    ///
+    /// @param index The index of the entry.
+    /// @return The entry.
+    TEntry operator[](size_t const index) const noexcept
+    {
+        auto const &block = _blocks[index / BlockSize];
+        auto const  lane  = index % BlockSize;
+        return TEntry{block.x[lane], block.y[lane], block.z[lane], block.values[lane]};
+    }
+
+    /// @brief Searches the given entry.
+    ///
+    /// @param e The entry to search.
+    /// @return The index of the first entry equal to the given one, size() if there is none.
+    size_t find(TEntry const &e) const noexcept
+    {
+        for (size_t index = 0U; index < _size; ++index)
+        {
+            auto const &block = _blocks[index / BlockSize];
+            auto const  lane  = index % BlockSize;
+            if ((block.x[lane] == e.x) && (block.y[lane] == e.y) && (block.z[lane] == e.z) &&
+                (block.values[lane] == e.value))
+            {
+                return index;
+            }
+        }
+        return _size;
+    }
+
+    /// @brief Overwrites the entry at the given index.
+    ///
+    /// @param index The index of the entry.
+    /// @param e The new entry.
+    void replace(size_t const index, TEntry const &e) noexcept { set(index, e); }
+
+    /// @brief Removes the entry at the given index, moving the last entry into its place.
+    ///
+    /// @param index The index of the entry.
+    void erase(size_t const index) noexcept
+    {
+        --_size;
+        set(index, (*this)[_size]);
+        if ((_size % BlockSize) == 0U)
+        {
+            _blocks.pop_back();
+        }
+    }
+
+    /// @brief Returns the start of the entries.
+    ///
+    /// @return The start of the entries.
+    Iterator begin() const noexcept { return Iterator{*this, 0U}; }
+
+    /// @brief Returns the end of the entries.
+    ///
+    /// @return The end of the entries.
+    Iterator end() const noexcept { return Iterator{*this, _size}; }
+
+    /// @brief Calls the function for every entry the predicate accepts.
+    ///
+    /// @tparam TPredicate The type of the predicate, called with the coordinates of an entry.
+    /// @tparam TFunction The type of the function, called with the entries.
+    /// @param predicate The predicate selecting the entries, evaluated for the unused end of the last block as well.
+    /// @param function The function to call.
+    template <typename TPredicate, typename TFunction>
+    void filter(TPredicate const &predicate, TFunction &function) const noexcept
+    {
+        std::array<std::uint8_t, BlockSize> hits{};
+        for (size_t first = 0U; first < _size; first += BlockSize)
+        {
+            auto const &block = _blocks[first / BlockSize];
+            std::uint8_t any{};
+            for (size_t lane = 0U; lane < BlockSize; ++lane)
+            {
+                hits[lane] = predicate(block.x[lane], block.y[lane], block.z[lane]) ? 1U : 0U;
+                any |= hits[lane];
+            }
+            if (any == 0U)
+            {
+                continue;
+            }
+            auto const count = std::min(BlockSize, _size - first);
+            for (size_t lane = 0U; lane < count; ++lane)
+            {
+                if (hits[lane] != 0U)
+                {
+                    function(TEntry{block.x[lane], block.y[lane], block.z[lane], block.values[lane]});
+                }
+            }
+        }
+    }
+
+    /// @brief Calls the function for every entry together with its distance.
+    ///
+    /// @tparam TDistance The type of the distance, called with the coordinates of an entry.
+    /// @tparam TFunction The type of the function, called with an entry and its distance.
+    /// @param distance The distance measuring the entries, evaluated for the unused end of the last block as well.
+    /// @param function The function to call.
+    template <typename TDistance, typename TFunction>
+    void measure(TDistance const &distance, TFunction &function) const noexcept
+    {
+        using ResultType = std::invoke_result_t<TDistance const &, CoordinateType, CoordinateType, CoordinateType>;
+
+        std::array<ResultType, BlockSize> distances{};
+        for (size_t first = 0U; first < _size; first += BlockSize)
+        {
+            auto const &block = _blocks[first / BlockSize];
+            for (size_t lane = 0U; lane < BlockSize; ++lane)
+            {
+                distances[lane] = distance(block.x[lane], block.y[lane], block.z[lane]);
+            }
+            auto const count = std::min(BlockSize, _size - first);
+            for (size_t lane = 0U; lane < count; ++lane)
+            {
+                function(TEntry{block.x[lane], block.y[lane], block.z[lane], block.values[lane]}, distances[lane]);
+            }
+        }
+    }
+
+private:
+    /// @brief BlockSize entries, one array per member.
+    struct Block
+    {
+        /// @brief The x coordinates of the entries.
+        std::array<CoordinateType, BlockSize> x{};
+
+        /// @brief The y coordinates of the entries.
+        std::array<CoordinateType, BlockSize> y{};
+
+        /// @brief The z coordinates of the entries.
+        std::array<CoordinateType, BlockSize> z{};
+
+        /// @brief The values of the entries.
+        std::array<DataType, BlockSize> values{};
+    };
+
+    /// @brief Writes the given entry to the given index.
+    ///
+    /// @param index The index to write the entry to.
+    /// @param e The entry to write.
+    void set(size_t const index, TEntry const &e) noexcept
+    {
+        auto      &block   = _blocks[index / BlockSize];
+        auto const lane    = index % BlockSize;
+        block.x[lane]      = e.x;
+        block.y[lane]      = e.y;
+        block.z[lane]      = e.z;
+        block.values[lane] = e.value;
+    }
+
+    /// @brief The blocks holding the entries.
+    std::vector<Block> _blocks{};
+
+    /// @brief The number of entries.
+    size_t _size{};
+};
+
+} // namespace Internal
+
 /// @brief Implementation of an octree based on a cube shaped space.
 ///
 /// @tparam TCoordinateType The type used for the coordinates inside the octree space.
 /// @tparam TSizeType The type used to measure the octree space (needs to be bigger than TCoordinateType).
 /// @tparam TDataType The data type of the elements inside the octree.
-template <typename TCoordinateType, typename TSizeType, typename TDataType>
+/// @tparam TLayout The way the entries of the nodes are arranged in memory.
+template <typename TCoordinateType,
+          typename TSizeType,
+          typename TDataType,
+          OctreeLayout TLayout = OctreeLayout::ArrayOfStructures>
 class Octree
 {
 public:
@@ -21,24 +529,66 @@ public:
     static_assert(sizeof(TCoordinateType) <= sizeof(TSizeType),
                   "TCoordinateType needs to be smaller or equal to TSizeType");
 
-    /// @brief Represents an entry in the octree.
-    struct Entry
+    /// @brief Represents an entry in the octree, shared by all layouts.
+    using Entry = OctreeEntry<TCoordinateType, TDataType>;
+
+    /// @brief Shortcut to this type.
+    using MyType = Octree<TCoordinateType, TSizeType, TDataType, TLayout>;
+
+    /// @brief The type of squared distances, exact for small integral coordinates.
+    using DistanceType = std::conditional_t<std::is_integral_v<TCoordinateType> && (sizeof(TCoordinateType) <= 2U),
+                                            std::int64_t,
+                                            double>;
+
+    /// @brief Axis aligned box, all bounds are inclusive.
+    struct Box
     {
-        /// @brief The x coordinate of the entry.
-        TCoordinateType x{};
+        /// @brief The lowest x coordinate inside the box.
+        TCoordinateType minX{};
 
-        /// @brief The y coordinate of the entry.
-        TCoordinateType y{};
+        /// @brief The lowest y coordinate inside the box.
+        TCoordinateType minY{};
 
-        /// @brief The z coordinate of the entry.
-        TCoordinateType z{};
+        /// @brief The lowest z coordinate inside the box.
+        TCoordinateType minZ{};
 
-        /// @brief The value of the entry.
-        TDataType value{};
+        /// @brief The highest x coordinate inside the box.
+        TCoordinateType maxX{};
+
+        /// @brief The highest y coordinate inside the box.
+        TCoordinateType maxY{};
+
+        /// @brief The highest z coordinate inside the box.
+        TCoordinateType maxZ{};
     };
 
-    /// @brief Shortcut to this type.
-    using MyType = Octree<TCoordinateType, TSizeType, TDataType>;
+    /// @brief An entry found by a nearest neighbour query.
+    struct Neighbour
+    {
+        /// @brief The entry.
+        Entry entry{};
+
+        /// @brief The squared distance of the entry to the position of the query.
+        DistanceType distance{};
+
+        /// @brief Compares neighbours by their distance.
+        ///
+        /// @param other The neighbour to compare with.
+        /// @return True if this neighbour is closer, false otherwise.
+        bool operator<(Neighbour const &other) const noexcept { return distance < other.distance; }
+    };
+
+    /// @brief The number of levels of the tree encoded in the Morton codes used by build.
+    static constexpr uint8_t MortonLevels{21U};
+
+    /// @brief The number of entries from which build works in parallel, if it is given a pool.
+    static constexpr size_t ParallelBuildThreshold{65536U};
+
+    /// @brief The number of entries from which build hands the subtree of a node to the pool.
+    static constexpr size_t ParallelBuildGrain{8192U};
+
+    /// @brief The number of levels in which parallelAnalyzeEntries and parallelRecalculate hand subtrees to the pool.
+    static constexpr uint8_t ParallelLevels{2U};
 
     /// @brief A vector of pointers to constant nodes on a Octree.
     using CNodePointerVector = std::vector<MyType const *>;
@@ -116,25 +666,7 @@ public:
             }
             else
             {
-                // split node
-                auto const childSize   = _size / 2;
-                auto const childOffset = childSize / 2;
-
-                auto const xp = _centerX + childOffset;
-                auto const xn = _centerX - childOffset;
-                auto const yp = _centerY + childOffset;
-                auto const yn = _centerY - childOffset;
-                auto const zp = _centerZ + childOffset;
-                auto const zn = _centerZ - childOffset;
-                _children.emplace_back(xn, yn, zn, childSize, _maxEntries, _maxDepth - 1);
-                _children.emplace_back(xp, yn, zn, childSize, _maxEntries, _maxDepth - 1);
-                _children.emplace_back(xn, yp, zn, childSize, _maxEntries, _maxDepth - 1);
-                _children.emplace_back(xp, yp, zn, childSize, _maxEntries, _maxDepth - 1);
-                _children.emplace_back(xn, yn, zp, childSize, _maxEntries, _maxDepth - 1);
-                _children.emplace_back(xp, yn, zp, childSize, _maxEntries, _maxDepth - 1);
-                _children.emplace_back(xn, yp, zp, childSize, _maxEntries, _maxDepth - 1);
-                _children.emplace_back(xp, yp, zp, childSize, _maxEntries, _maxDepth - 1);
-
+                split();
                 addEntry(e);
                 for (auto const &entry : _entries)
                 {
@@ -156,6 +688,90 @@ public:
         addEntry(Entry{x, y, z, value});
     }
 
+    /// @brief Removes an entry from the octree.
+    ///
+    /// @param e The entry to remove, all members have to match.
+    /// @return True if the entry was found and removed, false otherwise.
+    /// @remarks Only the nodes on the path to the entry are touched, children left holding too few entries are merged
+    /// into their parent by the next recalculate().
+    bool removeEntry(Entry const &e) noexcept
+    {
+        if (!_children.empty())
+        {
+            if (!_children[positionToIndex(e.x, e.y, e.z)].removeEntry(e))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            auto const index = _entries.find(e);
+            if (index == _entries.size())
+            {
+                return false;
+            }
+            _entries.erase(index);
+        }
+        _touched = true;
+        return true;
+    }
+
+    /// @brief Removes an entry from the octree.
+    ///
+    /// @param x The x coordinate of the entry.
+    /// @param y The y coordinate of the entry.
+    /// @param z The z coordinate of the entry.
+    /// @param value The value of the entry.
+    /// @return True if the entry was found and removed, false otherwise.
+    bool removeEntry(TCoordinateType x, TCoordinateType y, TCoordinateType z, TDataType value) noexcept
+    {
+        return removeEntry(Entry{x, y, z, value});
+    }
+
+    /// @brief Moves an entry of the octree to a new position.
+    ///
+    /// @param e The entry to move, all members have to match.
+    /// @param x The new x coordinate of the entry.
+    /// @param y The new y coordinate of the entry.
+    /// @param z The new z coordinate of the entry.
+    /// @return True if the entry was found and moved, false otherwise.
+    /// @remarks An entry staying inside its leaf is updated in place without touching any node. Otherwise it is
+    /// removed from its leaf and added below the deepest node containing both positions, only touching the nodes on
+    /// the way.
+    bool moveEntry(Entry const &e, TCoordinateType const x, TCoordinateType const y, TCoordinateType const z) noexcept
+    {
+        return moveEntry(e, Entry{x, y, z, e.value}) != MoveResult::NotFound;
+    }
+
+    /// @brief Replaces all entries of the octree with the given ones, building the tree in one pass.
+    ///
+    /// @param entries The entries to store in the octree.
+    /// @param pool The pool to build large inputs in parallel with, nullptr to build on the calling thread.
+    /// @remarks Produces the same nodes holding the same entries as adding the entries one by one, only the order of
+    /// the entries inside a node may differ. The entries are sorted by the Morton codes of their paths through the
+    /// tree, which places the entries of every node next to each other, so each node is created once and its entries
+    /// are copied once. The codes cover the first MortonLevels levels, deeper nodes are filled by adding entries.
+    /// Sorting by the codes partitions the entries by octant, so in parallel the subtrees of all children holding at
+    /// least ParallelBuildGrain entries are built as separate jobs, starting with the top-level octants.
+    void build(gsl::span<Entry const> const entries, ThreadPool *const pool = nullptr) noexcept
+    {
+        reset();
+        auto const count = entries.size();
+        if (count == 0U)
+        {
+            return;
+        }
+        if ((count < ParallelBuildThreshold) || (pool == nullptr) || (pool->workerCount() < 2U))
+        {
+            // not worth waking up the workers
+            buildSorted(entries, nullptr);
+        }
+        else
+        {
+            buildSorted(entries, pool);
+        }
+    }
+
     /// @brief Resets this node, removing all children and entries and setting the given values.
     ///
     /// @param centerX The geometric center of the node on the x-axis.
@@ -192,6 +808,8 @@ public:
             _children.clear();
         }
         _entries.clear();
+        _totalEntries = 0U;
+        _touched      = false;
     }
 
     /// @brief Returns the children of this node, or an empty span if this nodes has no children.
@@ -268,7 +886,110 @@ public:
         }
     }
 
+    /// @brief Calls the given function for every entry inside the given box.
+    ///
+    /// @tparam TFunction The type of the function, called with the entries.
+    /// @param box The box to search.
+    /// @param function The function to call.
+    template <typename TFunction>
+    requires std::invocable<TFunction &, Entry const &>
+    void queryBox(Box const &box, TFunction &function) const noexcept
+    {
+        queryBox(box, function, Region{});
+    }
+
+    /// @brief Writes the entries inside the given box to the given output.
+    ///
+    /// @param box The box to search.
+    /// @param output Output: The buffer to write the entries to.
+    /// @return The number of entries inside the box, only the ones fitting into output have been written.
+    size_t queryBox(Box const &box, gsl::span<Entry> const output) const noexcept
+    {
+        size_t count{};
+        auto   collect = [&](Entry const &e) noexcept {
+            if (count < output.size())
+            {
+                output[count] = e;
+            }
+            ++count;
+        };
+        queryBox(box, collect);
+        return count;
+    }
+
+    /// @brief Calls the given function for every entry inside the given sphere.
+    ///
+    /// @tparam TFunction The type of the function, called with the entries.
+    /// @param x The center of the sphere on the x-axis.
+    /// @param y The center of the sphere on the y-axis.
+    /// @param z The center of the sphere on the z-axis.
+    /// @param radius The radius of the sphere, entries on its surface are inside.
+    /// @param function The function to call.
+    template <typename TFunction>
+    requires std::invocable<TFunction &, Entry const &>
+    void querySphere(TCoordinateType const x,
+                     TCoordinateType const y,
+                     TCoordinateType const z,
+                     DistanceType const    radius,
+                     TFunction            &function) const noexcept
+    {
+        querySphere(Point{x, y, z}, radius * radius, function, Region{});
+    }
+
+    /// @brief Writes the entries inside the given sphere to the given output.
+    ///
+    /// @param x The center of the sphere on the x-axis.
+    /// @param y The center of the sphere on the y-axis.
+    /// @param z The center of the sphere on the z-axis.
+    /// @param radius The radius of the sphere, entries on its surface are inside.
+    /// @param output Output: The buffer to write the entries to.
+    /// @return The number of entries inside the sphere, only the ones fitting into output have been written.
+    size_t querySphere(TCoordinateType const  x,
+                       TCoordinateType const  y,
+                       TCoordinateType const  z,
+                       DistanceType const     radius,
+                       gsl::span<Entry> const output) const noexcept
+    {
+        size_t count{};
+        auto   collect = [&](Entry const &e) noexcept {
+            if (count < output.size())
+            {
+                output[count] = e;
+            }
+            ++count;
+        };
+        querySphere(x, y, z, radius, collect);
+        return count;
+    }
+
+    /// @brief Finds the entries closest to the given position.
+    ///
+    /// @param x The position on the x-axis.
+    /// @param y The position on the y-axis.
+    /// @param z The position on the z-axis.
+    /// @param output Output: The buffer to write the neighbours to, its size is the number of neighbours searched.
+    /// @return The number of neighbours written, sorted by ascending distance.
+    /// @remarks Visits the children closest to the position first, skipping every node farther away than the
+    /// farthest neighbour found so far, once the output is full.
+    size_t queryNearest(TCoordinateType const      x,
+                        TCoordinateType const      y,
+                        TCoordinateType const      z,
+                        gsl::span<Neighbour> const output) const noexcept
+    {
+        if (output.empty())
+        {
+            return 0U;
+        }
+        BoundedPriorityQueue<Neighbour> queue{output};
+        queryNearest(Point{x, y, z}, queue, Region{});
+        return queue.release().size();
+    }
+
     /// @brief Recalculates all meta data for faster processing.
+    ///
+    /// @remarks Only visits touched nodes, merging the children of nodes left holding at most half of the maximum
+    /// number of entries, so the work is proportional to the number of changes since the last call. Merging removes
+    /// nodes, invalidating the pointers and spans returned by getNodes() and getChildNodes().
     void recalculate() noexcept
     {
         if (_touched)
@@ -279,22 +1000,43 @@ public:
                 child.recalculate();
                 _totalEntries += child.totalEntries();
             }
+            mergeUnderfullChildren();
             _touched = false;
         }
     }
 
-    /// @brief Returns the number of entries this node or its children have in total.
+    /// @brief Recalculates all meta data, handing the subtrees of the first ParallelLevels levels to the pool.
     ///
-    /// @return The number of entries this node or its children have in total.
-    size_t totalEntries() noexcept
+    /// @param pool The pool to recalculate the subtrees with.
+    /// @remarks Invalidates the pointers and spans returned by getNodes() and getChildNodes() like recalculate().
+    void parallelRecalculate(ThreadPool &pool) noexcept { parallelRecalculate(pool, ParallelLevels); }
+
+    /// @brief Analyzes all entries in parallel, handing the subtrees of the first ParallelLevels levels to the pool.
+    ///
+    /// @tparam TResult The type of the result.
+    /// @tparam TFunction The type of the function, called with a TResult & and an Entry const &.
+    /// @tparam TReducer The type of the reducer, called with two TResult and returning their combination.
+    /// @param pool The pool to analyze the subtrees with.
+    /// @param identity The result of analyzing no entries, every subtree starts with a copy of it.
+    /// @param function The function adding an entry to the result of a subtree, called concurrently for different
+    /// subtrees.
+    /// @param reducer The reducer combining the results of two subtrees, the first one preceding the second.
+    /// @return The combined result of all entries.
+    /// @remarks The results are combined in the order analyzeEntries visits the subtrees, so the reducer only has to
+    /// be associative.
+    template <typename TResult, typename TFunction, typename TReducer>
+    TResult parallelAnalyzeEntries(ThreadPool      &pool,
+                                   TResult const   &identity,
+                                   TFunction const &function,
+                                   TReducer const  &reducer) const noexcept
     {
-        recalculate();
-        return _totalEntries;
+        return parallelAnalyzeEntries(pool, identity, function, reducer, ParallelLevels);
     }
 
     /// @brief Returns the number of entries this node or its children have in total.
     ///
     /// @return The number of entries this node or its children have in total.
+    /// @remarks Counts the entries of touched nodes on the fly, it never merges children like recalculate() does.
     size_t totalEntries() const noexcept
     {
         if (_touched)
@@ -310,6 +1052,546 @@ public:
     }
 
 private:
+    /// @brief A position given as squared distance types, so differences neither wrap nor overflow.
+    struct Point
+    {
+        /// @brief Initializes a new Point.
+        ///
+        /// @param px The position on the x-axis.
+        /// @param py The position on the y-axis.
+        /// @param pz The position on the z-axis.
+        Point(TCoordinateType const px, TCoordinateType const py, TCoordinateType const pz) noexcept
+            : x{static_cast<DistanceType>(px)}, y{static_cast<DistanceType>(py)}, z{static_cast<DistanceType>(pz)}
+        {}
+
+        /// @brief Returns the squared distance to the given position.
+        ///
+        /// @param px The position on the x-axis.
+        /// @param py The position on the y-axis.
+        /// @param pz The position on the z-axis.
+        /// @return The squared distance.
+        DistanceType
+        distance(TCoordinateType const px, TCoordinateType const py, TCoordinateType const pz) const noexcept
+        {
+            auto const dx = static_cast<DistanceType>(px) - x;
+            auto const dy = static_cast<DistanceType>(py) - y;
+            auto const dz = static_cast<DistanceType>(pz) - z;
+            return (dx * dx) + (dy * dy) + (dz * dz);
+        }
+
+        /// @brief The position on the x-axis.
+        DistanceType x{};
+
+        /// @brief The position on the y-axis.
+        DistanceType y{};
+
+        /// @brief The position on the z-axis.
+        DistanceType z{};
+    };
+
+    /// @brief The space covered by a node, bounded by the centers of its ancestors.
+    ///
+    /// @remarks Entries outside the root cube end up in the outermost nodes, so the bounds are derived from the
+    /// centers splitting the space instead of the sizes, the root being unbounded. Lower bounds are inclusive, upper
+    /// bounds exclusive.
+    struct Region
+    {
+        /// @brief Returns the region of the child with the given index.
+        ///
+        /// @param node The node splitting this region.
+        /// @param index The index of the child.
+        /// @return The region of the child.
+        Region child(Octree const &node, std::uint_fast8_t const index) const noexcept
+        {
+            auto result = *this;
+            ((index & 0x1U) != 0U ? result.lower[0U] : result.upper[0U]) = static_cast<double>(node._centerX);
+            ((index & 0x2U) != 0U ? result.lower[1U] : result.upper[1U]) = static_cast<double>(node._centerY);
+            ((index & 0x4U) != 0U ? result.lower[2U] : result.upper[2U]) = static_cast<double>(node._centerZ);
+            return result;
+        }
+
+        /// @brief Returns the smallest squared distance of the given position to the region.
+        ///
+        /// @param p The position.
+        /// @return The smallest squared distance.
+        double minDistance(Point const &p) const noexcept
+        {
+            auto const axis = [](double const v, double const low, double const high) noexcept {
+                auto const d = (v < low) ? (low - v) : ((v > high) ? (v - high) : 0.0);
+                return d * d;
+            };
+            return axis(static_cast<double>(p.x), lower[0U], upper[0U]) +
+                   axis(static_cast<double>(p.y), lower[1U], upper[1U]) +
+                   axis(static_cast<double>(p.z), lower[2U], upper[2U]);
+        }
+
+        /// @brief Returns the largest squared distance of the given position to the region.
+        ///
+        /// @param p The position.
+        /// @return The largest squared distance, infinite for unbounded regions.
+        double maxDistance(Point const &p) const noexcept
+        {
+            auto const axis = [](double const v, double const low, double const high) noexcept {
+                auto const d = std::max(v - low, high - v);
+                return d * d;
+            };
+            return axis(static_cast<double>(p.x), lower[0U], upper[0U]) +
+                   axis(static_cast<double>(p.y), lower[1U], upper[1U]) +
+                   axis(static_cast<double>(p.z), lower[2U], upper[2U]);
+        }
+
+        /// @brief Checks if the region intersects the given box.
+        ///
+        /// @param box The box.
+        /// @return True if the region intersects the box, false otherwise.
+        bool intersects(Box const &box) const noexcept
+        {
+            return (lower[0U] <= box.maxX) && (upper[0U] > box.minX) && (lower[1U] <= box.maxY) &&
+                   (upper[1U] > box.minY) && (lower[2U] <= box.maxZ) && (upper[2U] > box.minZ);
+        }
+
+        /// @brief Checks if the region lies inside the given box.
+        ///
+        /// @param box The box.
+        /// @return True if the region lies inside the box, false otherwise.
+        bool inside(Box const &box) const noexcept
+        {
+            return (lower[0U] >= box.minX) && (upper[0U] <= box.maxX) && (lower[1U] >= box.minY) &&
+                   (upper[1U] <= box.maxY) && (lower[2U] >= box.minZ) && (upper[2U] <= box.maxZ);
+        }
+
+        /// @brief The inclusive lower bounds of the region.
+        std::array<double, 3U> lower{-std::numeric_limits<double>::infinity(),
+                                     -std::numeric_limits<double>::infinity(),
+                                     -std::numeric_limits<double>::infinity()};
+
+        /// @brief The exclusive upper bounds of the region.
+        std::array<double, 3U> upper{std::numeric_limits<double>::infinity(),
+                                     std::numeric_limits<double>::infinity(),
+                                     std::numeric_limits<double>::infinity()};
+    };
+
+    /// @brief Checks if the given position lies inside the given box.
+    ///
+    /// @param box The box.
+    /// @param x The position on the x-axis.
+    /// @param y The position on the y-axis.
+    /// @param z The position on the z-axis.
+    /// @return True if the position lies inside the box, false otherwise.
+    static bool
+    inside(Box const &box, TCoordinateType const x, TCoordinateType const y, TCoordinateType const z) noexcept
+    {
+        // no short circuits, so the checks of many entries are done side by side
+        return (x >= box.minX) & (x <= box.maxX) & (y >= box.minY) & (y <= box.maxY) & (z >= box.minZ) &
+               (z <= box.maxZ);
+    }
+
+    /// @brief Calls the given function for every entry of this node and its children inside the given box.
+    ///
+    /// @tparam TFunction The type of the function, called with the entries.
+    /// @param box The box to search.
+    /// @param function The function to call.
+    /// @param region The region of this node.
+    template <typename TFunction>
+    void queryBox(Box const &box, TFunction &function, Region const &region) const noexcept
+    {
+        if (region.inside(box))
+        {
+            analyzeEntries(function);
+            return;
+        }
+        auto const inBox = [&box](auto const x, auto const y, auto const z) noexcept { return inside(box, x, y, z); };
+        _entries.filter(inBox, function);
+        for (std::uint_fast8_t index = 0U; index < _children.size(); ++index)
+        {
+            auto const childRegion = region.child(*this, index);
+            if (childRegion.intersects(box))
+            {
+                _children[index].queryBox(box, function, childRegion);
+            }
+        }
+    }
+
+    /// @brief Calls the given function for every entry of this node and its children inside the given sphere.
+    ///
+    /// @tparam TFunction The type of the function, called with the entries.
+    /// @param center The center of the sphere.
+    /// @param limit The squared radius of the sphere.
+    /// @param function The function to call.
+    /// @param region The region of this node.
+    template <typename TFunction>
+    void
+    querySphere(Point const &center, DistanceType const limit, TFunction &function, Region const &region) const noexcept
+    {
+        if (region.maxDistance(center) <= static_cast<double>(limit))
+        {
+            analyzeEntries(function);
+            return;
+        }
+        auto const inSphere = [&](auto const x, auto const y, auto const z) noexcept {
+            return center.distance(x, y, z) <= limit;
+        };
+        _entries.filter(inSphere, function);
+        for (std::uint_fast8_t index = 0U; index < _children.size(); ++index)
+        {
+            auto const childRegion = region.child(*this, index);
+            if (childRegion.minDistance(center) <= static_cast<double>(limit))
+            {
+                _children[index].querySphere(center, limit, function, childRegion);
+            }
+        }
+    }
+
+    /// @brief Pushes the entries of this node and its children closest to the given position to the queue.
+    ///
+    /// @param position The position to search around.
+    /// @param queue The queue keeping the closest entries found so far.
+    /// @param region The region of this node.
+    void queryNearest(Point const                     &position,
+                      BoundedPriorityQueue<Neighbour> &queue,
+                      Region const                    &region) const noexcept
+    {
+        auto push = [&queue](Entry const &e, DistanceType const d) noexcept { queue.push(Neighbour{e, d}); };
+        auto const distance = [&position](auto const x, auto const y, auto const z) noexcept {
+            return position.distance(x, y, z);
+        };
+        _entries.measure(distance, push);
+        if (_children.empty())
+        {
+            return;
+        }
+
+        // closest children first, the farther ones are likely skipped then
+        std::array<Region, 8U>            regions{};
+        std::array<double, 8U>            distances{};
+        std::array<std::uint_fast8_t, 8U> order{};
+        for (std::uint_fast8_t index = 0U; index < 8U; ++index)
+        {
+            regions[index]   = region.child(*this, index);
+            distances[index] = regions[index].minDistance(position);
+            order[index]     = index;
+        }
+        std::sort(order.begin(), order.end(), [&](auto const a, auto const b) noexcept {
+            return distances[a] < distances[b];
+        });
+        for (auto const index : order)
+        {
+            if (queue.full() && (distances[index] > static_cast<double>(queue.top()->distance)))
+            {
+                return;
+            }
+            _children[index].queryNearest(position, queue, regions[index]);
+        }
+    }
+
+    /// @brief Recalculates all meta data, handing the subtrees of the given number of levels to the pool.
+    ///
+    /// @param pool The pool to recalculate the subtrees with.
+    /// @param levels The number of levels in which subtrees are handed to the pool.
+    void parallelRecalculate(ThreadPool &pool, uint8_t const levels) noexcept
+    {
+        if (!_touched)
+        {
+            return;
+        }
+        if ((levels == 0U) || _children.empty())
+        {
+            recalculate();
+            return;
+        }
+
+        // the first child is recalculated by this thread
+        std::array<TaskFuture<void>, 8U> subtrees{};
+        for (size_t index = 1U; index < _children.size(); ++index)
+        {
+            auto &child     = _children[index];
+            subtrees[index] = pool.submit([&child, &pool, levels]() noexcept {
+                child.parallelRecalculate(pool, levels - 1U);
+            });
+        }
+        _children.front().parallelRecalculate(pool, levels - 1U);
+        _totalEntries = _entries.size();
+        for (size_t index = 0U; index < _children.size(); ++index)
+        {
+            subtrees[index].wait();
+            _totalEntries += _children[index]._totalEntries;
+        }
+        mergeUnderfullChildren();
+        _touched = false;
+    }
+
+    /// @brief Analyzes the entries of this node and its children, handing the subtrees of the given number of levels
+    /// to the pool.
+    ///
+    /// @tparam TResult The type of the result.
+    /// @tparam TFunction The type of the function, called with a TResult & and an Entry const &.
+    /// @tparam TReducer The type of the reducer, called with two TResult and returning their combination.
+    /// @param pool The pool to analyze the subtrees with.
+    /// @param identity The result of analyzing no entries.
+    /// @param function The function adding an entry to a result.
+    /// @param reducer The reducer combining two results.
+    /// @param levels The number of levels in which subtrees are handed to the pool.
+    /// @return The combined result of the entries of this node and its children.
+    template <typename TResult, typename TFunction, typename TReducer>
+    TResult parallelAnalyzeEntries(ThreadPool      &pool,
+                                   TResult const   &identity,
+                                   TFunction const &function,
+                                   TReducer const  &reducer,
+                                   uint8_t const    levels) const noexcept
+    {
+        auto result = identity;
+        auto fold   = [&](Entry const &e) noexcept { function(result, e); };
+        if ((levels == 0U) || _children.empty())
+        {
+            analyzeEntries(fold);
+            return result;
+        }
+
+        std::array<TaskFuture<TResult>, 8U> subtrees{};
+        for (size_t index = 1U; index < _children.size(); ++index)
+        {
+            auto const &child = _children[index];
+            subtrees[index]   = pool.submit([&, levels]() noexcept {
+                return child.parallelAnalyzeEntries(pool, identity, function, reducer, levels - 1U);
+            });
+        }
+        for (auto const &entry : _entries)
+        {
+            fold(entry);
+        }
+        result = reducer(std::move(result),
+                         _children.front().parallelAnalyzeEntries(pool, identity, function, reducer, levels - 1U));
+        for (size_t index = 1U; index < _children.size(); ++index)
+        {
+            result = reducer(std::move(result), subtrees[index].get());
+        }
+        return result;
+    }
+
+    /// @brief The outcomes of moving an entry.
+    enum class MoveResult
+    {
+        /// @brief The entry was not found.
+        NotFound,
+
+        /// @brief The entry stayed inside its leaf.
+        Replaced,
+
+        /// @brief The entry was moved to another leaf.
+        Relocated
+    };
+
+    /// @brief Moves an entry of this node or its children.
+    ///
+    /// @param from The entry to move.
+    /// @param to The entry at its new position, inside this node.
+    /// @return The outcome of the move.
+    MoveResult moveEntry(Entry const &from, Entry const &to) noexcept
+    {
+        if (_children.empty())
+        {
+            auto const index = _entries.find(from);
+            if (index == _entries.size())
+            {
+                return MoveResult::NotFound;
+            }
+            _entries.replace(index, to);
+            return MoveResult::Replaced;
+        }
+
+        auto const fromIndex = positionToIndex(from.x, from.y, from.z);
+        auto const toIndex   = positionToIndex(to.x, to.y, to.z);
+        if (fromIndex == toIndex)
+        {
+            auto const result = _children[fromIndex].moveEntry(from, to);
+            _touched          = _touched || (result == MoveResult::Relocated);
+            return result;
+        }
+        if (!_children[fromIndex].removeEntry(from))
+        {
+            return MoveResult::NotFound;
+        }
+        _children[toIndex].addEntry(to);
+        _touched = true;
+        return MoveResult::Relocated;
+    }
+
+    /// @brief Moves the entries of the children into this node and removes them, if they hold at most half of the
+    /// maximum number of entries.
+    ///
+    /// @remarks Requires _totalEntries to be up to date. Merging at half the maximum keeps a node from being split
+    /// and merged over and over by entries moving back and forth.
+    void mergeUnderfullChildren() noexcept
+    {
+        if (_children.empty() || (_totalEntries > (_maxEntries / 2U)))
+        {
+            return;
+        }
+        auto collect = [this](Entry const &e) noexcept { _entries.push_back(e); };
+        for (auto const &child : _children)
+        {
+            child.analyzeEntries(collect);
+        }
+        _children.clear();
+    }
+
+    /// @brief Creates the eight children of this node.
+    void split() noexcept
+    {
+        auto const childSize   = _size / 2;
+        auto const childOffset = childSize / 2;
+
+        auto const xp = _centerX + childOffset;
+        auto const xn = _centerX - childOffset;
+        auto const yp = _centerY + childOffset;
+        auto const yn = _centerY - childOffset;
+        auto const zp = _centerZ + childOffset;
+        auto const zn = _centerZ - childOffset;
+        _children.reserve(8U);
+        _children.emplace_back(xn, yn, zn, childSize, _maxEntries, _maxDepth - 1);
+        _children.emplace_back(xp, yn, zn, childSize, _maxEntries, _maxDepth - 1);
+        _children.emplace_back(xn, yp, zn, childSize, _maxEntries, _maxDepth - 1);
+        _children.emplace_back(xp, yp, zn, childSize, _maxEntries, _maxDepth - 1);
+        _children.emplace_back(xn, yn, zp, childSize, _maxEntries, _maxDepth - 1);
+        _children.emplace_back(xp, yn, zp, childSize, _maxEntries, _maxDepth - 1);
+        _children.emplace_back(xn, yp, zp, childSize, _maxEntries, _maxDepth - 1);
+        _children.emplace_back(xp, yp, zp, childSize, _maxEntries, _maxDepth - 1);
+    }
+
+    /// @brief Sorts the given entries by their Morton codes and builds the tree from them.
+    ///
+    /// @param entries The entries to store in the octree.
+    /// @param pool The pool to sort in parallel with, nullptr to sort on the calling thread.
+    void buildSorted(gsl::span<Entry const> const entries, ThreadPool *const pool) noexcept
+    {
+        auto const count  = entries.size();
+        auto const levels = std::min(_maxDepth, MortonLevels);
+        auto const chunks = (pool != nullptr) ? (8U * pool->workerCount()) : 1U;
+
+        std::vector<Internal::MortonKey> keys(count);
+        std::vector<Internal::MortonKey> scratch(count);
+        Internal::forEachChunk(pool, chunks, [&](size_t const chunk) noexcept {
+            for (auto i = (count * chunk) / chunks; i < (count * (chunk + 1U)) / chunks; ++i)
+            {
+                keys[i] = Internal::MortonKey{mortonCode(entries[i], levels), i};
+            }
+        });
+        Internal::radixSort(keys, scratch, 3U * levels, pool);
+
+        std::vector<Entry> sorted(count);
+        Internal::forEachChunk(pool, chunks, [&](size_t const chunk) noexcept {
+            for (auto i = (count * chunk) / chunks; i < (count * (chunk + 1U)) / chunks; ++i)
+            {
+                sorted[i] = entries[keys[i].index];
+            }
+        });
+        buildNode(sorted.data(), keys.data(), count, 0U, levels, pool);
+    }
+
+    /// @brief Builds this node from entries sorted by their Morton codes.
+    ///
+    /// @param entries The entries of the node.
+    /// @param keys The keys of the entries.
+    /// @param count The number of entries.
+    /// @param level The level of this node in the tree.
+    /// @param levels The number of levels encoded in the Morton codes.
+    /// @param pool The pool to build large subtrees with, nullptr to build on the calling thread.
+    void buildNode(Entry const               *entries,
+                   Internal::MortonKey const *keys,
+                   size_t const               count,
+                   uint8_t const              level,
+                   uint8_t const              levels,
+                   ThreadPool *const          pool) noexcept
+    {
+        _totalEntries = count;
+        _touched      = false;
+        if ((count <= _maxEntries) || (_maxDepth == 0))
+        {
+            _entries.assign(entries, entries + count);
+            return;
+        }
+
+        split();
+        if (level < levels)
+        {
+            // the three bits of this level select the child, the entries of each child follow each other
+            auto const shift = 3U * (levels - level - 1U);
+            auto       begin = keys;
+
+            std::array<TaskFuture<void>, 8U> subtrees{};
+            for (std::uint64_t index = 0U; index < 8U; ++index)
+            {
+                auto const end = std::partition_point(begin, keys + count, [=](Internal::MortonKey const &key) {
+                    return ((key.code >> shift) & 0x7U) <= index;
+                });
+                auto const childEntries = entries + (begin - keys);
+                auto const childCount   = static_cast<size_t>(end - begin);
+                auto      &child        = _children[index];
+                if ((pool != nullptr) && (childCount >= ParallelBuildGrain))
+                {
+                    subtrees[index] = pool->submit([=, &child]() noexcept {
+                        child.buildNode(childEntries, begin, childCount, level + 1U, levels, pool);
+                    });
+                }
+                else
+                {
+                    child.buildNode(childEntries, begin, childCount, level + 1U, levels, pool);
+                }
+                begin = end;
+            }
+            for (auto const &subtree : subtrees)
+            {
+                subtree.wait();
+            }
+        }
+        else
+        {
+            for (auto entry = entries; entry != (entries + count); ++entry)
+            {
+                _children[positionToIndex(entry->x, entry->y, entry->z)].addEntry(*entry);
+            }
+            for (auto &child : _children)
+            {
+                child.recalculate();
+            }
+        }
+    }
+
+    /// @brief Returns the Morton code of the path of the given entry through the tree.
+    ///
+    /// @param e The entry to encode.
+    /// @param levels The number of levels to encode.
+    /// @return The child indices of the first levels, three bits each, the first level in the highest bits.
+    /// @remarks For a tree spanning a power of two this is the Morton code of the coordinates relative to its corner.
+    std::uint64_t mortonCode(Entry const &e, uint8_t const levels) const noexcept
+    {
+        std::uint64_t code{};
+        auto          centerX = _centerX;
+        auto          centerY = _centerY;
+        auto          centerZ = _centerZ;
+        auto          size    = _size;
+        for (uint8_t level = 0U; level < levels; ++level)
+        {
+            // the centers are derived the same way split() does
+            auto const childSize   = size / 2;
+            auto const childOffset = childSize / 2;
+
+            // selects instead of branches, random points would mispredict every comparison
+            auto const px = e.x >= centerX;
+            auto const py = e.y >= centerY;
+            auto const pz = e.z >= centerZ;
+            centerX       = static_cast<TCoordinateType>(px ? (centerX + childOffset) : (centerX - childOffset));
+            centerY       = static_cast<TCoordinateType>(py ? (centerY + childOffset) : (centerY - childOffset));
+            centerZ       = static_cast<TCoordinateType>(pz ? (centerZ + childOffset) : (centerZ - childOffset));
+
+            auto const index = static_cast<std::uint64_t>(px) | (static_cast<std::uint64_t>(py) << 1U) |
+                               (static_cast<std::uint64_t>(pz) << 2U);
+            code = (code << 3U) | index;
+            size = childSize;
+        }
+        return code;
+    }
+
     /// @brief Turns the given position into an index in the _children vector.
     ///
     /// @param x The position on the X-axis.
@@ -356,7 +1638,7 @@ private:
     std::vector<Octree> _children{};
 
     /// @brief The entries of this node.
-    std::vector<Entry> _entries{};
+    Internal::OctreeEntries<Entry, TLayout> _entries{};
 
     /// @brief Flag signalling if the node has been changed.
     bool _touched{};
@@ -3,17 +3,174 @@
 
 #include "THzCommon/utility/spanhelpers.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <gsl/span>
-#include <iostream>
+#include <memory>
+#include <type_traits>
 
 namespace Terrahertz {
 
+/// @brief The ways a Queue can arrange its values in memory.
+enum class QueueMode
+{
+    /// @brief The values wrap around the end of the buffer, the filled part may be split in two spans.
+    Ring,
+
+    /// @brief The buffer is followed by a mirror of itself, the filled part is always a single span.
+    ///
+    /// @remarks Uses a double mapped memory region where available, otherwise each value is written twice.
+    Mirrored
+};
+
+namespace Internal {
+
+/// @brief Memory region mapped twice in a row, so writes to the first half show up in the second and vice versa.
+class MirroredMapping
+{
+public:
+    /// @brief Initializes a new mapping.
+    ///
+    /// @param size The size of the region [bytes], mapped twice.
+    /// @remarks The mapping fails if the size is not a multiple of the granularity or the system does not support it.
+    MirroredMapping(std::size_t size) noexcept;
+
+    /// @brief No copy construction allowed.
+    MirroredMapping(MirroredMapping const &) = delete;
+
+    /// @brief No move construction allowed.
+    MirroredMapping(MirroredMapping &&) = delete;
+
+    /// @brief No copy assignment allowed.
+    MirroredMapping &operator=(MirroredMapping const &) = delete;
+
+    /// @brief No move assignment allowed.
+    MirroredMapping &operator=(MirroredMapping &&) = delete;
+
+    /// @brief Releases the mapping.
+    ~MirroredMapping() noexcept;
+
+    /// @brief Returns the granularity the size of a mapping has to be a multiple of.
+    ///
+    /// @return The page size of the system [bytes], 0 if mirrored mappings are not supported.
+    [[nodiscard]] static std::size_t granularity() noexcept;
+
+    /// @brief Returns the start of the mapping.
+    ///
+    /// @return The start of the mapping, nullptr if mapping failed.
+    [[nodiscard]] std::byte *data() const noexcept { return _data; }
+
+private:
+    /// @brief The start of the mapping.
+    std::byte *_data{};
+
+    /// @brief The size of the region, the mapping itself is twice as large.
+    std::size_t _size{};
+};
+
+/// @brief Storage of a Queue, holding each value once.
+///
+/// @tparam TValueType The type of values stored in the queue.
+/// @tparam TBufferSize The size of the queue.
+/// @tparam TMode The way the values are arranged in memory.
+template <typename TValueType, std::size_t TBufferSize, QueueMode TMode>
+class QueueStorage
+{
+public:
+    /// @brief Returns the start of the buffer.
+    ///
+    /// @return The start of the buffer.
+    TValueType *data() noexcept { return _buffer.data(); }
+
+    /// @brief Returns the start of the buffer.
+    ///
+    /// @return The start of the buffer.
+    TValueType const *data() const noexcept { return _buffer.data(); }
+
+    /// @brief Writes a value to the buffer.
+    ///
+    /// @param index The index to write the value to.
+    /// @param value The value to write.
+    void write(std::size_t const index, TValueType const &value) noexcept { _buffer[index] = value; }
+
+private:
+    /// @brief The buffer of the queue.
+    std::array<TValueType, TBufferSize> _buffer{};
+};
+
+/// @brief Storage of a Queue, followed by a mirror of itself.
+///
+/// @tparam TValueType The type of values stored in the queue.
+/// @tparam TBufferSize The size of the queue.
+template <typename TValueType, std::size_t TBufferSize>
+class QueueStorage<TValueType, TBufferSize, QueueMode::Mirrored>
+{
+    static_assert(std::is_trivially_copyable_v<TValueType>, "Mirrored queues require trivially copyable values.");
+
+public:
+    /// @brief Initializes the storage, preferring a double mapped region over writing each value twice.
+    QueueStorage() noexcept : _mapping{std::make_unique<MirroredMapping>(sizeof(TValueType) * TBufferSize)}
+    {
+        if (_mapping->data() != nullptr)
+        {
+            _data = reinterpret_cast<TValueType *>(_mapping->data());
+        }
+        else
+        {
+            _mapping.reset();
+            _fallback = std::make_unique<TValueType[]>(2U * TBufferSize);
+            _data     = _fallback.get();
+        }
+    }
+
+    /// @brief Checks if the mirror is provided by the memory mapping.
+    ///
+    /// @return True if the storage is double mapped, false if each value is written twice.
+    bool doubleMapped() const noexcept { return _mapping != nullptr; }
+
+    /// @brief Returns the start of the buffer.
+    ///
+    /// @return The start of the buffer.
+    TValueType *data() noexcept { return _data; }
+
+    /// @brief Returns the start of the buffer.
+    ///
+    /// @return The start of the buffer.
+    TValueType const *data() const noexcept { return _data; }
+
+    /// @brief Writes a value to the buffer and its mirror.
+    ///
+    /// @param index The index to write the value to.
+    /// @param value The value to write.
+    void write(std::size_t const index, TValueType const &value) noexcept
+    {
+        _data[index] = value;
+        if (!_mapping)
+        {
+            _data[index + TBufferSize] = value;
+        }
+    }
+
+private:
+    /// @brief The double mapped region, if available.
+    std::unique_ptr<MirroredMapping> _mapping{};
+
+    /// @brief The buffer of twice the size used if no double mapped region is available.
+    std::unique_ptr<TValueType[]> _fallback{};
+
+    /// @brief The start of the buffer.
+    TValueType *_data{};
+};
+
+} // namespace Internal
+
 /// @brief Template implementation of a static sized queue.
 ///
 /// @tparam TValueType The type of values stored in the queue.
 /// @tparam TBufferSize The size of the queue.
-template <typename TValueType, size_t TBufferSize>
+/// @tparam TMode The way the values are arranged in memory.
+template <typename TValueType, size_t TBufferSize, QueueMode TMode = QueueMode::Ring>
 class Queue
 {
 public:
@@ -26,80 +183,121 @@ public:
     /// @brief Pushes a new value to the back of the queue.
     ///
     /// @param value The value to push into the queue.
+    /// @remarks If the queue is full, the value will not be pushed.
     void push(TValueType const &value) noexcept
     {
-        if (_pushPosition == TBufferSize)
+        if (_filled < TBufferSize)
         {
-            size_t i = 0U;
-            size_t j = _popPosition;
-            while (j != _pushPosition)
+            auto index = _popPosition + _filled;
+            if (index >= TBufferSize)
             {
-                _buffer[i] = _buffer[j];
-                ++i;
-                ++j;
+                index -= TBufferSize;
             }
-            _pushPosition -= _popPosition;
-            _popPosition = 0U;
-        }
-
-        if (_pushPosition < _buffer.size())
-        {
-            _buffer[_pushPosition] = value;
-            ++_pushPosition;
+            _storage.write(index, value);
+            ++_filled;
         }
     }
 
     /// @brief Pops a certain amount of values at the front of the queue.
     ///
     /// @param amount The amount of values to pop.
-    /// @remarks If more values are popped than are in the queue, it will be reset.
+    /// @remarks If all values are popped, the queue will be reset.
     void pop(size_t amount) noexcept
     {
+        if (amount >= _filled)
+        {
+            // starting over at the front keeps the values in a single span for as long as possible
+            _popPosition = 0U;
+            _filled      = 0U;
+            return;
+        }
         _popPosition += amount;
-        if (_popPosition > _pushPosition)
+        if (_popPosition >= TBufferSize)
         {
-            _popPosition  = 0U;
-            _pushPosition = 0U;
+            _popPosition -= TBufferSize;
         }
+        _filled -= amount;
     }
 
     /// @brief Checks if the queue is empty.
     ///
     /// @return True if the queue is empty, false otherwise.
-    inline bool empty() const noexcept { return _popPosition == _pushPosition; }
+    inline bool empty() const noexcept { return _filled == 0U; }
 
     /// @brief Returns the size of the currently filled part of the queue.
     ///
     /// @return The size of the currently filled part of the queue.
-    size_t filled() const noexcept { return _pushPosition - _popPosition; }
+    size_t filled() const noexcept { return _filled; }
 
     /// @brief Returns the size of the queue.
     ///
     /// @return The size of the queue.
     constexpr size_t size() const noexcept { return TBufferSize; }
 
-    /// @brief Returns a span of the currently filled part of the queue.
+    /// @brief Returns a span of the front of the currently filled part of the queue.
+    ///
+    /// @return The span from the front of the queue up to its back or the end of the buffer.
+    /// @remarks Always contains the entire filled part in Mirrored mode.
+    gsl::span<TValueType const> firstSpan() const noexcept
+    {
+        return toSpan<TValueType const>(_storage.data() + _popPosition, firstSize());
+    }
+
+    /// @brief Returns a span of the front of the currently filled part of the queue.
     ///
-    /// @return A Span of the currently filled part of the queue.
-    gsl::span<TValueType const> data() const noexcept
+    /// @return The span from the front of the queue up to its back or the end of the buffer.
+    /// @remarks Always contains the entire filled part in Mirrored mode.
+    gsl::span<TValueType> firstSpan() noexcept
     {
-        return toSpan<TValueType const>(_buffer.data() + _popPosition, filled());
+        return toSpan<TValueType>(_storage.data() + _popPosition, firstSize());
     }
 
-    /// @brief Returns a span of the currently filled part of the queue.
+    /// @brief Returns a span of the part of the queue that wrapped around to the start of the buffer.
+    ///
+    /// @return The span following the one returned by firstSpan, always empty in Mirrored mode.
+    gsl::span<TValueType const> secondSpan() const noexcept
+    {
+        return toSpan<TValueType const>(_storage.data(), _filled - firstSize());
+    }
+
+    /// @brief Returns a span of the part of the queue that wrapped around to the start of the buffer.
+    ///
+    /// @return The span following the one returned by firstSpan, always empty in Mirrored mode.
+    gsl::span<TValueType> secondSpan() noexcept { return toSpan<TValueType>(_storage.data(), _filled - firstSize()); }
+
+    /// @brief Checks if the mirror of a Mirrored queue is provided by a double mapped memory region.
     ///
-    /// @return A Span of the currently filled part of the queue.
-    gsl::span<TValueType> data() noexcept { return toSpan<TValueType>(_buffer.data() + _popPosition, filled()); }
+    /// @return True if the memory is double mapped, false if each value is written twice or not in Mirrored mode.
+    bool doubleMapped() const noexcept
+    {
+        if constexpr (TMode == QueueMode::Mirrored)
+        {
+            return _storage.doubleMapped();
+        }
+        return false;
+    }
 
 private:
+    /// @brief Returns the size of the span returned by firstSpan.
+    ///
+    /// @return The size of the span returned by firstSpan.
+    size_t firstSize() const noexcept
+    {
+        if constexpr (TMode == QueueMode::Mirrored)
+        {
+            return _filled;
+        }
+        return std::min(_filled, TBufferSize - _popPosition);
+    }
+
     /// @brief The position in the buffer to pop the next value from.
     size_t _popPosition{};
 
-    /// @brief The position in the buffer to push the next value to.
-    size_t _pushPosition{};
+    /// @brief The number of values in the queue.
+    size_t _filled{};
 
-    /// @brief The buffer of the queue.
-    std::array<TValueType, TBufferSize> _buffer{};
+    /// @brief The storage of the queue.
+    Internal::QueueStorage<TValueType, TBufferSize, TMode> _storage{};
 };
 
 } // namespace Terrahertz
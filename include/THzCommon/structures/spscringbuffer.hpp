@@ -0,0 +1,216 @@
+#ifndef THZ_COMMON_STRUCTURES_SPSCRINGBUFFER_HPP
+#define THZ_COMMON_STRUCTURES_SPSCRINGBUFFER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <span>
+
+namespace Terrahertz {
+
+/// @brief Lock-free ring buffer handing values from exactly one producer thread to exactly one consumer thread.
+///
+/// @tparam TValueType The type of values stored in the buffer.
+/// @tparam TCapacity The number of values the buffer can hold, must be a power of two.
+/// @remarks push, reserve and commit may only be called by the producer; pop, peek and consume only by the consumer.
+template <typename TValueType, std::size_t TCapacity>
+class SpscRingBuffer
+{
+    static_assert(std::has_single_bit(TCapacity), "The capacity must be a power of two.");
+
+public:
+    /// @brief The value type of the buffer.
+    using value_type = TValueType;
+
+    /// @brief The size of a cache line, used to keep the positions of producer and consumer apart.
+    static constexpr std::size_t CacheLineSize{64U};
+
+    /// @brief Default initializes a new SpscRingBuffer instance.
+    SpscRingBuffer() noexcept = default;
+
+    /// @brief Pushes a value to the back of the buffer.
+    ///
+    /// @param value The value to push.
+    /// @return True if the value was pushed, false if the buffer is full.
+    bool push(TValueType const &value) noexcept
+    {
+        auto const tail = _tail.load(std::memory_order_relaxed);
+        if (freeSpace(tail, 1U) == 0U)
+        {
+            return false;
+        }
+        _buffer[tail & Mask] = value;
+        _tail.store(tail + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Pushes as many of the given values as fit to the back of the buffer.
+    ///
+    /// @param values The values to push.
+    /// @return The number of values pushed.
+    std::size_t push(std::span<TValueType const> const values) noexcept
+    {
+        auto const tail  = _tail.load(std::memory_order_relaxed);
+        auto const count = freeSpace(tail, values.size());
+
+        // copy in up to two parts, split at the end of the buffer
+        auto const index = tail & Mask;
+        auto const first = std::min(count, TCapacity - index);
+        std::copy_n(values.begin(), first, _buffer.begin() + index);
+        std::copy_n(values.begin() + first, count - first, _buffer.begin());
+        _tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /// @brief Returns a contiguous region at the back of the buffer to write values into without copying.
+    ///
+    /// @param count The number of values requested.
+    /// @return The region, shorter than requested if the buffer is full or wraps around.
+    /// @remarks The values only become visible to the consumer after commit was called.
+    std::span<TValueType> reserve(std::size_t const count) noexcept
+    {
+        auto const tail  = _tail.load(std::memory_order_relaxed);
+        auto const index = tail & Mask;
+        return std::span<TValueType>{_buffer}.subspan(index, std::min(freeSpace(tail, count), TCapacity - index));
+    }
+
+    /// @brief Publishes values written into the region returned by reserve.
+    ///
+    /// @param count The number of values to publish, must not exceed the size of the reserved region.
+    void commit(std::size_t const count) noexcept
+    {
+        _tail.store(_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /// @brief Pops a value from the front of the buffer.
+    ///
+    /// @param value The value to pop into.
+    /// @return True if a value was popped, false if the buffer is empty.
+    bool pop(TValueType &value) noexcept
+    {
+        auto const head = _head.load(std::memory_order_relaxed);
+        if (available(head, 1U) == 0U)
+        {
+            return false;
+        }
+        value = _buffer[head & Mask];
+        _head.store(head + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Pops as many values as available from the front of the buffer.
+    ///
+    /// @param values The span to pop the values into.
+    /// @return The number of values popped.
+    std::size_t pop(std::span<TValueType> const values) noexcept
+    {
+        auto const head  = _head.load(std::memory_order_relaxed);
+        auto const count = available(head, values.size());
+
+        auto const index = head & Mask;
+        auto const first = std::min(count, TCapacity - index);
+        std::copy_n(_buffer.begin() + index, first, values.begin());
+        std::copy_n(_buffer.begin(), count - first, values.begin() + first);
+        _head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /// @brief Returns a contiguous region at the front of the buffer to read values from without copying.
+    ///
+    /// @param count The maximum number of values requested.
+    /// @return The region, shorter than requested if the buffer holds less values or wraps around.
+    /// @remarks The values stay in the buffer until consume was called.
+    std::span<TValueType const> peek(std::size_t const count = TCapacity) noexcept
+    {
+        auto const head  = _head.load(std::memory_order_relaxed);
+        auto const index = head & Mask;
+        return std::span<TValueType const>{_buffer}.subspan(index, std::min(available(head, count), TCapacity - index));
+    }
+
+    /// @brief Removes values read using peek from the front of the buffer.
+    ///
+    /// @param count The number of values to remove, must not exceed the size of the peeked region.
+    void consume(std::size_t const count) noexcept
+    {
+        _head.store(_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /// @brief Checks if the buffer is empty.
+    ///
+    /// @return True if the buffer is empty, false otherwise.
+    /// @remarks Only a snapshot if called while the other thread is working on the buffer.
+    bool empty() const noexcept { return filled() == 0U; }
+
+    /// @brief Returns the number of values in the buffer.
+    ///
+    /// @return The number of values in the buffer.
+    /// @remarks Only a snapshot if called while the other thread is working on the buffer.
+    std::size_t filled() const noexcept
+    {
+        // the head is loaded first, so it can never be ahead of the tail
+        auto const head = _head.load(std::memory_order_acquire);
+        return _tail.load(std::memory_order_acquire) - head;
+    }
+
+    /// @brief Returns the capacity of the buffer.
+    ///
+    /// @return The capacity of the buffer.
+    constexpr std::size_t size() const noexcept { return TCapacity; }
+
+private:
+    /// @brief Mask turning a position into an index of the buffer.
+    static constexpr std::size_t Mask{TCapacity - 1U};
+
+    /// @brief Returns the free space at the back of the buffer, only looking at the consumer if necessary.
+    ///
+    /// @param tail The current position of the producer.
+    /// @param wanted The number of values the producer wants to write.
+    /// @return The number of values that can be written, at most wanted.
+    std::size_t freeSpace(std::size_t const tail, std::size_t const wanted) noexcept
+    {
+        auto space = TCapacity - (tail - _cachedHead);
+        if (space < wanted)
+        {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            space       = TCapacity - (tail - _cachedHead);
+        }
+        return std::min(space, wanted);
+    }
+
+    /// @brief Returns the number of values at the front of the buffer, only looking at the producer if necessary.
+    ///
+    /// @param head The current position of the consumer.
+    /// @param wanted The number of values the consumer wants to read.
+    /// @return The number of values that can be read, at most wanted.
+    std::size_t available(std::size_t const head, std::size_t const wanted) noexcept
+    {
+        auto count = _cachedTail - head;
+        if (count < wanted)
+        {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            count       = _cachedTail - head;
+        }
+        return std::min(count, wanted);
+    }
+
+    /// @brief The position of the consumer, only written by the consumer.
+    alignas(CacheLineSize) std::atomic<std::size_t> _head{};
+
+    /// @brief The position of the producer as last seen by the consumer.
+    std::size_t _cachedTail{};
+
+    /// @brief The position of the producer, only written by the producer.
+    alignas(CacheLineSize) std::atomic<std::size_t> _tail{};
+
+    /// @brief The position of the consumer as last seen by the producer.
+    std::size_t _cachedHead{};
+
+    /// @brief The buffer holding the values.
+    alignas(CacheLineSize) std::array<TValueType, TCapacity> _buffer{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_STRUCTURES_SPSCRINGBUFFER_HPP
@@ -5,6 +5,12 @@
 
 namespace Terrahertz {
 
+/// @brief Changes the byteorder of the given 16-bit unsigned integer.
+///
+/// @param input The integer to change.
+/// @return The integer in the new byte order.
+std::uint16_t flipByteOrder(std::uint16_t input) noexcept;
+
 /// @brief Changes the byteorder of the given 32-bit unsigned integer.
 ///
 /// @param input The integer to change.
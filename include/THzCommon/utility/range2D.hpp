@@ -102,6 +102,16 @@ public:
     /// @return An Iterator with its index at the end of the buffer.
     [[nodiscard]] Iterator end() const noexcept;
 
+    /// @brief Returns the width of the buffer.
+    ///
+    /// @return The width of the buffer.
+    [[nodiscard]] std::uint32_t width() const noexcept;
+
+    /// @brief Returns the height of the buffer.
+    ///
+    /// @return The height of the buffer.
+    [[nodiscard]] std::uint32_t height() const noexcept;
+
 private:
     /// @brief The width of the buffer.
     std::uint32_t _width{};
@@ -0,0 +1,388 @@
+#ifndef THZ_COMMON_UTILITY_TASK_HPP
+#define THZ_COMMON_UTILITY_TASK_HPP
+
+#include "THzCommon/utility/threadPool.hpp"
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace Terrahertz {
+
+template <typename T>
+class Task;
+
+namespace Internal {
+
+/// @brief Parts of the promise of a Task independent of its result.
+class TaskPromiseBase
+{
+public:
+    /// @brief Awaiter resuming the coroutine waiting for the task once it is finished.
+    struct FinalAwaiter
+    {
+        /// @brief The task always suspends at its end, it is destroyed by its Task instance.
+        ///
+        /// @return Always false.
+        bool await_ready() const noexcept { return false; }
+
+        /// @brief Transfers control to the coroutine waiting for the task.
+        ///
+        /// @tparam TPromise The type of the promise of the task.
+        /// @param coroutine The finished task.
+        /// @return The coroutine waiting for the task, a no-op coroutine if there is none.
+        template <typename TPromise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> coroutine) const noexcept
+        {
+            auto const continuation = coroutine.promise().continuation();
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        /// @brief Never called, as the task is not resumed after its end.
+        void await_resume() const noexcept {}
+    };
+
+    /// @brief Tasks are lazy, they only start once they are awaited.
+    ///
+    /// @return Always suspends.
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    /// @brief Resumes the coroutine waiting for the task.
+    ///
+    /// @return The awaiter resuming the waiting coroutine.
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    /// @brief Tasks must not throw.
+    void unhandled_exception() const noexcept { std::terminate(); }
+
+    /// @brief Sets the coroutine to resume once the task is finished.
+    ///
+    /// @param continuation The coroutine waiting for the task.
+    void continueWith(std::coroutine_handle<> const continuation) noexcept { _continuation = continuation; }
+
+    /// @brief Returns the coroutine to resume once the task is finished.
+    ///
+    /// @return The coroutine waiting for the task.
+    std::coroutine_handle<> continuation() const noexcept { return _continuation; }
+
+private:
+    /// @brief The coroutine waiting for the task.
+    std::coroutine_handle<> _continuation{};
+};
+
+/// @brief The promise of a Task returning a value.
+///
+/// @tparam T The type of the result.
+template <typename T>
+class TaskPromise : public TaskPromiseBase
+{
+public:
+    /// @brief Creates the Task owning the coroutine.
+    ///
+    /// @return The Task owning the coroutine.
+    Task<T> get_return_object() noexcept;
+
+    /// @brief Stores the result of the task.
+    ///
+    /// @tparam TValue The type of the value passed to co_return.
+    /// @param value The result of the task.
+    template <typename TValue>
+    void return_value(TValue &&value) noexcept
+    {
+        _value.emplace(std::forward<TValue>(value));
+    }
+
+    /// @brief Returns the result of the task.
+    ///
+    /// @return The result, moved out of the promise.
+    T result() noexcept { return std::move(*_value); }
+
+private:
+    /// @brief The result of the task.
+    std::optional<T> _value{};
+};
+
+/// @brief The promise of a Task without result.
+template <>
+class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+    /// @brief Creates the Task owning the coroutine.
+    ///
+    /// @return The Task owning the coroutine.
+    Task<void> get_return_object() noexcept;
+
+    /// @brief Called at the end of the task.
+    void return_void() const noexcept {}
+
+    /// @brief Called when the task is awaited.
+    void result() const noexcept {}
+};
+
+/// @brief Coroutine running on its own, destroying itself at its end.
+struct DetachedTask
+{
+    /// @brief The promise of the DetachedTask.
+    struct promise_type
+    {
+        /// @brief Creates the DetachedTask.
+        ///
+        /// @return An empty DetachedTask, as the coroutine is not owned by anyone.
+        DetachedTask get_return_object() const noexcept { return {}; }
+
+        /// @brief The coroutine starts right away.
+        ///
+        /// @return Never suspends.
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+
+        /// @brief The coroutine destroys itself at its end.
+        ///
+        /// @return Never suspends.
+        std::suspend_never final_suspend() const noexcept { return {}; }
+
+        /// @brief Called at the end of the coroutine.
+        void return_void() const noexcept {}
+
+        /// @brief Detached coroutines must not throw.
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+/// @brief Signals the end of a task to a thread waiting in syncWait.
+struct SyncWaitSignal
+{
+    /// @brief The mutex guarding the flag.
+    std::mutex mutex{};
+
+    /// @brief Notified once the task is finished.
+    std::condition_variable finished{};
+
+    /// @brief Set once the task is finished.
+    bool done{};
+};
+
+/// @brief Awaiter continuing the coroutine on a worker of a ThreadPool.
+class PoolAwaiter
+{
+public:
+    /// @brief Initializes a new PoolAwaiter.
+    ///
+    /// @param pool The pool to continue the coroutine on.
+    PoolAwaiter(ThreadPool &pool) noexcept : _pool{&pool} {}
+
+    /// @brief The coroutine always moves to the pool.
+    ///
+    /// @return Always false.
+    bool await_ready() const noexcept { return false; }
+
+    /// @brief Hands the coroutine to the pool.
+    ///
+    /// @param coroutine The coroutine to continue.
+    void await_suspend(std::coroutine_handle<> const coroutine) const noexcept
+    {
+        _pool->post([coroutine]() noexcept { coroutine.resume(); });
+    }
+
+    /// @brief Called on the worker continuing the coroutine.
+    void await_resume() const noexcept {}
+
+private:
+    /// @brief The pool to continue the coroutine on.
+    ThreadPool *_pool;
+};
+
+} // namespace Internal
+
+/// @brief Lazily started coroutine returning a value to the coroutine awaiting it.
+///
+/// @tparam T The type of the result.
+/// @remarks The coroutine starts once the task is awaited and is destroyed together with the Task instance. Tasks
+/// must not throw.
+template <typename T = void>
+class [[nodiscard]] Task
+{
+public:
+    /// @brief The promise of the coroutine.
+    using promise_type = Internal::TaskPromise<T>;
+
+    /// @brief Awaiter starting the task and resuming the awaiting coroutine once it is finished.
+    class Awaiter
+    {
+    public:
+        /// @brief Initializes a new Awaiter.
+        ///
+        /// @param coroutine The coroutine of the task.
+        Awaiter(std::coroutine_handle<promise_type> const coroutine) noexcept : _coroutine{coroutine} {}
+
+        /// @brief Checks if the task already finished.
+        ///
+        /// @return True if the task already finished, false otherwise.
+        bool await_ready() const noexcept { return _coroutine.done(); }
+
+        /// @brief Starts the task, resuming the awaiting coroutine at its end.
+        ///
+        /// @param awaiting The coroutine awaiting the task.
+        /// @return The coroutine of the task.
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> const awaiting) const noexcept
+        {
+            _coroutine.promise().continueWith(awaiting);
+            return _coroutine;
+        }
+
+        /// @brief Returns the result of the task.
+        ///
+        /// @return The result of the task.
+        T await_resume() const noexcept { return _coroutine.promise().result(); }
+
+    private:
+        /// @brief The coroutine of the task.
+        std::coroutine_handle<promise_type> _coroutine;
+    };
+
+    /// @brief Default initializes a new Task, not referring to any coroutine.
+    Task() noexcept = default;
+
+    /// @brief Initializes a new Task taking over the given coroutine.
+    ///
+    /// @param coroutine The coroutine of the task.
+    explicit Task(std::coroutine_handle<promise_type> const coroutine) noexcept : _coroutine{coroutine} {}
+
+    /// @brief No copy construction allowed.
+    Task(Task const &) = delete;
+
+    /// @brief Initializes a Task by taking over the coroutine of another one.
+    ///
+    /// @param other The task to move from.
+    Task(Task &&other) noexcept : _coroutine{std::exchange(other._coroutine, {})} {}
+
+    /// @brief No copy assignment allowed.
+    Task &operator=(Task const &) = delete;
+
+    /// @brief Swaps the coroutines of this and another task.
+    ///
+    /// @param other The task to swap with.
+    /// @return This task.
+    Task &operator=(Task &&other) noexcept
+    {
+        std::swap(_coroutine, other._coroutine);
+        return *this;
+    }
+
+    /// @brief Destroys the coroutine.
+    ~Task() noexcept
+    {
+        if (_coroutine)
+        {
+            _coroutine.destroy();
+        }
+    }
+
+    /// @brief Checks if the task refers to a coroutine.
+    ///
+    /// @return True if the task refers to a coroutine, false otherwise.
+    bool valid() const noexcept { return static_cast<bool>(_coroutine); }
+
+    /// @brief Checks if the coroutine finished.
+    ///
+    /// @return True if the coroutine finished, false otherwise.
+    bool done() const noexcept { return valid() && _coroutine.done(); }
+
+    /// @brief Starts the task, resuming the awaiting coroutine once it is finished.
+    ///
+    /// @return The awaiter of the task.
+    /// @remarks The task has to be valid and must only be awaited once.
+    Awaiter operator co_await() const noexcept { return Awaiter{_coroutine}; }
+
+private:
+    /// @brief The coroutine of the task.
+    std::coroutine_handle<promise_type> _coroutine{};
+};
+
+template <typename T>
+Task<T> Internal::TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+inline Task<void> Internal::TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+/// @brief Runs the task on its own, without anyone waiting for it.
+///
+/// @tparam T The type of the result, which is dropped.
+/// @param task The task to run.
+/// @remarks The task runs on the calling thread until it suspends for the first time.
+template <typename T>
+Internal::DetachedTask spawn(Task<T> task) noexcept
+{
+    co_await task;
+}
+
+namespace Internal {
+
+/// @brief Runs the task and signals its end.
+///
+/// @tparam T The type of the result.
+/// @param task The task to run.
+/// @param result Receives the result of the task.
+/// @param signal The signal to raise at the end of the task.
+template <typename T, typename TResult>
+DetachedTask runSignalling(Task<T> &task, std::optional<TResult> &result, SyncWaitSignal &signal) noexcept
+{
+    if constexpr (std::is_void_v<T>)
+    {
+        co_await task;
+        result.emplace();
+    }
+    else
+    {
+        result.emplace(co_await task);
+    }
+    // notifying while holding the lock keeps the waiting thread from destroying the signal too early
+    std::lock_guard<std::mutex> lock{signal.mutex};
+    signal.done = true;
+    signal.finished.notify_one();
+}
+
+} // namespace Internal
+
+/// @brief Runs the task and blocks the calling thread until it is finished.
+///
+/// @tparam T The type of the result.
+/// @param task The task to run.
+/// @return The result of the task.
+/// @remarks Meant for the boundary between regular and coroutine code, e.g. main or tests.
+template <typename T>
+T syncWait(Task<T> task) noexcept
+{
+    using Result = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    Internal::SyncWaitSignal signal{};
+    std::optional<Result>    result{};
+    Internal::runSignalling(task, result, signal);
+    {
+        std::unique_lock<std::mutex> lock{signal.mutex};
+        signal.finished.wait(lock, [&]() noexcept { return signal.done; });
+    }
+    if constexpr (!std::is_void_v<T>)
+    {
+        return std::move(*result);
+    }
+}
+
+/// @brief Continues the awaiting coroutine on a worker of the given pool.
+///
+/// @param pool The pool to continue on.
+/// @return The awaiter moving the coroutine, use as co_await schedule(pool).
+inline Internal::PoolAwaiter schedule(ThreadPool &pool) noexcept { return Internal::PoolAwaiter{pool}; }
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_UTILITY_TASK_HPP
@@ -0,0 +1,476 @@
+#ifndef THZ_COMMON_UTILITY_THREADPOOL_HPP
+#define THZ_COMMON_UTILITY_THREADPOOL_HPP
+
+#include "THzCommon/utility/range2D.hpp"
+#include "THzCommon/utility/workerThread.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Terrahertz {
+
+class ThreadPool;
+
+namespace Internal {
+
+/// @brief Base of all jobs executed by the ThreadPool.
+class PoolJob
+{
+public:
+    /// @brief Default destructor.
+    virtual ~PoolJob() noexcept = default;
+
+    /// @brief Executes the job.
+    virtual void execute() noexcept = 0;
+};
+
+/// @brief Deque of jobs, the owning worker pushes and takes at the bottom while others steal from the top.
+///
+/// @remarks Chase-Lev deque using the memory orderings of Lê et al., grows when full and keeps the replaced
+/// buffers alive until destruction as thieves might still read from them.
+class WorkStealingDeque
+{
+public:
+    /// @brief Initializes a new WorkStealingDeque.
+    ///
+    /// @param capacity The initial capacity, rounded up to a power of two.
+    WorkStealingDeque(std::size_t capacity = 256U) noexcept;
+
+    /// @brief No copy construction allowed.
+    WorkStealingDeque(WorkStealingDeque const &) = delete;
+
+    /// @brief No move construction allowed.
+    WorkStealingDeque(WorkStealingDeque &&) = delete;
+
+    /// @brief No copy assignment allowed.
+    WorkStealingDeque &operator=(WorkStealingDeque const &) = delete;
+
+    /// @brief No move assignment allowed.
+    WorkStealingDeque &operator=(WorkStealingDeque &&) = delete;
+
+    /// @brief Pushes a job to the bottom of the deque, only to be called by the owner.
+    ///
+    /// @param job The job to push.
+    void push(PoolJob *job) noexcept;
+
+    /// @brief Takes the job at the bottom of the deque, only to be called by the owner.
+    ///
+    /// @return The job, nullptr if the deque is empty.
+    PoolJob *take() noexcept;
+
+    /// @brief Steals the job at the top of the deque, can be called by any thread.
+    ///
+    /// @return The job, nullptr if the deque is empty or another thread got the job first.
+    PoolJob *steal() noexcept;
+
+    /// @brief Checks if the deque is empty.
+    ///
+    /// @return True if the deque is empty, false otherwise.
+    /// @remarks Only a snapshot if called while other threads are working on the deque.
+    bool empty() const noexcept;
+
+private:
+    /// @brief Ring of job pointers.
+    struct Buffer
+    {
+        /// @brief Initializes a new Buffer.
+        ///
+        /// @param size The number of slots, must be a power of two.
+        Buffer(std::size_t size) noexcept;
+
+        /// @brief Provides access to the slot of the given position.
+        ///
+        /// @param position The position to access.
+        /// @return The slot of the position.
+        std::atomic<PoolJob *> &operator[](std::int64_t position) noexcept;
+
+        /// @brief The number of slots.
+        std::size_t capacity{};
+
+        /// @brief The slots.
+        std::unique_ptr<std::atomic<PoolJob *>[]> slots{};
+    };
+
+    /// @brief Replaces the current buffer by one twice as large.
+    ///
+    /// @param bottom The current bottom position.
+    /// @param top The current top position.
+    /// @return The new buffer.
+    Buffer *grow(std::int64_t bottom, std::int64_t top) noexcept;
+
+    /// @brief The position the next job is stolen from.
+    alignas(64) std::atomic<std::int64_t> _top{};
+
+    /// @brief The position the next job is pushed to.
+    alignas(64) std::atomic<std::int64_t> _bottom{};
+
+    /// @brief The buffer currently used.
+    alignas(64) std::atomic<Buffer *> _buffer{};
+
+    /// @brief All buffers ever used by the deque, only accessed by the owner.
+    std::vector<std::unique_ptr<Buffer>> _buffers{};
+};
+
+/// @brief State shared between a submitted job and its TaskFuture.
+///
+/// @tparam T The type of the result.
+template <typename T>
+struct FutureState
+{
+    /// @brief Set once the result is available.
+    std::atomic_bool ready{};
+
+    /// @brief The result of the job.
+    std::optional<T> value{};
+};
+
+/// @brief State shared between a submitted job without result and its TaskFuture.
+template <>
+struct FutureState<void>
+{
+    /// @brief Set once the job has been executed.
+    std::atomic_bool ready{};
+};
+
+/// @brief Job executing a function and handing the result to a TaskFuture.
+///
+/// @tparam TFunction The type of the function.
+/// @tparam TResult The type returned by the function.
+template <typename TFunction, typename TResult>
+class SubmittedJob final : public PoolJob
+{
+public:
+    /// @brief Initializes a new SubmittedJob.
+    ///
+    /// @param function The function to execute.
+    /// @param state The state to store the result in.
+    SubmittedJob(TFunction &&function, std::shared_ptr<FutureState<TResult>> state) noexcept
+        : _function{std::move(function)}, _state{std::move(state)}
+    {}
+
+    /// @copydoc PoolJob::execute
+    void execute() noexcept override
+    {
+        if constexpr (std::is_void_v<TResult>)
+        {
+            _function();
+        }
+        else
+        {
+            _state->value.emplace(_function());
+        }
+        _state->ready.store(true, std::memory_order_release);
+        _state->ready.notify_all();
+    }
+
+private:
+    /// @brief The function to execute.
+    TFunction _function;
+
+    /// @brief The state to store the result in.
+    std::shared_ptr<FutureState<TResult>> _state;
+};
+
+/// @brief Job executing a function without handing out its result.
+///
+/// @tparam TFunction The type of the function.
+template <typename TFunction>
+class PostedJob final : public PoolJob
+{
+public:
+    /// @brief Initializes a new PostedJob.
+    ///
+    /// @param function The function to execute.
+    PostedJob(TFunction &&function) noexcept : _function{std::move(function)} {}
+
+    /// @copydoc PoolJob::execute
+    void execute() noexcept override { _function(); }
+
+private:
+    /// @brief The function to execute.
+    TFunction _function;
+};
+
+} // namespace Internal
+
+/// @brief Lightweight future of a job submitted to the ThreadPool.
+///
+/// @tparam T The type of the result.
+/// @remarks Waiting on a worker of the pool executes other jobs in the meantime, so jobs can wait for the jobs they
+/// spawned without blocking the pool.
+template <typename T>
+class TaskFuture
+{
+public:
+    /// @brief Default initializes a new TaskFuture, not referring to any job.
+    TaskFuture() noexcept = default;
+
+    /// @brief Checks if the future refers to a job.
+    ///
+    /// @return True if the future refers to a job, false otherwise.
+    bool valid() const noexcept { return _state != nullptr; }
+
+    /// @brief Checks if the job has been executed.
+    ///
+    /// @return True if the result is available, false otherwise.
+    bool ready() const noexcept { return valid() && _state->ready.load(std::memory_order_acquire); }
+
+    /// @brief Waits until the job has been executed.
+    void wait() const noexcept;
+
+    /// @brief Waits until the job has been executed and returns its result.
+    ///
+    /// @return The result of the job, moved out of the future.
+    T get() noexcept
+    {
+        wait();
+        if constexpr (!std::is_void_v<T>)
+        {
+            return std::move(*_state->value);
+        }
+    }
+
+private:
+    friend class ThreadPool;
+
+    /// @brief Initializes a new TaskFuture.
+    ///
+    /// @param pool The pool executing the job.
+    /// @param state The state shared with the job.
+    TaskFuture(ThreadPool *pool, std::shared_ptr<Internal::FutureState<T>> state) noexcept
+        : _pool{pool}, _state{std::move(state)}
+    {}
+
+    /// @brief The pool executing the job.
+    ThreadPool *_pool{};
+
+    /// @brief The state shared with the job.
+    std::shared_ptr<Internal::FutureState<T>> _state{};
+};
+
+/// @brief Pool of worker threads, each stealing jobs from the others once it runs out of its own.
+///
+/// @remarks Jobs submitted by a worker go to its own deque, all other jobs to a global injection queue. Jobs must not
+/// throw.
+class ThreadPool
+{
+public:
+    /// @brief Initializes a new ThreadPool and starts its workers.
+    ///
+    /// @param workerCount The number of workers, 0 to use one per hardware thread.
+    ThreadPool(std::size_t workerCount = 0U) noexcept;
+
+    /// @brief No copy construction allowed.
+    ThreadPool(ThreadPool const &) = delete;
+
+    /// @brief No move construction allowed.
+    ThreadPool(ThreadPool &&) = delete;
+
+    /// @brief No copy assignment allowed.
+    ThreadPool &operator=(ThreadPool const &) = delete;
+
+    /// @brief No move assignment allowed.
+    ThreadPool &operator=(ThreadPool &&) = delete;
+
+    /// @brief Shuts the pool down.
+    ~ThreadPool() noexcept;
+
+    /// @brief Returns the number of workers.
+    ///
+    /// @return The number of workers.
+    std::size_t workerCount() const noexcept { return _workers.size(); }
+
+    /// @brief Submits a function to be executed by the pool.
+    ///
+    /// @tparam TFunction The type of the function.
+    /// @param function The function to execute.
+    /// @return The future of the result.
+    /// @remarks Executes the function right away if the pool has been shut down.
+    template <typename TFunction>
+    auto submit(TFunction &&function) noexcept -> TaskFuture<std::invoke_result_t<std::decay_t<TFunction>>>
+    {
+        using Function = std::decay_t<TFunction>;
+        using Result   = std::invoke_result_t<Function>;
+
+        auto state = std::make_shared<Internal::FutureState<Result>>();
+        schedule(new Internal::SubmittedJob<Function, Result>(Function{std::forward<TFunction>(function)}, state));
+        return TaskFuture<Result>{this, std::move(state)};
+    }
+
+    /// @brief Hands a function to the pool without waiting for it, saving the allocation of a future.
+    ///
+    /// @tparam TFunction The type of the function.
+    /// @param function The function to execute.
+    /// @remarks Executes the function right away if the pool has been shut down.
+    template <typename TFunction>
+    void post(TFunction &&function) noexcept
+    {
+        using Function = std::decay_t<TFunction>;
+        schedule(new Internal::PostedJob<Function>(Function{std::forward<TFunction>(function)}));
+    }
+
+    /// @brief Calls the body for each index of the range, splitting the range recursively between the workers.
+    ///
+    /// @tparam TBody The type of the body, called with a std::size_t.
+    /// @param begin The first index of the range.
+    /// @param end The index after the last index of the range.
+    /// @param body The body to call for each index.
+    /// @param grainSize The number of indices below which a range is no longer split, 0 to derive it from the size.
+    /// @remarks Returns once the body has been called for all indices, the calling thread takes part in the work.
+    template <typename TBody>
+    void
+    parallelFor(std::size_t const begin, std::size_t const end, TBody const &body, std::size_t grainSize = 0U) noexcept
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+        if (grainSize == 0U)
+        {
+            // a few chunks per worker leave room for balancing without drowning in jobs
+            grainSize = std::max<std::size_t>((end - begin) / (8U * std::max<std::size_t>(workerCount(), 1U)), 1U);
+        }
+        split(begin, end, grainSize, body);
+    }
+
+    /// @brief Calls the body for each position of the range, splitting the range by lines between the workers.
+    ///
+    /// @tparam TBody The type of the body, called with a Range2D::Position.
+    /// @param range The range to iterate.
+    /// @param body The body to call for each position.
+    /// @param grainSize The number of lines below which the range is no longer split, 0 to derive it from the size.
+    template <typename TBody>
+    void parallelFor(Range2D const &range, TBody const &body, std::size_t const grainSize = 0U) noexcept
+    {
+        auto const width = range.width();
+
+        auto const line = [width, &body](std::size_t const y) noexcept {
+            Range2D::Position position{};
+            position.index = y * width;
+            position.y     = static_cast<std::uint32_t>(y);
+            for (position.x = 0U; position.x < width; ++position.x, ++position.index)
+            {
+                body(position);
+            }
+        };
+        parallelFor(0U, range.height(), line, grainSize);
+    }
+
+    /// @brief Executes a single pending job, if there is one.
+    ///
+    /// @return True if a job has been executed, false otherwise.
+    /// @remarks Used to help out while waiting, workers prefer the jobs of their own deque.
+    bool runPendingJob() noexcept;
+
+    /// @brief Executes all jobs left and stops the workers.
+    ///
+    /// @remarks Jobs submitted afterwards are executed right away by the submitting thread.
+    void shutdown() noexcept;
+
+private:
+    /// @brief A single worker of the pool.
+    struct Worker
+    {
+        /// @brief The thread of the worker.
+        WorkerThread thread{};
+
+        /// @brief The jobs of the worker.
+        Internal::WorkStealingDeque deque{};
+
+        /// @brief Set while the worker is waiting for jobs.
+        std::atomic_bool idle{};
+    };
+
+    /// @brief Splits the range in halves until it is small enough, handing the upper halves to the pool.
+    ///
+    /// @tparam TBody The type of the body, called with a std::size_t.
+    /// @param begin The first index of the range.
+    /// @param end The index after the last index of the range.
+    /// @param grainSize The number of indices below which a range is no longer split.
+    /// @param body The body to call for each index.
+    template <typename TBody>
+    void split(std::size_t const begin, std::size_t const end, std::size_t const grainSize, TBody const &body) noexcept
+    {
+        if ((end - begin) <= grainSize)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                body(i);
+            }
+            return;
+        }
+        auto const middle = begin + ((end - begin) / 2U);
+        auto       upper  = submit([this, middle, end, grainSize, &body]() noexcept {
+            split(middle, end, grainSize, body);
+        });
+        split(begin, middle, grainSize, body);
+        upper.wait();
+    }
+
+    /// @brief Hands a job to the pool.
+    ///
+    /// @param job The job, owned by the pool from now on.
+    void schedule(Internal::PoolJob *job) noexcept;
+
+    /// @brief Finds a pending job, first in the deque of the given worker, then in the other deques and the queue.
+    ///
+    /// @param self The index of the calling worker, workerCount() if not called by a worker.
+    /// @return The job, nullptr if there is none.
+    Internal::PoolJob *findJob(std::size_t self) noexcept;
+
+    /// @brief Wakes up an idle worker, if there is one.
+    void wakeUpIdleWorker() noexcept;
+
+    /// @brief The loop executed by each worker.
+    ///
+    /// @param self The index of the worker.
+    void work(std::size_t self) noexcept;
+
+    /// @brief The workers of the pool.
+    std::vector<std::unique_ptr<Worker>> _workers{};
+
+    /// @brief The mutex protecting the injection queue.
+    std::mutex _injectionMutex{};
+
+    /// @brief The queue of jobs submitted from outside the pool.
+    std::deque<Internal::PoolJob *> _injection{};
+
+    /// @brief The number of jobs waiting in the deques and the injection queue.
+    std::atomic<std::size_t> _pending{};
+
+    /// @brief The number of workers waiting for jobs.
+    std::atomic<std::size_t> _idleWorkers{};
+
+    /// @brief Set once the pool has been shut down, guarded by the injection mutex.
+    bool _stopped{};
+};
+
+template <typename T>
+void TaskFuture<T>::wait() const noexcept
+{
+    if (!valid())
+    {
+        return;
+    }
+    while (!_state->ready.load(std::memory_order_acquire))
+    {
+        if (!_pool->runPendingJob())
+        {
+            // nothing left to help with, the job is being executed by another thread
+            _state->ready.wait(false, std::memory_order_acquire);
+        }
+    }
+}
+
+} // namespace Terrahertz
+
+#endif // !THZ_COMMON_UTILITY_THREADPOOL_HPP
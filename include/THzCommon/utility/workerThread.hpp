@@ -1,3 +1,6 @@
+#ifndef THZ_COMMON_UTILITY_WORKERTHREAD_HPP
+#define THZ_COMMON_UTILITY_WORKERTHREAD_HPP
+
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
@@ -35,3 +38,5 @@ struct WorkerThread
         }
     }
 };
+
+#endif // !THZ_COMMON_UTILITY_WORKERTHREAD_HPP
@@ -0,0 +1,395 @@
+#include "THzCommon/converter/octreequantizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <queue>
+#include <type_traits>
+#include <utility>
+
+namespace Terrahertz {
+namespace {
+
+/// @brief Marks a cluster without a parent.
+constexpr std::uint32_t NoParent{0xFFFFFFFFU};
+
+/// @brief A node of the color tree holding pixels, summing up the bins below it.
+struct Cluster
+{
+    /// @brief The number of pixels in the cluster.
+    std::uint64_t count{};
+
+    /// @brief The sum of the first channel of the pixels.
+    std::uint64_t red{};
+
+    /// @brief The sum of the second channel of the pixels.
+    std::uint64_t green{};
+
+    /// @brief The sum of the third channel of the pixels.
+    std::uint64_t blue{};
+
+    /// @brief The index of the parent cluster.
+    std::uint32_t parent{NoParent};
+
+    /// @brief The number of child clusters not merged into this one yet, 0 if this cluster is a leaf.
+    std::uint32_t children{};
+};
+
+/// @brief How the rows of an image are split into jobs.
+struct Tiling
+{
+    /// @brief The number of rows per job, a multiple of the rows of a tile.
+    std::uint32_t rowsPerChunk{};
+
+    /// @brief The number of jobs.
+    size_t chunks{};
+};
+
+/// @brief Splits the rows of an image into tiles of up to TileRows rows and the tiles into jobs.
+///
+/// @param pool The pool running the jobs, may be nullptr.
+/// @param width The width of the image [pixels].
+/// @param height The height of the image [pixels].
+/// @return The tiling of the image.
+Tiling createTiling(ThreadPool const *const pool, std::uint32_t const width, std::uint32_t const height) noexcept
+{
+    auto const maxRows = static_cast<std::uint32_t>(std::max(OctreeQuantizer::MaxChunkPixels / width, size_t{1U}));
+
+    auto const rows   = std::min({OctreeQuantizer::TileRows, height, maxRows});
+    auto const tiles  = (height + rows - 1U) / rows;
+    auto const wanted = (pool != nullptr) ? std::max(pool->workerCount() * 4U, size_t{1U}) : size_t{1U};
+    auto const fit    = std::max(maxRows / rows, 1U);
+    auto const spread = static_cast<std::uint32_t>((tiles + wanted - 1U) / wanted);
+
+    Tiling tiling{};
+    tiling.rowsPerChunk = std::min(spread, fit) * rows;
+    tiling.chunks       = (height + tiling.rowsPerChunk - 1U) / tiling.rowsPerChunk;
+    return tiling;
+}
+
+/// @brief Returns the pixels of the rows of a job.
+///
+/// @param tiling The tiling of the image.
+/// @param chunk The index of the job.
+/// @param width The width of the image [pixels].
+/// @param height The height of the image [pixels].
+/// @return The index of the first pixel and the number of pixels of the job.
+/// @remarks The rows are stored one after another, so the pixels of a job are contiguous and visited in memory order.
+std::pair<size_t, size_t> chunkPixels(Tiling const       &tiling,
+                                      size_t const        chunk,
+                                      std::uint32_t const width,
+                                      std::uint32_t const height) noexcept
+{
+    auto const firstRow = static_cast<std::uint32_t>(chunk * tiling.rowsPerChunk);
+    auto const rows     = std::min(tiling.rowsPerChunk, height - firstRow);
+    return {size_t{firstRow} * width, size_t{rows} * width};
+}
+
+/// @brief Returns the index of the histogram bin of the given color.
+///
+/// @param red The first channel of the color.
+/// @param green The second channel of the color.
+/// @param blue The third channel of the color.
+/// @return The index of the bin.
+inline size_t binIndex(std::uint8_t const red, std::uint8_t const green, std::uint8_t const blue) noexcept
+{
+    constexpr auto Shift = 8U - OctreeQuantizer::BinBits;
+    return (size_t{red} >> Shift) << (2U * OctreeQuantizer::BinBits) |
+           (size_t{green} >> Shift) << OctreeQuantizer::BinBits | (size_t{blue} >> Shift);
+}
+
+/// @brief Calls the function with the number of bytes per pixel, as a constant for the common formats.
+///
+/// @tparam TFunction The type of the function, called with the number of bytes per pixel.
+/// @param bytesPerPixel The number of bytes per pixel.
+/// @param function The function to call.
+/// @remarks A constant stride lets the compiler unroll the loops over the pixels of RGB and RGBA images.
+template <typename TFunction>
+void withStride(std::uint32_t const bytesPerPixel, TFunction const &function) noexcept
+{
+    switch (bytesPerPixel)
+    {
+    case 3U:
+        function(std::integral_constant<std::uint32_t, 3U>{});
+        break;
+    case 4U:
+        function(std::integral_constant<std::uint32_t, 4U>{});
+        break;
+    default:
+        function(bytesPerPixel);
+        break;
+    }
+}
+
+/// @brief Checks the parameters describing the pixels of an image.
+///
+/// @param pixels The pixels of the image.
+/// @param width The width of the image [pixels].
+/// @param height The height of the image [pixels].
+/// @param bytesPerPixel The number of bytes per pixel.
+/// @return True if the parameters are valid, false otherwise.
+bool checkImage(gsl::span<std::uint8_t const> const pixels,
+                std::uint32_t const                 width,
+                std::uint32_t const                 height,
+                std::uint32_t const                 bytesPerPixel) noexcept
+{
+    return (width != 0U) && (height != 0U) && (bytesPerPixel >= 3U) &&
+           (size_t{width} <= OctreeQuantizer::MaxChunkPixels) &&
+           (pixels.size() / bytesPerPixel >= size_t{width} * height);
+}
+
+/// @brief Adds the node and its children holding pixels to the clusters.
+///
+/// @tparam TNode The type of the node.
+/// @param node The node to add.
+/// @param parent The index of the cluster of the parent node.
+/// @param clusters Output: The clusters.
+template <typename TNode>
+void flatten(TNode const &node, std::uint32_t const parent, std::vector<Cluster> &clusters) noexcept
+{
+    auto const index = static_cast<std::uint32_t>(clusters.size());
+    clusters.emplace_back().parent = parent;
+    if (node.getChildNodes().empty())
+    {
+        auto sum = [&](auto const &entry) noexcept {
+            auto &cluster = clusters[index];
+            cluster.count += entry.value.count;
+            cluster.red += entry.value.red;
+            cluster.green += entry.value.green;
+            cluster.blue += entry.value.blue;
+        };
+        node.analyzeEntries(sum);
+    }
+    for (auto const &child : node.getChildNodes())
+    {
+        if (child.totalEntries() == 0U)
+        {
+            continue;
+        }
+        auto const childIndex = static_cast<std::uint32_t>(clusters.size());
+        flatten(child, index, clusters);
+        auto &cluster = clusters[index];
+        cluster.count += clusters[childIndex].count;
+        cluster.red += clusters[childIndex].red;
+        cluster.green += clusters[childIndex].green;
+        cluster.blue += clusters[childIndex].blue;
+        ++cluster.children;
+    }
+}
+
+} // namespace
+
+OctreeQuantizer::OctreeQuantizer(ThreadPool *const pool) noexcept : _pool{pool}, _bins(BinCount), _lookup(BinCount) {}
+
+bool OctreeQuantizer::addPixels(gsl::span<std::uint8_t const> const pixels,
+                                std::uint32_t const                 width,
+                                std::uint32_t const                 height,
+                                std::uint32_t const                 bytesPerPixel) noexcept
+{
+    if (!checkImage(pixels, width, height, bytesPerPixel))
+    {
+        return false;
+    }
+    auto const tiling = createTiling(_pool, width, height);
+    if (_partialBins.size() < tiling.chunks)
+    {
+        _partialBins.resize(tiling.chunks);
+    }
+
+    Internal::forEachChunk(_pool, tiling.chunks, [&](size_t const chunk) noexcept {
+        auto &bins = _partialBins[chunk];
+        bins.assign(BinCount, PartialBin{});
+        auto const [first, count] = chunkPixels(tiling, chunk, width, height);
+        withStride(bytesPerPixel, [&](auto const stride) noexcept {
+            auto const *pixel = pixels.data() + first * stride;
+            auto const *end   = pixel + count * stride;
+            for (; pixel != end; pixel += stride)
+            {
+                auto &bin = bins[binIndex(pixel[0U], pixel[1U], pixel[2U])];
+                ++bin.count;
+                bin.red += pixel[0U];
+                bin.green += pixel[1U];
+                bin.blue += pixel[2U];
+            }
+        });
+    });
+
+    // every job sums up its own range of the histogram
+    auto const ranges = (_pool != nullptr) ? std::max(_pool->workerCount(), size_t{1U}) : size_t{1U};
+    Internal::forEachChunk(_pool, ranges, [&](size_t const range) noexcept {
+        auto const end = (BinCount * (range + 1U)) / ranges;
+        for (size_t b = (BinCount * range) / ranges; b < end; ++b)
+        {
+            auto &bin = _bins[b];
+            for (size_t chunk = 0U; chunk < tiling.chunks; ++chunk)
+            {
+                auto const &partial = _partialBins[chunk][b];
+                bin.count += partial.count;
+                bin.red += partial.red;
+                bin.green += partial.green;
+                bin.blue += partial.blue;
+            }
+        }
+    });
+    _pixelCount += size_t{width} * height;
+    return true;
+}
+
+std::uint64_t OctreeQuantizer::pixelCount() const noexcept { return _pixelCount; }
+
+gsl::span<OctreeQuantizer::Color const> OctreeQuantizer::reducePalette(size_t const colors) noexcept
+{
+    _palette.clear();
+    _paletteTree.reset();
+    for (auto &entry : _lookup)
+    {
+        entry.store(Unknown, std::memory_order_relaxed);
+    }
+
+    std::vector<ColorTree::Entry> entries{};
+    for (auto const &bin : _bins)
+    {
+        if (bin.count != 0U)
+        {
+            auto const average = [&](std::uint64_t const sum) noexcept {
+                return static_cast<std::uint8_t>((sum + bin.count / 2U) / bin.count);
+            };
+            entries.emplace_back(ColorTree::Entry{average(bin.red), average(bin.green), average(bin.blue), bin});
+        }
+    }
+    if (entries.empty())
+    {
+        return {};
+    }
+    _colorTree.build(entries, _pool);
+
+    std::vector<Cluster> clusters{};
+    flatten(_colorTree, NoParent, clusters);
+
+    // fold the least populated leaf into its parent, which becomes a leaf once all its children are folded
+    using Candidate = std::pair<std::uint64_t, std::uint32_t>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> leaves{};
+    for (std::uint32_t i = 0U; i < clusters.size(); ++i)
+    {
+        if (clusters[i].children == 0U)
+        {
+            leaves.emplace(clusters[i].count, i);
+        }
+    }
+    auto const target = std::clamp(colors, size_t{1U}, MaxColors);
+    while (leaves.size() > target)
+    {
+        auto const leaf   = leaves.top().second;
+        auto const parent = clusters[leaf].parent;
+        leaves.pop();
+        if (--clusters[parent].children == 0U)
+        {
+            leaves.emplace(clusters[parent].count, parent);
+        }
+    }
+
+    std::vector<std::uint32_t> remaining{};
+    for (; !leaves.empty(); leaves.pop())
+    {
+        remaining.emplace_back(leaves.top().second);
+    }
+    std::sort(remaining.begin(), remaining.end());
+    for (auto const index : remaining)
+    {
+        auto const &cluster = clusters[index];
+        auto const  average = [&](std::uint64_t const sum) noexcept {
+            return static_cast<std::uint8_t>((sum + cluster.count / 2U) / cluster.count);
+        };
+        auto const color = Color{average(cluster.red), average(cluster.green), average(cluster.blue)};
+        _paletteTree.addEntry(color.red, color.green, color.blue, static_cast<std::uint8_t>(_palette.size()));
+        _palette.emplace_back(color);
+    }
+    _paletteTree.recalculate();
+
+    // look up the bins counted by their average colors, as those are most likely to be mapped
+    auto const ranges = (_pool != nullptr) ? std::max(_pool->workerCount(), size_t{1U}) : size_t{1U};
+    Internal::forEachChunk(_pool, ranges, [&](size_t const range) noexcept {
+        auto const end = (entries.size() * (range + 1U)) / ranges;
+        for (size_t i = (entries.size() * range) / ranges; i < end; ++i)
+        {
+            auto const &entry = entries[i];
+            lookup(binIndex(entry.x, entry.y, entry.z), entry.x, entry.y, entry.z);
+        }
+    });
+    return palette();
+}
+
+gsl::span<OctreeQuantizer::Color const> OctreeQuantizer::palette() const noexcept { return {_palette}; }
+
+bool OctreeQuantizer::mapPixels(gsl::span<std::uint8_t const> const pixels,
+                                std::uint32_t const                 width,
+                                std::uint32_t const                 height,
+                                std::uint32_t const                 bytesPerPixel,
+                                gsl::span<std::uint8_t> const       indices) noexcept
+{
+    if (_palette.empty() || !checkImage(pixels, width, height, bytesPerPixel) ||
+        (indices.size() < size_t{width} * height))
+    {
+        return false;
+    }
+    constexpr auto Shift  = 8U - BinBits;
+    constexpr auto Center = std::uint8_t{1U << (Shift - 1U)};
+
+    auto const center = [](std::uint8_t const channel) noexcept {
+        return static_cast<std::uint8_t>(((channel >> Shift) << Shift) | Center);
+    };
+
+    auto const tiling = createTiling(_pool, width, height);
+    Internal::forEachChunk(_pool, tiling.chunks, [&](size_t const chunk) noexcept {
+        auto const [first, count] = chunkPixels(tiling, chunk, width, height);
+        withStride(bytesPerPixel, [&](auto const stride) noexcept {
+            auto const *pixel  = pixels.data() + first * stride;
+            auto       *output = indices.data() + first;
+            for (auto const *end = output + count; output != end; ++output, pixel += stride)
+            {
+                auto const bin   = binIndex(pixel[0U], pixel[1U], pixel[2U]);
+                auto const index = _lookup[bin].load(std::memory_order_relaxed);
+                *output          = (index != Unknown)
+                                       ? static_cast<std::uint8_t>(index)
+                                       : lookup(bin, center(pixel[0U]), center(pixel[1U]), center(pixel[2U]));
+            }
+        });
+    });
+    return true;
+}
+
+std::uint8_t OctreeQuantizer::paletteIndex(Color const color) noexcept
+{
+    if (_palette.empty())
+    {
+        return 0U;
+    }
+    std::array<PaletteTree::Neighbour, 1U> nearest{};
+    _paletteTree.queryNearest(color.red, color.green, color.blue, nearest);
+    return nearest[0U].entry.value;
+}
+
+void OctreeQuantizer::reset() noexcept
+{
+    std::fill(_bins.begin(), _bins.end(), Bin{});
+    _pixelCount = 0U;
+}
+
+std::uint8_t OctreeQuantizer::lookup(size_t const       bin,
+                                     std::uint8_t const red,
+                                     std::uint8_t const green,
+                                     std::uint8_t const blue) noexcept
+{
+    // racing jobs find the same color, so the order of the stores does not matter
+    auto const index = _lookup[bin].load(std::memory_order_relaxed);
+    if (index != Unknown)
+    {
+        return static_cast<std::uint8_t>(index);
+    }
+    std::array<PaletteTree::Neighbour, 1U> nearest{};
+    _paletteTree.queryNearest(red, green, blue, nearest);
+    _lookup[bin].store(nearest[0U].entry.value, std::memory_order_relaxed);
+    return nearest[0U].entry.value;
+}
+
+} // namespace Terrahertz
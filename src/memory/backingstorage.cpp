@@ -0,0 +1,256 @@
+#include "THzCommon/memory/backingstorage.hpp"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <array>
+#include <climits>
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Terrahertz {
+
+BackingStorage::BackingStorage(BackingStorage &&other) noexcept
+    : _data{std::exchange(other._data, nullptr)}, _size{std::exchange(other._size, 0U)}, _applied{other._applied}
+{}
+
+BackingStorage &BackingStorage::operator=(BackingStorage &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        _data    = std::exchange(other._data, nullptr);
+        _size    = std::exchange(other._size, 0U);
+        _applied = other._applied;
+    }
+    return *this;
+}
+
+BackingStorage::~BackingStorage() noexcept { release(); }
+
+void BackingStorage::accumulate(std::vector<std::size_t> &totals, std::vector<std::size_t> const &resident) noexcept
+{
+    try
+    {
+        if (totals.size() < resident.size())
+        {
+            totals.resize(resident.size());
+        }
+        for (std::size_t node = 0U; node < resident.size(); ++node)
+        {
+            totals[node] += resident[node];
+        }
+    }
+    catch (...)
+    {}
+}
+
+#ifdef __linux__
+
+/// @brief Returns the size of the regular pages of the system.
+///
+/// @return The size of a page [bytes].
+static std::size_t regularPageSize() noexcept
+{
+    static auto const pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return pageSize;
+}
+
+/// @brief Rounds the given size up to a multiple of the given page size.
+///
+/// @param size The size to round [bytes].
+/// @param pageSize The size of a page [bytes].
+/// @return The rounded size [bytes].
+static std::size_t roundUp(std::size_t const size, std::size_t const pageSize) noexcept
+{
+    return ((std::max<std::size_t>(size, 1U) + pageSize - 1U) / pageSize) * pageSize;
+}
+
+/// @brief Maps anonymous memory.
+///
+/// @param size The size of the mapping [bytes].
+/// @param flags Additional flags for the mapping.
+/// @return The start of the mapping, nullptr if mapping failed.
+static char *mapAnonymous(std::size_t const size, int const flags) noexcept
+{
+    auto const region = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    return (region == MAP_FAILED) ? nullptr : static_cast<char *>(region);
+}
+
+/// @brief Maps a region aligned to the size of a huge page, so the kernel can back all of it with huge pages.
+///
+/// @param size The size of the region, a multiple of the huge page size [bytes].
+/// @return The start of the region, nullptr if mapping failed.
+static char *mapHugeAligned(std::size_t const size) noexcept
+{
+    auto const region = mapAnonymous(size + BackingStorage::HugePageSize, 0);
+    if (region == nullptr)
+    {
+        return nullptr;
+    }
+    // the surplus in front of and behind the aligned part is given back right away
+    auto const address = reinterpret_cast<std::uintptr_t>(region);
+    auto const aligned = (address + BackingStorage::HugePageSize - 1U) & ~(BackingStorage::HugePageSize - 1U);
+    auto const front   = static_cast<std::size_t>(aligned - address);
+    if (front != 0U)
+    {
+        ::munmap(region, front);
+    }
+    if (front != BackingStorage::HugePageSize)
+    {
+        ::munmap(region + front + size, BackingStorage::HugePageSize - front);
+    }
+    return region + front;
+}
+
+/// @brief Binds the given region to a NUMA node, before any of its pages have been touched.
+///
+/// @param data The start of the region.
+/// @param size The size of the region [bytes].
+/// @param node The node to bind the region to.
+/// @return True if the region was bound, false otherwise.
+static bool bindToNode(char *const data, std::size_t const size, int const node) noexcept
+{
+    constexpr auto BitsPerWord = sizeof(unsigned long) * CHAR_BIT;
+    constexpr auto Words       = 16U;
+    if ((node < 0) || (static_cast<std::size_t>(node) >= (Words * BitsPerWord)))
+    {
+        return false;
+    }
+    std::array<unsigned long, Words> mask{};
+    auto const                       bit = static_cast<std::size_t>(node);
+    mask[bit / BitsPerWord] |= 1UL << (bit % BitsPerWord);
+    return ::syscall(SYS_mbind, data, size, MPOL_BIND, mask.data(), Words * BitsPerWord + 1U, 0U) == 0;
+}
+
+BackingStorage::BackingStorage(std::size_t const size, StoragePolicy const &policy) noexcept
+{
+    if (policy.pages == PageKind::Huge)
+    {
+        _size = roundUp(size, HugePageSize);
+        _data = mapAnonymous(_size, MAP_HUGETLB);
+        if (_data != nullptr)
+        {
+            _applied.pages = PageKind::Huge;
+        }
+    }
+    if ((_data == nullptr) && (policy.pages != PageKind::Regular))
+    {
+        _size = roundUp(size, HugePageSize);
+        _data = mapHugeAligned(_size);
+        if ((_data != nullptr) && (::madvise(_data, _size, MADV_HUGEPAGE) == 0))
+        {
+            _applied.pages = PageKind::TransparentHuge;
+        }
+    }
+    if (_data == nullptr)
+    {
+        _size = roundUp(size, regularPageSize());
+        _data = mapAnonymous(_size, 0);
+    }
+    if (_data == nullptr)
+    {
+        _size = 0U;
+        return;
+    }
+
+    // binding has to happen before pinning faults in the pages
+    if ((policy.numaNode >= 0) && bindToNode(_data, _size, policy.numaNode))
+    {
+        _applied.numaNode = policy.numaNode;
+    }
+    if (policy.locked && (::mlock(_data, _size) == 0))
+    {
+        _applied.locked = true;
+    }
+}
+
+void BackingStorage::release() noexcept
+{
+    if (_data != nullptr)
+    {
+        ::munmap(_data, _size);
+        _data = nullptr;
+        _size = 0U;
+    }
+}
+
+std::vector<std::size_t> BackingStorage::residentPerNode() const noexcept
+{
+    constexpr std::size_t BatchSize{1024U};
+
+    std::vector<std::size_t> result{};
+    auto const               step = (_applied.pages == PageKind::Huge) ? HugePageSize : regularPageSize();
+    try
+    {
+        std::array<void *, BatchSize> pages{};
+        std::array<int, BatchSize>    status{};
+        for (std::size_t offset = 0U; offset < _size;)
+        {
+            std::size_t count{};
+            for (; (count < BatchSize) && (offset < _size); ++count, offset += step)
+            {
+                pages[count] = _data + offset;
+            }
+            // without target nodes the call only reports where the pages are
+            if (::syscall(SYS_move_pages, 0, count, pages.data(), nullptr, status.data(), 0) != 0)
+            {
+                return {};
+            }
+            for (std::size_t i = 0U; i < count; ++i)
+            {
+                if (status[i] < 0)
+                {
+                    continue;
+                }
+                auto const node = static_cast<std::size_t>(status[i]);
+                if (result.size() <= node)
+                {
+                    result.resize(node + 1U);
+                }
+                result[node] += step;
+            }
+        }
+    }
+    catch (...)
+    {
+        return {};
+    }
+    return result;
+}
+
+std::size_t BackingStorage::mappedSize(std::size_t const size, StoragePolicy const &policy) noexcept
+{
+    return roundUp(size, (policy.pages == PageKind::Regular) ? regularPageSize() : HugePageSize);
+}
+
+#else
+
+BackingStorage::BackingStorage(std::size_t const size, StoragePolicy const &) noexcept
+{
+    _data = static_cast<char *>(::operator new(size, std::align_val_t{64U}, std::nothrow));
+    _size = (_data != nullptr) ? size : 0U;
+}
+
+void BackingStorage::release() noexcept
+{
+    if (_data != nullptr)
+    {
+        ::operator delete(_data, std::align_val_t{64U});
+        _data = nullptr;
+        _size = 0U;
+    }
+}
+
+std::vector<std::size_t> BackingStorage::residentPerNode() const noexcept { return {}; }
+
+std::size_t BackingStorage::mappedSize(std::size_t const size, StoragePolicy const &) noexcept { return size; }
+
+#endif // !__linux__
+
+} // namespace Terrahertz
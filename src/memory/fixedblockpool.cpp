@@ -0,0 +1,138 @@
+#include "THzCommon/memory/fixedblockpool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <new>
+
+namespace Terrahertz {
+
+/// @brief Rounds the given block size up to the next multiple of the fundamental alignment.
+///
+/// @param blockSize The requested size of a block [bytes].
+/// @return The size of a block keeping every block aligned [bytes].
+static std::size_t alignedBlockSize(std::size_t const blockSize) noexcept
+{
+    constexpr auto Alignment = alignof(std::max_align_t);
+    return std::max(((blockSize + Alignment - 1U) / Alignment) * Alignment, Alignment);
+}
+
+FixedBlockPool::FixedBlockPool(std::size_t const   blockSize,
+                               std::size_t const   blockCount,
+                               StoragePolicy const &policy) noexcept(false)
+    : _blockSize{alignedBlockSize(blockSize)}, _blockCount{blockCount}
+{
+    // neither rounding up the block size nor the size of the arena may overflow
+    constexpr auto Limit = std::numeric_limits<std::size_t>::max();
+    if ((_blockCount > MaxBlockCount) || (blockSize > (Limit - alignof(std::max_align_t))) ||
+        ((_blockCount != 0U) && (_blockSize > (Limit / _blockCount))))
+    {
+        throw std::bad_alloc{};
+    }
+    _links   = std::make_unique<std::atomic<std::uint32_t>[]>(_blockCount);
+    _storage = BackingStorage{_blockSize * _blockCount, policy};
+    if (!_storage.good())
+    {
+        throw std::bad_alloc{};
+    }
+    _arena = _storage.data();
+
+    // initially every block links to the one behind it
+    for (std::size_t i = 0U; i < _blockCount; ++i)
+    {
+        auto const next = ((i + 1U) < _blockCount) ? static_cast<std::uint32_t>(i + 1U) : NoBlock;
+        _links[i].store(next, std::memory_order_relaxed);
+    }
+    _head.store((_blockCount != 0U) ? 0U : NoBlock, std::memory_order_release);
+}
+
+char *FixedBlockPool::allocate(size_t const n) noexcept(false)
+{
+    if (n > _blockSize)
+    {
+        throw std::bad_alloc{};
+    }
+    auto const block = tryAllocate();
+    if (block == nullptr)
+    {
+        throw std::bad_alloc{};
+    }
+    return block;
+}
+
+char *FixedBlockPool::tryAllocate() noexcept
+{
+    auto head = _head.load(std::memory_order_acquire);
+    for (;;)
+    {
+        auto const index = static_cast<std::uint32_t>(head);
+        if (index == NoBlock)
+        {
+            return nullptr;
+        }
+        // the link may be stale if another thread took the block meanwhile, the tag makes the exchange fail then
+        auto const next = _links[index].load(std::memory_order_relaxed);
+        if (_head.compare_exchange_weak(head, retag(head, next), std::memory_order_acquire, std::memory_order_acquire))
+        {
+            _usedBlocks.fetch_add(1U, std::memory_order_relaxed);
+            return _arena + (index * _blockSize);
+        }
+    }
+}
+
+void FixedBlockPool::deallocate(char *const p, size_t const) noexcept
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+
+    // a foreign or misaligned pointer would corrupt the list of free blocks, so it is never linked
+    auto const owned  = owns(p);
+    auto const offset = owned ? static_cast<std::size_t>(p - _arena) : 0U;
+    assert(owned && "The block does not belong to the pool.");
+    assert(((offset % _blockSize) == 0U) && "The pointer is not the start of a block.");
+    if (!owned || ((offset % _blockSize) != 0U))
+    {
+        return;
+    }
+    auto const index = static_cast<std::uint32_t>(offset / _blockSize);
+    _usedBlocks.fetch_sub(1U, std::memory_order_relaxed);
+
+    auto head = _head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        _links[index].store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+        if (_head.compare_exchange_weak(head, retag(head, index), std::memory_order_release, std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+}
+
+size_t FixedBlockPool::usedSpace() const noexcept { return usedBlocks() * _blockSize; }
+
+size_t FixedBlockPool::totalSpace() const noexcept { return _blockCount * _blockSize; }
+
+std::size_t FixedBlockPool::blockSize() const noexcept { return _blockSize; }
+
+std::size_t FixedBlockPool::blockCount() const noexcept { return _blockCount; }
+
+std::size_t FixedBlockPool::usedBlocks() const noexcept { return _usedBlocks.load(std::memory_order_relaxed); }
+
+bool FixedBlockPool::owns(char const *const p) const noexcept
+{
+    return (p >= _arena) && (p < (_arena + (_blockCount * _blockSize)));
+}
+
+BackingStorage const &FixedBlockPool::storage() const noexcept { return _storage; }
+
+std::vector<std::size_t> FixedBlockPool::residentPerNode() const noexcept { return _storage.residentPerNode(); }
+
+std::uint64_t FixedBlockPool::retag(std::uint64_t const head, std::uint32_t const index) noexcept
+{
+    auto const tag = (head >> 32U) + 1U;
+    return (tag << 32U) | index;
+}
+
+} // namespace Terrahertz
@@ -0,0 +1,288 @@
+#include "THzCommon/memory/instrumentedpool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <string_view>
+
+namespace Terrahertz {
+namespace {
+
+#ifdef NDEBUG
+/// @brief Outstanding allocations are only tracked in debug builds.
+constexpr bool TrackAllocations{false};
+#else
+/// @brief Outstanding allocations are only tracked in debug builds.
+constexpr bool TrackAllocations{true};
+#endif
+
+/// @brief Returns the bucket of the size histogram counting the given size.
+///
+/// @param n The size of the allocation [bytes].
+/// @return The index of the bucket.
+std::size_t sizeBucket(std::size_t const n) noexcept
+{
+    return (n <= 1U) ? 0U : static_cast<std::size_t>(std::bit_width(n - 1U));
+}
+
+/// @brief Returns the current time of the steady clock.
+///
+/// @return The nanoseconds since the epoch of the steady clock.
+std::int64_t now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// @brief Formats the given call site.
+///
+/// @param location The call site to format.
+/// @return The formatted call site.
+std::string describe(std::source_location const &location) noexcept
+{
+    if (location.line() == 0U)
+    {
+        return "unknown call site";
+    }
+    std::string text{location.file_name()};
+    text += '(';
+    text += std::to_string(location.line());
+    text += ':';
+    text += std::to_string(location.column());
+    text += ") ";
+    text += location.function_name();
+    return text;
+}
+
+/// @brief Checks if both locations denote the same call site.
+///
+/// @param lhs The first location.
+/// @param rhs The second location.
+/// @return True if both are the same call site, false otherwise.
+bool sameSite(std::source_location const &lhs, std::source_location const &rhs) noexcept
+{
+    return (lhs.line() == rhs.line()) && (lhs.column() == rhs.column()) &&
+           (std::string_view{lhs.file_name()} == std::string_view{rhs.file_name()});
+}
+
+} // namespace
+
+double PoolStatistics::allocationRate() const noexcept
+{
+    if (elapsed.count() <= 0)
+    {
+        return 0.0;
+    }
+    return static_cast<double>(allocations) / std::chrono::duration<double>(elapsed).count();
+}
+
+bool InstrumentedPool::tracksAllocations() noexcept { return TrackAllocations; }
+
+InstrumentedPool::InstrumentedPool(IMemoryPool &pool, Logger &logger) noexcept
+    : _pool{pool}, _logger{logger}, _start{now()}
+{}
+
+InstrumentedPool::~InstrumentedPool() noexcept
+{
+    for (auto const &site : snapshot().sites)
+    {
+        std::string text{"leaked "};
+        text += std::to_string(site.bytes) + " bytes in ";
+        text += std::to_string(site.allocations) + " allocations from ";
+        text += describe(site.location);
+        _logger.log<LogLevel::Warning, MemoryProject>(text);
+    }
+}
+
+char *InstrumentedPool::allocate(size_t const n) noexcept(false) { return allocateAt(n, std::source_location{}); }
+
+char *InstrumentedPool::allocateAt(size_t const n, std::source_location const location) noexcept(false)
+{
+    char *p{};
+    try
+    {
+        p = _pool.allocate(n);
+    }
+    catch (...)
+    {
+        _failures.fetch_add(1U, std::memory_order_relaxed);
+        throw;
+    }
+    recordAllocation(p, n, location);
+    return p;
+}
+
+void InstrumentedPool::deallocate(char *const p, size_t const n) noexcept
+{
+    if (p == nullptr)
+    {
+        _pool.deallocate(p, n);
+        return;
+    }
+
+    auto size = n;
+    if constexpr (TrackAllocations)
+    {
+        std::unique_lock lock{_mutex};
+        auto const       iterator = _outstanding.find(p);
+        if (iterator == _outstanding.end())
+        {
+            lock.unlock();
+            // forwarding would corrupt the pool, so the block is dropped
+            _doubleFrees.fetch_add(1U, std::memory_order_relaxed);
+            std::string text{"deallocation of a block not allocated or already deallocated, "};
+            text += std::to_string(n) + " bytes";
+            _logger.log<LogLevel::Error, MemoryProject>(text);
+            return;
+        }
+        auto const allocation = iterator->second;
+        _outstanding.erase(iterator);
+        lock.unlock();
+
+        if (allocation.size != n)
+        {
+            _sizeMismatches.fetch_add(1U, std::memory_order_relaxed);
+            std::string text{"deallocation of "};
+            text += std::to_string(n) + " bytes, allocated with ";
+            text += std::to_string(allocation.size) + " bytes from ";
+            text += describe(allocation.location);
+            _logger.log<LogLevel::Warning, MemoryProject>(text);
+            size = allocation.size;
+        }
+    }
+    _requestedBytes.fetch_sub(size, std::memory_order_relaxed);
+    _deallocations.fetch_add(1U, std::memory_order_relaxed);
+    _pool.deallocate(p, size);
+}
+
+size_t InstrumentedPool::usedSpace() const noexcept { return _pool.usedSpace(); }
+
+size_t InstrumentedPool::totalSpace() const noexcept { return _pool.totalSpace(); }
+
+PoolStatistics InstrumentedPool::snapshot() const noexcept
+{
+    PoolStatistics result{};
+    for (std::size_t i = 0U; i < _sizes.size(); ++i)
+    {
+        result.sizes[i] = _sizes[i].load(std::memory_order_relaxed);
+    }
+    result.allocations        = _allocations.load(std::memory_order_relaxed);
+    result.deallocations      = _deallocations.load(std::memory_order_relaxed);
+    result.failures           = _failures.load(std::memory_order_relaxed);
+    result.doubleFrees        = _doubleFrees.load(std::memory_order_relaxed);
+    result.sizeMismatches     = _sizeMismatches.load(std::memory_order_relaxed);
+    result.requestedBytes     = _requestedBytes.load(std::memory_order_relaxed);
+    result.peakRequestedBytes = _peakRequestedBytes.load(std::memory_order_relaxed);
+    result.usedSpace          = _pool.usedSpace();
+    result.totalSpace         = _pool.totalSpace();
+    result.elapsed            = std::chrono::nanoseconds{now() - _start.load(std::memory_order_relaxed)};
+
+    if constexpr (TrackAllocations)
+    {
+        try
+        {
+            std::lock_guard lock{_mutex};
+            for (auto const &[p, allocation] : _outstanding)
+            {
+                // few call sites allocate from the same pool, a linear search is fast enough
+                auto site = std::find_if(result.sites.begin(), result.sites.end(), [&](AllocationSite const &s) {
+                    return sameSite(s.location, allocation.location);
+                });
+                if (site == result.sites.end())
+                {
+                    site = result.sites.insert(site, AllocationSite{allocation.location});
+                }
+                ++site->allocations;
+                site->bytes += allocation.size;
+            }
+        }
+        catch (...)
+        {}
+        std::sort(result.sites.begin(), result.sites.end(), [](AllocationSite const &a, AllocationSite const &b) {
+            return a.bytes > b.bytes;
+        });
+    }
+    return result;
+}
+
+void InstrumentedPool::reset() noexcept
+{
+    for (auto &bucket : _sizes)
+    {
+        bucket.store(0U, std::memory_order_relaxed);
+    }
+    _allocations.store(0U, std::memory_order_relaxed);
+    _deallocations.store(0U, std::memory_order_relaxed);
+    _failures.store(0U, std::memory_order_relaxed);
+    _doubleFrees.store(0U, std::memory_order_relaxed);
+    _sizeMismatches.store(0U, std::memory_order_relaxed);
+    _peakRequestedBytes.store(_requestedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _start.store(now(), std::memory_order_relaxed);
+}
+
+void InstrumentedPool::recordAllocation(char *const                 p,
+                                        std::size_t const           n,
+                                        std::source_location const &location) noexcept
+{
+    _sizes[sizeBucket(n)].fetch_add(1U, std::memory_order_relaxed);
+    _allocations.fetch_add(1U, std::memory_order_relaxed);
+    auto const requested = _requestedBytes.fetch_add(n, std::memory_order_relaxed) + n;
+    auto       peak      = _peakRequestedBytes.load(std::memory_order_relaxed);
+    while ((peak < requested) && !_peakRequestedBytes.compare_exchange_weak(peak, requested, std::memory_order_relaxed))
+    {}
+
+    if constexpr (TrackAllocations)
+    {
+        try
+        {
+            std::lock_guard lock{_mutex};
+            _outstanding.insert_or_assign(p, Allocation{n, location});
+        }
+        catch (...)
+        {}
+    }
+}
+
+std::string toString(PoolStatistics const &statistics) noexcept
+{
+    std::string text{};
+    text += std::to_string(statistics.allocations) + " allocs, ";
+    text += std::to_string(statistics.deallocations) + " frees, ";
+    text += std::to_string(statistics.failures) + " failures, ";
+    text += std::to_string(static_cast<std::uint64_t>(statistics.allocationRate())) + " allocs/s, ";
+    text += std::to_string(statistics.requestedBytes) + " bytes requested, peak ";
+    text += std::to_string(statistics.peakRequestedBytes) + " bytes, pool ";
+    text += std::to_string(statistics.usedSpace) + "/";
+    text += std::to_string(statistics.totalSpace) + " bytes, ";
+    text += std::to_string(statistics.doubleFrees) + " double frees, ";
+    text += std::to_string(statistics.sizeMismatches) + " size mismatches, sizes";
+    for (std::size_t i = 0U; i < statistics.sizes.size(); ++i)
+    {
+        if (statistics.sizes[i] != 0U)
+        {
+            // the last bucket covers 2^64, which does not fit into the type
+            text += (i < 64U) ? " <=" + std::to_string(std::uint64_t{1U} << i) : std::string{" >2^63"};
+            text += ": " + std::to_string(statistics.sizes[i]);
+        }
+    }
+    return text;
+}
+
+void logStatistics(PoolStatistics const &statistics, std::string_view const poolName, Logger &logger) noexcept
+{
+    std::string text{poolName};
+    text += ' ';
+    text += toString(statistics);
+    logger.log<LogLevel::Info, MemoryProject>(text);
+
+    for (auto const &site : statistics.sites)
+    {
+        text = poolName;
+        text += ' ';
+        text += std::to_string(site.allocations) + " allocs, ";
+        text += std::to_string(site.bytes) + " bytes from ";
+        text += describe(site.location);
+        logger.log<LogLevel::Info, MemoryProject>(text);
+    }
+}
+
+} // namespace Terrahertz
@@ -0,0 +1,102 @@
+#include "THzCommon/memory/monotonicarena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Terrahertz {
+
+MonotonicArena::MonotonicArena(std::size_t const blockSize, std::size_t const capacity) noexcept
+    : _blockSize{std::max<std::size_t>(blockSize, alignof(std::max_align_t))}, _capacity{capacity}
+{}
+
+MonotonicArena::~MonotonicArena() noexcept { release(); }
+
+char *MonotonicArena::allocate(size_t const n) noexcept(false) { return allocate(n, alignof(std::max_align_t)); }
+
+char *MonotonicArena::allocate(std::size_t const n, std::size_t const alignment) noexcept(false)
+{
+    if (n > (std::numeric_limits<std::size_t>::max() - alignment))
+    {
+        throw std::bad_alloc{};
+    }
+    for (;;)
+    {
+        if (_current != nullptr)
+        {
+            auto const data    = reinterpret_cast<char *>(_current + 1);
+            auto const address = reinterpret_cast<std::uintptr_t>(data + _offset);
+            auto const padding = static_cast<std::size_t>(((address + alignment - 1U) & ~(alignment - 1U)) - address);
+            if ((padding <= (_current->size - _offset)) && (n <= (_current->size - _offset - padding)))
+            {
+                auto const result = data + _offset + padding;
+                _offset += padding + n;
+                _used += padding + n;
+                return result;
+            }
+        }
+        // the data of a block is aligned to std::max_align_t, only larger alignments need padding
+        constexpr auto BlockAlignment = alignof(std::max_align_t);
+        advance(n + ((alignment > BlockAlignment) ? (alignment - BlockAlignment) : 0U));
+    }
+}
+
+void MonotonicArena::deallocate(char *const, size_t const) noexcept {}
+
+size_t MonotonicArena::usedSpace() const noexcept { return _used; }
+
+size_t MonotonicArena::totalSpace() const noexcept { return _reserved; }
+
+MonotonicArena::Marker MonotonicArena::mark() const noexcept { return Marker{_current, _offset, _used}; }
+
+void MonotonicArena::rewind(Marker const &marker) noexcept
+{
+    _current = marker.block;
+    _offset  = marker.offset;
+    _used    = marker.used;
+}
+
+void MonotonicArena::reset() noexcept { rewind(Marker{}); }
+
+void MonotonicArena::release() noexcept
+{
+    while (_first != nullptr)
+    {
+        auto const next = _first->next;
+        ::operator delete(_first);
+        _first = next;
+    }
+    _reserved = 0U;
+    reset();
+}
+
+void MonotonicArena::advance(std::size_t const minimum) noexcept(false)
+{
+    // blocks left behind by a rewind are reused, as long as the allocation fits
+    auto const next = (_current != nullptr) ? _current->next : _first;
+    if ((next != nullptr) && (next->size >= minimum))
+    {
+        _current = next;
+        _offset  = 0U;
+        return;
+    }
+
+    auto const size = std::max(_blockSize, minimum);
+    if ((size > (std::numeric_limits<std::size_t>::max() - sizeof(Block))) || (size > (_capacity - _reserved)))
+    {
+        throw std::bad_alloc{};
+    }
+    auto const block = new (::operator new(sizeof(Block) + size)) Block{next, size};
+    if (_current != nullptr)
+    {
+        _current->next = block;
+    }
+    else
+    {
+        _first = block;
+    }
+    _reserved += size;
+    _current = block;
+    _offset  = 0U;
+}
+
+} // namespace Terrahertz
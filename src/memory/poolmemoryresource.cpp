@@ -0,0 +1,56 @@
+#include "THzCommon/memory/poolmemoryresource.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace Terrahertz {
+
+/// @brief Returns the number of bytes taken from the pool for the given allocation.
+///
+/// @param bytes The number of bytes requested.
+/// @param alignment The alignment requested.
+/// @return The number of bytes to take from the pool.
+static std::size_t pooledSize(std::size_t const bytes, std::size_t const alignment) noexcept
+{
+    return (alignment <= alignof(std::max_align_t)) ? bytes : (bytes + alignment + sizeof(std::size_t));
+}
+
+PoolMemoryResource::PoolMemoryResource(IMemoryPool &pool) noexcept : _pool{&pool} {}
+
+IMemoryPool &PoolMemoryResource::pool() const noexcept { return *_pool; }
+
+void *PoolMemoryResource::do_allocate(std::size_t const bytes, std::size_t const alignment)
+{
+    auto const block = _pool->allocate(pooledSize(bytes, alignment));
+    if (alignment <= alignof(std::max_align_t))
+    {
+        return block;
+    }
+
+    // leaves room for the offset in front of the aligned memory
+    auto const address = reinterpret_cast<std::uintptr_t>(block) + sizeof(std::size_t);
+    auto const offset  = static_cast<std::size_t>(((address + alignment - 1U) & ~(alignment - 1U)) -
+                                                 reinterpret_cast<std::uintptr_t>(block));
+    std::memcpy(block + offset - sizeof(std::size_t), &offset, sizeof(std::size_t));
+    return block + offset;
+}
+
+void PoolMemoryResource::do_deallocate(void *const p, std::size_t const bytes, std::size_t const alignment)
+{
+    auto block = static_cast<char *>(p);
+    if (alignment > alignof(std::max_align_t))
+    {
+        std::size_t offset{};
+        std::memcpy(&offset, block - sizeof(std::size_t), sizeof(std::size_t));
+        block -= offset;
+    }
+    _pool->deallocate(block, pooledSize(bytes, alignment));
+}
+
+bool PoolMemoryResource::do_is_equal(std::pmr::memory_resource const &other) const noexcept
+{
+    auto const resource = dynamic_cast<PoolMemoryResource const *>(&other);
+    return (resource != nullptr) && (resource->_pool == _pool);
+}
+
+} // namespace Terrahertz
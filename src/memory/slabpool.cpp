@@ -0,0 +1,522 @@
+#include "THzCommon/memory/slabpool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <span>
+#include <unordered_map>
+
+namespace Terrahertz {
+namespace Internal {
+
+/// @brief Blocks cached by a single thread, one stack per size class.
+struct Magazine
+{
+    /// @brief The cached blocks per class.
+    std::array<std::array<char *, SlabPool::MagazineSize>, SlabPool::ClassCount> blocks{};
+
+    /// @brief The number of cached blocks per class.
+    std::array<std::size_t, SlabPool::ClassCount> counts{};
+
+    /// @brief The size of the blocks allocated minus the size of those deallocated through this magazine [bytes].
+    std::atomic<std::ptrdiff_t> usedBytes{};
+
+    /// @brief The bytes requested by allocations minus those of deallocations through this magazine [bytes].
+    std::atomic<std::ptrdiff_t> requestedBytes{};
+
+    /// @brief True while a thread uses the magazine.
+    std::atomic_bool owned{};
+};
+
+/// @brief A single size class of a SlabPool.
+struct SizeClass
+{
+    /// @brief Guards the members of the class.
+    std::mutex mutex{};
+
+    /// @brief The first free block, each free block stores the address of the next one.
+    char *freeList{};
+
+    /// @brief The next block to carve from the current slab.
+    char *carveBegin{};
+
+    /// @brief The end of the current slab.
+    char *carveEnd{};
+
+    /// @brief The number of blocks carved from the slabs.
+    std::size_t reservedBlocks{};
+
+    /// @brief The number of blocks handed out to the magazines.
+    std::size_t takenBlocks{};
+
+    /// @brief The largest number of blocks handed out at the same time.
+    std::size_t highWaterBlocks{};
+};
+
+struct SlabPoolState
+{
+    /// @brief Initializes a new state.
+    ///
+    /// @param maximum The maximum amount of memory taken from the system [bytes].
+    /// @param storagePolicy The policy to map the slabs and large allocations with.
+    SlabPoolState(std::size_t const maximum, StoragePolicy const &storagePolicy) noexcept
+        : capacity{maximum}, policy{storagePolicy}
+    {}
+
+    /// @brief The id of the pool, unique for the lifetime of the process.
+    std::uint64_t const id{nextId.fetch_add(1U, std::memory_order_relaxed)};
+
+    /// @brief The maximum amount of memory taken from the system [bytes].
+    std::size_t const capacity;
+
+    /// @brief The policy to map the slabs and large allocations with.
+    StoragePolicy const policy;
+
+    /// @brief The memory taken from the system [bytes].
+    std::atomic<std::size_t> reservedBytes{};
+
+    /// @brief The memory mapped for large allocations [bytes].
+    std::atomic<std::size_t> largeBytes{};
+
+    /// @brief Used bytes of large allocations and of blocks deallocated without magazine [bytes].
+    std::atomic<std::ptrdiff_t> usedBytes{};
+
+    /// @brief Requested bytes of large allocations and of blocks deallocated without magazine [bytes].
+    std::atomic<std::ptrdiff_t> requestedBytes{};
+
+    /// @brief The size classes.
+    std::array<SizeClass, SlabPool::ClassCount> classes{};
+
+    /// @brief Guards the list of slabs.
+    std::mutex slabMutex{};
+
+    /// @brief The slabs taken from the system.
+    std::vector<BackingStorage> slabs{};
+
+    /// @brief Guards the large allocations.
+    std::mutex largeMutex{};
+
+    /// @brief The storage of the large allocations, by their address.
+    std::unordered_map<char *, BackingStorage> large{};
+
+    /// @brief Guards the list of magazines.
+    mutable std::mutex magazineMutex{};
+
+    /// @brief The magazines of all threads that used the pool so far.
+    std::vector<std::unique_ptr<Magazine>> magazines{};
+
+    /// @brief The id of the next pool.
+    static inline std::atomic<std::uint64_t> nextId{};
+};
+
+} // namespace Internal
+
+namespace {
+
+/// @brief The magazine a thread uses for a certain pool.
+struct MagazineClaim
+{
+    /// @brief The id of the pool.
+    std::uint64_t poolId{};
+
+    /// @brief The magazine used by the thread.
+    Internal::Magazine *magazine{};
+
+    /// @brief The state of the pool, to hand back the magazine on exit while the pool is still alive.
+    std::weak_ptr<Internal::SlabPoolState> state{};
+};
+
+/// @brief The magazines claimed by a thread, handed back once the thread exits.
+struct ThreadMagazines
+{
+    /// @brief Hands back the magazines of pools still alive, so other threads can use the cached blocks.
+    ~ThreadMagazines() noexcept
+    {
+        for (auto &claim : claims)
+        {
+            if (auto const state = claim.state.lock())
+            {
+                claim.magazine->owned.store(false, std::memory_order_release);
+            }
+        }
+    }
+
+    /// @brief The magazines claimed by the thread.
+    std::vector<MagazineClaim> claims{};
+};
+
+thread_local ThreadMagazines threadMagazines{};
+
+/// @brief Adds to a counter only the owning thread of a magazine writes to.
+///
+/// @param counter The counter to add to.
+/// @param value The value to add.
+void addOwned(std::atomic<std::ptrdiff_t> &counter, std::ptrdiff_t const value) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/// @brief Returns the magazine of the calling thread for the given pool, claiming one if necessary.
+///
+/// @param state The state of the pool.
+/// @return The magazine of the calling thread.
+/// @exception bad_alloc In case a new magazine could not be allocated.
+Internal::Magazine &magazineOf(std::shared_ptr<Internal::SlabPoolState> const &state) noexcept(false)
+{
+    auto &claims = threadMagazines.claims;
+    for (auto const &claim : claims)
+    {
+        if (claim.poolId == state->id)
+        {
+            return *claim.magazine;
+        }
+    }
+    std::erase_if(claims, [](MagazineClaim const &claim) noexcept { return claim.state.expired(); });
+    claims.reserve(claims.size() + 1U);
+
+    // magazines of threads that exited still hold blocks, so they are reused before creating new ones
+    std::lock_guard<std::mutex> lock{state->magazineMutex};
+    Internal::Magazine         *magazine{};
+    for (auto const &candidate : state->magazines)
+    {
+        bool expected{};
+        if (candidate->owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            magazine = candidate.get();
+            break;
+        }
+    }
+    if (magazine == nullptr)
+    {
+        state->magazines.emplace_back(std::make_unique<Internal::Magazine>());
+        magazine = state->magazines.back().get();
+        magazine->owned.store(true, std::memory_order_relaxed);
+    }
+    claims.emplace_back(MagazineClaim{state->id, magazine, state});
+    return *magazine;
+}
+
+/// @brief Returns the size of the blocks of the given class.
+///
+/// @param index The index of the class.
+/// @return The size of the blocks [bytes].
+constexpr std::size_t blockSizeOf(std::size_t const index) noexcept { return SlabPool::MinClassSize << index; }
+
+/// @brief Reserves memory of the pool, if the capacity allows it.
+///
+/// @param state The state of the pool.
+/// @param bytes The number of bytes to reserve.
+/// @return True if the memory was reserved, false otherwise.
+bool reserve(Internal::SlabPoolState &state, std::size_t const bytes) noexcept
+{
+    auto reserved = state.reservedBytes.load(std::memory_order_relaxed);
+    do
+    {
+        if ((state.capacity < bytes) || (reserved > (state.capacity - bytes)))
+        {
+            return false;
+        }
+    } while (!state.reservedBytes.compare_exchange_weak(reserved, reserved + bytes, std::memory_order_relaxed));
+    return true;
+}
+
+/// @brief Takes a new slab from the system for the given class.
+///
+/// @param state The state of the pool.
+/// @param sizeClass The class to carve the slab for, its mutex has to be locked.
+/// @return True if a slab was taken, false if the capacity or the system ran out of memory.
+/// @exception bad_alloc In case the slab could not be recorded.
+bool takeSlab(Internal::SlabPoolState &state, Internal::SizeClass &sizeClass) noexcept(false)
+{
+    auto const expected = BackingStorage::mappedSize(SlabPool::SlabSize, state.policy);
+    if (!reserve(state, expected))
+    {
+        return false;
+    }
+    BackingStorage slab{SlabPool::SlabSize, state.policy};
+    if (!slab.good())
+    {
+        state.reservedBytes.fetch_sub(expected, std::memory_order_relaxed);
+        return false;
+    }
+    // huge pages falling back to regular ones make the slab smaller than expected
+    state.reservedBytes.fetch_sub(expected - slab.size(), std::memory_order_relaxed);
+
+    auto const data = slab.data();
+    auto const size = slab.size();
+    {
+        std::lock_guard<std::mutex> lock{state.slabMutex};
+        try
+        {
+            state.slabs.emplace_back(std::move(slab));
+        }
+        catch (...)
+        {
+            state.reservedBytes.fetch_sub(size, std::memory_order_relaxed);
+            throw;
+        }
+    }
+    sizeClass.carveBegin = data;
+    sizeClass.carveEnd   = data + size;
+    return true;
+}
+
+/// @brief Fills half of the magazine for the given class from the class.
+///
+/// @param state The state of the pool.
+/// @param index The index of the class.
+/// @param magazine The magazine to fill.
+/// @exception bad_alloc In case not a single block could be taken.
+void refill(Internal::SlabPoolState &state, std::size_t const index, Internal::Magazine &magazine) noexcept(false)
+{
+    auto      &sizeClass = state.classes[index];
+    auto const blockSize = blockSizeOf(index);
+    auto      &count     = magazine.counts[index];
+    {
+        std::lock_guard<std::mutex> lock{sizeClass.mutex};
+        while (count < (SlabPool::MagazineSize / 2U))
+        {
+            auto block = sizeClass.freeList;
+            if (block != nullptr)
+            {
+                std::memcpy(&sizeClass.freeList, block, sizeof(char *));
+            }
+            else
+            {
+                if ((sizeClass.carveBegin == sizeClass.carveEnd) && !takeSlab(state, sizeClass))
+                {
+                    break;
+                }
+                block = sizeClass.carveBegin;
+                sizeClass.carveBegin += blockSize;
+                ++sizeClass.reservedBlocks;
+            }
+            magazine.blocks[index][count++] = block;
+            ++sizeClass.takenBlocks;
+        }
+        sizeClass.highWaterBlocks = std::max(sizeClass.highWaterBlocks, sizeClass.takenBlocks);
+    }
+    if (count == 0U)
+    {
+        throw std::bad_alloc{};
+    }
+}
+
+/// @brief Returns blocks to the free list of the given class.
+///
+/// @param state The state of the pool.
+/// @param index The index of the class.
+/// @param blocks The blocks to return.
+void giveBack(Internal::SlabPoolState &state, std::size_t const index, std::span<char *const> const blocks) noexcept
+{
+    auto                       &sizeClass = state.classes[index];
+    std::lock_guard<std::mutex> lock{sizeClass.mutex};
+    for (auto const block : blocks)
+    {
+        std::memcpy(block, &sizeClass.freeList, sizeof(char *));
+        sizeClass.freeList = block;
+    }
+    sizeClass.takenBlocks -= blocks.size();
+}
+
+} // namespace
+
+double SlabPoolStatistics::fragmentation() const noexcept
+{
+    if (reservedBytes == 0U)
+    {
+        return 0.0;
+    }
+    return 1.0 - (static_cast<double>(requestedBytes) / static_cast<double>(reservedBytes));
+}
+
+SlabPool::SlabPool(std::size_t const capacity, StoragePolicy const &policy) noexcept
+    : _state{std::make_shared<Internal::SlabPoolState>(capacity, policy)}
+{}
+
+SlabPool::~SlabPool() noexcept {}
+
+char *SlabPool::allocate(size_t const n) noexcept(false)
+{
+    auto const index = classIndex(n);
+    if (index == ClassCount)
+    {
+        auto const expected = BackingStorage::mappedSize(n, _state->policy);
+        if (!reserve(*_state, expected))
+        {
+            throw std::bad_alloc{};
+        }
+        BackingStorage storage{n, _state->policy};
+        if (!storage.good())
+        {
+            _state->reservedBytes.fetch_sub(expected, std::memory_order_relaxed);
+            throw std::bad_alloc{};
+        }
+        _state->reservedBytes.fetch_sub(expected - storage.size(), std::memory_order_relaxed);
+
+        auto const block = storage.data();
+        auto const size  = storage.size();
+        try
+        {
+            std::lock_guard<std::mutex> lock{_state->largeMutex};
+            _state->large.emplace(block, std::move(storage));
+        }
+        catch (...)
+        {
+            _state->reservedBytes.fetch_sub(size, std::memory_order_relaxed);
+            throw;
+        }
+        _state->largeBytes.fetch_add(size, std::memory_order_relaxed);
+        _state->usedBytes.fetch_add(static_cast<std::ptrdiff_t>(size), std::memory_order_relaxed);
+        _state->requestedBytes.fetch_add(static_cast<std::ptrdiff_t>(n), std::memory_order_relaxed);
+        return block;
+    }
+
+    auto &magazine = magazineOf(_state);
+    if (magazine.counts[index] == 0U)
+    {
+        refill(*_state, index, magazine);
+    }
+    addOwned(magazine.usedBytes, static_cast<std::ptrdiff_t>(blockSizeOf(index)));
+    addOwned(magazine.requestedBytes, static_cast<std::ptrdiff_t>(n));
+    return magazine.blocks[index][--magazine.counts[index]];
+}
+
+void SlabPool::deallocate(char *const p, size_t const n) noexcept
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+    auto const index = classIndex(n);
+    if (index == ClassCount)
+    {
+        std::size_t size{};
+        {
+            std::lock_guard<std::mutex> lock{_state->largeMutex};
+            auto const                  storage = _state->large.find(p);
+            if (storage == _state->large.end())
+            {
+                return;
+            }
+            size = storage->second.size();
+            _state->large.erase(storage);
+        }
+        _state->largeBytes.fetch_sub(size, std::memory_order_relaxed);
+        _state->reservedBytes.fetch_sub(size, std::memory_order_relaxed);
+        _state->usedBytes.fetch_sub(static_cast<std::ptrdiff_t>(size), std::memory_order_relaxed);
+        _state->requestedBytes.fetch_sub(static_cast<std::ptrdiff_t>(n), std::memory_order_relaxed);
+        return;
+    }
+
+    Internal::Magazine *magazine{};
+    try
+    {
+        magazine = &magazineOf(_state);
+    }
+    catch (...)
+    {
+        // without magazine the block goes straight back to its class
+        giveBack(*_state, index, std::span<char *const>{&p, 1U});
+        _state->usedBytes.fetch_sub(static_cast<std::ptrdiff_t>(blockSizeOf(index)), std::memory_order_relaxed);
+        _state->requestedBytes.fetch_sub(static_cast<std::ptrdiff_t>(n), std::memory_order_relaxed);
+        return;
+    }
+
+    auto &count = magazine->counts[index];
+    if (count == MagazineSize)
+    {
+        constexpr auto Half = MagazineSize / 2U;
+        giveBack(*_state, index, std::span<char *const>{magazine->blocks[index].data() + Half, Half});
+        count = Half;
+    }
+    magazine->blocks[index][count++] = p;
+    addOwned(magazine->usedBytes, -static_cast<std::ptrdiff_t>(blockSizeOf(index)));
+    addOwned(magazine->requestedBytes, -static_cast<std::ptrdiff_t>(n));
+}
+
+size_t SlabPool::usedSpace() const noexcept
+{
+    auto used = _state->usedBytes.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock{_state->magazineMutex};
+        for (auto const &magazine : _state->magazines)
+        {
+            used += magazine->usedBytes.load(std::memory_order_relaxed);
+        }
+    }
+    return static_cast<size_t>(std::max<std::ptrdiff_t>(used, 0));
+}
+
+size_t SlabPool::totalSpace() const noexcept { return _state->capacity; }
+
+SlabPoolStatistics SlabPool::statistics() const noexcept
+{
+    SlabPoolStatistics result{};
+
+    auto used      = _state->usedBytes.load(std::memory_order_relaxed);
+    auto requested = _state->requestedBytes.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock{_state->magazineMutex};
+        for (auto const &magazine : _state->magazines)
+        {
+            used += magazine->usedBytes.load(std::memory_order_relaxed);
+            requested += magazine->requestedBytes.load(std::memory_order_relaxed);
+        }
+    }
+    result.usedBytes      = static_cast<std::size_t>(std::max<std::ptrdiff_t>(used, 0));
+    result.requestedBytes = static_cast<std::size_t>(std::max<std::ptrdiff_t>(requested, 0));
+    result.reservedBytes  = _state->reservedBytes.load(std::memory_order_relaxed);
+    result.largeBytes     = _state->largeBytes.load(std::memory_order_relaxed);
+
+    try
+    {
+        {
+            std::lock_guard<std::mutex> lock{_state->slabMutex};
+            for (auto const &slab : _state->slabs)
+            {
+                BackingStorage::accumulate(result.residentPerNode, slab.residentPerNode());
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock{_state->largeMutex};
+            for (auto const &[block, storage] : _state->large)
+            {
+                BackingStorage::accumulate(result.residentPerNode, storage.residentPerNode());
+            }
+        }
+        result.classes.reserve(ClassCount);
+        for (std::size_t i = 0U; i < ClassCount; ++i)
+        {
+            auto                       &sizeClass = _state->classes[i];
+            std::lock_guard<std::mutex> lock{sizeClass.mutex};
+            result.classes.emplace_back(SizeClassStatistics{
+                blockSizeOf(i), sizeClass.reservedBlocks, sizeClass.takenBlocks, sizeClass.highWaterBlocks});
+        }
+    }
+    catch (...)
+    {
+        result.classes.clear();
+    }
+    return result;
+}
+
+std::size_t SlabPool::classIndex(std::size_t const n) noexcept
+{
+    if (n <= MinClassSize)
+    {
+        return 0U;
+    }
+    if (n > MaxClassSize)
+    {
+        return ClassCount;
+    }
+    constexpr auto Offset = static_cast<std::size_t>(std::countr_zero(MinClassSize));
+    return static_cast<std::size_t>(std::bit_width(n - 1U)) - Offset;
+}
+
+} // namespace Terrahertz
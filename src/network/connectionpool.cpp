@@ -0,0 +1,331 @@
+#include "THzCommon/network/connectionpool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+#include <utility>
+
+namespace Terrahertz {
+
+/// @brief Parses a boolean configuration value.
+///
+/// @param value The value to parse.
+/// @param target The variable to store the value in, unchanged if the value is invalid.
+static void parseValue(std::string_view const value, bool &target) noexcept
+{
+    if ((value == "true") || (value == "1"))
+    {
+        target = true;
+    }
+    else if ((value == "false") || (value == "0"))
+    {
+        target = false;
+    }
+}
+
+/// @brief Parses a numeric configuration value.
+///
+/// @tparam TValueType The type of the value.
+/// @param value The value to parse.
+/// @param target The variable to store the value in, unchanged if the value is invalid.
+template <typename TValueType>
+static void parseValue(std::string_view const value, TValueType &target) noexcept
+{
+    TValueType parsed{};
+    auto const end    = value.data() + value.size();
+    auto const result = std::from_chars(value.data(), end, parsed);
+    if ((result.ec == std::errc{}) && (result.ptr == end))
+    {
+        target = parsed;
+    }
+}
+
+void ConnectionPoolSettings::load(Configuration const &configuration) noexcept
+{
+    parseValue(configuration.valueOf("no_delay"), noDelay);
+    parseValue(configuration.valueOf("keep_alive"), keepAlive);
+    parseValue(configuration.valueOf("max_per_endpoint"), maxPerEndpoint);
+    parseValue(configuration.valueOf("max_total"), maxTotal);
+
+    auto timeout = idleTimeout.count();
+    parseValue(configuration.valueOf("idle_timeout_ms"), timeout);
+    idleTimeout = std::chrono::milliseconds{timeout};
+}
+
+template <IPVersion TVersion>
+ConnectionPool<TVersion>::Lease::Lease(ConnectionPool          *pool,
+                                       Address<TVersion> const &address,
+                                       TCPSocket<TVersion>    &&socket) noexcept
+    : _pool{pool}, _address{address}, _socket{std::move(socket)}
+{}
+
+template <IPVersion TVersion>
+ConnectionPool<TVersion>::Lease::Lease(Lease &&other) noexcept
+    : _pool{other._pool}, _address{other._address}, _socket{std::move(other._socket)}
+{
+    other._pool = nullptr;
+    other._socket.reset();
+}
+
+template <IPVersion TVersion>
+typename ConnectionPool<TVersion>::Lease &ConnectionPool<TVersion>::Lease::operator=(Lease &&other) noexcept
+{
+    if (this != &other)
+    {
+        giveBack();
+        _pool    = other._pool;
+        _address = other._address;
+        _socket  = std::move(other._socket);
+
+        other._pool = nullptr;
+        other._socket.reset();
+    }
+    return *this;
+}
+
+template <IPVersion TVersion>
+ConnectionPool<TVersion>::Lease::~Lease() noexcept
+{
+    giveBack();
+}
+
+template <IPVersion TVersion>
+bool ConnectionPool<TVersion>::Lease::good() noexcept
+{
+    return _socket && _socket->good();
+}
+
+template <IPVersion TVersion>
+TCPSocket<TVersion> &ConnectionPool<TVersion>::Lease::socket() noexcept
+{
+    return *_socket;
+}
+
+template <IPVersion TVersion>
+void ConnectionPool<TVersion>::Lease::invalidate() noexcept
+{
+    if (_socket)
+    {
+        _socket->close();
+    }
+}
+
+template <IPVersion TVersion>
+void ConnectionPool<TVersion>::Lease::giveBack() noexcept
+{
+    if ((_pool != nullptr) && _socket)
+    {
+        _pool->giveBack(_address, _socket);
+    }
+    _pool = nullptr;
+    _socket.reset();
+}
+
+template <IPVersion TVersion>
+ConnectionPool<TVersion>::ConnectionPool(ConnectionPoolSettings const &settings) noexcept : _settings{settings}
+{}
+
+template <IPVersion TVersion>
+ConnectionPool<TVersion>::~ConnectionPool() noexcept
+{
+    _maintenance.shutdown();
+}
+
+template <IPVersion TVersion>
+typename ConnectionPool<TVersion>::Lease ConnectionPool<TVersion>::acquire(Address<TVersion> const &address) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+
+        auto      &endpoint = _endpoints[address];
+        auto const now      = std::chrono::steady_clock::now();
+        while (!endpoint.idle.empty())
+        {
+            auto connection = std::move(endpoint.idle.back());
+            endpoint.idle.pop_back();
+
+            // a readable idle connection was either closed by the server or received unexpected data
+            if (connection.socket.good() && ((now - connection.since) < _settings.idleTimeout) &&
+                !connection.socket.receiveIsNonblocking())
+            {
+                ++endpoint.leased;
+                return Lease{this, address, std::move(connection.socket)};
+            }
+            --_total;
+        }
+
+        if ((endpoint.leased >= _settings.maxPerEndpoint) || ((_total >= _settings.maxTotal) && !evictIdle()))
+        {
+            if (endpoint.leased == 0U)
+            {
+                _endpoints.erase(address);
+            }
+            return {};
+        }
+        ++endpoint.leased;
+        ++_total;
+    }
+
+    // the slot is reserved, so connecting can happen without holding the lock
+    TCPSocket<TVersion> socket{};
+    if (socket.good())
+    {
+        if (_settings.noDelay)
+        {
+            socket.setNoDelay(true);
+        }
+        if (_settings.keepAlive)
+        {
+            socket.setKeepAlive(true);
+        }
+        if (!socket.connect(address))
+        {
+            socket.close();
+        }
+    }
+    if (!socket.good())
+    {
+        std::optional<TCPSocket<TVersion>> failed{};
+        giveBack(address, failed);
+        return {};
+    }
+    return Lease{this, address, std::move(socket)};
+}
+
+template <IPVersion TVersion>
+std::size_t ConnectionPool<TVersion>::checkHealth() noexcept
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    std::size_t closed{};
+    auto const  now = std::chrono::steady_clock::now();
+    for (auto iter = _endpoints.begin(); iter != _endpoints.end();)
+    {
+        auto      &idle   = iter->second.idle;
+        auto const broken = std::remove_if(idle.begin(), idle.end(), [&](IdleConnection &connection) noexcept {
+            return !connection.socket.good() || ((now - connection.since) >= _settings.idleTimeout) ||
+                   connection.socket.receiveIsNonblocking();
+        });
+        closed += static_cast<std::size_t>(idle.end() - broken);
+        idle.erase(broken, idle.end());
+
+        if (idle.empty() && (iter->second.leased == 0U))
+        {
+            iter = _endpoints.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+    _total -= closed;
+    return closed;
+}
+
+template <IPVersion TVersion>
+void ConnectionPool<TVersion>::startMaintenance(std::chrono::milliseconds const interval) noexcept
+{
+    if (_maintenance.thread.joinable())
+    {
+        return;
+    }
+    _maintenance.thread = std::thread{[this, interval]() noexcept {
+        WorkerThread::UniqueLock lock{_maintenance.mutex};
+        while (!_maintenance.shutdownFlag)
+        {
+            _maintenance.wakeUp.wait_for(lock, interval, [this]() noexcept {
+                return _maintenance.shutdownFlag.load();
+            });
+            if (!_maintenance.shutdownFlag)
+            {
+                checkHealth();
+            }
+        }
+    }};
+}
+
+template <IPVersion TVersion>
+std::size_t ConnectionPool<TVersion>::idleConnections() const noexcept
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    std::size_t idle{};
+    for (auto const &endpoint : _endpoints)
+    {
+        idle += endpoint.second.idle.size();
+    }
+    return idle;
+}
+
+template <IPVersion TVersion>
+std::size_t ConnectionPool<TVersion>::leasedConnections() const noexcept
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    std::size_t leased{};
+    for (auto const &endpoint : _endpoints)
+    {
+        leased += endpoint.second.leased;
+    }
+    return leased;
+}
+
+template <IPVersion TVersion>
+void ConnectionPool<TVersion>::giveBack(Address<TVersion> const            &address,
+                                        std::optional<TCPSocket<TVersion>> &socket) noexcept
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    auto const iter = _endpoints.find(address);
+    if (iter == _endpoints.end())
+    {
+        return;
+    }
+    auto &endpoint = iter->second;
+    --endpoint.leased;
+
+    // unread data means the protocol state of the connection is unknown, so it can not be reused
+    if (socket && socket->good() && !socket->receiveIsNonblocking())
+    {
+        endpoint.idle.push_back(IdleConnection{std::move(*socket), std::chrono::steady_clock::now()});
+    }
+    else
+    {
+        --_total;
+        if (endpoint.idle.empty() && (endpoint.leased == 0U))
+        {
+            _endpoints.erase(iter);
+        }
+    }
+    socket.reset();
+}
+
+template <IPVersion TVersion>
+bool ConnectionPool<TVersion>::evictIdle() noexcept
+{
+    auto oldest = _endpoints.end();
+    for (auto iter = _endpoints.begin(); iter != _endpoints.end(); ++iter)
+    {
+        auto const &idle = iter->second.idle;
+        if (!idle.empty() && ((oldest == _endpoints.end()) || (idle.front().since < oldest->second.idle.front().since)))
+        {
+            oldest = iter;
+        }
+    }
+    if (oldest == _endpoints.end())
+    {
+        return false;
+    }
+    oldest->second.idle.erase(oldest->second.idle.begin());
+    if (oldest->second.idle.empty() && (oldest->second.leased == 0U))
+    {
+        _endpoints.erase(oldest);
+    }
+    --_total;
+    return true;
+}
+
+template class ConnectionPool<IPVersion::V4>;
+template class ConnectionPool<IPVersion::V6>;
+
+} // namespace Terrahertz
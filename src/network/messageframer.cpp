@@ -0,0 +1,515 @@
+#include "THzCommon/network/messageframer.hpp"
+
+#include "THzCommon/utility/byteorder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <optional>
+
+namespace Terrahertz {
+
+/// @brief The maximum size of an encoded length prefix [bytes].
+static constexpr std::size_t MaxPrefixSize = 5U;
+
+/// @brief Buffer for an encoded length prefix.
+using PrefixBuffer = std::array<std::byte, MaxPrefixSize>;
+
+/// @brief The size and the length of the message announced by a decoded prefix.
+struct DecodedPrefix final
+{
+    /// @brief The size of the prefix [bytes].
+    std::size_t size{};
+
+    /// @brief The length of the message following the prefix [bytes].
+    std::size_t length{};
+};
+
+/// @brief Converts the given value between host and network byte order.
+///
+/// @tparam TValueType The type of the value to convert.
+/// @param value The value to convert.
+/// @return The converted value.
+template <typename TValueType>
+static TValueType networkOrder(TValueType const value) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        return flipByteOrder(value);
+    }
+    return value;
+}
+
+/// @brief Encodes the given length as a prefix.
+///
+/// @param prefix The encoding to use.
+/// @param length The length to encode.
+/// @param buffer The buffer to encode the prefix into.
+/// @return The size of the encoded prefix, 0 if the length can not be encoded.
+static std::size_t encodePrefix(LengthPrefix const prefix, std::size_t length, PrefixBuffer &buffer) noexcept
+{
+    switch (prefix)
+    {
+    case LengthPrefix::Fixed16:
+    {
+        if (length > std::numeric_limits<std::uint16_t>::max())
+        {
+            return 0U;
+        }
+        auto const value = networkOrder(static_cast<std::uint16_t>(length));
+        std::memcpy(buffer.data(), &value, sizeof(value));
+        return sizeof(value);
+    }
+    case LengthPrefix::Fixed32:
+    {
+        if (length > std::numeric_limits<std::uint32_t>::max())
+        {
+            return 0U;
+        }
+        auto const value = networkOrder(static_cast<std::uint32_t>(length));
+        std::memcpy(buffer.data(), &value, sizeof(value));
+        return sizeof(value);
+    }
+    case LengthPrefix::VarInt:
+    {
+        if (length > std::numeric_limits<std::uint32_t>::max())
+        {
+            return 0U;
+        }
+        std::size_t size{};
+        do
+        {
+            auto group = static_cast<std::uint8_t>(length & 0x7FU);
+            length >>= 7U;
+            if (length != 0U)
+            {
+                group |= 0x80U;
+            }
+            buffer[size] = static_cast<std::byte>(group);
+            ++size;
+        } while (length != 0U);
+        return size;
+    }
+    }
+    return 0U;
+}
+
+/// @brief Decodes the prefix at the start of the given data.
+///
+/// @param prefix The encoding to use.
+/// @param data The data to decode the prefix from.
+/// @return The decoded prefix, if the data contains a complete prefix. Malformed prefixes announce a maximum length.
+static std::optional<DecodedPrefix> decodePrefix(LengthPrefix const prefix, std::span<std::byte const> data) noexcept
+{
+    switch (prefix)
+    {
+    case LengthPrefix::Fixed16:
+    {
+        std::uint16_t value{};
+        if (data.size() < sizeof(value))
+        {
+            return {};
+        }
+        std::memcpy(&value, data.data(), sizeof(value));
+        return DecodedPrefix{sizeof(value), networkOrder(value)};
+    }
+    case LengthPrefix::Fixed32:
+    {
+        std::uint32_t value{};
+        if (data.size() < sizeof(value))
+        {
+            return {};
+        }
+        std::memcpy(&value, data.data(), sizeof(value));
+        return DecodedPrefix{sizeof(value), networkOrder(value)};
+    }
+    case LengthPrefix::VarInt:
+    {
+        std::size_t length{};
+        for (std::size_t i = 0U; i < std::min(data.size(), MaxPrefixSize); ++i)
+        {
+            auto const group = std::to_integer<std::size_t>(data[i]);
+            length |= (group & 0x7FU) << (7U * i);
+            if ((group & 0x80U) == 0U)
+            {
+                return DecodedPrefix{i + 1U, length};
+            }
+        }
+        if (data.size() >= MaxPrefixSize)
+        {
+            return DecodedPrefix{MaxPrefixSize, std::numeric_limits<std::size_t>::max()};
+        }
+        return {};
+    }
+    }
+    return {};
+}
+
+/// @brief Draws a buffer of the given size from the pool.
+///
+/// @param pool The pool to draw the buffer from.
+/// @param size The size of the buffer [bytes].
+/// @return The buffer, empty if size is 0.
+static std::span<std::byte> drawBuffer(IMemoryPool &pool, std::size_t const size) noexcept(false)
+{
+    if (size == 0U)
+    {
+        return {};
+    }
+    return {reinterpret_cast<std::byte *>(pool.allocate(size)), size};
+}
+
+/// @brief Returns the given buffer to the pool.
+///
+/// @param pool The pool to return the buffer to.
+/// @param buffer The buffer to return.
+static void returnBuffer(IMemoryPool &pool, std::span<std::byte> const buffer) noexcept
+{
+    if (!buffer.empty())
+    {
+        pool.deallocate(reinterpret_cast<char *>(buffer.data()), buffer.size());
+    }
+}
+
+template <IPVersion TVersion>
+MessageFramer<TVersion>::MessageFramer(TCPSocket<TVersion> &socket,
+                                       IMemoryPool         &pool,
+                                       LengthPrefix const   prefix,
+                                       std::size_t const    receiveBufferSize,
+                                       std::size_t const    maxMessageSize,
+                                       FlushPolicy const    policy) noexcept(false)
+    : _socket{socket}, _pool{pool}, _prefix{prefix}, _maxMessageSize{maxMessageSize}, _policy{policy}
+{
+    _receiveBuffer = drawBuffer(_pool, std::max(receiveBufferSize, MaxPrefixSize));
+    try
+    {
+        _sendBuffer = drawBuffer(_pool, _policy.flushThreshold);
+    }
+    catch (...)
+    {
+        returnBuffer(_pool, _receiveBuffer);
+        throw;
+    }
+}
+
+template <IPVersion TVersion>
+MessageFramer<TVersion>::~MessageFramer() noexcept
+{
+    returnBuffer(_pool, _partial);
+    returnBuffer(_pool, _sendBuffer);
+    returnBuffer(_pool, _receiveBuffer);
+}
+
+template <IPVersion TVersion>
+bool MessageFramer<TVersion>::messageBuffered() const noexcept
+{
+    if (_malformed || !_partial.empty() || (_discard != 0U))
+    {
+        return false;
+    }
+    auto const buffered = _receiveBuffer.subspan(_receiveBegin, _receiveEnd - _receiveBegin);
+    auto const decoded  = decodePrefix(_prefix, buffered);
+    return decoded && ((buffered.size() - decoded->size) >= decoded->length);
+}
+
+template <IPVersion TVersion>
+Result<std::span<std::byte>> MessageFramer<TVersion>::receive() noexcept
+{
+    if (_malformed)
+    {
+        return Result<std::span<std::byte>>::error(EBADMSG);
+    }
+    if (!_partial.empty())
+    {
+        return receiveRemaining();
+    }
+    if (_discard != 0U)
+    {
+        auto const discarded = discardRemaining();
+        if (discarded.isError())
+        {
+            return Result<std::span<std::byte>>::error(discarded.errorCode());
+        }
+    }
+    for (;;)
+    {
+        auto const buffered = _receiveBuffer.subspan(_receiveBegin, _receiveEnd - _receiveBegin);
+        auto const decoded  = decodePrefix(_prefix, buffered);
+        if (decoded)
+        {
+            if (decoded->length == std::numeric_limits<std::size_t>::max())
+            {
+                _malformed = true;
+                return Result<std::span<std::byte>>::error(EBADMSG);
+            }
+            if (decoded->length > _maxMessageSize)
+            {
+                // skip the message, so the next call continues with the following one
+                _receiveBegin += decoded->size;
+                _discard = decoded->length;
+                auto const skipped = std::min(_discard, _receiveEnd - _receiveBegin);
+                _receiveBegin += skipped;
+                _discard -= skipped;
+                return Result<std::span<std::byte>>::error(EMSGSIZE);
+            }
+
+            std::span<std::byte> message{};
+            try
+            {
+                message = drawBuffer(_pool, decoded->length);
+            }
+            catch (std::bad_alloc const &)
+            {
+                return Result<std::span<std::byte>>::error(ENOMEM);
+            }
+
+            auto const available = std::min(decoded->length, buffered.size() - decoded->size);
+            std::memcpy(message.data(), buffered.data() + decoded->size, available);
+            _receiveBegin += decoded->size + available;
+            if (available == message.size())
+            {
+                return message;
+            }
+
+            // the receive buffer is empty now, read the rest of the message directly into its own buffer
+            // and whatever follows it into the receive buffer
+            _receiveBegin    = 0U;
+            _receiveEnd      = 0U;
+            _partial         = message;
+            _partialReceived = available;
+            return receiveRemaining();
+        }
+
+        // move the incomplete prefix to the front and read more data
+        if (_receiveBegin != 0U)
+        {
+            std::memmove(_receiveBuffer.data(), buffered.data(), buffered.size());
+            _receiveBegin = 0U;
+            _receiveEnd   = buffered.size();
+        }
+        auto const result = _socket.receive(_receiveBuffer.subspan(_receiveEnd));
+        if (result.isError())
+        {
+            return Result<std::span<std::byte>>::error(result.errorCode());
+        }
+        if (result.value().empty())
+        {
+            return Result<std::span<std::byte>>::error(ECONNRESET);
+        }
+        _receiveEnd += result.value().size();
+    }
+}
+
+template <IPVersion TVersion>
+Result<std::span<std::byte>> MessageFramer<TVersion>::receiveRemaining() noexcept
+{
+    while (_partialReceived != _partial.size())
+    {
+        std::array<std::span<std::byte>, 2U> buffers{_partial.subspan(_partialReceived), _receiveBuffer};
+
+        auto const result = _socket.receivev(buffers);
+        if (result.isError())
+        {
+            // keep what has been read, the next call continues with the rest
+            return Result<std::span<std::byte>>::error(result.errorCode());
+        }
+        if (result.value() == 0U)
+        {
+            returnBuffer(_pool, _partial);
+            _partial         = {};
+            _partialReceived = 0U;
+            return Result<std::span<std::byte>>::error(ECONNRESET);
+        }
+        auto const intoMessage = std::min(result.value(), _partial.size() - _partialReceived);
+        _partialReceived += intoMessage;
+        _receiveEnd = result.value() - intoMessage;
+    }
+    auto const message = _partial;
+    _partial           = {};
+    _partialReceived   = 0U;
+    return message;
+}
+
+template <IPVersion TVersion>
+Result<std::size_t> MessageFramer<TVersion>::discardRemaining() noexcept
+{
+    std::size_t skipped{};
+    for (;;)
+    {
+        auto const buffered = std::min(_discard, _receiveEnd - _receiveBegin);
+        _receiveBegin += buffered;
+        _discard -= buffered;
+        skipped += buffered;
+        if (_discard == 0U)
+        {
+            return skipped;
+        }
+
+        _receiveBegin     = 0U;
+        _receiveEnd       = 0U;
+        auto const result = _socket.receive(_receiveBuffer);
+        if (result.isError())
+        {
+            return Result<std::size_t>::error(result.errorCode());
+        }
+        if (result.value().empty())
+        {
+            return Result<std::size_t>::error(ECONNRESET);
+        }
+        _receiveEnd = result.value().size();
+    }
+}
+
+template <IPVersion TVersion>
+void MessageFramer<TVersion>::release(std::span<std::byte> const message) noexcept
+{
+    returnBuffer(_pool, message);
+}
+
+template <IPVersion TVersion>
+Result<std::size_t> MessageFramer<TVersion>::send(std::span<std::byte const> const message) noexcept
+{
+    if (_broken)
+    {
+        return Result<std::size_t>::error(EPIPE);
+    }
+    PrefixBuffer prefix{};
+    auto const   prefixSize = encodePrefix(_prefix, message.size(), prefix);
+    if (prefixSize == 0U)
+    {
+        return Result<std::size_t>::error(EMSGSIZE);
+    }
+
+    auto const frameSize = prefixSize + message.size();
+    if ((_pending + frameSize) > _sendBuffer.size())
+    {
+        auto const flushed = flush();
+        if (flushed.isError())
+        {
+            return flushed;
+        }
+    }
+
+    if (frameSize > _sendBuffer.size())
+    {
+        // too large to be coalesced, hand it to the socket without copying
+        std::array<std::span<std::byte const>, 2U> buffers{std::span<std::byte const>{prefix}.first(prefixSize),
+                                                           message};
+
+        std::size_t sent{};
+        auto const  result = sendAll(buffers, sent);
+        if (result.isError())
+        {
+            // the peer would see a truncated frame followed by the next one
+            _broken = sent != 0U;
+            return result;
+        }
+        return message.size();
+    }
+
+    if (_pending == 0U)
+    {
+        _oldestPending = std::chrono::steady_clock::now();
+    }
+    std::memcpy(_sendBuffer.data() + _pending, prefix.data(), prefixSize);
+    if (!message.empty())
+    {
+        std::memcpy(_sendBuffer.data() + _pending + prefixSize, message.data(), message.size());
+    }
+    _pending += frameSize;
+
+    if (_pending == _sendBuffer.size())
+    {
+        auto const flushed = flush();
+        if (flushed.isError())
+        {
+            return flushed;
+        }
+    }
+    else
+    {
+        auto const flushed = flushIfDue();
+        if (flushed.isError())
+        {
+            return flushed;
+        }
+    }
+    return message.size();
+}
+
+template <IPVersion TVersion>
+Result<std::size_t> MessageFramer<TVersion>::flush() noexcept
+{
+    if (_broken)
+    {
+        return Result<std::size_t>::error(EPIPE);
+    }
+    if (_pending == 0U)
+    {
+        return std::size_t{};
+    }
+    std::array<std::span<std::byte const>, 1U> buffers{_sendBuffer.subspan(_sent, _pending - _sent)};
+
+    std::size_t sent{};
+    auto const  result = sendAll(buffers, sent);
+    _sent += sent;
+    if (!result.isError())
+    {
+        _pending = 0U;
+        _sent    = 0U;
+    }
+    return result;
+}
+
+template <IPVersion TVersion>
+Result<std::size_t> MessageFramer<TVersion>::flushIfDue() noexcept
+{
+    if ((_pending != 0U) && ((std::chrono::steady_clock::now() - _oldestPending) >= _policy.maxDelay))
+    {
+        return flush();
+    }
+    return std::size_t{};
+}
+
+template <IPVersion TVersion>
+std::size_t MessageFramer<TVersion>::pending() const noexcept
+{
+    return _pending - _sent;
+}
+
+template <IPVersion TVersion>
+Result<std::size_t> MessageFramer<TVersion>::sendAll(std::span<std::span<std::byte const>> buffers,
+                                                     std::size_t                          &sent) noexcept
+{
+    sent = 0U;
+    while (!buffers.empty())
+    {
+        auto const result = _socket.sendv(buffers);
+        if (result.isError())
+        {
+            return result;
+        }
+        sent += result.value();
+
+        // skip what has been sent
+        auto skip = result.value();
+        while (!buffers.empty() && (skip >= buffers.front().size()))
+        {
+            skip -= buffers.front().size();
+            buffers = buffers.subspan(1U);
+        }
+        if (!buffers.empty())
+        {
+            buffers.front() = buffers.front().subspan(skip);
+        }
+    }
+    return sent;
+}
+
+template class MessageFramer<IPVersion::V4>;
+template class MessageFramer<IPVersion::V6>;
+
+} // namespace Terrahertz
@@ -3,9 +3,13 @@
 
 #include "THzCommon/network/address.hpp"
 #include "THzCommon/network/common.hpp"
+#include "THzCommon/utility/result.hpp"
 
+#include <cerrno>
 #include <cstddef>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
 #ifdef _WIN32
 
@@ -18,7 +22,10 @@
 
 #else
 
+#include <fcntl.h>
 #include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -162,19 +169,73 @@ inline Address<IPVersion::V6> convertSocketAddress(sockaddr_in6 const &address)
     return {convertIPAddress(address.sin6_addr), ntohs(address.sin6_port)};
 }
 
+/// @brief Sets an integer option of the given socket.
+///
+/// @tparam TValue The type of the value, converted to int.
+/// @param socket The socket to set the option of.
+/// @param level The level of the option.
+/// @param name The name of the option.
+/// @param value The value to set the option to.
+/// @return True if the operation was successfull, false otherwise.
+/// @remarks Fails with EINVAL if the value does not fit into an int.
+template <typename TValue>
+inline bool setOption(SocketHandleType socket, int const level, int const name, TValue const value) noexcept
+{
+    if constexpr (!std::is_same_v<TValue, bool>)
+    {
+        if (!std::in_range<int>(value))
+        {
+#ifdef _WIN32
+            ::WSASetLastError(WSAEINVAL);
+#endif
+            errno = EINVAL;
+            return false;
+        }
+    }
+    int        converted{static_cast<int>(value)};
+    auto const result = ::setsockopt(socket,
+                                     level,
+                                     name,
+                                     reinterpret_cast<SocketTraits::SendBufferType>(&converted),
+                                     static_cast<SocketTraits::SockLengthType>(sizeof(converted)));
+    return result != -1;
+}
+
+/// @brief Reads an integer option of the given socket.
+///
+/// @tparam TValue The type to convert the value to.
+/// @param socket The socket to read the option of.
+/// @param level The level of the option.
+/// @param name The name of the option.
+/// @return The value of the option, if successful.
+template <typename TValue>
+inline Result<TValue> getOption(SocketHandleType socket, int const level, int const name) noexcept
+{
+    int        value{};
+    auto       length{static_cast<SocketTraits::SockLengthType>(sizeof(value))};
+    auto const result =
+        ::getsockopt(socket, level, name, reinterpret_cast<SocketTraits::RecvBufferType>(&value), &length);
+    if (result == -1)
+    {
+        return Result<TValue>::error();
+    }
+    return static_cast<TValue>(value);
+}
+
 /// @brief Performs a poll operation to see if there is data to read on the socket.
 ///
 /// @param socket The socket to poll.
+/// @param timeout The time to wait for data to arrive [ms].
 /// @return True if data can be read from the socket without blocking, false otherwise.
-inline bool pollRead(SocketHandleType socket) noexcept
+inline bool pollRead(SocketHandleType socket, int const timeout = 0) noexcept
 {
     std::array<pollfd, 1U> fds{};
     fds[0].fd     = socket;
     fds[0].events = POLLIN;
 #ifdef _WIN32
-    auto const result = WSAPoll(fds.data(), 1U, 0);
+    auto const result = WSAPoll(fds.data(), 1U, timeout);
 #else
-    auto const result = poll(fds.data(), 1U, 0);
+    auto const result = poll(fds.data(), 1U, timeout);
 #endif
     return (result > 0) && ((fds[0].revents & POLLIN) != 0);
 }
@@ -196,6 +257,12 @@ inline bool pollWrite(SocketHandleType socket) noexcept
     return (result > 0) && ((fds[0].revents & POLLOUT) != 0);
 }
 
+/// @brief Checks if the given error code signals a call on a non-blocking socket that would have blocked.
+///
+/// @param code The error code to check.
+/// @return True if the call would have blocked, false otherwise.
+inline bool wouldBlock(errno_t const code) noexcept { return (code == EAGAIN) || (code == EWOULDBLOCK); }
+
 } // namespace Internal
 } // namespace Terrahertz
 
@@ -0,0 +1,260 @@
+#include "THzCommon/network/reactor.hpp"
+
+#ifdef __linux__
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace Terrahertz {
+
+Reactor::Readiness::Readiness(Reactor &reactor, Internal::SocketHandleType const handle, bool const write) noexcept
+    : _reactor{&reactor}, _handle{handle}, _write{write}
+{}
+
+bool Reactor::Readiness::await_suspend(std::coroutine_handle<> const coroutine) noexcept
+{
+    _coroutine        = coroutine;
+    auto const result = _reactor->arm(*this);
+    if (result != 0)
+    {
+        _error = result;
+        return false;
+    }
+    // the coroutine may already be running on another thread, this must not be accessed anymore
+    return true;
+}
+
+void Reactor::resume(std::coroutine_handle<> const coroutine) noexcept
+{
+    if (_pool != nullptr)
+    {
+        _pool->post([coroutine]() noexcept { coroutine.resume(); });
+    }
+    else
+    {
+        coroutine.resume();
+    }
+}
+
+#ifdef __linux__
+
+Reactor::Reactor(ThreadPool *const pool) noexcept : _pool{pool}
+{
+    _poller = ::epoll_create1(EPOLL_CLOEXEC);
+    _wakeUp = ::eventfd(0U, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ((_poller == -1) || (_wakeUp == -1))
+    {
+        return;
+    }
+
+    // the eventfd is the only registration without awaiter
+    epoll_event event{};
+    event.events  = EPOLLIN;
+    event.data.fd = _wakeUp;
+    if (::epoll_ctl(_poller, EPOLL_CTL_ADD, _wakeUp, &event) == 0)
+    {
+        _thread.thread = std::thread{&Reactor::run, this};
+    }
+}
+
+Reactor::~Reactor() noexcept
+{
+    stop();
+    if (_wakeUp != -1)
+    {
+        ::close(_wakeUp);
+    }
+    if (_poller != -1)
+    {
+        ::close(_poller);
+    }
+}
+
+bool Reactor::good() const noexcept { return _thread.thread.joinable() && !_thread.shutdownFlag; }
+
+void Reactor::stop() noexcept
+{
+    if (!_thread.thread.joinable())
+    {
+        return;
+    }
+    _thread.shutdownFlag = true;
+
+    std::uint64_t const value{1U};
+    [[maybe_unused]] auto const written = ::write(_wakeUp, &value, sizeof(value));
+    _thread.shutdown();
+
+    // the thread is gone, so nobody else resumes the coroutines still waiting
+    std::unordered_map<Internal::SocketHandleType, Registration> cancelled{};
+    {
+        std::lock_guard<std::mutex> lock{_thread.mutex};
+        cancelled.swap(_registrations);
+    }
+    for (auto const &[handle, registration] : cancelled)
+    {
+        ::epoll_ctl(_poller, EPOLL_CTL_DEL, handle, nullptr);
+        for (auto *const readiness : {registration.reader, registration.writer})
+        {
+            if (readiness != nullptr)
+            {
+                readiness->_error = ECANCELED;
+                resume(readiness->_coroutine);
+            }
+        }
+    }
+}
+
+std::uint32_t Reactor::events(Registration const &registration) noexcept
+{
+    std::uint32_t result{EPOLLONESHOT};
+    if (registration.reader != nullptr)
+    {
+        result |= EPOLLIN;
+    }
+    if (registration.writer != nullptr)
+    {
+        result |= EPOLLOUT;
+    }
+    return result;
+}
+
+errno_t Reactor::update(Internal::SocketHandleType const handle, Registration const &registration) noexcept
+{
+    epoll_event event{};
+    event.events  = events(registration);
+    event.data.fd = handle;
+
+    // a socket stays registered after its first wait, unless it was closed in between
+    if (::epoll_ctl(_poller, EPOLL_CTL_MOD, handle, &event) == 0)
+    {
+        return 0;
+    }
+    if ((errno == ENOENT) && (::epoll_ctl(_poller, EPOLL_CTL_ADD, handle, &event) == 0))
+    {
+        return 0;
+    }
+    return errno;
+}
+
+errno_t Reactor::arm(Readiness &readiness) noexcept
+{
+    std::lock_guard<std::mutex> lock{_thread.mutex};
+    if (_thread.shutdownFlag)
+    {
+        return ECANCELED;
+    }
+    auto &registration = _registrations[readiness._handle];
+    auto &slot         = readiness._write ? registration.writer : registration.reader;
+    if (slot != nullptr)
+    {
+        return EBUSY;
+    }
+    slot             = &readiness;
+    auto const error = update(readiness._handle, registration);
+    if (error != 0)
+    {
+        slot = nullptr;
+        if ((registration.reader == nullptr) && (registration.writer == nullptr))
+        {
+            _registrations.erase(readiness._handle);
+        }
+    }
+    return error;
+}
+
+void Reactor::run() noexcept
+{
+    std::array<epoll_event, EventsPerWakeUp> events{};
+    while (!_thread.shutdownFlag)
+    {
+        auto const count = ::epoll_wait(_poller, events.data(), EventsPerWakeUp, -1);
+        for (auto i = 0; i < count; ++i)
+        {
+            auto const handle = events[i].data.fd;
+            if (handle == _wakeUp)
+            {
+                std::uint64_t value{};
+                [[maybe_unused]] auto const read = ::read(_wakeUp, &value, sizeof(value));
+                continue;
+            }
+
+            // errors and hangups wake up both directions, they are reported to the coroutine by the call it retries
+            auto const ready  = events[i].events;
+            auto const failed = (ready & (EPOLLERR | EPOLLHUP)) != 0U;
+
+            Readiness *reader{};
+            Readiness *writer{};
+            {
+                std::lock_guard<std::mutex> lock{_thread.mutex};
+                auto const                  found = _registrations.find(handle);
+                if (found == _registrations.end())
+                {
+                    continue;
+                }
+                auto &registration = found->second;
+                if (failed || ((ready & EPOLLIN) != 0U))
+                {
+                    std::swap(reader, registration.reader);
+                }
+                if (failed || ((ready & EPOLLOUT) != 0U))
+                {
+                    std::swap(writer, registration.writer);
+                }
+
+                // the event disabled the registration, keep waiting for the other direction
+                if ((registration.reader == nullptr) && (registration.writer == nullptr))
+                {
+                    _registrations.erase(found);
+                }
+                else if (auto const error = update(handle, registration); error != 0)
+                {
+                    // the other direction can not be waited for anymore, report the error to its coroutine
+                    if (registration.reader != nullptr)
+                    {
+                        reader         = registration.reader;
+                        reader->_error = error;
+                    }
+                    else
+                    {
+                        writer         = registration.writer;
+                        writer->_error = error;
+                    }
+                    _registrations.erase(found);
+                }
+            }
+            for (auto *const readiness : {reader, writer})
+            {
+                if (readiness != nullptr)
+                {
+                    resume(readiness->_coroutine);
+                }
+            }
+        }
+    }
+}
+
+#else
+
+Reactor::Reactor(ThreadPool *const pool) noexcept : _pool{pool} {}
+
+Reactor::~Reactor() noexcept {}
+
+bool Reactor::good() const noexcept { return false; }
+
+void Reactor::stop() noexcept {}
+
+std::uint32_t Reactor::events(Registration const &) noexcept { return 0U; }
+
+errno_t Reactor::update(Internal::SocketHandleType, Registration const &) noexcept { return EOPNOTSUPP; }
+
+errno_t Reactor::arm(Readiness &) noexcept { return EOPNOTSUPP; }
+
+void Reactor::run() noexcept {}
+
+#endif // !__linux__
+
+} // namespace Terrahertz
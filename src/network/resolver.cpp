@@ -0,0 +1,172 @@
+#include "THzCommon/network/resolver.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Terrahertz {
+
+Resolver::Resolver(ResolverSettings const &settings) noexcept
+    : Resolver{settings, [](std::string_view const host) noexcept { return resolveIPAddresses(host); }}
+{}
+
+Resolver::Resolver(ResolverSettings const &settings, LookupFunction lookup) noexcept
+    : _settings{settings}, _lookup{std::move(lookup)}
+{
+    auto const workerCount = std::max(_settings.workerCount, std::size_t{1U});
+    for (auto i = 0U; i < workerCount; ++i)
+    {
+        auto &worker          = *_workers.emplace_back(std::make_unique<Worker>());
+        worker.control.thread = std::thread{[this, &worker]() noexcept { serve(worker); }};
+    }
+}
+
+Resolver::~Resolver() noexcept
+{
+    for (auto &worker : _workers)
+    {
+        {
+            // set the flag while holding the mutex, so the worker can not miss the wake up
+            WorkerThread::UniqueLock lock{worker->control.mutex};
+            worker->control.shutdownFlag = true;
+        }
+        worker->control.shutdown();
+    }
+    for (auto &worker : _workers)
+    {
+        for (auto const &host : worker->queue)
+        {
+            complete(host, {}, false);
+        }
+    }
+}
+
+std::shared_future<Resolver::Addresses> Resolver::resolve(std::string_view const host) noexcept
+{
+    return enqueue(host, {});
+}
+
+void Resolver::resolve(std::string_view const host, Callback callback) noexcept
+{
+    enqueue(host, std::move(callback));
+}
+
+std::size_t Resolver::cacheSize() const noexcept
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _cache.size();
+}
+
+void Resolver::clearCache() noexcept
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    _index.clear();
+    _cache.clear();
+}
+
+std::shared_future<Resolver::Addresses> Resolver::enqueue(std::string_view const host, Callback callback) noexcept
+{
+    std::unique_lock<std::mutex> lock{_mutex};
+
+    auto const cached = _index.find(host);
+    if (cached != _index.end())
+    {
+        auto const entry = cached->second;
+        if (entry->expires > std::chrono::steady_clock::now())
+        {
+            _cache.splice(_cache.begin(), _cache, entry);
+
+            std::promise<Addresses> promise{};
+            promise.set_value(entry->addresses);
+            if (callback)
+            {
+                auto const addresses = entry->addresses;
+                lock.unlock();
+                callback(addresses);
+            }
+            return promise.get_future().share();
+        }
+        _cache.erase(entry);
+        _index.erase(cached);
+    }
+
+    auto pending = _pending.find(host);
+    if (pending == _pending.end())
+    {
+        pending                = _pending.emplace(std::string{host}, PendingLookup{}).first;
+        pending->second.future = pending->second.promise.get_future().share();
+
+        auto &worker = *_workers[_nextWorker++ % _workers.size()];
+        {
+            WorkerThread::UniqueLock workerLock{worker.control.mutex};
+            worker.queue.emplace_back(host);
+        }
+        worker.control.wakeUp.notify_one();
+    }
+    if (callback)
+    {
+        pending->second.callbacks.emplace_back(std::move(callback));
+    }
+    return pending->second.future;
+}
+
+void Resolver::serve(Worker &worker) noexcept
+{
+    WorkerThread::UniqueLock lock{worker.control.mutex};
+    for (;;)
+    {
+        worker.control.wakeUp.wait(lock, [&]() noexcept {
+            return worker.control.shutdownFlag || !worker.queue.empty();
+        });
+        if (worker.control.shutdownFlag)
+        {
+            return;
+        }
+        auto const host = std::move(worker.queue.front());
+        worker.queue.pop_front();
+        lock.unlock();
+
+        complete(host, _lookup(host), true);
+        lock.lock();
+    }
+}
+
+void Resolver::complete(std::string const &host, Addresses const &addresses, bool const cache) noexcept
+{
+    PendingLookup lookup{};
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+
+        if (cache && (_settings.capacity != 0U))
+        {
+            auto const timeToLive = addresses ? _settings.timeToLive : _settings.negativeTimeToLive;
+            _cache.emplace_front(CacheEntry{host, addresses, std::chrono::steady_clock::now() + timeToLive});
+            auto const [position, inserted] = _index.try_emplace(host, _cache.begin());
+            if (!inserted)
+            {
+                _cache.erase(position->second);
+                position->second = _cache.begin();
+            }
+            while (_cache.size() > _settings.capacity)
+            {
+                _index.erase(_cache.back().host);
+                _cache.pop_back();
+            }
+        }
+
+        auto const pending = _pending.find(host);
+        if (pending == _pending.end())
+        {
+            return;
+        }
+        lookup = std::move(pending->second);
+        _pending.erase(pending);
+    }
+
+    lookup.promise.set_value(addresses);
+    for (auto const &callback : lookup.callbacks)
+    {
+        callback(addresses);
+    }
+}
+
+} // namespace Terrahertz
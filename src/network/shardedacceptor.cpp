@@ -0,0 +1,225 @@
+#include "THzCommon/network/shardedacceptor.hpp"
+
+#include "privatecommon.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Terrahertz {
+
+/// @brief Pins the calling thread to the given core.
+///
+/// @param core The index of the core.
+/// @return True if the thread was pinned, false otherwise.
+static bool pinCurrentThread(std::size_t const core) noexcept
+{
+#ifdef __linux__
+    cpu_set_t cpuSet{};
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+    return false;
+#endif
+}
+
+/// @brief Returns the cores the process is allowed to run on.
+///
+/// @return The indices of the cores, empty if unknown.
+static std::vector<std::size_t> allowedCores() noexcept
+{
+    std::vector<std::size_t> cores{};
+#ifdef __linux__
+    cpu_set_t cpuSet{};
+    CPU_ZERO(&cpuSet);
+    if (::sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+    {
+        for (std::size_t core = 0U; core < CPU_SETSIZE; ++core)
+        {
+            if (CPU_ISSET(core, &cpuSet))
+            {
+                cores.emplace_back(core);
+            }
+        }
+    }
+#endif
+    return cores;
+}
+
+/// @brief Returns the local address the given socket is bound to.
+///
+/// @tparam TVersion The version of the internet protocol.
+/// @param handle The handle of the socket.
+/// @return The local address, if successful.
+template <IPVersion TVersion>
+static std::optional<Address<TVersion>> localAddress(Internal::SocketHandleType const handle) noexcept
+{
+    Internal::SockAddr<TVersion> addr{};
+    auto                         length = Internal::SockAddrLength<TVersion>;
+    if (::getsockname(handle, reinterpret_cast<sockaddr *>(&addr), &length) != 0)
+    {
+        return std::nullopt;
+    }
+    return Internal::convertSocketAddress(addr);
+}
+
+template <IPVersion TVersion>
+ShardedAcceptor<TVersion>::ShardedAcceptor(std::size_t const shardCount,
+                                           Handler           handler,
+                                           bool const        pinThreads) noexcept
+    : _handler{std::move(handler)}, _pinThreads{pinThreads}
+{
+    auto const count = (shardCount != 0U) ? shardCount : std::max(std::thread::hardware_concurrency(), 1U);
+    for (auto i = 0U; i < count; ++i)
+    {
+        _shards.emplace_back(std::make_unique<Shard>());
+    }
+}
+
+template <IPVersion TVersion>
+ShardedAcceptor<TVersion>::~ShardedAcceptor() noexcept
+{
+    stop();
+}
+
+template <IPVersion TVersion>
+bool ShardedAcceptor<TVersion>::start(Address<TVersion> const &address, std::uint32_t const backlog) noexcept
+{
+    if (_running)
+    {
+        return false;
+    }
+    _address = address;
+    for (auto &shard : _shards)
+    {
+        shard->listener = TCPSocket<TVersion>{};
+        shard->accepted = 0U;
+
+        // non-blocking, so draining the backlog ends once it is empty
+        auto &listener = shard->listener;
+        auto bound = listener.good() && listener.setReuseAddr(true) && listener.setReusePort(true) &&
+                     listener.bind(_address) && listener.listen(backlog) && listener.setNonblocking(true);
+
+        // an ephemeral port is shared by all shards, otherwise each would bind its own
+        if (bound && (_address.port == 0U))
+        {
+            auto const local = localAddress<TVersion>(listener.handle());
+            bound            = local.has_value();
+            _address.port    = bound ? local->port : 0U;
+        }
+        if (!bound)
+        {
+            for (auto &opened : _shards)
+            {
+                opened->listener.close();
+            }
+            return false;
+        }
+    }
+
+    auto cores = allowedCores();
+    if (cores.empty())
+    {
+        cores.emplace_back(0U);
+    }
+    _running = true;
+    for (auto i = 0U; i < _shards.size(); ++i)
+    {
+        auto const core                  = cores[i % cores.size()];
+        _shards[i]->pinned               = false;
+        _shards[i]->control.shutdownFlag = false;
+        _shards[i]->control.thread       = std::thread{[this, i, core]() noexcept { serve(i, core); }};
+    }
+    return true;
+}
+
+template <IPVersion TVersion>
+void ShardedAcceptor<TVersion>::stop() noexcept
+{
+    for (auto &shard : _shards)
+    {
+        shard->control.shutdown();
+        shard->listener.close();
+    }
+    _running = false;
+}
+
+template <IPVersion TVersion>
+Address<TVersion> ShardedAcceptor<TVersion>::address() const noexcept
+{
+    return _address;
+}
+
+template <IPVersion TVersion>
+bool ShardedAcceptor<TVersion>::isPinned(std::size_t const shard) const noexcept
+{
+    return (shard < _shards.size()) && _shards[shard]->pinned.load();
+}
+
+template <IPVersion TVersion>
+std::size_t ShardedAcceptor<TVersion>::shardCount() const noexcept
+{
+    return _shards.size();
+}
+
+template <IPVersion TVersion>
+std::uint64_t ShardedAcceptor<TVersion>::acceptedConnections(std::size_t const shard) const noexcept
+{
+    return (shard < _shards.size()) ? _shards[shard]->accepted.load() : 0U;
+}
+
+template <IPVersion TVersion>
+std::vector<std::uint64_t> ShardedAcceptor<TVersion>::acceptedConnectionsPerShard() const noexcept
+{
+    std::vector<std::uint64_t> result{};
+    result.reserve(_shards.size());
+    for (auto const &shard : _shards)
+    {
+        result.emplace_back(shard->accepted.load());
+    }
+    return result;
+}
+
+template <IPVersion TVersion>
+void ShardedAcceptor<TVersion>::serve(std::size_t const index, std::size_t const core) noexcept
+{
+    auto &shard = *_shards[index];
+    if (_pinThreads)
+    {
+        shard.pinned = pinCurrentThread(core);
+    }
+
+    auto const timeout = static_cast<int>(PollInterval.count());
+    while (!shard.control.shutdownFlag)
+    {
+        if (!Internal::pollRead(shard.listener.handle(), timeout))
+        {
+            continue;
+        }
+
+        // drain the backlog before polling again
+        for (;;)
+        {
+            Address<TVersion> peer{};
+            auto              connection = shard.listener.accept(&peer);
+            if (!connection.good())
+            {
+                break;
+            }
+            ++shard.accepted;
+            _handler(std::move(connection), peer, index);
+        }
+    }
+}
+
+template class ShardedAcceptor<IPVersion::V4>;
+template class ShardedAcceptor<IPVersion::V6>;
+
+} // namespace Terrahertz
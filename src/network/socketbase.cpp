@@ -7,39 +7,55 @@
 namespace Terrahertz {
 namespace Internal {
 
-template <IPVersion TVersion, Protocol TProtocol>
-SocketBase<TVersion, TProtocol>::SocketBase(Internal::SocketApi const &) noexcept
+/// @brief The level of the option setting the type of service field.
+template <IPVersion TVersion>
+inline auto constexpr TypeOfServiceLevel = IPPROTO_IP;
+
+template <>
+inline auto constexpr TypeOfServiceLevel<IPVersion::V6> = IPPROTO_IPV6;
+
+/// @brief The name of the option setting the type of service field.
+template <IPVersion TVersion>
+inline auto constexpr TypeOfServiceName = IP_TOS;
+
+template <>
+inline auto constexpr TypeOfServiceName<IPVersion::V6> = IPV6_TCLASS;
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+SocketBase<TVersion, TProtocol, TInstrumentation>::SocketBase(Internal::SocketApi const &) noexcept
     : _handle{socket(AddressFamily<TVersion>, SocketType<TProtocol>, ProtocolType<TProtocol>)}
 {}
 
-template <IPVersion TVersion, Protocol TProtocol>
-SocketBase<TVersion, TProtocol>::SocketBase(SocketBase<TVersion, TProtocol> &&other) noexcept : _handle{other._handle}
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+SocketBase<TVersion, TProtocol, TInstrumentation>::SocketBase(SocketBase &&other) noexcept
+    : _handle{other._handle}, _instrumentation{std::move(other._instrumentation)}
 {
     other._handle = SocketTraits::InvalidValue;
 }
 
-template <IPVersion TVersion, Protocol TProtocol>
-SocketBase<TVersion, TProtocol> &
-SocketBase<TVersion, TProtocol>::operator=(SocketBase<TVersion, TProtocol> &&other) noexcept
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+SocketBase<TVersion, TProtocol, TInstrumentation> &
+SocketBase<TVersion, TProtocol, TInstrumentation>::operator=(SocketBase &&other) noexcept
 {
     std::swap(_handle, other._handle);
+    std::swap(_instrumentation, other._instrumentation);
     return *this;
 }
 
-template <IPVersion TVersion, Protocol TProtocol>
-SocketBase<TVersion, TProtocol>::~SocketBase() noexcept
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+SocketBase<TVersion, TProtocol, TInstrumentation>::~SocketBase() noexcept
 {
     close();
 }
 
-template <IPVersion TVersion, Protocol TProtocol>
-SocketHandleType SocketBase<TVersion, TProtocol>::handle() const noexcept
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+SocketHandleType SocketBase<TVersion, TProtocol, TInstrumentation>::handle() const noexcept
 {
     return _handle;
 }
 
-template <IPVersion TVersion, Protocol TProtocol>
-bool SocketBase<TVersion, TProtocol>::bind(Address<TVersion> const &to) noexcept
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::bind(Address<TVersion> const &to) noexcept
 {
     auto const address = convertSocketAddress(to);
     auto const result =
@@ -47,34 +63,206 @@ bool SocketBase<TVersion, TProtocol>::bind(Address<TVersion> const &to) noexcept
     return result != -1;
 }
 
-template <IPVersion TVersion, Protocol TProtocol>
-bool SocketBase<TVersion, TProtocol>::setReuseAddr(bool const reuse) noexcept
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setReuseAddr(bool const reuse) noexcept
 {
-    int        value{reuse ? 1 : 0};
-    auto const result = ::setsockopt(_handle,
-                                     SOL_SOCKET,
-                                     SO_REUSEADDR,
-                                     reinterpret_cast<SocketTraits::SendBufferType>(&value),
-                                     static_cast<SocketTraits::SockLengthType>(sizeof(value)));
-    return result != -1;
+    return setOption(_handle, SOL_SOCKET, SO_REUSEADDR, reuse);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<bool> SocketBase<TVersion, TProtocol, TInstrumentation>::getReuseAddr() noexcept
+{
+    return getOption<bool>(_handle, SOL_SOCKET, SO_REUSEADDR);
+}
+
+#ifdef _WIN32
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setReusePort(bool const) noexcept
+{
+    return false;
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<bool> SocketBase<TVersion, TProtocol, TInstrumentation>::getReusePort() noexcept
+{
+    return Result<bool>::error(EOPNOTSUPP);
+}
+
+#else
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setReusePort(bool const reuse) noexcept
+{
+    return setOption(_handle, SOL_SOCKET, SO_REUSEPORT, reuse);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<bool> SocketBase<TVersion, TProtocol, TInstrumentation>::getReusePort() noexcept
+{
+    return getOption<bool>(_handle, SOL_SOCKET, SO_REUSEPORT);
+}
+
+#endif // !_WIN32
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setReceiveBufferSize(std::size_t const size) noexcept
+{
+    return setOption(_handle, SOL_SOCKET, SO_RCVBUF, size);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<std::size_t> SocketBase<TVersion, TProtocol, TInstrumentation>::getReceiveBufferSize() noexcept
+{
+    return getOption<std::size_t>(_handle, SOL_SOCKET, SO_RCVBUF);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setSendBufferSize(std::size_t const size) noexcept
+{
+    return setOption(_handle, SOL_SOCKET, SO_SNDBUF, size);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<std::size_t> SocketBase<TVersion, TProtocol, TInstrumentation>::getSendBufferSize() noexcept
+{
+    return getOption<std::size_t>(_handle, SOL_SOCKET, SO_SNDBUF);
+}
+
+#ifdef __linux__
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setBusyPoll(std::chrono::microseconds const duration) noexcept
+{
+    return setOption(_handle, SOL_SOCKET, SO_BUSY_POLL, duration.count());
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<std::chrono::microseconds> SocketBase<TVersion, TProtocol, TInstrumentation>::getBusyPoll() noexcept
+{
+    return getOption<std::chrono::microseconds>(_handle, SOL_SOCKET, SO_BUSY_POLL);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setPriority(std::uint32_t const priority) noexcept
+{
+    return setOption(_handle, SOL_SOCKET, SO_PRIORITY, priority);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<std::uint32_t> SocketBase<TVersion, TProtocol, TInstrumentation>::getPriority() noexcept
+{
+    return getOption<std::uint32_t>(_handle, SOL_SOCKET, SO_PRIORITY);
 }
 
-template <IPVersion TVersion, Protocol TProtocol>
-Result<bool> SocketBase<TVersion, TProtocol>::getReuseAddr() noexcept
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setTimestamping(std::uint32_t const flags) noexcept
 {
-    int        reuse{};
-    auto       length{static_cast<SocketTraits::SockLengthType>(sizeof(reuse))};
-    auto const result = ::getsockopt(
-        _handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<SocketTraits::RecvBufferType>(&reuse), &length);
-    if (result == -1)
+    return setOption(_handle, SOL_SOCKET, SO_TIMESTAMPING, flags);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<std::uint32_t> SocketBase<TVersion, TProtocol, TInstrumentation>::getTimestamping() noexcept
+{
+    return getOption<std::uint32_t>(_handle, SOL_SOCKET, SO_TIMESTAMPING);
+}
+
+#else
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setBusyPoll(std::chrono::microseconds const) noexcept
+{
+    return false;
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<std::chrono::microseconds> SocketBase<TVersion, TProtocol, TInstrumentation>::getBusyPoll() noexcept
+{
+    return Result<std::chrono::microseconds>::error(EOPNOTSUPP);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setPriority(std::uint32_t const) noexcept
+{
+    return false;
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<std::uint32_t> SocketBase<TVersion, TProtocol, TInstrumentation>::getPriority() noexcept
+{
+    return Result<std::uint32_t>::error(EOPNOTSUPP);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setTimestamping(std::uint32_t const) noexcept
+{
+    return false;
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<std::uint32_t> SocketBase<TVersion, TProtocol, TInstrumentation>::getTimestamping() noexcept
+{
+    return Result<std::uint32_t>::error(EOPNOTSUPP);
+}
+
+#endif // !__linux__
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setTypeOfService(std::uint8_t const typeOfService) noexcept
+{
+    return setOption(_handle, TypeOfServiceLevel<TVersion>, TypeOfServiceName<TVersion>, typeOfService);
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<std::uint8_t> SocketBase<TVersion, TProtocol, TInstrumentation>::getTypeOfService() noexcept
+{
+    return getOption<std::uint8_t>(_handle, TypeOfServiceLevel<TVersion>, TypeOfServiceName<TVersion>);
+}
+
+#ifdef _WIN32
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setNonblocking(bool const nonblocking) noexcept
+{
+    u_long mode{nonblocking ? 1UL : 0UL};
+    return ::ioctlsocket(_handle, FIONBIO, &mode) == 0;
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<bool> SocketBase<TVersion, TProtocol, TInstrumentation>::getNonblocking() noexcept
+{
+    // winsock offers no way to query the mode
+    return Result<bool>::error(EOPNOTSUPP);
+}
+
+#else
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::setNonblocking(bool const nonblocking) noexcept
+{
+    auto const flags = ::fcntl(_handle, F_GETFL);
+    if (flags == -1)
+    {
+        return false;
+    }
+    return ::fcntl(_handle, F_SETFL, nonblocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK)) != -1;
+}
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+Result<bool> SocketBase<TVersion, TProtocol, TInstrumentation>::getNonblocking() noexcept
+{
+    auto const flags = ::fcntl(_handle, F_GETFL);
+    if (flags == -1)
     {
         return Result<bool>::error();
     }
-    return reuse == 1;
+    return (flags & O_NONBLOCK) != 0;
 }
 
-template <IPVersion TVersion, Protocol TProtocol>
-void SocketBase<TVersion, TProtocol>::close() noexcept
+#endif // !_WIN32
+
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+void SocketBase<TVersion, TProtocol, TInstrumentation>::close() noexcept
 {
     if (_handle != SocketTraits::InvalidValue)
     {
@@ -87,8 +275,8 @@ void SocketBase<TVersion, TProtocol>::close() noexcept
     _handle = SocketTraits::InvalidValue;
 }
 
-template <IPVersion TVersion, Protocol TProtocol>
-bool SocketBase<TVersion, TProtocol>::good() noexcept
+template <IPVersion TVersion, Protocol TProtocol, typename TInstrumentation>
+bool SocketBase<TVersion, TProtocol, TInstrumentation>::good() noexcept
 {
     return _handle != SocketTraits::InvalidValue;
 }
@@ -97,6 +285,10 @@ template class SocketBase<IPVersion::V4, Protocol::UDP>;
 template class SocketBase<IPVersion::V4, Protocol::TCP>;
 template class SocketBase<IPVersion::V6, Protocol::UDP>;
 template class SocketBase<IPVersion::V6, Protocol::TCP>;
+template class SocketBase<IPVersion::V4, Protocol::UDP, SocketInstrumentation>;
+template class SocketBase<IPVersion::V4, Protocol::TCP, SocketInstrumentation>;
+template class SocketBase<IPVersion::V6, Protocol::UDP, SocketInstrumentation>;
+template class SocketBase<IPVersion::V6, Protocol::TCP, SocketInstrumentation>;
 
 } // namespace Internal
 } // namespace Terrahertz
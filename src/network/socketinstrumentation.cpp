@@ -0,0 +1,206 @@
+#include "THzCommon/network/socketinstrumentation.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+
+namespace Terrahertz {
+
+LatencyHistogram::LatencyHistogram(LatencyHistogram const &other) noexcept
+{
+    *this = other;
+}
+
+LatencyHistogram &LatencyHistogram::operator=(LatencyHistogram const &other) noexcept
+{
+    for (auto i = 0U; i < BucketCount; ++i)
+    {
+        _buckets[i].store(other._buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    _count.store(other._count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _max.store(other._max.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds const latency) noexcept
+{
+    auto const value = static_cast<std::uint64_t>(std::max(latency.count(), std::chrono::nanoseconds::rep{}));
+    _buckets[bucketOf(value)].fetch_add(1U, std::memory_order_relaxed);
+    _count.fetch_add(1U, std::memory_order_relaxed);
+
+    auto max = _max.load(std::memory_order_relaxed);
+    while ((value > max) && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {}
+}
+
+std::uint64_t LatencyHistogram::count() const noexcept
+{
+    return _count.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double const percentile) const noexcept
+{
+    auto const count = _count.load(std::memory_order_relaxed);
+    if (count == 0U)
+    {
+        return {};
+    }
+    auto const rank = std::max(
+        static_cast<std::uint64_t>((std::clamp(percentile, 0.0, 100.0) / 100.0) * static_cast<double>(count)),
+        std::uint64_t{1U});
+
+    std::uint64_t seen{};
+    for (auto i = 0U; i < BucketCount; ++i)
+    {
+        seen += _buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return std::chrono::nanoseconds{std::min(highestValueOf(i), _max.load(std::memory_order_relaxed))};
+        }
+    }
+    return max();
+}
+
+std::chrono::nanoseconds LatencyHistogram::max() const noexcept
+{
+    return std::chrono::nanoseconds{_max.load(std::memory_order_relaxed)};
+}
+
+void LatencyHistogram::reset() noexcept
+{
+    for (auto &bucket : _buckets)
+    {
+        bucket.store(0U, std::memory_order_relaxed);
+    }
+    _count.store(0U, std::memory_order_relaxed);
+    _max.store(0U, std::memory_order_relaxed);
+}
+
+std::size_t LatencyHistogram::bucketOf(std::uint64_t const value) noexcept
+{
+    if (value < SubBucketCount)
+    {
+        return static_cast<std::size_t>(value);
+    }
+    // the magnitude selects the power of two, the bits below the leading one select the sub-bucket
+    auto const magnitude = static_cast<std::size_t>(std::bit_width(value)) - 1U;
+    auto const subBucket = static_cast<std::size_t>(value >> (magnitude - SubBucketBits)) & (SubBucketCount - 1U);
+    return ((magnitude - SubBucketBits + 1U) * SubBucketCount) + subBucket;
+}
+
+std::uint64_t LatencyHistogram::highestValueOf(std::size_t const bucket) noexcept
+{
+    if (bucket < SubBucketCount)
+    {
+        return bucket;
+    }
+    auto const shift  = (bucket / SubBucketCount) - 1U;
+    auto const lowest = static_cast<std::uint64_t>(SubBucketCount + (bucket % SubBucketCount)) << shift;
+    return lowest + ((std::uint64_t{1U} << shift) - 1U);
+}
+
+SocketInstrumentation::Counters::Counters(Counters const &other) noexcept
+{
+    *this = other;
+}
+
+SocketInstrumentation::Counters &SocketInstrumentation::Counters::operator=(Counters const &other) noexcept
+{
+    messages.store(other.messages.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    bytes.store(other.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    wouldBlock.store(other.wouldBlock.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    errors.store(other.errors.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    latency = other.latency;
+    return *this;
+}
+
+void SocketInstrumentation::record(SocketOperation const operation,
+                                   Measurement const     start,
+                                   std::size_t const     bytes,
+                                   errno_t const         error) noexcept
+{
+    auto &counters = _operations[static_cast<std::size_t>(operation)];
+    counters.latency.record(std::chrono::steady_clock::now() - start);
+    if (error == 0)
+    {
+        counters.messages.fetch_add(1U, std::memory_order_relaxed);
+        counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    else if ((error == EAGAIN) || (error == EWOULDBLOCK))
+    {
+        counters.wouldBlock.fetch_add(1U, std::memory_order_relaxed);
+    }
+    else
+    {
+        counters.errors.fetch_add(1U, std::memory_order_relaxed);
+    }
+}
+
+SocketStatistics SocketInstrumentation::snapshot() const noexcept
+{
+    auto const convert = [](Counters const &counters) noexcept {
+        OperationStatistics result{};
+        result.messages   = counters.messages.load(std::memory_order_relaxed);
+        result.bytes      = counters.bytes.load(std::memory_order_relaxed);
+        result.wouldBlock = counters.wouldBlock.load(std::memory_order_relaxed);
+        result.errors     = counters.errors.load(std::memory_order_relaxed);
+        result.p50        = counters.latency.percentile(50.0);
+        result.p90        = counters.latency.percentile(90.0);
+        result.p99        = counters.latency.percentile(99.0);
+        result.p999       = counters.latency.percentile(99.9);
+        result.max        = counters.latency.max();
+        return result;
+    };
+    return {convert(_operations[static_cast<std::size_t>(SocketOperation::Send)]),
+            convert(_operations[static_cast<std::size_t>(SocketOperation::Receive)])};
+}
+
+void SocketInstrumentation::reset() noexcept
+{
+    for (auto &counters : _operations)
+    {
+        counters.messages.store(0U, std::memory_order_relaxed);
+        counters.bytes.store(0U, std::memory_order_relaxed);
+        counters.wouldBlock.store(0U, std::memory_order_relaxed);
+        counters.errors.store(0U, std::memory_order_relaxed);
+        counters.latency.reset();
+    }
+}
+
+/// @brief Appends the given statistics of an operation to the given text.
+///
+/// @param text The text to append to.
+/// @param name The name of the operation.
+/// @param statistics The statistics to append.
+static void appendStatistics(std::string &text, std::string_view const name, OperationStatistics const &statistics)
+{
+    text += name;
+    text += ": " + std::to_string(statistics.messages) + " msgs, ";
+    text += std::to_string(statistics.bytes) + " bytes, ";
+    text += std::to_string(statistics.wouldBlock) + " EAGAIN, ";
+    text += std::to_string(statistics.errors) + " errors, latency [ns] p50 ";
+    text += std::to_string(statistics.p50.count()) + " p90 ";
+    text += std::to_string(statistics.p90.count()) + " p99 ";
+    text += std::to_string(statistics.p99.count()) + " p99.9 ";
+    text += std::to_string(statistics.p999.count()) + " max ";
+    text += std::to_string(statistics.max.count());
+}
+
+std::string toString(SocketStatistics const &statistics) noexcept
+{
+    std::string text{};
+    appendStatistics(text, "send", statistics.send);
+    text += "; ";
+    appendStatistics(text, "receive", statistics.receive);
+    return text;
+}
+
+void logStatistics(SocketStatistics const &statistics, std::string_view const socketName, Logger &logger) noexcept
+{
+    std::string text{socketName};
+    text += ' ';
+    text += toString(statistics);
+    logger.log<LogLevel::Info, NetworkProject>(text);
+}
+
+} // namespace Terrahertz
@@ -2,35 +2,128 @@
 
 #include "privatecommon.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/errqueue.h>
+#endif
+
 namespace Terrahertz {
 
 using SockTraits = Internal::SocketTraits;
 
+#ifdef _WIN32
+using IOVector = WSABUF;
+#else
+using IOVector = iovec;
+#endif
+
+/// @brief Fills the given system vectors with the given buffers.
+///
+/// @tparam TBuffer The type of buffer to convert.
+/// @tparam TVectorCount The number of available vectors.
+/// @param buffers The buffers to put into the vectors.
+/// @param vectors The vectors to fill.
+/// @return The number of vectors used.
+template <typename TBuffer, std::size_t TVectorCount>
+static std::size_t fillVectors(std::span<TBuffer const> const      buffers,
+                               std::array<IOVector, TVectorCount> &vectors) noexcept
+{
+    auto const count = std::min(buffers.size(), vectors.size());
+    for (std::size_t i = 0U; i < count; ++i)
+    {
+        // the system structures are not const correct, the send calls do not write to the buffers though
+        auto const data = const_cast<std::byte *>(buffers[i].data());
+#ifdef _WIN32
+        vectors[i].buf = reinterpret_cast<CHAR *>(data);
+        vectors[i].len = static_cast<ULONG>(buffers[i].size_bytes());
+#else
+        vectors[i].iov_base = data;
+        vectors[i].iov_len  = buffers[i].size_bytes();
+#endif
+    }
+    return count;
+}
+
+/// @brief Records the outcome of a vectored call with the instrumentation of the socket.
+///
+/// @tparam TInstrumentation The type of the instrumentation.
+/// @param instrumentation The instrumentation of the socket.
+/// @param operation The type of the operation.
+/// @param start The start of the operation.
+/// @param result The result of the call.
+/// @return The result of the call.
+template <typename TInstrumentation>
+static Result<std::size_t> recordResult(TInstrumentation                           &instrumentation,
+                                        SocketOperation const                       operation,
+                                        typename TInstrumentation::Measurement const start,
+                                        Result<std::size_t> const                   result) noexcept
+{
+    instrumentation.record(operation, start, result.isError() ? 0U : result.value(), result.errorCode());
+    return result;
+}
+
+#ifndef _WIN32
+
+/// @brief Performs a sendmsg call using the given buffers.
+///
+/// @tparam TVersion The version of the internet protocol.
+/// @param handle The handle of the socket to send the data on.
+/// @param buffers The buffers containing the data to send.
+/// @param flags The flags for the sendmsg call.
+/// @return The number of transmitted bytes.
 template <IPVersion TVersion>
-bool TCPSocket<TVersion>::listen(std::uint32_t const backlog) noexcept
+static Result<std::size_t> sendMessage(Internal::SocketHandleType const                  handle,
+                                       std::span<std::span<std::byte const> const> const buffers,
+                                       int const                                         flags) noexcept
+{
+    std::array<IOVector, TCPSocket<TVersion>::VectorLimit> vectors{};
+
+    msghdr message{};
+    message.msg_iov    = vectors.data();
+    message.msg_iovlen = fillVectors(buffers, vectors);
+
+    auto const result = ::sendmsg(handle, &message, flags);
+    if (result == -1)
+    {
+        return Result<std::size_t>::error();
+    }
+    return static_cast<std::size_t>(result);
+}
+
+#endif // !_WIN32
+
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::listen(std::uint32_t const backlog) noexcept
 {
     return ::listen(this->_handle, static_cast<int>(backlog & std::numeric_limits<int>::max())) != -1;
 }
 
-template <IPVersion TVersion>
-bool TCPSocket<TVersion>::acceptIsNonblocking() const noexcept
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::acceptIsNonblocking() const noexcept
 {
     return Internal::pollRead(this->_handle);
 }
 
-template <IPVersion TVersion>
-TCPSocket<TVersion> TCPSocket<TVersion>::accept(Address<TVersion> *address) noexcept
+template <IPVersion TVersion, typename TInstrumentation>
+TCPSocket<TVersion, TInstrumentation> TCPSocket<TVersion, TInstrumentation>::accept(Address<TVersion> *address) noexcept
 {
     Internal::SockAddr<TVersion> addr{};
 
     auto addrLength = Internal::SockAddrLength<TVersion>;
 
     auto const result = ::accept(this->_handle, reinterpret_cast<sockaddr *>(&addr), &addrLength);
+    if ((result != SockTraits::InvalidValue) && (address != nullptr))
+    {
+        *address = Internal::convertSocketAddress(addr);
+    }
     return TCPSocket(result);
 }
 
-template <IPVersion TVersion>
-bool TCPSocket<TVersion>::connect(Address<TVersion> const &address) noexcept
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::connect(Address<TVersion> const &address) noexcept
 {
     auto const addr = Internal::convertSocketAddress(address);
     auto const result =
@@ -38,8 +131,32 @@ bool TCPSocket<TVersion>::connect(Address<TVersion> const &address) noexcept
     return result != -1;
 }
 
-template <IPVersion TVersion>
-bool TCPSocket<TVersion>::shutdown(int what) noexcept
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::setNoDelay(bool const noDelay) noexcept
+{
+    return Internal::setOption(this->_handle, IPPROTO_TCP, TCP_NODELAY, noDelay);
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<bool> TCPSocket<TVersion, TInstrumentation>::getNoDelay() noexcept
+{
+    return Internal::getOption<bool>(this->_handle, IPPROTO_TCP, TCP_NODELAY);
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::setKeepAlive(bool const keepAlive) noexcept
+{
+    return Internal::setOption(this->_handle, SOL_SOCKET, SO_KEEPALIVE, keepAlive);
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<bool> TCPSocket<TVersion, TInstrumentation>::getKeepAlive() noexcept
+{
+    return Internal::getOption<bool>(this->_handle, SOL_SOCKET, SO_KEEPALIVE);
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::shutdown(int what) noexcept
 {
 #ifdef _WIN32
     auto const how = SD_BOTH;
@@ -49,47 +166,300 @@ bool TCPSocket<TVersion>::shutdown(int what) noexcept
     return ::shutdown(this->_handle, how) != -1;
 }
 
-template <IPVersion TVersion>
-bool TCPSocket<TVersion>::receiveIsNonblocking() const noexcept
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::receiveIsNonblocking() const noexcept
 {
     return Internal::pollRead(this->_handle);
 }
 
-template <IPVersion TVersion>
-Result<std::span<std::byte>> TCPSocket<TVersion>::receive(std::span<std::byte> buffer) noexcept
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::span<std::byte>> TCPSocket<TVersion, TInstrumentation>::receive(std::span<std::byte> buffer) noexcept
 {
+    auto const start  = this->_instrumentation.start();
     auto const result = ::recv(this->_handle,
                                reinterpret_cast<SockTraits::RecvBufferType>(buffer.data()),
                                static_cast<SockTraits::BufferLength>(buffer.size_bytes()),
                                0);
     if (result == -1)
     {
-        return Result<std::span<std::byte>>::error();
+        auto const code = errno;
+        this->_instrumentation.record(SocketOperation::Receive, start, 0U, code);
+        return Result<std::span<std::byte>>::error(code);
     }
+    this->_instrumentation.record(SocketOperation::Receive, start, static_cast<std::size_t>(result), 0);
     return buffer.first(result);
 }
 
-template <IPVersion TVersion>
-bool TCPSocket<TVersion>::sendIsNonblocking() const noexcept
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::sendIsNonblocking() const noexcept
 {
     return Internal::pollWrite(this->_handle);
 }
 
-template <IPVersion TVersion>
-Result<std::size_t> TCPSocket<TVersion>::send(std::span<std::byte const> buffer) noexcept
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::size_t> TCPSocket<TVersion, TInstrumentation>::send(std::span<std::byte const> buffer) noexcept
 {
+    auto const start  = this->_instrumentation.start();
     auto const result = ::send(this->_handle,
                                reinterpret_cast<SockTraits::SendBufferType>(buffer.data()),
                                static_cast<SockTraits::BufferLength>(buffer.size_bytes()),
                                0);
     if (result == -1)
     {
-        return Result<std::size_t>::error();
+        auto const code = errno;
+        this->_instrumentation.record(SocketOperation::Send, start, 0U, code);
+        return Result<std::size_t>::error(code);
     }
+    this->_instrumentation.record(SocketOperation::Send, start, static_cast<std::size_t>(result), 0);
     return static_cast<std::size_t>(result);
 }
 
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::size_t>
+TCPSocket<TVersion, TInstrumentation>::receivev(std::span<std::span<std::byte> const> buffers) noexcept
+{
+    std::array<IOVector, VectorLimit> vectors{};
+
+    auto const count = fillVectors(buffers, vectors);
+    auto const start = this->_instrumentation.start();
+#ifdef _WIN32
+    DWORD      received{};
+    DWORD      flags{};
+    auto const result = ::WSARecv(
+        this->_handle, vectors.data(), static_cast<DWORD>(count), &received, &flags, nullptr, nullptr);
+    if (result == SOCKET_ERROR)
+    {
+        return recordResult(
+            this->_instrumentation, SocketOperation::Receive, start, Result<std::size_t>::error(::WSAGetLastError()));
+    }
+    return recordResult(this->_instrumentation, SocketOperation::Receive, start, static_cast<std::size_t>(received));
+#else
+    msghdr message{};
+    message.msg_iov    = vectors.data();
+    message.msg_iovlen = count;
+
+    auto const result = ::recvmsg(this->_handle, &message, 0);
+    if (result == -1)
+    {
+        return recordResult(this->_instrumentation, SocketOperation::Receive, start, Result<std::size_t>::error());
+    }
+    return recordResult(this->_instrumentation, SocketOperation::Receive, start, static_cast<std::size_t>(result));
+#endif
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::size_t>
+TCPSocket<TVersion, TInstrumentation>::sendv(std::span<std::span<std::byte const> const> buffers) noexcept
+{
+#ifdef _WIN32
+    std::array<IOVector, VectorLimit> vectors{};
+
+    auto const count = fillVectors(buffers, vectors);
+    auto const start = this->_instrumentation.start();
+    DWORD      sent{};
+    auto const result =
+        ::WSASend(this->_handle, vectors.data(), static_cast<DWORD>(count), &sent, 0, nullptr, nullptr);
+    if (result == SOCKET_ERROR)
+    {
+        return recordResult(
+            this->_instrumentation, SocketOperation::Send, start, Result<std::size_t>::error(::WSAGetLastError()));
+    }
+    return recordResult(this->_instrumentation, SocketOperation::Send, start, static_cast<std::size_t>(sent));
+#else
+    auto const start = this->_instrumentation.start();
+    return recordResult(
+        this->_instrumentation, SocketOperation::Send, start, sendMessage<TVersion>(this->_handle, buffers, 0));
+#endif
+}
+
+#ifdef __linux__
+
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::setZeroCopy(bool const enable) noexcept
+{
+    return Internal::setOption(this->_handle, SOL_SOCKET, SO_ZEROCOPY, enable);
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::setQuickAck(bool const quickAck) noexcept
+{
+    return Internal::setOption(this->_handle, IPPROTO_TCP, TCP_QUICKACK, quickAck);
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<bool> TCPSocket<TVersion, TInstrumentation>::getQuickAck() noexcept
+{
+    return Internal::getOption<bool>(this->_handle, IPPROTO_TCP, TCP_QUICKACK);
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::size_t>
+TCPSocket<TVersion, TInstrumentation>::sendvZeroCopy(std::span<std::span<std::byte const> const> buffers) noexcept
+{
+    auto const start = this->_instrumentation.start();
+    return recordResult(this->_instrumentation,
+                        SocketOperation::Send,
+                        start,
+                        sendMessage<TVersion>(this->_handle, buffers, MSG_ZEROCOPY));
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<ZeroCopyCompletion> TCPSocket<TVersion, TInstrumentation>::pollZeroCopyCompletion() noexcept
+{
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(sock_extended_err))> control{};
+
+    msghdr message{};
+    message.msg_control    = control.data();
+    message.msg_controllen = control.size();
+
+    if (::recvmsg(this->_handle, &message, MSG_ERRQUEUE | MSG_DONTWAIT) == -1)
+    {
+        return Result<ZeroCopyCompletion>::error();
+    }
+    for (auto cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR(&message, cmsg))
+    {
+        sock_extended_err error{};
+        std::memcpy(&error, CMSG_DATA(cmsg), sizeof(error));
+        if ((error.ee_errno == 0) && (error.ee_origin == SO_EE_ORIGIN_ZEROCOPY))
+        {
+            auto const copied = (error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+            return ZeroCopyCompletion{error.ee_info, error.ee_data, copied};
+        }
+    }
+    // the error queue contained something else
+    return Result<ZeroCopyCompletion>::error(EAGAIN);
+}
+
+#else
+
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::setZeroCopy(bool const) noexcept
+{
+    return false;
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+bool TCPSocket<TVersion, TInstrumentation>::setQuickAck(bool const) noexcept
+{
+    return false;
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<bool> TCPSocket<TVersion, TInstrumentation>::getQuickAck() noexcept
+{
+    return Result<bool>::error(EOPNOTSUPP);
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::size_t>
+TCPSocket<TVersion, TInstrumentation>::sendvZeroCopy(std::span<std::span<std::byte const> const>) noexcept
+{
+    return Result<std::size_t>::error(EOPNOTSUPP);
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<ZeroCopyCompletion> TCPSocket<TVersion, TInstrumentation>::pollZeroCopyCompletion() noexcept
+{
+    return Result<ZeroCopyCompletion>::error(EOPNOTSUPP);
+}
+
+#endif // !__linux__
+
+template <IPVersion TVersion, typename TInstrumentation>
+Task<TCPSocket<TVersion, TInstrumentation>>
+TCPSocket<TVersion, TInstrumentation>::asyncAccept(Reactor &reactor, Address<TVersion> *const address) noexcept
+{
+    for (;;)
+    {
+        auto connection = accept(address);
+        if (connection.good())
+        {
+            connection.setNonblocking(true);
+            co_return std::move(connection);
+        }
+        if (!Internal::wouldBlock(errno) || ((co_await reactor.readable(this->_handle)) != 0))
+        {
+            co_return std::move(connection);
+        }
+    }
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Task<Result<bool>> TCPSocket<TVersion, TInstrumentation>::asyncConnect(Reactor                 &reactor,
+                                                                        Address<TVersion> const &address) noexcept
+{
+    if (connect(address))
+    {
+        co_return true;
+    }
+    auto const code = errno;
+    if ((code != EINPROGRESS) && !Internal::wouldBlock(code))
+    {
+        co_return Result<bool>::error(code);
+    }
+    if (auto const waitCode = co_await reactor.writable(this->_handle); waitCode != 0)
+    {
+        co_return Result<bool>::error(waitCode);
+    }
+    // the outcome of the connection attempt is reported as pending error of the socket
+    auto const pending = Internal::getOption<errno_t>(this->_handle, SOL_SOCKET, SO_ERROR);
+    if (pending.isError())
+    {
+        co_return Result<bool>::error(pending.errorCode());
+    }
+    if (pending.value() != 0)
+    {
+        co_return Result<bool>::error(pending.value());
+    }
+    co_return true;
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Task<Result<std::span<std::byte>>>
+TCPSocket<TVersion, TInstrumentation>::asyncReceive(Reactor &reactor, std::span<std::byte> const buffer) noexcept
+{
+    for (;;)
+    {
+        auto const result = receive(buffer);
+        if (!result.isError() || !Internal::wouldBlock(result.errorCode()))
+        {
+            co_return result;
+        }
+        if (auto const code = co_await reactor.readable(this->_handle); code != 0)
+        {
+            co_return Result<std::span<std::byte>>::error(code);
+        }
+    }
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Task<Result<std::size_t>>
+TCPSocket<TVersion, TInstrumentation>::asyncSend(Reactor &reactor, std::span<std::byte const> const buffer) noexcept
+{
+    std::size_t sent{};
+    while (sent < buffer.size())
+    {
+        auto const result = send(buffer.subspan(sent));
+        if (!result.isError())
+        {
+            sent += result.value();
+            continue;
+        }
+        if (!Internal::wouldBlock(result.errorCode()))
+        {
+            co_return result;
+        }
+        if (auto const code = co_await reactor.writable(this->_handle); code != 0)
+        {
+            co_return Result<std::size_t>::error(code);
+        }
+    }
+    co_return sent;
+}
+
 template class TCPSocket<IPVersion::V4>;
 template class TCPSocket<IPVersion::V6>;
+template class TCPSocket<IPVersion::V4, SocketInstrumentation>;
+template class TCPSocket<IPVersion::V6, SocketInstrumentation>;
 
 } // namespace Terrahertz
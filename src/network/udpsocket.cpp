@@ -2,24 +2,35 @@
 
 #include "privatecommon.hpp"
 
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <netinet/udp.h>
+#endif
+
 namespace Terrahertz {
 
 using SockTraits = Internal::SocketTraits;
 
-template <IPVersion TVersion>
-bool UDPSocket<TVersion>::receiveIsNonblocking() const noexcept
+/// @brief The maximum number of datagrams handed to the system in a single call.
+static constexpr std::size_t BatchLimit = 64U;
+
+template <IPVersion TVersion, typename TInstrumentation>
+bool UDPSocket<TVersion, TInstrumentation>::receiveIsNonblocking() const noexcept
 {
     return Internal::pollRead(this->_handle);
 }
 
-template <IPVersion TVersion>
-Result<std::span<std::byte>> UDPSocket<TVersion>::receiveFrom(Address<TVersion>   *address,
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::span<std::byte>> UDPSocket<TVersion, TInstrumentation>::receiveFrom(Address<TVersion>   *address,
                                                               std::span<std::byte> buffer) noexcept
 {
     Internal::SockAddr<TVersion> addr{};
 
     auto addrLength = Internal::SockAddrLength<TVersion>;
 
+    auto const start  = this->_instrumentation.start();
     auto const result = ::recvfrom(this->_handle,
                                    reinterpret_cast<SockTraits::RecvBufferType>(buffer.data()),
                                    static_cast<SockTraits::BufferLength>(buffer.size_bytes()),
@@ -33,32 +44,316 @@ Result<std::span<std::byte>> UDPSocket<TVersion>::receiveFrom(Address<TVersion>
     }
     if (result == -1)
     {
-        return Result<std::span<std::byte>>::error();
+        auto const code = errno;
+        this->_instrumentation.record(SocketOperation::Receive, start, 0U, code);
+        return Result<std::span<std::byte>>::error(code);
     }
+    this->_instrumentation.record(SocketOperation::Receive, start, static_cast<std::size_t>(result), 0);
     return buffer.first(result);
 }
 
-template <IPVersion TVersion>
-bool UDPSocket<TVersion>::sendIsNonblocking() const noexcept
+template <IPVersion TVersion, typename TInstrumentation>
+bool UDPSocket<TVersion, TInstrumentation>::sendIsNonblocking() const noexcept
 {
     return Internal::pollWrite(this->_handle);
 }
 
-template <IPVersion TVersion>
-Result<std::size_t> UDPSocket<TVersion>::sendTo(Address<TVersion> const   &address,
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::size_t> UDPSocket<TVersion, TInstrumentation>::sendTo(Address<TVersion> const   &address,
                                                 std::span<std::byte const> buffer) noexcept
 {
     auto const addr   = Internal::convertSocketAddress(address);
+    auto const start  = this->_instrumentation.start();
     auto const result = ::sendto(this->_handle,
                                  reinterpret_cast<SockTraits::SendBufferType>(buffer.data()),
                                  static_cast<SockTraits::BufferLength>(buffer.size_bytes()),
                                  0,
                                  reinterpret_cast<sockaddr const *>(&addr),
                                  Internal::SockAddrLength<TVersion>);
+    if (result == -1)
+    {
+        auto const code = errno;
+        this->_instrumentation.record(SocketOperation::Send, start, 0U, code);
+        return Result<std::size_t>::error(code);
+    }
+    this->_instrumentation.record(SocketOperation::Send, start, static_cast<std::size_t>(result), 0);
     return static_cast<std::size_t>(result);
 }
 
+#ifdef __linux__
+
+/// @brief Buffer for the control message carrying the segment size of a datagram.
+struct alignas(cmsghdr) SegmentControlBuffer final
+{
+    std::array<char, CMSG_SPACE(sizeof(int))> data{};
+};
+
+/// @brief Sums up the bytes transferred by a recvmmsg/sendmmsg call.
+///
+/// @param headers The headers of the call.
+/// @param count The number of datagrams transferred by the call.
+/// @return The number of bytes transferred.
+static std::size_t batchBytes(std::span<mmsghdr const> const headers, int const count) noexcept
+{
+    std::size_t bytes{};
+    for (std::size_t i = 0U; i < static_cast<std::size_t>(count); ++i)
+    {
+        bytes += headers[i].msg_len;
+    }
+    return bytes;
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::size_t>
+UDPSocket<TVersion, TInstrumentation>::receiveBatch(std::span<Datagram<TVersion>> datagrams) noexcept
+{
+    std::array<mmsghdr, BatchLimit>                      headers{};
+    std::array<iovec, BatchLimit>                        vectors{};
+    std::array<Internal::SockAddr<TVersion>, BatchLimit> addresses{};
+    std::array<SegmentControlBuffer, BatchLimit>         controls{};
+
+    std::size_t received{};
+    int         flags{MSG_WAITFORONE};
+    while (received < datagrams.size())
+    {
+        auto const chunk = datagrams.subspan(received, std::min(BatchLimit, datagrams.size() - received));
+        for (std::size_t i = 0U; i < chunk.size(); ++i)
+        {
+            vectors[i].iov_base = chunk[i].buffer.data();
+            vectors[i].iov_len  = chunk[i].buffer.size_bytes();
+
+            headers[i]                        = mmsghdr{};
+            headers[i].msg_hdr.msg_name       = &addresses[i];
+            headers[i].msg_hdr.msg_namelen    = Internal::SockAddrLength<TVersion>;
+            headers[i].msg_hdr.msg_iov        = &vectors[i];
+            headers[i].msg_hdr.msg_iovlen     = 1U;
+            headers[i].msg_hdr.msg_control    = controls[i].data.data();
+            headers[i].msg_hdr.msg_controllen = controls[i].data.size();
+        }
+
+        auto const start = this->_instrumentation.start();
+        auto const result =
+            ::recvmmsg(this->_handle, headers.data(), static_cast<unsigned>(chunk.size()), flags, nullptr);
+        if (result == -1)
+        {
+            this->_instrumentation.record(SocketOperation::Receive, start, 0U, errno);
+            if (received == 0U)
+            {
+                return Result<std::size_t>::error();
+            }
+            // everything available has been received
+            break;
+        }
+
+        for (std::size_t i = 0U; i < static_cast<std::size_t>(result); ++i)
+        {
+            chunk[i].address     = Internal::convertSocketAddress(addresses[i]);
+            chunk[i].length      = headers[i].msg_len;
+            chunk[i].segmentSize = 0U;
+            for (auto cmsg = CMSG_FIRSTHDR(&headers[i].msg_hdr); cmsg != nullptr;
+                 cmsg      = CMSG_NXTHDR(&headers[i].msg_hdr, cmsg))
+            {
+                if ((cmsg->cmsg_level == SOL_UDP) && (cmsg->cmsg_type == UDP_GRO))
+                {
+                    int segmentSize{};
+                    std::memcpy(&segmentSize, CMSG_DATA(cmsg), sizeof(segmentSize));
+                    chunk[i].segmentSize = static_cast<std::uint16_t>(segmentSize);
+                }
+            }
+        }
+        this->_instrumentation.record(SocketOperation::Receive, start, batchBytes(headers, result), 0);
+        received += static_cast<std::size_t>(result);
+        if (static_cast<std::size_t>(result) < chunk.size())
+        {
+            break;
+        }
+        flags = MSG_DONTWAIT;
+    }
+    return received;
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::size_t>
+UDPSocket<TVersion, TInstrumentation>::sendBatch(std::span<Datagram<TVersion> const> datagrams) noexcept
+{
+    std::array<mmsghdr, BatchLimit>                      headers{};
+    std::array<iovec, BatchLimit>                        vectors{};
+    std::array<Internal::SockAddr<TVersion>, BatchLimit> addresses{};
+    std::array<SegmentControlBuffer, BatchLimit>         controls{};
+
+    std::size_t sent{};
+    while (sent < datagrams.size())
+    {
+        auto const chunk = datagrams.subspan(sent, std::min(BatchLimit, datagrams.size() - sent));
+        for (std::size_t i = 0U; i < chunk.size(); ++i)
+        {
+            addresses[i]        = Internal::convertSocketAddress(chunk[i].address);
+            vectors[i].iov_base = chunk[i].buffer.data();
+            vectors[i].iov_len  = chunk[i].buffer.size_bytes();
+
+            headers[i]                     = mmsghdr{};
+            headers[i].msg_hdr.msg_name    = &addresses[i];
+            headers[i].msg_hdr.msg_namelen = Internal::SockAddrLength<TVersion>;
+            headers[i].msg_hdr.msg_iov     = &vectors[i];
+            headers[i].msg_hdr.msg_iovlen  = 1U;
+            if (chunk[i].segmentSize != 0U)
+            {
+                headers[i].msg_hdr.msg_control    = controls[i].data.data();
+                headers[i].msg_hdr.msg_controllen = CMSG_SPACE(sizeof(std::uint16_t));
+
+                auto const cmsg  = CMSG_FIRSTHDR(&headers[i].msg_hdr);
+                cmsg->cmsg_level = SOL_UDP;
+                cmsg->cmsg_type  = UDP_SEGMENT;
+                cmsg->cmsg_len   = CMSG_LEN(sizeof(std::uint16_t));
+                std::memcpy(CMSG_DATA(cmsg), &chunk[i].segmentSize, sizeof(std::uint16_t));
+            }
+        }
+
+        auto const start  = this->_instrumentation.start();
+        auto const result = ::sendmmsg(this->_handle, headers.data(), static_cast<unsigned>(chunk.size()), 0);
+        if (result == -1)
+        {
+            this->_instrumentation.record(SocketOperation::Send, start, 0U, errno);
+            if (sent == 0U)
+            {
+                return Result<std::size_t>::error();
+            }
+            break;
+        }
+        this->_instrumentation.record(SocketOperation::Send, start, batchBytes(headers, result), 0);
+        sent += static_cast<std::size_t>(result);
+        if (static_cast<std::size_t>(result) < chunk.size())
+        {
+            break;
+        }
+    }
+    return sent;
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+bool UDPSocket<TVersion, TInstrumentation>::setReceiveOffload(bool const enable) noexcept
+{
+    return Internal::setOption(this->_handle, SOL_UDP, UDP_GRO, enable);
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<bool> UDPSocket<TVersion, TInstrumentation>::getReceiveOffload() noexcept
+{
+    return Internal::getOption<bool>(this->_handle, SOL_UDP, UDP_GRO);
+}
+
+#else
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::size_t>
+UDPSocket<TVersion, TInstrumentation>::receiveBatch(std::span<Datagram<TVersion>> datagrams) noexcept
+{
+    // no batching available, fall back to one call per datagram
+    std::size_t received{};
+    for (auto &datagram : datagrams)
+    {
+        if ((received != 0U) && !receiveIsNonblocking())
+        {
+            break;
+        }
+        auto const result = receiveFrom(&datagram.address, datagram.buffer);
+        if (result.isError())
+        {
+            if (received == 0U)
+            {
+                return Result<std::size_t>::error(result.errorCode());
+            }
+            break;
+        }
+        datagram.length      = result.value().size();
+        datagram.segmentSize = 0U;
+        ++received;
+    }
+    return received;
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<std::size_t>
+UDPSocket<TVersion, TInstrumentation>::sendBatch(std::span<Datagram<TVersion> const> datagrams) noexcept
+{
+    // no batching or segmentation offload available, fall back to one call per datagram (segment)
+    std::size_t sent{};
+    for (auto const &datagram : datagrams)
+    {
+        std::span<std::byte const> remaining{datagram.buffer};
+        auto const                 segmentSize = (datagram.segmentSize == 0U) ? remaining.size() : datagram.segmentSize;
+        do
+        {
+            auto const segment = remaining.first(std::min<std::size_t>(segmentSize, remaining.size()));
+            auto const result  = sendTo(datagram.address, segment);
+            if (result.isError())
+            {
+                if (sent == 0U)
+                {
+                    return Result<std::size_t>::error(result.errorCode());
+                }
+                return sent;
+            }
+            remaining = remaining.subspan(segment.size());
+        } while (!remaining.empty());
+        ++sent;
+    }
+    return sent;
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+bool UDPSocket<TVersion, TInstrumentation>::setReceiveOffload(bool const) noexcept
+{
+    return false;
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Result<bool> UDPSocket<TVersion, TInstrumentation>::getReceiveOffload() noexcept
+{
+    return Result<bool>::error(EOPNOTSUPP);
+}
+
+#endif // !__linux__
+
+template <IPVersion TVersion, typename TInstrumentation>
+Task<Result<std::span<std::byte>>> UDPSocket<TVersion, TInstrumentation>::asyncReceiveFrom(
+    Reactor &reactor, Address<TVersion> *const address, std::span<std::byte> const buffer) noexcept
+{
+    for (;;)
+    {
+        auto const result = receiveFrom(address, buffer);
+        if (!result.isError() || !Internal::wouldBlock(result.errorCode()))
+        {
+            co_return result;
+        }
+        if (auto const code = co_await reactor.readable(this->_handle); code != 0)
+        {
+            co_return Result<std::span<std::byte>>::error(code);
+        }
+    }
+}
+
+template <IPVersion TVersion, typename TInstrumentation>
+Task<Result<std::size_t>> UDPSocket<TVersion, TInstrumentation>::asyncSendTo(
+    Reactor &reactor, Address<TVersion> const &address, std::span<std::byte const> const buffer) noexcept
+{
+    for (;;)
+    {
+        auto const result = sendTo(address, buffer);
+        if (!result.isError() || !Internal::wouldBlock(result.errorCode()))
+        {
+            co_return result;
+        }
+        if (auto const code = co_await reactor.writable(this->_handle); code != 0)
+        {
+            co_return Result<std::size_t>::error(code);
+        }
+    }
+}
+
 template class UDPSocket<IPVersion::V4>;
 template class UDPSocket<IPVersion::V6>;
+template class UDPSocket<IPVersion::V4, SocketInstrumentation>;
+template class UDPSocket<IPVersion::V6, SocketInstrumentation>;
 
 } // namespace Terrahertz
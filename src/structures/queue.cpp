@@ -0,0 +1,75 @@
+#include "THzCommon/structures/queue.hpp"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Terrahertz::Internal {
+
+#ifdef __linux__
+
+MirroredMapping::MirroredMapping(std::size_t const size) noexcept
+{
+    auto const pageSize = granularity();
+    if ((size == 0U) || (pageSize == 0U) || ((size % pageSize) != 0U))
+    {
+        return;
+    }
+
+    auto const file = ::memfd_create("THzCommon.MirroredMapping", MFD_CLOEXEC);
+    if (file == -1)
+    {
+        return;
+    }
+    if (::ftruncate(file, static_cast<off_t>(size)) == 0)
+    {
+        // reserve the address range of both halves first, so nothing else can be mapped in between
+        auto const region = ::mmap(nullptr, 2U * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region != MAP_FAILED)
+        {
+            auto const first  = static_cast<std::byte *>(region);
+            auto const second = first + size;
+
+            auto const flags = MAP_SHARED | MAP_FIXED;
+            if ((::mmap(first, size, PROT_READ | PROT_WRITE, flags, file, 0) != MAP_FAILED) &&
+                (::mmap(second, size, PROT_READ | PROT_WRITE, flags, file, 0) != MAP_FAILED))
+            {
+                _data = first;
+                _size = size;
+            }
+            else
+            {
+                ::munmap(region, 2U * size);
+            }
+        }
+    }
+    // the mappings keep the memory alive
+    ::close(file);
+}
+
+MirroredMapping::~MirroredMapping() noexcept
+{
+    if (_data != nullptr)
+    {
+        ::munmap(_data, 2U * _size);
+    }
+}
+
+std::size_t MirroredMapping::granularity() noexcept
+{
+    auto const pageSize = ::sysconf(_SC_PAGESIZE);
+    return (pageSize > 0) ? static_cast<std::size_t>(pageSize) : 0U;
+}
+
+#else
+
+MirroredMapping::MirroredMapping(std::size_t const) noexcept {}
+
+MirroredMapping::~MirroredMapping() noexcept {}
+
+std::size_t MirroredMapping::granularity() noexcept { return 0U; }
+
+#endif // !__linux__
+
+} // namespace Terrahertz::Internal
@@ -4,6 +4,18 @@
 
 namespace Terrahertz {
 
+std::uint16_t flipByteOrder(std::uint16_t input) noexcept
+{
+    std::uint16_t output{};
+
+    auto inArr = std::bit_cast<std::uint8_t *>(&input);
+    auto ouArr = std::bit_cast<std::uint8_t *>(&output);
+
+    ouArr[0] = inArr[1];
+    ouArr[1] = inArr[0];
+    return output;
+}
+
 std::uint32_t flipByteOrder(std::uint32_t input) noexcept
 {
     std::uint32_t output{};
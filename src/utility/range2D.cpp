@@ -46,4 +46,8 @@ Range2D::Iterator Range2D::begin() const noexcept { return Iterator{_width}; }
 
 Range2D::Iterator Range2D::end() const noexcept { return Iterator{_width, _width * _height}; }
 
+std::uint32_t Range2D::width() const noexcept { return _width; }
+
+std::uint32_t Range2D::height() const noexcept { return _height; }
+
 } // namespace Terrahertz
@@ -0,0 +1,285 @@
+#include "THzCommon/utility/threadPool.hpp"
+
+#include <bit>
+#include <thread>
+
+namespace Terrahertz {
+namespace Internal {
+
+WorkStealingDeque::Buffer::Buffer(std::size_t const size) noexcept
+    : capacity{size}, slots{std::make_unique<std::atomic<PoolJob *>[]>(size)}
+{}
+
+std::atomic<PoolJob *> &WorkStealingDeque::Buffer::operator[](std::int64_t const position) noexcept
+{
+    return slots[static_cast<std::size_t>(position) & (capacity - 1U)];
+}
+
+WorkStealingDeque::WorkStealingDeque(std::size_t const capacity) noexcept
+{
+    _buffers.emplace_back(std::make_unique<Buffer>(std::bit_ceil(std::max<std::size_t>(capacity, 2U))));
+    _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+}
+
+void WorkStealingDeque::push(PoolJob *const job) noexcept
+{
+    auto const bottom = _bottom.load(std::memory_order_relaxed);
+    auto const top    = _top.load(std::memory_order_acquire);
+    auto      *buffer = _buffer.load(std::memory_order_relaxed);
+    if ((bottom - top) >= static_cast<std::int64_t>(buffer->capacity))
+    {
+        buffer = grow(bottom, top);
+    }
+    (*buffer)[bottom].store(job, std::memory_order_relaxed);
+    // publishes the job to the thieves
+    _bottom.store(bottom + 1, std::memory_order_release);
+}
+
+PoolJob *WorkStealingDeque::take() noexcept
+{
+    auto const bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    auto      *buffer = _buffer.load(std::memory_order_relaxed);
+
+    // claiming the bottom has to be ordered before looking at the top, otherwise owner and thief could both get the
+    // last job; sequentially consistent accesses take the place of the fence of the original algorithm
+    _bottom.store(bottom, std::memory_order_seq_cst);
+    auto top = _top.load(std::memory_order_seq_cst);
+    if (top > bottom)
+    {
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto *job = (*buffer)[bottom].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+        // the last job, race the thieves for it
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            job = nullptr;
+        }
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+PoolJob *WorkStealingDeque::steal() noexcept
+{
+    auto       top    = _top.load(std::memory_order_seq_cst);
+    auto const bottom = _bottom.load(std::memory_order_seq_cst);
+    if (top >= bottom)
+    {
+        return nullptr;
+    }
+
+    auto *buffer = _buffer.load(std::memory_order_acquire);
+    auto *job    = (*buffer)[top].load(std::memory_order_relaxed);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+    return job;
+}
+
+bool WorkStealingDeque::empty() const noexcept
+{
+    return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+}
+
+WorkStealingDeque::Buffer *WorkStealingDeque::grow(std::int64_t const bottom, std::int64_t const top) noexcept
+{
+    auto *current = _buffer.load(std::memory_order_relaxed);
+    auto  buffer  = std::make_unique<Buffer>(2U * current->capacity);
+    for (auto i = top; i < bottom; ++i)
+    {
+        (*buffer)[i].store((*current)[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    _buffer.store(buffer.get(), std::memory_order_release);
+    _buffers.emplace_back(std::move(buffer));
+    return _buffers.back().get();
+}
+
+} // namespace Internal
+
+namespace {
+
+/// @brief The pool the current thread is a worker of, nullptr if it is none.
+thread_local ThreadPool *currentPool{};
+
+/// @brief The index of the current thread in its pool.
+thread_local std::size_t currentIndex{};
+
+/// @brief Executes the job and destroys it afterwards.
+///
+/// @param job The job to execute.
+void run(Internal::PoolJob *const job) noexcept
+{
+    std::unique_ptr<Internal::PoolJob> owned{job};
+    owned->execute();
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t workerCount) noexcept
+{
+    if (workerCount == 0U)
+    {
+        workerCount = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    // all workers have to exist before the first one starts stealing
+    for (std::size_t i = 0U; i < workerCount; ++i)
+    {
+        _workers.emplace_back(std::make_unique<Worker>());
+    }
+    for (std::size_t i = 0U; i < workerCount; ++i)
+    {
+        _workers[i]->thread.thread = std::thread{&ThreadPool::work, this, i};
+    }
+}
+
+ThreadPool::~ThreadPool() noexcept { shutdown(); }
+
+bool ThreadPool::runPendingJob() noexcept
+{
+    auto const self = (currentPool == this) ? currentIndex : workerCount();
+    if (auto const job = findJob(self); job != nullptr)
+    {
+        run(job);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::shutdown() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{_injectionMutex};
+        if (_stopped)
+        {
+            return;
+        }
+        _stopped = true;
+    }
+    // let all workers drain the remaining jobs together before waiting for the first one to finish
+    for (auto &worker : _workers)
+    {
+        WorkerThread::UniqueLock lock{worker->thread.mutex};
+        worker->thread.shutdownFlag = true;
+        worker->thread.wakeUp.notify_one();
+    }
+    for (auto &worker : _workers)
+    {
+        worker->thread.shutdown();
+    }
+}
+
+void ThreadPool::schedule(Internal::PoolJob *const job) noexcept
+{
+    if (currentPool == this)
+    {
+        // counted first, so the job never appears to be taken before it was pushed
+        _pending.fetch_add(1U);
+        _workers[currentIndex]->deque.push(job);
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock{_injectionMutex};
+        if (_stopped)
+        {
+            lock.unlock();
+            run(job);
+            return;
+        }
+        _pending.fetch_add(1U);
+        _injection.emplace_back(job);
+    }
+    wakeUpIdleWorker();
+}
+
+Internal::PoolJob *ThreadPool::findJob(std::size_t const self) noexcept
+{
+    auto const count = workerCount();
+
+    Internal::PoolJob *job{};
+    if (self < count)
+    {
+        job = _workers[self]->deque.take();
+    }
+    // start stealing next to the caller, so thieves spread across the victims
+    for (std::size_t i = 1U; (job == nullptr) && (i <= count); ++i)
+    {
+        auto const victim = (self + i) % count;
+        if (victim != self)
+        {
+            job = _workers[victim]->deque.steal();
+        }
+    }
+    if (job == nullptr)
+    {
+        std::lock_guard<std::mutex> lock{_injectionMutex};
+        if (!_injection.empty())
+        {
+            job = _injection.front();
+            _injection.pop_front();
+        }
+    }
+    if (job != nullptr)
+    {
+        _pending.fetch_sub(1U);
+    }
+    return job;
+}
+
+void ThreadPool::wakeUpIdleWorker() noexcept
+{
+    if (_idleWorkers.load() == 0U)
+    {
+        return;
+    }
+    for (auto &worker : _workers)
+    {
+        // claiming the worker keeps jobs submitted in quick succession from all waking up the same one
+        if (worker->idle.exchange(false))
+        {
+            // taking the mutex makes sure the worker either sees the job or is already waiting for the notification
+            {
+                WorkerThread::UniqueLock lock{worker->thread.mutex};
+            }
+            worker->thread.wakeUp.notify_one();
+            return;
+        }
+    }
+}
+
+void ThreadPool::work(std::size_t const self) noexcept
+{
+    currentPool  = this;
+    currentIndex = self;
+
+    auto &worker = *_workers[self];
+    for (;;)
+    {
+        if (auto const job = findJob(self); job != nullptr)
+        {
+            run(job);
+            continue;
+        }
+        if (worker.thread.shutdownFlag)
+        {
+            break;
+        }
+
+        worker.idle = true;
+        _idleWorkers.fetch_add(1U);
+        {
+            WorkerThread::UniqueLock lock{worker.thread.mutex};
+            worker.thread.wakeUp.wait(lock, [&]() noexcept {
+                return worker.thread.shutdownFlag || (_pending.load() != 0U);
+            });
+        }
+        _idleWorkers.fetch_sub(1U);
+        worker.idle = false;
+    }
+}
+
+} // namespace Terrahertz
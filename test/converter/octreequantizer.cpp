@@ -0,0 +1,187 @@
+#include "THzCommon/converter/octreequantizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct ConverterOctreeQuantizer : public testing::Test
+{
+    using Color = OctreeQuantizer::Color;
+
+    static constexpr std::array<Color, 4U> Colors{
+        Color{255U, 0U, 0U}, Color{0U, 255U, 0U}, Color{0U, 0U, 255U}, Color{200U, 200U, 200U}};
+
+    /// @brief Creates an image using the given colors in stripes of the given width.
+    ///
+    /// @param width The width of the image.
+    /// @param height The height of the image.
+    /// @param bytesPerPixel The number of bytes per pixel.
+    /// @param colors The colors of the stripes.
+    /// @return The pixels of the image.
+    static std::vector<std::uint8_t> createImage(std::uint32_t const          width,
+                                                 std::uint32_t const          height,
+                                                 std::uint32_t const          bytesPerPixel,
+                                                 gsl::span<Color const> const colors) noexcept
+    {
+        std::vector<std::uint8_t> pixels(size_t{width} * height * bytesPerPixel);
+        for (size_t i = 0U; i < size_t{width} * height; ++i)
+        {
+            auto const &color                = colors[(i % width) % colors.size()];
+            pixels[i * bytesPerPixel]        = color.red;
+            pixels[(i * bytesPerPixel) + 1U] = color.green;
+            pixels[(i * bytesPerPixel) + 2U] = color.blue;
+        }
+        return pixels;
+    }
+
+    /// @brief Creates an image with a gradient over all channels.
+    ///
+    /// @param width The width of the image.
+    /// @param height The height of the image.
+    /// @return The pixels of the image.
+    static std::vector<std::uint8_t> createGradient(std::uint32_t const width, std::uint32_t const height) noexcept
+    {
+        std::vector<std::uint8_t> pixels(size_t{width} * height * 3U);
+        for (std::uint32_t y = 0U; y < height; ++y)
+        {
+            for (std::uint32_t x = 0U; x < width; ++x)
+            {
+                auto const i   = ((size_t{y} * width) + x) * 3U;
+                pixels[i]      = static_cast<std::uint8_t>((x * 256U) / width);
+                pixels[i + 1U] = static_cast<std::uint8_t>((y * 256U) / height);
+                pixels[i + 2U] = static_cast<std::uint8_t>(((x + y) * 128U) / (width + height));
+            }
+        }
+        return pixels;
+    }
+
+    OctreeQuantizer sut{};
+};
+
+TEST_F(ConverterOctreeQuantizer, EmptyOnConstruction)
+{
+    EXPECT_EQ(sut.pixelCount(), 0U);
+    EXPECT_TRUE(sut.palette().empty());
+    EXPECT_TRUE(sut.reducePalette(16U).empty());
+    EXPECT_EQ(sut.paletteIndex(Color{1U, 2U, 3U}), 0U);
+
+    std::array<std::uint8_t, 3U> pixel{};
+    std::array<std::uint8_t, 1U> index{};
+    EXPECT_FALSE(sut.mapPixels(pixel, 1U, 1U, 3U, index));
+}
+
+TEST_F(ConverterOctreeQuantizer, InvalidParameters)
+{
+    std::vector<std::uint8_t> pixels(4U * 4U * 3U);
+    std::vector<std::uint8_t> indices(4U * 4U);
+    EXPECT_FALSE(sut.addPixels(pixels, 0U, 4U));
+    EXPECT_FALSE(sut.addPixels(pixels, 4U, 0U));
+    EXPECT_FALSE(sut.addPixels(pixels, 4U, 4U, 2U));
+    EXPECT_FALSE(sut.addPixels(pixels, 4U, 5U));
+    EXPECT_EQ(sut.pixelCount(), 0U);
+
+    EXPECT_TRUE(sut.addPixels(pixels, 4U, 4U));
+    ASSERT_EQ(sut.reducePalette(4U).size(), 1U);
+    EXPECT_FALSE(sut.mapPixels(pixels, 4U, 5U, 3U, indices));
+    EXPECT_FALSE(sut.mapPixels(pixels, 4U, 4U, 3U, gsl::span<std::uint8_t>{indices}.subspan(1U)));
+    EXPECT_TRUE(sut.mapPixels(pixels, 4U, 4U, 3U, indices));
+}
+
+TEST_F(ConverterOctreeQuantizer, KeepsFewColors)
+{
+    auto const pixels = createImage(37U, 41U, 4U, Colors);
+    EXPECT_TRUE(sut.addPixels(pixels, 37U, 41U, 4U));
+    EXPECT_EQ(sut.pixelCount(), 37U * 41U);
+
+    auto const palette = sut.reducePalette(16U);
+    ASSERT_EQ(palette.size(), Colors.size());
+    for (auto const &color : Colors)
+    {
+        auto const index = sut.paletteIndex(color);
+        ASSERT_LT(index, palette.size());
+        EXPECT_EQ(palette[index], color);
+    }
+
+    std::vector<std::uint8_t> indices(37U * 41U);
+    EXPECT_TRUE(sut.mapPixels(pixels, 37U, 41U, 4U, indices));
+    for (size_t i = 0U; i < indices.size(); ++i)
+    {
+        ASSERT_EQ(palette[indices[i]], Colors[(i % 37U) % Colors.size()]) << i;
+    }
+}
+
+TEST_F(ConverterOctreeQuantizer, ReducesToRequestedColors)
+{
+    auto const pixels = createGradient(256U, 200U);
+    EXPECT_TRUE(sut.addPixels(pixels, 256U, 200U));
+    EXPECT_EQ(sut.reducePalette(0U).size(), 1U);
+    EXPECT_EQ(sut.reducePalette(7U).size(), 7U);
+    EXPECT_EQ(sut.reducePalette(1000U).size(), OctreeQuantizer::MaxColors);
+    auto const palette = sut.reducePalette(64U);
+    ASSERT_EQ(palette.size(), 64U);
+
+    // every pixel is mapped to a close color of the palette
+    std::vector<std::uint8_t> indices(256U * 200U);
+    EXPECT_TRUE(sut.mapPixels(pixels, 256U, 200U, 3U, indices));
+    std::uint64_t error{};
+    for (size_t i = 0U; i < indices.size(); ++i)
+    {
+        auto const &color = palette[indices[i]];
+        auto const  red   = std::int32_t{pixels[i * 3U]} - color.red;
+        auto const  green = std::int32_t{pixels[(i * 3U) + 1U]} - color.green;
+        auto const  blue  = std::int32_t{pixels[(i * 3U) + 2U]} - color.blue;
+        error += static_cast<std::uint64_t>((red * red) + (green * green) + (blue * blue));
+    }
+    EXPECT_LT(error / indices.size(), 300U);
+}
+
+TEST_F(ConverterOctreeQuantizer, StreamsPixels)
+{
+    // the image is added in pieces of rows, which counts the same pixels as adding it as a whole
+    auto const pixels = createGradient(100U, 90U);
+    EXPECT_TRUE(sut.addPixels(pixels, 100U, 90U));
+    auto const reduced  = sut.reducePalette(32U);
+    auto const expected = std::vector<Color>(reduced.begin(), reduced.end());
+
+    OctreeQuantizer streamed{};
+    auto const      rows = gsl::span<std::uint8_t const>{pixels};
+    EXPECT_TRUE(streamed.addPixels(rows.subspan(0U, 100U * 33U * 3U), 100U, 33U));
+    EXPECT_TRUE(streamed.addPixels(rows.subspan(100U * 33U * 3U), 100U, 57U));
+    EXPECT_EQ(streamed.pixelCount(), 100U * 90U);
+    auto const palette = streamed.reducePalette(32U);
+    ASSERT_EQ(palette.size(), expected.size());
+    EXPECT_TRUE(std::equal(palette.begin(), palette.end(), expected.begin()));
+
+    streamed.reset();
+    EXPECT_EQ(streamed.pixelCount(), 0U);
+    EXPECT_EQ(streamed.palette().size(), expected.size());
+    EXPECT_TRUE(streamed.reducePalette(32U).empty());
+}
+
+TEST_F(ConverterOctreeQuantizer, Parallel)
+{
+    // 300 rows are split into tiles of TileRows rows, leaving a smaller tile at the end
+    auto const pixels = createGradient(320U, 300U);
+    EXPECT_TRUE(sut.addPixels(pixels, 320U, 300U));
+    auto const reduced  = sut.reducePalette(48U);
+    auto const expected = std::vector<Color>(reduced.begin(), reduced.end());
+
+    ThreadPool      pool{4U};
+    OctreeQuantizer parallel{&pool};
+    EXPECT_TRUE(parallel.addPixels(pixels, 320U, 300U));
+    auto const palette = parallel.reducePalette(48U);
+    ASSERT_EQ(palette.size(), expected.size());
+    EXPECT_TRUE(std::equal(palette.begin(), palette.end(), expected.begin()));
+
+    std::vector<std::uint8_t> sequentialIndices(320U * 300U);
+    std::vector<std::uint8_t> parallelIndices(320U * 300U);
+    EXPECT_TRUE(sut.mapPixels(pixels, 320U, 300U, 3U, sequentialIndices));
+    EXPECT_TRUE(parallel.mapPixels(pixels, 320U, 300U, 3U, parallelIndices));
+    EXPECT_EQ(sequentialIndices, parallelIndices);
+}
+
+} // namespace Terrahertz::UnitTests
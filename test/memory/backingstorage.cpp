@@ -0,0 +1,117 @@
+#include "THzCommon/memory/backingstorage.hpp"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <utility>
+
+namespace Terrahertz::UnitTests {
+
+struct MemoryBackingStorage : public testing::Test
+{
+    /// @brief The size of the regions of the tests.
+    static constexpr std::size_t Size{1U << 20U};
+
+    /// @brief Writes to every byte of the storage and checks the content afterwards.
+    ///
+    /// @param storage The storage to check.
+    static void checkWritable(BackingStorage const &storage) noexcept
+    {
+        ASSERT_TRUE(storage.good());
+        std::memset(storage.data(), 0x5A, storage.size());
+        EXPECT_EQ(storage.data()[0U], 0x5A);
+        EXPECT_EQ(storage.data()[storage.size() - 1U], 0x5A);
+    }
+};
+
+TEST_F(MemoryBackingStorage, DefaultConstructedEmpty)
+{
+    BackingStorage sut{};
+    EXPECT_FALSE(sut.good());
+    EXPECT_EQ(sut.data(), nullptr);
+    EXPECT_EQ(sut.size(), 0U);
+    EXPECT_TRUE(sut.residentPerNode().empty());
+}
+
+TEST_F(MemoryBackingStorage, RegularPages)
+{
+    BackingStorage sut{Size - 5U};
+    EXPECT_GE(sut.size(), Size - 5U);
+    EXPECT_EQ(sut.size(), BackingStorage::mappedSize(Size - 5U, StoragePolicy{}));
+    EXPECT_EQ(sut.applied().pages, PageKind::Regular);
+    EXPECT_FALSE(sut.applied().locked);
+    EXPECT_EQ(sut.applied().numaNode, -1);
+    checkWritable(sut);
+}
+
+TEST_F(MemoryBackingStorage, HugePagesFallBack)
+{
+    // whether huge pages are reserved depends on the system, the storage has to work either way
+    BackingStorage sut{Size, StoragePolicy{PageKind::Huge}};
+    EXPECT_EQ(sut.size() % BackingStorage::HugePageSize, 0U);
+    checkWritable(sut);
+}
+
+TEST_F(MemoryBackingStorage, TransparentHugePagesAligned)
+{
+    BackingStorage sut{3U * BackingStorage::HugePageSize, StoragePolicy{PageKind::TransparentHuge}};
+    ASSERT_TRUE(sut.good());
+    EXPECT_EQ(sut.size(), 3U * BackingStorage::HugePageSize);
+#ifdef __linux__
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(sut.data()) % BackingStorage::HugePageSize, 0U);
+#endif
+    checkWritable(sut);
+}
+
+TEST_F(MemoryBackingStorage, LockedAndBound)
+{
+    BackingStorage sut{Size, StoragePolicy{PageKind::Regular, true, 0}};
+    checkWritable(sut);
+
+    // a node that does not exist is not applied
+    BackingStorage unknown{Size, StoragePolicy{PageKind::Regular, false, 4000}};
+    EXPECT_EQ(unknown.applied().numaNode, -1);
+    checkWritable(unknown);
+}
+
+TEST_F(MemoryBackingStorage, ResidentPerNode)
+{
+    BackingStorage sut{Size};
+    ASSERT_TRUE(sut.good());
+    auto const untouched = sut.residentPerNode();
+    EXPECT_EQ(std::accumulate(untouched.begin(), untouched.end(), std::size_t{}), 0U);
+
+    std::memset(sut.data(), 1, sut.size());
+    auto const touched = sut.residentPerNode();
+    if (!touched.empty())
+    {
+        EXPECT_EQ(std::accumulate(touched.begin(), touched.end(), std::size_t{}), sut.size());
+    }
+}
+
+TEST_F(MemoryBackingStorage, Accumulate)
+{
+    std::vector<std::size_t> totals{1U};
+    BackingStorage::accumulate(totals, {2U, 3U});
+    EXPECT_EQ(totals, (std::vector<std::size_t>{3U, 3U}));
+    BackingStorage::accumulate(totals, {});
+    EXPECT_EQ(totals, (std::vector<std::size_t>{3U, 3U}));
+}
+
+TEST_F(MemoryBackingStorage, MoveTransfersRegion)
+{
+    BackingStorage first{Size};
+    auto const     data = first.data();
+
+    BackingStorage second{std::move(first)};
+    EXPECT_FALSE(first.good());
+    EXPECT_EQ(second.data(), data);
+
+    BackingStorage third{Size};
+    third = std::move(second);
+    EXPECT_FALSE(second.good());
+    EXPECT_EQ(third.data(), data);
+    checkWritable(third);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,219 @@
+#include "THzCommon/memory/fixedblockpool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct MemoryFixedBlockPool : public testing::Test
+{
+    /// @brief The number of blocks in the pool of the tests.
+    static constexpr std::size_t BlockCount{16U};
+
+    FixedBlockPool sut{100U, BlockCount};
+};
+
+TEST_F(MemoryFixedBlockPool, Construction)
+{
+    EXPECT_EQ(sut.blockSize() % alignof(std::max_align_t), 0U);
+    EXPECT_GE(sut.blockSize(), 100U);
+    EXPECT_EQ(sut.blockCount(), BlockCount);
+    EXPECT_EQ(sut.totalSpace(), sut.blockSize() * BlockCount);
+    EXPECT_EQ(sut.usedSpace(), 0U);
+    EXPECT_EQ(sut.usedBlocks(), 0U);
+    EXPECT_EQ(sut.level(), 0.0);
+}
+
+TEST_F(MemoryFixedBlockPool, BlockSizeRoundedUpToAlignment)
+{
+    FixedBlockPool tiny{1U, 1U};
+    EXPECT_EQ(tiny.blockSize(), alignof(std::max_align_t));
+}
+
+TEST_F(MemoryFixedBlockPool, AllocateUntilExhausted)
+{
+    std::set<char *> blocks{};
+    for (auto i = 0U; i < BlockCount; ++i)
+    {
+        auto const block = sut.allocate(100U);
+        ASSERT_NE(block, nullptr);
+        EXPECT_TRUE(sut.owns(block));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % alignof(std::max_align_t), 0U);
+        blocks.emplace(block);
+    }
+    EXPECT_EQ(blocks.size(), BlockCount);
+    EXPECT_EQ(sut.usedSpace(), sut.totalSpace());
+    EXPECT_EQ(sut.level(), 100.0);
+
+    EXPECT_EQ(sut.tryAllocate(), nullptr);
+    EXPECT_THROW((void)sut.allocate(1U), std::bad_alloc);
+
+    for (auto const block : blocks)
+    {
+        sut.deallocate(block, 100U);
+    }
+    EXPECT_EQ(sut.usedSpace(), 0U);
+}
+
+TEST_F(MemoryFixedBlockPool, BlocksDoNotOverlap)
+{
+    std::vector<char *> blocks{};
+    for (auto i = 0U; i < BlockCount; ++i)
+    {
+        blocks.emplace_back(sut.allocate(sut.blockSize()));
+        std::memset(blocks.back(), static_cast<int>(i), sut.blockSize());
+    }
+    for (auto i = 0U; i < BlockCount; ++i)
+    {
+        EXPECT_TRUE(std::all_of(blocks[i], blocks[i] + sut.blockSize(), [i](char const c) noexcept {
+            return c == static_cast<char>(i);
+        }));
+    }
+    for (auto const block : blocks)
+    {
+        sut.deallocate(block, sut.blockSize());
+    }
+}
+
+TEST_F(MemoryFixedBlockPool, TooLargeRequestThrows)
+{
+    EXPECT_THROW((void)sut.allocate(sut.blockSize() + 1U), std::bad_alloc);
+    EXPECT_EQ(sut.usedSpace(), 0U);
+}
+
+TEST_F(MemoryFixedBlockPool, DeallocatedBlockReused)
+{
+    auto const first = sut.allocate(8U);
+    sut.deallocate(first, 8U);
+    EXPECT_EQ(sut.allocate(8U), first);
+    EXPECT_EQ(sut.usedBlocks(), 1U);
+    sut.deallocate(first, 8U);
+}
+
+TEST_F(MemoryFixedBlockPool, DeallocateNullptrIgnored)
+{
+    sut.deallocate(nullptr, 0U);
+    EXPECT_EQ(sut.usedBlocks(), 0U);
+}
+
+TEST_F(MemoryFixedBlockPool, OwnsOnlyArena)
+{
+    char outside{};
+    EXPECT_FALSE(sut.owns(&outside));
+    EXPECT_FALSE(sut.owns(nullptr));
+}
+
+TEST_F(MemoryFixedBlockPool, DeallocateForeignPointerRejected)
+{
+    char       outside{};
+    auto const block = sut.allocate(8U);
+    EXPECT_DEBUG_DEATH(sut.deallocate(&outside, 1U), "");
+    EXPECT_DEBUG_DEATH(sut.deallocate(block + 1U, 8U), "");
+    EXPECT_EQ(sut.usedBlocks(), 1U);
+    sut.deallocate(block, 8U);
+    EXPECT_EQ(sut.usedBlocks(), 0U);
+}
+
+TEST_F(MemoryFixedBlockPool, EmptyPool)
+{
+    FixedBlockPool empty{64U, 0U};
+    EXPECT_EQ(empty.totalSpace(), 0U);
+    EXPECT_EQ(empty.tryAllocate(), nullptr);
+}
+
+TEST_F(MemoryFixedBlockPool, TooManyBlocksThrow)
+{
+    EXPECT_THROW(FixedBlockPool(16U, FixedBlockPool::MaxBlockCount + 1U), std::bad_alloc);
+}
+
+TEST_F(MemoryFixedBlockPool, OverflowingSizeThrows)
+{
+    constexpr auto Limit = std::numeric_limits<std::size_t>::max();
+    EXPECT_THROW(FixedBlockPool(Limit, 1U), std::bad_alloc);
+    EXPECT_THROW(FixedBlockPool(Limit / 4U, 8U), std::bad_alloc);
+}
+
+TEST_F(MemoryFixedBlockPool, StoragePolicyApplied)
+{
+    FixedBlockPool pool{4096U, 1024U, StoragePolicy{PageKind::TransparentHuge, true}};
+    EXPECT_GE(pool.storage().size(), pool.totalSpace());
+    EXPECT_TRUE(pool.owns(pool.storage().data()));
+
+    auto const block = pool.allocate(4096U);
+    block[0U]        = 1;
+    auto const nodes = pool.residentPerNode();
+    if (!nodes.empty() && !pool.storage().applied().locked)
+    {
+        // without pinning only the touched pages are resident
+        EXPECT_LT(std::accumulate(nodes.begin(), nodes.end(), std::size_t{}), pool.totalSpace());
+    }
+    pool.deallocate(block, 4096U);
+}
+
+TEST_F(MemoryFixedBlockPool, ConcurrentAllocateAndDeallocate)
+{
+    constexpr std::size_t Threads{4U};
+    constexpr std::size_t Rounds{20000U};
+
+    std::atomic_bool         intact{true};
+    std::vector<std::thread> workers{};
+    for (std::size_t t = 0U; t < Threads; ++t)
+    {
+        workers.emplace_back([&, t]() noexcept {
+            // each thread holds up to a quarter of the pool, marking its blocks to detect double allocations
+            std::vector<char *> held{};
+            for (std::size_t round = 0U; round < Rounds; ++round)
+            {
+                if ((held.size() < (BlockCount / Threads)) && ((round % 3U) != 2U))
+                {
+                    auto const block = sut.tryAllocate();
+                    if (block != nullptr)
+                    {
+                        std::memset(block, static_cast<int>(t), sut.blockSize());
+                        held.emplace_back(block);
+                    }
+                }
+                else if (!held.empty())
+                {
+                    auto const block = held.back();
+                    held.pop_back();
+                    if (!std::all_of(block, block + sut.blockSize(), [t](char const c) noexcept {
+                            return c == static_cast<char>(t);
+                        }))
+                    {
+                        intact = false;
+                    }
+                    sut.deallocate(block, sut.blockSize());
+                }
+            }
+            for (auto const block : held)
+            {
+                sut.deallocate(block, sut.blockSize());
+            }
+        });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    EXPECT_TRUE(intact);
+    EXPECT_EQ(sut.usedSpace(), 0U);
+
+    // every block has made it back to the list
+    for (auto i = 0U; i < BlockCount; ++i)
+    {
+        EXPECT_NE(sut.tryAllocate(), nullptr);
+    }
+    EXPECT_EQ(sut.tryAllocate(), nullptr);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,269 @@
+#include "THzCommon/memory/instrumentedpool.hpp"
+
+#include "THzCommon/memory/fixedblockpool.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct MemoryInstrumentedPool : public testing::Test
+{
+    /// @brief Reads all lines of the log file of the given logger, destroying the logger.
+    ///
+    /// @param logger The logger to read the file of.
+    /// @return The lines of the log file.
+    static std::vector<std::string> readLog(std::unique_ptr<Logger> &logger) noexcept
+    {
+        auto const filepath = logger->filepath();
+        logger.reset();
+
+        std::vector<std::string> lines{};
+        std::ifstream            file{filepath};
+        for (std::string line{}; std::getline(file, line);)
+        {
+            lines.emplace_back(line);
+        }
+        file.close();
+        std::remove(filepath.c_str());
+        return lines;
+    }
+
+    FixedBlockPool pool{64U, 16U};
+
+    std::unique_ptr<Logger> logger{std::make_unique<Logger>()};
+
+    InstrumentedPool sut{pool};
+};
+
+TEST_F(MemoryInstrumentedPool, ForwardsToPool)
+{
+    EXPECT_EQ(sut.totalSpace(), pool.totalSpace());
+    auto const block = sut.allocate(10U);
+    EXPECT_TRUE(pool.owns(block));
+    EXPECT_EQ(sut.usedSpace(), pool.blockSize());
+    sut.deallocate(block, 10U);
+    EXPECT_EQ(sut.usedSpace(), 0U);
+}
+
+TEST_F(MemoryInstrumentedPool, HistogramAndPeak)
+{
+    std::vector<char *> blocks{};
+    for (auto const size : {1U, 8U, 16U, 17U, 64U, 64U})
+    {
+        blocks.emplace_back(sut.allocate(size));
+    }
+    sut.deallocate(blocks.back(), 64U);
+
+    auto const statistics = sut.snapshot();
+    EXPECT_EQ(statistics.sizes[0U], 1U);
+    EXPECT_EQ(statistics.sizes[3U], 1U);
+    EXPECT_EQ(statistics.sizes[4U], 1U);
+    EXPECT_EQ(statistics.sizes[5U], 1U);
+    EXPECT_EQ(statistics.sizes[6U], 2U);
+    EXPECT_EQ(statistics.allocations, 6U);
+    EXPECT_EQ(statistics.deallocations, 1U);
+    EXPECT_EQ(statistics.requestedBytes, 106U);
+    EXPECT_EQ(statistics.peakRequestedBytes, 170U);
+    EXPECT_EQ(statistics.usedSpace, 5U * pool.blockSize());
+    EXPECT_EQ(statistics.totalSpace, pool.totalSpace());
+    EXPECT_GT(statistics.elapsed.count(), 0);
+    EXPECT_GT(statistics.allocationRate(), 0.0);
+
+    blocks.pop_back();
+    std::size_t i{};
+    for (auto const size : {1U, 8U, 16U, 17U, 64U})
+    {
+        sut.deallocate(blocks[i++], size);
+    }
+    EXPECT_EQ(sut.snapshot().requestedBytes, 0U);
+    EXPECT_EQ(sut.snapshot().peakRequestedBytes, 170U);
+}
+
+TEST_F(MemoryInstrumentedPool, FailuresCounted)
+{
+    EXPECT_THROW((void)sut.allocate(pool.blockSize() + 1U), std::bad_alloc);
+    auto const statistics = sut.snapshot();
+    EXPECT_EQ(statistics.failures, 1U);
+    EXPECT_EQ(statistics.allocations, 0U);
+    EXPECT_EQ(statistics.requestedBytes, 0U);
+}
+
+TEST_F(MemoryInstrumentedPool, Reset)
+{
+    auto const first  = sut.allocate(32U);
+    auto const second = sut.allocate(32U);
+    sut.deallocate(second, 32U);
+    sut.reset();
+
+    auto const statistics = sut.snapshot();
+    EXPECT_EQ(statistics.allocations, 0U);
+    EXPECT_EQ(statistics.deallocations, 0U);
+    EXPECT_EQ(statistics.sizes[5U], 0U);
+    EXPECT_EQ(statistics.requestedBytes, 32U);
+    EXPECT_EQ(statistics.peakRequestedBytes, 32U);
+    sut.deallocate(first, 32U);
+}
+
+TEST_F(MemoryInstrumentedPool, CallSitesAttributed)
+{
+    if (!InstrumentedPool::tracksAllocations())
+    {
+        GTEST_SKIP() << "allocations are only tracked in debug builds";
+    }
+    std::vector<char *> blocks{};
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        blocks.emplace_back(sut.allocateAt(16U));
+    }
+    auto const line  = std::source_location::current().line() + 1U;
+    auto const large = sut.allocateAt(64U);
+
+    auto const statistics = sut.snapshot();
+    ASSERT_EQ(statistics.sites.size(), 2U);
+    EXPECT_EQ(statistics.sites[0U].allocations, 1U);
+    EXPECT_EQ(statistics.sites[0U].bytes, 64U);
+    EXPECT_EQ(statistics.sites[0U].location.line(), line);
+    EXPECT_EQ(statistics.sites[1U].allocations, 3U);
+    EXPECT_EQ(statistics.sites[1U].bytes, 48U);
+
+    sut.deallocate(large, 64U);
+    for (auto const block : blocks)
+    {
+        sut.deallocate(block, 16U);
+    }
+    EXPECT_TRUE(sut.snapshot().sites.empty());
+}
+
+TEST_F(MemoryInstrumentedPool, DoubleFreeDetected)
+{
+    if (!InstrumentedPool::tracksAllocations())
+    {
+        GTEST_SKIP() << "allocations are only tracked in debug builds";
+    }
+    logger->setFilepath("test_");
+    logger->maxLevel() = LogLevel::Error;
+    InstrumentedPool instrumented{pool, *logger};
+
+    auto const block = instrumented.allocate(8U);
+    instrumented.deallocate(block, 8U);
+    instrumented.deallocate(block, 8U);
+
+    // the second deallocation has not reached the pool, so it still holds every block once
+    EXPECT_EQ(instrumented.snapshot().doubleFrees, 1U);
+    EXPECT_EQ(instrumented.snapshot().deallocations, 1U);
+    EXPECT_EQ(pool.usedBlocks(), 0U);
+    for (auto i = 0U; i < pool.blockCount(); ++i)
+    {
+        EXPECT_NE(pool.tryAllocate(), nullptr);
+    }
+    EXPECT_EQ(pool.tryAllocate(), nullptr);
+
+    auto const lines = readLog(logger);
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_NE(lines[0U].find(" E THzCommon.Memory"), std::string::npos);
+}
+
+TEST_F(MemoryInstrumentedPool, SizeMismatchDetected)
+{
+    if (!InstrumentedPool::tracksAllocations())
+    {
+        GTEST_SKIP() << "allocations are only tracked in debug builds";
+    }
+    logger->setFilepath("test_");
+    logger->maxLevel() = LogLevel::Warning;
+    InstrumentedPool instrumented{pool, *logger};
+
+    auto const block = instrumented.allocateAt(32U);
+    instrumented.deallocate(block, 16U);
+
+    auto const statistics = instrumented.snapshot();
+    EXPECT_EQ(statistics.sizeMismatches, 1U);
+    EXPECT_EQ(statistics.requestedBytes, 0U);
+    EXPECT_EQ(pool.usedBlocks(), 0U);
+
+    auto const lines = readLog(logger);
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_NE(lines[0U].find("deallocation of 16 bytes, allocated with 32 bytes from "), std::string::npos);
+    EXPECT_NE(lines[0U].find("test/memory/instrumentedpool.cpp"), std::string::npos);
+}
+
+TEST_F(MemoryInstrumentedPool, LeaksLoggedOnDestruction)
+{
+    if (!InstrumentedPool::tracksAllocations())
+    {
+        GTEST_SKIP() << "allocations are only tracked in debug builds";
+    }
+    logger->setFilepath("test_");
+    logger->maxLevel() = LogLevel::Warning;
+    char *block{};
+    {
+        InstrumentedPool instrumented{pool, *logger};
+        block = instrumented.allocateAt(24U);
+    }
+    pool.deallocate(block, 24U);
+
+    auto const lines = readLog(logger);
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_NE(lines[0U].find("leaked 24 bytes in 1 allocations from "), std::string::npos);
+}
+
+TEST_F(MemoryInstrumentedPool, LogStatistics)
+{
+    logger->setFilepath("test_");
+    logger->maxLevel() = LogLevel::Info;
+
+    auto const block      = sut.allocateAt(40U);
+    auto const statistics = sut.snapshot();
+    EXPECT_NE(toString(statistics).find("1 allocs, 0 frees, 0 failures, "), std::string::npos);
+    EXPECT_NE(toString(statistics).find(" sizes <=64: 1"), std::string::npos);
+    logStatistics(statistics, "pool", *logger);
+    sut.deallocate(block, 40U);
+
+    auto const lines = readLog(logger);
+    ASSERT_EQ(lines.size(), 1U + statistics.sites.size());
+    EXPECT_NE(lines[0U].find(" I THzCommon.Memory"), std::string::npos);
+    EXPECT_NE(lines[0U].find("pool " + toString(statistics)), std::string::npos);
+    if (InstrumentedPool::tracksAllocations())
+    {
+        EXPECT_NE(lines[1U].find("pool 1 allocs, 40 bytes from "), std::string::npos);
+    }
+}
+
+TEST_F(MemoryInstrumentedPool, ConcurrentRecording)
+{
+    constexpr std::size_t Threads{4U};
+    constexpr std::size_t Rounds{10000U};
+
+    std::vector<std::thread> workers{};
+    for (std::size_t t = 0U; t < Threads; ++t)
+    {
+        workers.emplace_back([&, t]() noexcept {
+            for (std::size_t round = 0U; round < Rounds; ++round)
+            {
+                auto const size  = 1U + ((t + round) % 64U);
+                auto const block = sut.allocateAt(size);
+                sut.deallocate(block, size);
+            }
+        });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    auto const statistics = sut.snapshot();
+    EXPECT_EQ(statistics.allocations, Threads * Rounds);
+    EXPECT_EQ(statistics.deallocations, Threads * Rounds);
+    EXPECT_EQ(statistics.requestedBytes, 0U);
+    EXPECT_LE(statistics.peakRequestedBytes, Threads * 64U);
+    EXPECT_EQ(statistics.doubleFrees, 0U);
+    EXPECT_TRUE(statistics.sites.empty());
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,170 @@
+#include "THzCommon/memory/monotonicarena.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct MemoryMonotonicArena : public testing::Test
+{
+    /// @brief The size of the blocks of the arena of the tests.
+    static constexpr std::size_t BlockSize{1024U};
+
+    MonotonicArena sut{BlockSize};
+};
+
+TEST_F(MemoryMonotonicArena, Construction)
+{
+    EXPECT_EQ(sut.usedSpace(), 0U);
+    EXPECT_EQ(sut.totalSpace(), 0U);
+}
+
+TEST_F(MemoryMonotonicArena, AllocationsBumpThePointer)
+{
+    auto const first  = sut.allocate(16U);
+    auto const second = sut.allocate(16U);
+    EXPECT_EQ(second, first + 16U);
+    EXPECT_EQ(sut.usedSpace(), 32U);
+    EXPECT_EQ(sut.totalSpace(), BlockSize);
+
+    // deallocating does not give back anything
+    sut.deallocate(second, 16U);
+    EXPECT_EQ(sut.usedSpace(), 32U);
+}
+
+TEST_F(MemoryMonotonicArena, AllocationsAligned)
+{
+    (void)sut.allocate(1U, 1U);
+    for (std::size_t alignment = 1U; alignment <= 256U; alignment *= 2U)
+    {
+        auto const p = sut.allocate(3U, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0U);
+        (void)sut.allocate(1U, 1U);
+    }
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(sut.allocate(1U)) % alignof(std::max_align_t), 0U);
+}
+
+TEST_F(MemoryMonotonicArena, BlocksChained)
+{
+    std::vector<char *> allocations{};
+    for (auto i = 0U; i < 10U; ++i)
+    {
+        allocations.emplace_back(sut.allocate(400U));
+        std::memset(allocations.back(), static_cast<int>(i), 400U);
+    }
+    EXPECT_EQ(sut.totalSpace(), 5U * BlockSize);
+    for (auto i = 0U; i < 10U; ++i)
+    {
+        EXPECT_EQ(allocations[i][399U], static_cast<char>(i));
+    }
+}
+
+TEST_F(MemoryMonotonicArena, LargeAllocationGetsBlockOfItsOwn)
+{
+    auto const p = sut.allocate(5000U);
+    std::memset(p, 1, 5000U);
+    EXPECT_GE(sut.totalSpace(), 5000U);
+    EXPECT_EQ(sut.usedSpace(), 5000U);
+}
+
+TEST_F(MemoryMonotonicArena, ResetKeepsBlocks)
+{
+    auto const first = sut.allocate(400U);
+    for (auto i = 0U; i < 9U; ++i)
+    {
+        (void)sut.allocate(400U);
+    }
+    auto const total = sut.totalSpace();
+
+    sut.reset();
+    EXPECT_EQ(sut.usedSpace(), 0U);
+    EXPECT_EQ(sut.allocate(400U), first);
+    for (auto i = 0U; i < 9U; ++i)
+    {
+        (void)sut.allocate(400U);
+    }
+    EXPECT_EQ(sut.totalSpace(), total);
+}
+
+TEST_F(MemoryMonotonicArena, ReleaseReturnsBlocks)
+{
+    (void)sut.allocate(400U);
+    sut.release();
+    EXPECT_EQ(sut.usedSpace(), 0U);
+    EXPECT_EQ(sut.totalSpace(), 0U);
+    (void)sut.allocate(400U);
+    EXPECT_EQ(sut.totalSpace(), BlockSize);
+}
+
+TEST_F(MemoryMonotonicArena, RewindToMarker)
+{
+    (void)sut.allocate(100U);
+    auto const marker = sut.mark();
+    auto const p      = sut.allocate(100U);
+    (void)sut.allocate(2000U);
+
+    sut.rewind(marker);
+    EXPECT_EQ(sut.usedSpace(), 100U);
+    EXPECT_EQ(sut.allocate(100U), p);
+}
+
+TEST_F(MemoryMonotonicArena, NestedScopes)
+{
+    (void)sut.allocate(16U);
+    {
+        ArenaScope outer{sut};
+        (void)sut.allocate(16U);
+        {
+            ArenaScope inner{sut};
+            (void)sut.allocate(3000U);
+            EXPECT_EQ(sut.usedSpace(), 3032U);
+        }
+        EXPECT_EQ(sut.usedSpace(), 32U);
+    }
+    EXPECT_EQ(sut.usedSpace(), 16U);
+}
+
+TEST_F(MemoryMonotonicArena, CapacityExhausted)
+{
+    MonotonicArena bounded{BlockSize, 2U * BlockSize};
+    (void)bounded.allocate(BlockSize);
+    (void)bounded.allocate(BlockSize);
+    EXPECT_THROW((void)bounded.allocate(1U), std::bad_alloc);
+
+    // after a reset the blocks are available again
+    bounded.reset();
+    EXPECT_NO_THROW((void)bounded.allocate(BlockSize));
+}
+
+TEST_F(MemoryMonotonicArena, AllocatorForContainers)
+{
+    ArenaAllocator<int> allocator{sut};
+    {
+        std::vector<int, ArenaAllocator<int>> values{allocator};
+        for (auto i = 0; i < 100; ++i)
+        {
+            values.emplace_back(i);
+        }
+        EXPECT_EQ(values[99], 99);
+
+        using StringAllocator = ArenaAllocator<char>;
+        using String          = std::basic_string<char, std::char_traits<char>, StringAllocator>;
+        using MapAllocator    = ArenaAllocator<std::pair<String const, String>>;
+        std::map<String, String, std::less<>, MapAllocator> map{MapAllocator{allocator}};
+        map.emplace(String{"a key long enough to need memory of its own", allocator},
+                    String{"and a value that is even longer than that key", allocator});
+        EXPECT_EQ(map.size(), 1U);
+    }
+    EXPECT_GT(sut.usedSpace(), 100U * sizeof(int));
+    EXPECT_TRUE(ArenaAllocator<char>{sut} == allocator);
+
+    MonotonicArena other{};
+    EXPECT_FALSE(ArenaAllocator<int>{other} == allocator);
+}
+
+} // namespace Terrahertz::UnitTests
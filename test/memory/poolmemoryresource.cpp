@@ -0,0 +1,71 @@
+#include "THzCommon/memory/poolmemoryresource.hpp"
+
+#include "THzCommon/memory/slabpool.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct MemoryPoolMemoryResource : public testing::Test
+{
+    SlabPool           pool{1U << 24U};
+    PoolMemoryResource sut{pool};
+};
+
+TEST_F(MemoryPoolMemoryResource, Construction) { EXPECT_EQ(&sut.pool(), &pool); }
+
+TEST_F(MemoryPoolMemoryResource, ContainersAllocateFromPool)
+{
+    {
+        std::pmr::vector<std::uint32_t> values{&sut};
+        for (auto i = 0U; i < 1000U; ++i)
+        {
+            values.emplace_back(i);
+        }
+        std::pmr::string text{"a string way too long to fit into the small string buffer", &sut};
+        EXPECT_GE(pool.usedSpace(), values.capacity() * sizeof(std::uint32_t) + text.size());
+        EXPECT_EQ(values[999U], 999U);
+    }
+    EXPECT_EQ(pool.usedSpace(), 0U);
+}
+
+TEST_F(MemoryPoolMemoryResource, NestedContainersPropagateResource)
+{
+    {
+        std::pmr::map<std::pmr::string, std::pmr::vector<int>> map{&sut};
+        map["a rather long key, so it needs memory of its own"].emplace_back(42);
+        EXPECT_EQ(map.begin()->first.get_allocator().resource(), &sut);
+        EXPECT_EQ(map.begin()->second.get_allocator().resource(), &sut);
+    }
+    EXPECT_EQ(pool.usedSpace(), 0U);
+}
+
+TEST_F(MemoryPoolMemoryResource, OverAlignedAllocations)
+{
+    for (std::size_t alignment = 32U; alignment <= 4096U; alignment *= 2U)
+    {
+        auto const p = sut.allocate(100U, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0U);
+        sut.deallocate(p, 100U, alignment);
+    }
+    EXPECT_EQ(pool.usedSpace(), 0U);
+    EXPECT_EQ(pool.statistics().requestedBytes, 0U);
+}
+
+TEST_F(MemoryPoolMemoryResource, Equality)
+{
+    PoolMemoryResource samePool{pool};
+    SlabPool           otherPool{1U << 20U};
+    PoolMemoryResource other{otherPool};
+
+    EXPECT_TRUE(sut.is_equal(samePool));
+    EXPECT_FALSE(sut.is_equal(other));
+    EXPECT_FALSE(sut.is_equal(*std::pmr::new_delete_resource()));
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,266 @@
+#include "THzCommon/memory/slabpool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <new>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct MemorySlabPool : public testing::Test
+{
+    /// @brief The capacity of the pool of the tests.
+    static constexpr std::size_t Capacity{16U * SlabPool::SlabSize};
+
+    SlabPool sut{Capacity};
+};
+
+TEST_F(MemorySlabPool, Construction)
+{
+    EXPECT_EQ(sut.totalSpace(), Capacity);
+    EXPECT_EQ(sut.usedSpace(), 0U);
+
+    auto const statistics = sut.statistics();
+    EXPECT_EQ(statistics.reservedBytes, 0U);
+    EXPECT_EQ(statistics.fragmentation(), 0.0);
+    ASSERT_EQ(statistics.classes.size(), SlabPool::ClassCount);
+    EXPECT_EQ(statistics.classes.front().blockSize, SlabPool::MinClassSize);
+    EXPECT_EQ(statistics.classes.back().blockSize, SlabPool::MaxClassSize);
+}
+
+TEST_F(MemorySlabPool, ClassIndex)
+{
+    EXPECT_EQ(SlabPool::classIndex(0U), 0U);
+    EXPECT_EQ(SlabPool::classIndex(16U), 0U);
+    EXPECT_EQ(SlabPool::classIndex(17U), 1U);
+    EXPECT_EQ(SlabPool::classIndex(32U), 1U);
+    EXPECT_EQ(SlabPool::classIndex(1000U), 6U);
+    EXPECT_EQ(SlabPool::classIndex(SlabPool::MaxClassSize), SlabPool::ClassCount - 1U);
+    EXPECT_EQ(SlabPool::classIndex(SlabPool::MaxClassSize + 1U), SlabPool::ClassCount);
+}
+
+TEST_F(MemorySlabPool, AllocationsRoundedToClass)
+{
+    auto const block = sut.allocate(100U);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % SlabPool::MinClassSize, 0U);
+    std::memset(block, 0xAB, 128U);
+    EXPECT_EQ(sut.usedSpace(), 128U);
+
+    auto const statistics = sut.statistics();
+    EXPECT_EQ(statistics.requestedBytes, 100U);
+    EXPECT_EQ(statistics.usedBytes, 128U);
+    EXPECT_EQ(statistics.reservedBytes, SlabPool::SlabSize);
+    EXPECT_GT(statistics.fragmentation(), 0.99);
+
+    sut.deallocate(block, 100U);
+    EXPECT_EQ(sut.usedSpace(), 0U);
+    EXPECT_EQ(sut.statistics().requestedBytes, 0U);
+}
+
+TEST_F(MemorySlabPool, DistinctBlocks)
+{
+    std::vector<std::pair<char *, std::size_t>> blocks{};
+    for (std::size_t size = 1U; size <= SlabPool::MaxClassSize; size *= 3U)
+    {
+        for (auto i = 0U; i < 40U; ++i)
+        {
+            auto const block = sut.allocate(size);
+            std::memset(block, static_cast<int>(blocks.size()), size);
+            blocks.emplace_back(block, size);
+        }
+    }
+    for (std::size_t i = 0U; i < blocks.size(); ++i)
+    {
+        auto const [block, size] = blocks[i];
+        EXPECT_TRUE(std::all_of(block, block + size, [i](char const c) noexcept { return c == static_cast<char>(i); }));
+    }
+    for (auto const &[block, size] : blocks)
+    {
+        sut.deallocate(block, size);
+    }
+    EXPECT_EQ(sut.usedSpace(), 0U);
+}
+
+TEST_F(MemorySlabPool, DeallocatedBlocksReused)
+{
+    std::set<char *> first{};
+    for (auto i = 0U; i < 10U; ++i)
+    {
+        first.emplace(sut.allocate(64U));
+    }
+    for (auto const block : first)
+    {
+        sut.deallocate(block, 64U);
+    }
+    for (auto i = 0U; i < 10U; ++i)
+    {
+        auto const block = sut.allocate(64U);
+        EXPECT_TRUE(first.contains(block));
+        sut.deallocate(block, 64U);
+    }
+    EXPECT_EQ(sut.statistics().reservedBytes, SlabPool::SlabSize);
+}
+
+TEST_F(MemorySlabPool, HighWaterMark)
+{
+    constexpr auto Count = 3U * SlabPool::MagazineSize;
+
+    std::vector<char *> blocks{};
+    for (auto i = 0U; i < Count; ++i)
+    {
+        blocks.emplace_back(sut.allocate(SlabPool::MinClassSize));
+    }
+    for (auto const block : blocks)
+    {
+        sut.deallocate(block, SlabPool::MinClassSize);
+    }
+
+    auto const statistics = sut.statistics();
+    auto const &smallest  = statistics.classes.front();
+    EXPECT_GE(smallest.highWaterBlocks, Count);
+    EXPECT_LE(smallest.takenBlocks, SlabPool::MagazineSize);
+    EXPECT_GE(smallest.reservedBlocks, smallest.highWaterBlocks);
+    EXPECT_EQ(statistics.classes.back().highWaterBlocks, 0U);
+}
+
+TEST_F(MemorySlabPool, LargeAllocationsMapped)
+{
+    constexpr auto Size = 3U * SlabPool::MaxClassSize + 5U;
+
+    auto const block = sut.allocate(Size);
+    ASSERT_NE(block, nullptr);
+    std::memset(block, 0x42, Size);
+
+    auto const statistics = sut.statistics();
+    EXPECT_GE(statistics.largeBytes, Size);
+    EXPECT_EQ(statistics.reservedBytes, statistics.largeBytes);
+    EXPECT_EQ(statistics.requestedBytes, Size);
+    EXPECT_EQ(sut.usedSpace(), statistics.largeBytes);
+
+    sut.deallocate(block, Size);
+    EXPECT_EQ(sut.usedSpace(), 0U);
+    EXPECT_EQ(sut.statistics().largeBytes, 0U);
+    EXPECT_EQ(sut.statistics().reservedBytes, 0U);
+}
+
+TEST_F(MemorySlabPool, CapacityExhausted)
+{
+    EXPECT_THROW((void)sut.allocate(Capacity + 1U), std::bad_alloc);
+
+    SlabPool small{SlabPool::SlabSize};
+    auto const first = small.allocate(SlabPool::MaxClassSize);
+    EXPECT_THROW((void)small.allocate(SlabPool::MinClassSize), std::bad_alloc);
+    small.deallocate(first, SlabPool::MaxClassSize);
+}
+
+TEST_F(MemorySlabPool, StoragePolicyApplied)
+{
+    SlabPool pool{8U * BackingStorage::HugePageSize, StoragePolicy{PageKind::TransparentHuge}};
+
+    // a slab spans a huge page then
+    auto const small = pool.allocate(64U);
+    EXPECT_EQ(pool.statistics().reservedBytes, BackingStorage::HugePageSize);
+
+    auto const large = pool.allocate(SlabPool::MaxClassSize + 1U);
+    EXPECT_EQ(pool.statistics().largeBytes, BackingStorage::HugePageSize);
+
+    std::memset(small, 1, 64U);
+    std::memset(large, 1, SlabPool::MaxClassSize + 1U);
+    auto const nodes = pool.statistics().residentPerNode;
+    if (!nodes.empty())
+    {
+        EXPECT_GT(nodes.front(), 0U);
+    }
+    pool.deallocate(large, SlabPool::MaxClassSize + 1U);
+    pool.deallocate(small, 64U);
+}
+
+TEST_F(MemorySlabPool, BlocksFreedOnOtherThread)
+{
+    std::vector<char *> blocks{};
+    for (auto i = 0U; i < 100U; ++i)
+    {
+        blocks.emplace_back(sut.allocate(200U));
+    }
+    std::thread other{[&]() noexcept {
+        for (auto const block : blocks)
+        {
+            sut.deallocate(block, 200U);
+        }
+    }};
+    other.join();
+    EXPECT_EQ(sut.usedSpace(), 0U);
+    EXPECT_EQ(sut.statistics().requestedBytes, 0U);
+}
+
+TEST_F(MemorySlabPool, MagazineOfExitedThreadReused)
+{
+    auto const run = [&]() noexcept {
+        std::thread worker{[&]() noexcept { sut.deallocate(sut.allocate(48U), 48U); }};
+        worker.join();
+    };
+    run();
+    auto const taken = sut.statistics().classes[SlabPool::classIndex(48U)].takenBlocks;
+    run();
+    EXPECT_EQ(sut.statistics().classes[SlabPool::classIndex(48U)].takenBlocks, taken);
+}
+
+TEST_F(MemorySlabPool, ConcurrentUse)
+{
+    constexpr std::size_t Threads{4U};
+    constexpr std::size_t Rounds{5000U};
+
+    std::atomic_bool         intact{true};
+    std::vector<std::thread> workers{};
+    for (std::size_t t = 0U; t < Threads; ++t)
+    {
+        workers.emplace_back([&, t]() noexcept {
+            std::vector<std::pair<char *, std::size_t>> held{};
+            for (std::size_t round = 0U; round < Rounds; ++round)
+            {
+                if ((round % 4U) != 3U)
+                {
+                    auto const size  = 1U + ((round * 37U + t * 101U) % 3000U);
+                    auto const block = sut.allocate(size);
+                    std::memset(block, static_cast<int>(t), size);
+                    held.emplace_back(block, size);
+                }
+                else
+                {
+                    for (auto i = 0U; (i < 3U) && !held.empty(); ++i)
+                    {
+                        auto const [block, size] = held.back();
+                        held.pop_back();
+                        if (!std::all_of(block, block + size, [t](char const c) noexcept {
+                                return c == static_cast<char>(t);
+                            }))
+                        {
+                            intact = false;
+                        }
+                        sut.deallocate(block, size);
+                    }
+                }
+            }
+            for (auto const &[block, size] : held)
+            {
+                sut.deallocate(block, size);
+            }
+        });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    EXPECT_TRUE(intact);
+    EXPECT_EQ(sut.usedSpace(), 0U);
+    EXPECT_EQ(sut.statistics().requestedBytes, 0U);
+}
+
+} // namespace Terrahertz::UnitTests
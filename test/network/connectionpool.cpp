@@ -0,0 +1,244 @@
+#include "THzCommon/network/connectionpool.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct NetworkConnectionPool : public testing::Test
+{
+    using TCPSocketV4 = TCPSocket<IPVersion::V4>;
+    using PoolV4      = ConnectionPool<IPVersion::V4>;
+
+    /// @brief Binds the listener to a random port on the loopback interface.
+    void SetUp() override
+    {
+        std::uniform_int_distribution<> distrib{6001, 8000};
+
+        ASSERT_TRUE(listener.setReuseAddr(true));
+        bool bound{};
+        for (uint16_t i = 0U; (i < 5U) && !bound; ++i)
+        {
+            address.port = static_cast<std::uint16_t>(distrib(randomEngine));
+            bound        = listener.bind(address);
+        }
+        ASSERT_TRUE(bound) << "binding to address failed.";
+        ASSERT_TRUE(listener.listen(8U));
+    }
+
+    /// @brief Accepts a pending connection and keeps it open.
+    void acceptConnection() noexcept
+    {
+        accepted.emplace_back(listener.accept(nullptr));
+        ASSERT_TRUE(accepted.back().good());
+    }
+
+    std::mt19937 randomEngine{1337};
+
+    Address<IPVersion::V4> address{{127U, 0U, 0U, 1U}, 0U};
+
+    TCPSocketV4 listener{};
+
+    std::vector<TCPSocketV4> accepted{};
+};
+
+TEST_F(NetworkConnectionPool, SettingsAreLoadedFromConfiguration)
+{
+    Configuration const configuration{{{"no_delay", "false"},
+                                       {"keep_alive", "0"},
+                                       {"max_per_endpoint", "3"},
+                                       {"max_total", "12"},
+                                       {"idle_timeout_ms", "250"}}};
+
+    ConnectionPoolSettings sut{};
+    sut.load(configuration);
+    EXPECT_FALSE(sut.noDelay);
+    EXPECT_FALSE(sut.keepAlive);
+    EXPECT_EQ(sut.maxPerEndpoint, 3U);
+    EXPECT_EQ(sut.maxTotal, 12U);
+    EXPECT_EQ(sut.idleTimeout, std::chrono::milliseconds{250U});
+}
+
+TEST_F(NetworkConnectionPool, InvalidSettingsAreIgnored)
+{
+    Configuration const configuration{{{"no_delay", "maybe"}, {"max_per_endpoint", "-3"}, {"max_total", "12a"}}};
+
+    ConnectionPoolSettings const defaults{};
+    ConnectionPoolSettings       sut{};
+    sut.load(configuration);
+    EXPECT_EQ(sut.noDelay, defaults.noDelay);
+    EXPECT_EQ(sut.keepAlive, defaults.keepAlive);
+    EXPECT_EQ(sut.maxPerEndpoint, defaults.maxPerEndpoint);
+    EXPECT_EQ(sut.maxTotal, defaults.maxTotal);
+    EXPECT_EQ(sut.idleTimeout, defaults.idleTimeout);
+}
+
+TEST_F(NetworkConnectionPool, ConnectionIsReused)
+{
+    PoolV4 sut{};
+
+    Internal::SocketHandleType handle{};
+    {
+        auto lease = sut.acquire(address);
+        ASSERT_TRUE(lease.good());
+        acceptConnection();
+        handle = lease.socket().handle();
+        EXPECT_EQ(sut.leasedConnections(), 1U);
+        EXPECT_EQ(sut.idleConnections(), 0U);
+    }
+    EXPECT_EQ(sut.leasedConnections(), 0U);
+    EXPECT_EQ(sut.idleConnections(), 1U);
+
+    auto lease = sut.acquire(address);
+    ASSERT_TRUE(lease.good());
+    EXPECT_EQ(lease.socket().handle(), handle);
+    EXPECT_FALSE(listener.acceptIsNonblocking());
+}
+
+TEST_F(NetworkConnectionPool, InvalidatedConnectionIsNotReused)
+{
+    PoolV4 sut{};
+    {
+        auto lease = sut.acquire(address);
+        ASSERT_TRUE(lease.good());
+        acceptConnection();
+        lease.invalidate();
+        EXPECT_FALSE(lease.good());
+    }
+    EXPECT_EQ(sut.leasedConnections(), 0U);
+    EXPECT_EQ(sut.idleConnections(), 0U);
+}
+
+TEST_F(NetworkConnectionPool, LimitPerEndpointIsEnforced)
+{
+    ConnectionPoolSettings settings{};
+    settings.maxPerEndpoint = 2U;
+    PoolV4 sut{settings};
+
+    auto first  = sut.acquire(address);
+    auto second = sut.acquire(address);
+    auto third  = sut.acquire(address);
+    EXPECT_TRUE(first.good());
+    EXPECT_TRUE(second.good());
+    EXPECT_FALSE(third.good());
+    EXPECT_EQ(sut.leasedConnections(), 2U);
+
+    first = PoolV4::Lease{};
+    third = sut.acquire(address);
+    EXPECT_TRUE(third.good());
+}
+
+TEST_F(NetworkConnectionPool, IdleConnectionIsEvictedForTotalLimit)
+{
+    TCPSocketV4 otherListener{};
+    ASSERT_TRUE(otherListener.setReuseAddr(true));
+    auto otherAddress = address;
+    ++otherAddress.port;
+    if (!otherListener.bind(otherAddress) || !otherListener.listen(2U))
+    {
+        GTEST_SKIP() << "second port not available.";
+    }
+
+    ConnectionPoolSettings settings{};
+    settings.maxTotal = 1U;
+    PoolV4 sut{settings};
+    {
+        auto lease = sut.acquire(address);
+        ASSERT_TRUE(lease.good());
+
+        // no idle connection to make room
+        EXPECT_FALSE(sut.acquire(otherAddress).good());
+    }
+    EXPECT_EQ(sut.idleConnections(), 1U);
+
+    auto lease = sut.acquire(otherAddress);
+    EXPECT_TRUE(lease.good());
+    EXPECT_EQ(sut.idleConnections(), 0U);
+}
+
+TEST_F(NetworkConnectionPool, UnreachableEndpointReleasesSlot)
+{
+    ConnectionPoolSettings settings{};
+    settings.maxPerEndpoint = 1U;
+    PoolV4 sut{settings};
+
+    listener.close();
+    EXPECT_FALSE(sut.acquire(address).good());
+    EXPECT_EQ(sut.leasedConnections(), 0U);
+    EXPECT_EQ(sut.idleConnections(), 0U);
+}
+
+TEST_F(NetworkConnectionPool, HealthCheckClosesTimedOutConnections)
+{
+    ConnectionPoolSettings settings{};
+    settings.idleTimeout = std::chrono::milliseconds{20U};
+    PoolV4 sut{settings};
+
+    EXPECT_TRUE(sut.acquire(address).good());
+    EXPECT_EQ(sut.idleConnections(), 1U);
+    EXPECT_EQ(sut.checkHealth(), 0U);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{30U});
+    EXPECT_EQ(sut.checkHealth(), 1U);
+    EXPECT_EQ(sut.idleConnections(), 0U);
+}
+
+TEST_F(NetworkConnectionPool, HealthCheckDetectsClosedByServer)
+{
+    PoolV4 sut{};
+    {
+        auto lease = sut.acquire(address);
+        ASSERT_TRUE(lease.good());
+        acceptConnection();
+    }
+    accepted.clear();
+
+    // give the FIN time to arrive
+    std::this_thread::sleep_for(std::chrono::milliseconds{10U});
+    EXPECT_EQ(sut.checkHealth(), 1U);
+    EXPECT_EQ(sut.idleConnections(), 0U);
+}
+
+TEST_F(NetworkConnectionPool, MaintenanceRunsPeriodically)
+{
+    ConnectionPoolSettings settings{};
+    settings.idleTimeout = std::chrono::milliseconds{10U};
+    PoolV4 sut{settings};
+
+    EXPECT_TRUE(sut.acquire(address).good());
+    sut.startMaintenance(std::chrono::milliseconds{5U});
+    for (auto i = 0U; (i < 100U) && (sut.idleConnections() != 0U); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5U});
+    }
+    EXPECT_EQ(sut.idleConnections(), 0U);
+}
+
+TEST_F(NetworkConnectionPool, ConcurrentAcquireStaysWithinLimits)
+{
+    ConnectionPoolSettings settings{};
+    settings.maxPerEndpoint = 4U;
+    PoolV4 sut{settings};
+
+    std::vector<std::thread> threads{};
+    for (auto t = 0U; t < 8U; ++t)
+    {
+        threads.emplace_back([&]() {
+            for (auto i = 0U; i < 50U; ++i)
+            {
+                auto lease = sut.acquire(address);
+                EXPECT_LE(sut.leasedConnections(), settings.maxPerEndpoint);
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(sut.leasedConnections(), 0U);
+    EXPECT_LE(sut.idleConnections(), settings.maxPerEndpoint);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,334 @@
+#include "THzCommon/network/messageframer.hpp"
+
+#include "THzCommon/network/address.hpp"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+/// @brief Memory pool using the heap, keeping track of the used space.
+class HeapMemoryPool : public IMemoryPool
+{
+public:
+    char *allocate(size_t n) noexcept(false) override
+    {
+        _used += n;
+        return new char[n];
+    }
+
+    void deallocate(char *p, size_t n) noexcept override
+    {
+        _used -= n;
+        delete[] p;
+    }
+
+    size_t usedSpace() const noexcept override { return _used; }
+
+    size_t totalSpace() const noexcept override { return 1U << 30U; }
+
+private:
+    size_t _used{};
+};
+
+struct NetworkMessageFramer : public testing::TestWithParam<LengthPrefix>
+{
+    using TCPSocketV4 = TCPSocket<IPVersion::V4>;
+    using FramerV4    = MessageFramer<IPVersion::V4>;
+
+    /// @brief Connects the client socket to the server socket.
+    void SetUp() override
+    {
+        std::uniform_int_distribution<> distrib{4001, 6000};
+
+        TCPSocketV4 listener{};
+        ASSERT_TRUE(listener.setReuseAddr(true));
+        std::optional<Address<IPVersion::V4>> address{};
+        for (uint16_t i = 0U; (i < 5U) && !address; ++i)
+        {
+            auto const                   port = static_cast<std::uint16_t>(distrib(randomEngine));
+            Address<IPVersion::V4> const candidate{{127U, 0U, 0U, 1U}, port};
+            if (listener.bind(candidate))
+            {
+                address = candidate;
+            }
+        }
+        ASSERT_TRUE(address) << "binding to address failed.";
+        ASSERT_TRUE(listener.listen(2U));
+        ASSERT_TRUE(client.connect(*address));
+        server = listener.accept(nullptr);
+        ASSERT_TRUE(server.good());
+    }
+
+    /// @brief Creates a message of the given size with a recognizable content.
+    std::vector<std::byte> createMessage(size_t const size, std::uint8_t const seed) noexcept
+    {
+        std::vector<std::byte> message(size);
+        for (auto i = 0U; i < size; ++i)
+        {
+            message[i] = static_cast<std::byte>(seed + i);
+        }
+        return message;
+    }
+
+    std::mt19937 randomEngine{1337};
+
+    HeapMemoryPool pool{};
+
+    TCPSocketV4 client{};
+
+    TCPSocketV4 server{};
+};
+
+TEST_P(NetworkMessageFramer, BuffersAreDrawnFromThePool)
+{
+    {
+        FramerV4 sut{client, pool, GetParam(), 1024U};
+        EXPECT_GT(pool.usedSpace(), 1024U);
+        EXPECT_FALSE(sut.messageBuffered());
+        EXPECT_EQ(sut.pending(), 0U);
+    }
+    EXPECT_EQ(pool.usedSpace(), 0U);
+}
+
+TEST_P(NetworkMessageFramer, SmallMessagesAreCoalesced)
+{
+    FramerV4 sender{client, pool, GetParam(), 1024U, 1024U, FlushPolicy{512U, std::chrono::seconds{10U}}};
+    FramerV4 receiver{server, pool, GetParam(), 1024U};
+
+    std::vector<std::vector<std::byte>> messages{};
+    for (auto i = 0U; i < 10U; ++i)
+    {
+        messages.emplace_back(createMessage(i * 4U, static_cast<std::uint8_t>(i)));
+        auto const sendResult = sender.send(messages.back());
+        ASSERT_FALSE(sendResult.isError());
+        EXPECT_EQ(sendResult.value(), messages.back().size());
+    }
+    EXPECT_GT(sender.pending(), 0U);
+    EXPECT_FALSE(server.receiveIsNonblocking());
+    ASSERT_FALSE(sender.flush().isError());
+    EXPECT_EQ(sender.pending(), 0U);
+
+    auto const baseLevel = pool.usedSpace();
+    for (auto const &expected : messages)
+    {
+        auto const received = receiver.receive();
+        ASSERT_FALSE(received.isError());
+        ASSERT_EQ(received.value().size(), expected.size());
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), received.value().begin()));
+        receiver.release(received.value());
+
+        // all messages were read with the first call
+        EXPECT_FALSE(server.receiveIsNonblocking());
+    }
+    EXPECT_FALSE(receiver.messageBuffered());
+    EXPECT_EQ(pool.usedSpace(), baseLevel);
+}
+
+TEST_P(NetworkMessageFramer, ZeroDelayFlushesImmediately)
+{
+    FramerV4 sender{client, pool, GetParam(), 1024U, 1024U, FlushPolicy{512U, std::chrono::microseconds{0U}}};
+    FramerV4 receiver{server, pool, GetParam(), 1024U};
+
+    auto const message = createMessage(16U, 3U);
+    ASSERT_FALSE(sender.send(message).isError());
+    EXPECT_EQ(sender.pending(), 0U);
+
+    auto const received = receiver.receive();
+    ASSERT_FALSE(received.isError());
+    ASSERT_EQ(received.value().size(), message.size());
+    EXPECT_TRUE(std::equal(message.begin(), message.end(), received.value().begin()));
+    receiver.release(received.value());
+}
+
+TEST_P(NetworkMessageFramer, LargeMessagesBypassTheBuffers)
+{
+    FramerV4 sender{client, pool, GetParam(), 256U, 1U << 20U, FlushPolicy{256U, std::chrono::seconds{10U}}};
+    FramerV4 receiver{server, pool, GetParam(), 256U, 1U << 20U};
+
+    auto const small = createMessage(8U, 1U);
+    auto const large = createMessage(GetParam() == LengthPrefix::Fixed16 ? 60000U : 200000U, 7U);
+
+    // the large message forces the small one out first, keeping the order
+    ASSERT_FALSE(sender.send(small).isError());
+    std::thread senderThread{[&]() {
+        ASSERT_FALSE(sender.send(large).isError());
+        ASSERT_FALSE(sender.send(small).isError());
+        ASSERT_FALSE(sender.flush().isError());
+    }};
+
+    for (auto const *expected : {&small, &large, &small})
+    {
+        auto const received = receiver.receive();
+        ASSERT_FALSE(received.isError());
+        ASSERT_EQ(received.value().size(), expected->size());
+        EXPECT_TRUE(std::equal(expected->begin(), expected->end(), received.value().begin()));
+        receiver.release(received.value());
+    }
+    senderThread.join();
+}
+
+TEST_P(NetworkMessageFramer, OversizedMessageIsRejected)
+{
+    FramerV4 sender{client, pool, GetParam(), 256U};
+    FramerV4 receiver{server, pool, GetParam(), 256U, 16U};
+
+    ASSERT_FALSE(sender.send(createMessage(17U, 0U)).isError());
+    ASSERT_FALSE(sender.flush().isError());
+
+    auto const received = receiver.receive();
+    ASSERT_TRUE(received.isError());
+    EXPECT_EQ(received.errorCode(), EMSGSIZE);
+}
+
+TEST_P(NetworkMessageFramer, ClosedConnectionIsReported)
+{
+    FramerV4 receiver{server, pool, GetParam(), 256U};
+    client.close();
+
+    auto const received = receiver.receive();
+    ASSERT_TRUE(received.isError());
+    EXPECT_EQ(received.errorCode(), ECONNRESET);
+}
+
+TEST_P(NetworkMessageFramer, OversizedMessageIsSkipped)
+{
+    FramerV4 sender{client, pool, GetParam(), 256U};
+    FramerV4 receiver{server, pool, GetParam(), 256U, 16U};
+
+    auto const small = createMessage(4U, 9U);
+    ASSERT_FALSE(sender.send(createMessage(17U, 0U)).isError());
+    ASSERT_FALSE(sender.send(createMessage(5000U, 0U)).isError());
+    ASSERT_FALSE(sender.send(small).isError());
+    ASSERT_FALSE(sender.flush().isError());
+
+    for (auto i = 0U; i < 2U; ++i)
+    {
+        auto const rejected = receiver.receive();
+        ASSERT_TRUE(rejected.isError());
+        EXPECT_EQ(rejected.errorCode(), EMSGSIZE);
+    }
+    auto const received = receiver.receive();
+    ASSERT_FALSE(received.isError());
+    ASSERT_EQ(received.value().size(), small.size());
+    EXPECT_TRUE(std::equal(small.begin(), small.end(), received.value().begin()));
+    receiver.release(received.value());
+}
+
+TEST_P(NetworkMessageFramer, FailedFlushIsResumed)
+{
+    constexpr auto Count = 1000U;
+
+    FramerV4 sender{client, pool, GetParam(), 1024U, 1024U, FlushPolicy{1U << 20U, std::chrono::seconds{10U}}};
+    FramerV4 receiver{server, pool, GetParam(), 1024U, 1024U};
+    ASSERT_TRUE(client.setSendBufferSize(4096U));
+    ASSERT_TRUE(client.setNonblocking(true));
+
+    for (auto i = 0U; i < Count; ++i)
+    {
+        ASSERT_FALSE(sender.send(createMessage(1000U, static_cast<std::uint8_t>(i))).isError());
+    }
+    auto const queued = sender.pending();
+
+    // nobody reads yet, so only a part of the messages fits into the buffers of the connection
+    auto flushed = sender.flush();
+    ASSERT_TRUE(flushed.isError());
+    EXPECT_EQ(flushed.errorCode(), EAGAIN);
+    EXPECT_LT(sender.pending(), queued);
+
+    std::thread receiverThread{[&]() {
+        for (auto i = 0U; i < Count; ++i)
+        {
+            auto const expected = createMessage(1000U, static_cast<std::uint8_t>(i));
+            auto const received = receiver.receive();
+            ASSERT_FALSE(received.isError());
+            ASSERT_EQ(received.value().size(), expected.size());
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), received.value().begin())) << i;
+            receiver.release(received.value());
+        }
+    }};
+    while ((flushed = sender.flush()).isError())
+    {
+        ASSERT_EQ(flushed.errorCode(), EAGAIN);
+        std::this_thread::sleep_for(std::chrono::milliseconds{1U});
+    }
+    EXPECT_EQ(sender.pending(), 0U);
+    receiverThread.join();
+}
+
+TEST_P(NetworkMessageFramer, FailedReceiveIsResumed)
+{
+    FramerV4 sender{client, pool, GetParam(), 256U, 1U << 20U, FlushPolicy{256U, std::chrono::seconds{10U}}};
+    FramerV4 receiver{server, pool, GetParam(), 256U, 1U << 20U};
+    ASSERT_TRUE(server.setNonblocking(true));
+
+    auto const large = createMessage(60000U, 5U);
+    auto const small = createMessage(8U, 2U);
+
+    std::thread senderThread{[&]() {
+        ASSERT_FALSE(sender.send(large).isError());
+        ASSERT_FALSE(sender.send(small).isError());
+        ASSERT_FALSE(sender.flush().isError());
+    }};
+    for (auto const *expected : {&large, &small})
+    {
+        auto received = receiver.receive();
+        while (received.isError())
+        {
+            ASSERT_EQ(received.errorCode(), EAGAIN);
+            std::this_thread::sleep_for(std::chrono::microseconds{100U});
+            received = receiver.receive();
+        }
+        ASSERT_EQ(received.value().size(), expected->size());
+        EXPECT_TRUE(std::equal(expected->begin(), expected->end(), received.value().begin()));
+        receiver.release(received.value());
+    }
+    senderThread.join();
+}
+
+TEST_P(NetworkMessageFramer, PartiallySentLargeMessageBreaksTheStream)
+{
+    // the messages have to be larger than the segments the socket fills at once, which Fixed16 can not encode
+    if (GetParam() == LengthPrefix::Fixed16)
+    {
+        GTEST_SKIP();
+    }
+    FramerV4 sender{client, pool, GetParam(), 256U, 1U << 20U, FlushPolicy{256U, std::chrono::seconds{10U}}};
+    ASSERT_TRUE(client.setSendBufferSize(4096U));
+    ASSERT_TRUE(client.setNonblocking(true));
+
+    // fill the buffers of the connection, as nobody reads, until a message only fits partially
+    auto const large = createMessage(1U << 20U, 5U);
+    auto       sent  = sender.send(large);
+    while (!sent.isError())
+    {
+        sent = sender.send(large);
+    }
+    EXPECT_EQ(sent.errorCode(), EAGAIN);
+
+    sent = sender.send(large);
+    ASSERT_TRUE(sent.isError());
+    EXPECT_EQ(sent.errorCode(), EPIPE);
+    ASSERT_TRUE(sender.flush().isError());
+}
+
+INSTANTIATE_TEST_SUITE_P(Prefixes,
+                         NetworkMessageFramer,
+                         testing::Values(LengthPrefix::Fixed16, LengthPrefix::Fixed32, LengthPrefix::VarInt));
+
+TEST(NetworkMessageFramerEncoding, Fixed16RejectsLongMessages)
+{
+    HeapMemoryPool               pool{};
+    TCPSocket<IPVersion::V4>     socket{};
+    MessageFramer<IPVersion::V4> sut{socket, pool, LengthPrefix::Fixed16, 256U};
+
+    std::vector<std::byte> message(70000U);
+    auto const             result = sut.send(message);
+    ASSERT_TRUE(result.isError());
+    EXPECT_EQ(result.errorCode(), EMSGSIZE);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,391 @@
+#include "THzCommon/network/reactor.hpp"
+
+#include "THzCommon/network/address.hpp"
+#include "THzCommon/network/tcpsocket.hpp"
+#include "THzCommon/network/udpsocket.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct NetworkReactor : public testing::Test
+{
+    using TCPSocketV4 = TCPSocket<IPVersion::V4>;
+    using UDPSocketV4 = UDPSocket<IPVersion::V4>;
+
+    /// @brief The size of the messages exchanged by the clients.
+    static constexpr std::size_t MessageSize{1024U};
+
+    /// @brief Returns a localhost IPv4 address with a random port between 12001 and 14000, if possible.
+    std::optional<Address<IPVersion::V4>> getLocalAddress() noexcept
+    {
+        auto const ipAddresses = resolveIPAddresses("localhost");
+        auto const ipAddress   = getFirstIPV4From(ipAddresses);
+        if (ipAddress)
+        {
+            std::uniform_int_distribution<> distrib{12001, 14000};
+            return Address<IPVersion::V4>{*ipAddress, static_cast<std::uint16_t>(distrib(randomEngine))};
+        }
+        return {};
+    }
+
+    /// @brief Tries to bind the given socket to a local address.
+    ///
+    /// @tparam TSocket The type of socket.
+    /// @param socket The socket to bind.
+    /// @return The address the socket was bound to, if successful.
+    template <typename TSocket>
+    std::optional<Address<IPVersion::V4>> tryBind(TSocket &socket) noexcept
+    {
+        socket.setReuseAddr(true);
+        for (uint16_t i = 0U; i < 5U; ++i)
+        {
+            auto const address = getLocalAddress();
+            if (address && socket.bind(*address))
+            {
+                return address;
+            }
+        }
+        return {};
+    }
+
+    /// @brief Waits until the counter reaches the expected value or ten seconds passed.
+    ///
+    /// @param counter The counter to wait for.
+    /// @param expected The expected value.
+    /// @return True if the value was reached, false otherwise.
+    static bool waitFor(std::atomic<std::uint32_t> const &counter, std::uint32_t const expected) noexcept
+    {
+        auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10U};
+        while ((counter < expected) && (std::chrono::steady_clock::now() < deadline))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1U});
+        }
+        return counter == expected;
+    }
+
+    /// @brief Sends back everything received on the connection until the peer closes it.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param connection The connection to serve.
+    /// @param finished Incremented once the connection has been closed.
+    static Task<> echo(Reactor &reactor, TCPSocketV4 connection, std::atomic<std::uint32_t> &finished) noexcept
+    {
+        std::array<std::byte, 256U> buffer{};
+        for (;;)
+        {
+            auto const received = co_await connection.asyncReceive(reactor, buffer);
+            if (received.isError() || received.value().empty())
+            {
+                break;
+            }
+            if ((co_await connection.asyncSend(reactor, received.value())).isError())
+            {
+                break;
+            }
+        }
+        ++finished;
+    }
+
+    /// @brief Accepts the given number of connections, serving each by its own coroutine.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param listener The listening socket.
+    /// @param count The number of connections to accept.
+    /// @param finished Incremented once a connection has been closed.
+    static Task<> serve(Reactor                    &reactor,
+                        TCPSocketV4                &listener,
+                        std::uint32_t const         count,
+                        std::atomic<std::uint32_t> &finished) noexcept
+    {
+        for (auto i = 0U; i < count; ++i)
+        {
+            auto connection = co_await listener.asyncAccept(reactor, nullptr);
+            if (!connection.good())
+            {
+                co_return;
+            }
+            spawn(echo(reactor, std::move(connection), finished));
+        }
+    }
+
+    /// @brief Connects to the server, sends a message and checks the echo.
+    ///
+    /// @param reactor The reactor to wait with.
+    /// @param address The address of the server.
+    /// @param id The id of the client, used as content of the message.
+    /// @param succeeded Incremented if the echo matches the message.
+    /// @param finished Incremented once the client is done.
+    static Task<> client(Reactor                     &reactor,
+                         Address<IPVersion::V4> const address,
+                         std::uint32_t const          id,
+                         std::atomic<std::uint32_t>  &succeeded,
+                         std::atomic<std::uint32_t>  &finished) noexcept
+    {
+        TCPSocketV4 socket{};
+        socket.setNonblocking(true);
+
+        std::vector<std::byte> message(MessageSize, static_cast<std::byte>(id));
+        std::vector<std::byte> echoed(MessageSize);
+        if (!(co_await socket.asyncConnect(reactor, address)).isError() &&
+            !(co_await socket.asyncSend(reactor, message)).isError())
+        {
+            std::size_t received{};
+            while (received < echoed.size())
+            {
+                auto const result = co_await socket.asyncReceive(reactor, std::span{echoed}.subspan(received));
+                if (result.isError() || result.value().empty())
+                {
+                    break;
+                }
+                received += result.value().size();
+            }
+            if (echoed == message)
+            {
+                ++succeeded;
+            }
+        }
+        socket.close();
+        ++finished;
+    }
+
+    std::mt19937 randomEngine{1337};
+};
+
+TEST_F(NetworkReactor, Construction)
+{
+    Reactor sut{};
+    EXPECT_TRUE(sut.good());
+    sut.stop();
+    EXPECT_FALSE(sut.good());
+}
+
+TEST_F(NetworkReactor, ManyConcurrentConnectionsOnPool)
+{
+    constexpr std::uint32_t Clients{200U};
+
+    ThreadPool pool{2U};
+    Reactor    sut{&pool};
+
+    TCPSocketV4 listener{};
+    auto const  address = tryBind(listener);
+    ASSERT_TRUE(address);
+    ASSERT_TRUE(listener.listen(Clients));
+    ASSERT_TRUE(listener.setNonblocking(true));
+
+    std::atomic<std::uint32_t> served{};
+    std::atomic<std::uint32_t> succeeded{};
+    std::atomic<std::uint32_t> finished{};
+    spawn(serve(sut, listener, Clients, served));
+    for (auto i = 0U; i < Clients; ++i)
+    {
+        spawn(client(sut, *address, i, succeeded, finished));
+    }
+
+    EXPECT_TRUE(waitFor(finished, Clients));
+    EXPECT_TRUE(waitFor(served, Clients));
+    EXPECT_EQ(succeeded, Clients);
+}
+
+TEST_F(NetworkReactor, ConnectToClosedPortFails)
+{
+    Reactor sut{};
+
+    // binding without listening reserves a port nobody accepts connections on
+    TCPSocketV4 unused{};
+    auto const  address = tryBind(unused);
+    ASSERT_TRUE(address);
+
+    TCPSocketV4 socket{};
+    socket.setNonblocking(true);
+    auto const result = syncWait(socket.asyncConnect(sut, *address));
+    EXPECT_TRUE(result.isError());
+    EXPECT_EQ(result.errorCode(), ECONNREFUSED);
+}
+
+TEST_F(NetworkReactor, ReceiveWaitsForData)
+{
+    Reactor sut{};
+
+    TCPSocketV4 listener{};
+    auto const  address = tryBind(listener);
+    ASSERT_TRUE(address);
+    ASSERT_TRUE(listener.listen(1U));
+    ASSERT_TRUE(listener.setNonblocking(true));
+
+    TCPSocketV4 client{};
+    ASSERT_TRUE(client.connect(*address));
+    auto connection = syncWait(listener.asyncAccept(sut, nullptr));
+    ASSERT_TRUE(connection.good());
+    EXPECT_TRUE(connection.getNonblocking().value());
+
+    auto const send = [&]() noexcept {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20U});
+        std::array<std::byte, 4U> const data{std::byte{1U}, std::byte{2U}, std::byte{3U}, std::byte{4U}};
+        client.send(data);
+    };
+    std::thread sender{send};
+
+    std::array<std::byte, 16U> buffer{};
+    auto const                 received = syncWait(connection.asyncReceive(sut, buffer));
+    sender.join();
+    ASSERT_FALSE(received.isError());
+    EXPECT_EQ(received.value().size(), 4U);
+
+    // closing the connection ends the stream
+    client.close();
+    auto const closed = syncWait(connection.asyncReceive(sut, buffer));
+    ASSERT_FALSE(closed.isError());
+    EXPECT_TRUE(closed.value().empty());
+}
+
+TEST_F(NetworkReactor, FullDuplexOnOneSocket)
+{
+    constexpr std::size_t Size{4U << 20U};
+
+    Reactor sut{};
+
+    TCPSocketV4 listener{};
+    auto const  address = tryBind(listener);
+    ASSERT_TRUE(address);
+    ASSERT_TRUE(listener.listen(1U));
+    ASSERT_TRUE(listener.setNonblocking(true));
+
+    TCPSocketV4 client{};
+    ASSERT_TRUE(client.connect(*address));
+    Address<IPVersion::V4> peer{};
+    auto                   connection = syncWait(listener.asyncAccept(sut, &peer));
+    ASSERT_TRUE(connection.good());
+    EXPECT_EQ(peer.ipAddress, address->ipAddress);
+    EXPECT_NE(peer.port, 0U);
+    ASSERT_TRUE(connection.setSendBufferSize(4096U));
+
+    auto const receive = [](Reactor                    &reactor,
+                            TCPSocketV4                &socket,
+                            std::span<std::byte>        into,
+                            std::size_t                &received,
+                            std::atomic<std::uint32_t> &finished) noexcept -> Task<> {
+        auto const result = co_await socket.asyncReceive(reactor, into);
+        received          = result.isError() ? 0U : result.value().size();
+        ++finished;
+    };
+    auto const send = [](Reactor                    &reactor,
+                         TCPSocketV4                &socket,
+                         std::span<std::byte const>  data,
+                         std::size_t                &sent,
+                         std::atomic<std::uint32_t> &finished) noexcept -> Task<> {
+        auto const result = co_await socket.asyncSend(reactor, data);
+        sent              = result.isError() ? 0U : result.value();
+        ++finished;
+    };
+
+    // the receive waits for the answer while the send waits for the peer to read
+    std::array<std::byte, 16U> buffer{};
+    std::vector<std::byte>     data(Size);
+    std::size_t                received{};
+    std::size_t                sent{};
+    std::atomic<std::uint32_t> finished{};
+    spawn(receive(sut, connection, buffer, received, finished));
+    spawn(send(sut, connection, data, sent, finished));
+    EXPECT_EQ(finished, 0U);
+
+    std::thread peerThread{[&]() noexcept {
+        std::vector<std::byte> into(65536U);
+        for (std::size_t total = 0U; total < Size;)
+        {
+            auto const result = client.receive(into);
+            if (result.isError() || result.value().empty())
+            {
+                return;
+            }
+            total += result.value().size();
+        }
+        std::array<std::byte, 4U> const answer{};
+        client.send(answer);
+    }};
+    EXPECT_TRUE(waitFor(finished, 2U));
+    peerThread.join();
+    EXPECT_EQ(sent, Size);
+    EXPECT_EQ(received, 4U);
+}
+
+TEST_F(NetworkReactor, StopCancelsWaitingCoroutines)
+{
+    Reactor sut{};
+
+    TCPSocketV4 listener{};
+    auto const  address = tryBind(listener);
+    ASSERT_TRUE(address);
+    ASSERT_TRUE(listener.listen(1U));
+    ASSERT_TRUE(listener.setNonblocking(true));
+
+    TCPSocketV4 client{};
+    ASSERT_TRUE(client.connect(*address));
+    auto connection = syncWait(listener.asyncAccept(sut, nullptr));
+    ASSERT_TRUE(connection.good());
+
+    auto const receive = [](Reactor                    &reactor,
+                            TCPSocketV4                &socket,
+                            std::span<std::byte>        into,
+                            errno_t                    &code,
+                            std::atomic<std::uint32_t> &finished) noexcept -> Task<> {
+        auto const result = co_await socket.asyncReceive(reactor, into);
+        code              = result.errorCode();
+        ++finished;
+    };
+
+    std::array<std::byte, 16U> buffer{};
+    errno_t                    code{};
+    std::atomic<std::uint32_t> finished{};
+    spawn(receive(sut, connection, buffer, code, finished));
+    EXPECT_EQ(finished, 0U);
+
+    sut.stop();
+    EXPECT_EQ(finished, 1U);
+    EXPECT_EQ(code, ECANCELED);
+
+    // waiting after the reactor stopped fails right away
+    auto const result = syncWait(connection.asyncReceive(sut, buffer));
+    ASSERT_TRUE(result.isError());
+    EXPECT_EQ(result.errorCode(), ECANCELED);
+}
+
+TEST_F(NetworkReactor, UDPRoundTrip)
+{
+    Reactor sut{};
+
+    UDPSocketV4 receiver{};
+    auto const  address = tryBind(receiver);
+    ASSERT_TRUE(address);
+    ASSERT_TRUE(receiver.setNonblocking(true));
+
+    UDPSocketV4 sender{};
+    ASSERT_TRUE(sender.setNonblocking(true));
+
+    std::array<std::byte, 8U> const data{std::byte{42U}};
+    std::array<std::byte, 16U>      buffer{};
+
+    auto const roundTrip = [](Reactor                      &reactor,
+                              UDPSocketV4                  &from,
+                              UDPSocketV4                  &to,
+                              Address<IPVersion::V4> const &target,
+                              std::span<std::byte const>    message,
+                              std::span<std::byte>          into) noexcept -> Task<std::size_t> {
+        (void)co_await from.asyncSendTo(reactor, target, message);
+        auto const received = co_await to.asyncReceiveFrom(reactor, nullptr, into);
+        co_return received.isError() ? 0U : received.value().size();
+    };
+    EXPECT_EQ(syncWait(roundTrip(sut, sender, receiver, *address, data, buffer)), data.size());
+    EXPECT_EQ(buffer[0U], std::byte{42U});
+}
+
+} // namespace Terrahertz::UnitTests
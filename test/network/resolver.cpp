@@ -0,0 +1,189 @@
+#include "THzCommon/network/resolver.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+
+namespace Terrahertz::UnitTests {
+
+struct NetworkResolver : public testing::Test
+{
+    /// @brief Returns a lookup function counting its calls and resolving every host except "invalid".
+    Resolver::LookupFunction countingLookup() noexcept
+    {
+        return [this](std::string_view const host) -> Resolver::Addresses {
+            ++lookups;
+            if (host == "invalid")
+            {
+                return {};
+            }
+            return IPV_Addresses{Internal::IPV4Address{10U, 0U, 0U, static_cast<std::uint8_t>(host.size())}};
+        };
+    }
+
+    std::atomic_size_t lookups{};
+};
+
+TEST_F(NetworkResolver, NumericAddressesAreResolved)
+{
+    Resolver sut{};
+
+    auto const v4 = getFirstIPV4From(sut.resolve("127.0.0.1").get());
+    ASSERT_TRUE(v4);
+    EXPECT_EQ(*v4, (Internal::IPV4Address{127U, 0U, 0U, 1U}));
+
+    auto const v6 = getFirstIPV6From(sut.resolve("::1").get());
+    ASSERT_TRUE(v6);
+    EXPECT_EQ(*v6, (Internal::IPV6Address{0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U}));
+}
+
+TEST_F(NetworkResolver, LocalhostIsResolved)
+{
+    Resolver sut{};
+
+    auto const addresses = sut.resolve("localhost").get();
+    ASSERT_TRUE(addresses);
+    EXPECT_GE(addresses->size(), 1U);
+}
+
+TEST_F(NetworkResolver, ResultsAreCached)
+{
+    Resolver sut{{}, countingLookup()};
+
+    auto const first = sut.resolve("example").get();
+    ASSERT_TRUE(first);
+    EXPECT_EQ(lookups, 1U);
+
+    auto const second = sut.resolve("example");
+    EXPECT_EQ(second.wait_for(std::chrono::seconds{0U}), std::future_status::ready);
+    EXPECT_EQ(second.get(), first);
+    EXPECT_EQ(lookups, 1U);
+    EXPECT_EQ(sut.cacheSize(), 1U);
+
+    sut.clearCache();
+    EXPECT_EQ(sut.cacheSize(), 0U);
+    EXPECT_TRUE(sut.resolve("example").get());
+    EXPECT_EQ(lookups, 2U);
+}
+
+TEST_F(NetworkResolver, FailuresAreCachedNegatively)
+{
+    ResolverSettings settings{};
+    settings.negativeTimeToLive = std::chrono::milliseconds{20U};
+    Resolver sut{settings, countingLookup()};
+
+    EXPECT_FALSE(sut.resolve("invalid").get());
+    EXPECT_FALSE(sut.resolve("invalid").get());
+    EXPECT_EQ(lookups, 1U);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{30U});
+    EXPECT_FALSE(sut.resolve("invalid").get());
+    EXPECT_EQ(lookups, 2U);
+}
+
+TEST_F(NetworkResolver, EntriesExpire)
+{
+    ResolverSettings settings{};
+    settings.timeToLive = std::chrono::milliseconds{0U};
+    Resolver sut{settings, countingLookup()};
+
+    EXPECT_TRUE(sut.resolve("example").get());
+    EXPECT_TRUE(sut.resolve("example").get());
+    EXPECT_EQ(lookups, 2U);
+}
+
+TEST_F(NetworkResolver, LeastRecentlyUsedEntryIsEvicted)
+{
+    ResolverSettings settings{};
+    settings.capacity = 2U;
+    Resolver sut{settings, countingLookup()};
+
+    sut.resolve("a").get();
+    sut.resolve("bb").get();
+    sut.resolve("a").get();
+    sut.resolve("ccc").get();
+    EXPECT_EQ(lookups, 3U);
+    EXPECT_EQ(sut.cacheSize(), 2U);
+
+    // "bb" was evicted, "a" was not
+    sut.resolve("a").get();
+    EXPECT_EQ(lookups, 3U);
+    sut.resolve("bb").get();
+    EXPECT_EQ(lookups, 4U);
+}
+
+TEST_F(NetworkResolver, ConcurrentLookupsAreCoalesced)
+{
+    std::mutex              mutex{};
+    std::condition_variable released{};
+    bool                    release{};
+
+    auto const blockingLookup = [&](std::string_view) -> Resolver::Addresses {
+        ++lookups;
+        std::unique_lock<std::mutex> lock{mutex};
+        released.wait(lock, [&]() { return release; });
+        return IPV_Addresses{Internal::IPV4Address{10U, 0U, 0U, 1U}};
+    };
+
+    Resolver sut{{}, blockingLookup};
+
+    std::atomic_size_t                                   callbacks{};
+    std::vector<std::shared_future<Resolver::Addresses>> futures{};
+    for (auto i = 0U; i < 8U; ++i)
+    {
+        futures.emplace_back(sut.resolve("example"));
+        sut.resolve("example", [&](Resolver::Addresses const &addresses) { callbacks += addresses ? 1U : 0U; });
+    }
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        release = true;
+    }
+    released.notify_all();
+
+    for (auto const &future : futures)
+    {
+        EXPECT_TRUE(future.get());
+    }
+    EXPECT_EQ(lookups, 1U);
+    EXPECT_EQ(callbacks, 8U);
+}
+
+TEST_F(NetworkResolver, CachedCallbackIsCalledImmediately)
+{
+    Resolver sut{{}, countingLookup()};
+    sut.resolve("example").get();
+
+    bool called{};
+    sut.resolve("example", [&](Resolver::Addresses const &addresses) { called = addresses.has_value(); });
+    EXPECT_TRUE(called);
+}
+
+TEST_F(NetworkResolver, PendingLookupsFailOnDestruction)
+{
+    std::shared_future<Resolver::Addresses> future{};
+    {
+        ResolverSettings settings{};
+        settings.workerCount = 1U;
+
+        std::atomic_bool started{};
+        auto const       slowLookup = [&](std::string_view) -> Resolver::Addresses {
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds{20U});
+            return IPV_Addresses{};
+        };
+
+        Resolver sut{settings, slowLookup};
+        sut.resolve("first");
+        while (!started)
+        {
+            std::this_thread::yield();
+        }
+        future = sut.resolve("second");
+    }
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{0U}), std::future_status::ready);
+    EXPECT_FALSE(future.get());
+}
+
+} // namespace Terrahertz::UnitTests
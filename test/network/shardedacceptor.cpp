@@ -0,0 +1,174 @@
+#include "THzCommon/network/shardedacceptor.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct NetworkShardedAcceptor : public testing::Test
+{
+    using TCPSocketV4 = TCPSocket<IPVersion::V4>;
+    using AcceptorV4  = ShardedAcceptor<IPVersion::V4>;
+
+    /// @brief Starts the given acceptor on a random port on the loopback interface.
+    ///
+    /// @param acceptor The acceptor to start.
+    /// @return True if the acceptor was started, false otherwise.
+    bool tryStart(AcceptorV4 &acceptor) noexcept
+    {
+        std::uniform_int_distribution<> distrib{8001, 10000};
+        for (uint16_t i = 0U; i < 5U; ++i)
+        {
+            address.port = static_cast<std::uint16_t>(distrib(randomEngine));
+            if (acceptor.start(address))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Waits until the given acceptor accepted the given number of connections.
+    ///
+    /// @param acceptor The acceptor to wait for.
+    /// @param count The number of connections to wait for.
+    /// @return The number of accepted connections.
+    std::uint64_t waitForConnections(AcceptorV4 const &acceptor, std::uint64_t const count) noexcept
+    {
+        std::uint64_t accepted{};
+        for (auto i = 0U; i < 200U; ++i)
+        {
+            auto const perShard = acceptor.acceptedConnectionsPerShard();
+            accepted            = std::accumulate(perShard.begin(), perShard.end(), std::uint64_t{});
+            if (accepted >= count)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{5U});
+        }
+        return accepted;
+    }
+
+    std::mt19937 randomEngine{1337};
+
+    Address<IPVersion::V4> address{{127U, 0U, 0U, 1U}, 0U};
+};
+
+TEST_F(NetworkShardedAcceptor, ZeroShardsUsesHardwareThreads)
+{
+    AcceptorV4 sut{0U, [](TCPSocketV4 &&, Address<IPVersion::V4> const &, std::size_t) {}, false};
+    EXPECT_EQ(sut.shardCount(), std::max(std::thread::hardware_concurrency(), 1U));
+}
+
+TEST_F(NetworkShardedAcceptor, AllConnectionsAreAccepted)
+{
+    std::mutex               mutex{};
+    std::vector<TCPSocketV4> connections{};
+    std::atomic_bool         invalidShard{};
+    std::atomic_bool         invalidPeer{};
+
+    auto const keepConnection =
+        [&](TCPSocketV4 &&connection, Address<IPVersion::V4> const &peer, std::size_t const shard) {
+            invalidShard = invalidShard || (shard >= 4U);
+            invalidPeer  = invalidPeer || (peer.ipAddress != address.ipAddress) || (peer.port == 0U);
+            std::lock_guard<std::mutex> lock{mutex};
+            connections.emplace_back(std::move(connection));
+        };
+
+    AcceptorV4 sut{4U, keepConnection};
+    if (!tryStart(sut))
+    {
+        GTEST_SKIP() << "SO_REUSEPORT not supported.";
+    }
+
+    std::vector<TCPSocketV4> clients(64U);
+    for (auto &client : clients)
+    {
+        ASSERT_TRUE(client.connect(address));
+    }
+    EXPECT_EQ(waitForConnections(sut, clients.size()), clients.size());
+    EXPECT_FALSE(invalidShard);
+    EXPECT_FALSE(invalidPeer);
+
+    sut.stop();
+    EXPECT_EQ(connections.size(), clients.size());
+    for (auto i = 0U; i < sut.shardCount(); ++i)
+    {
+        EXPECT_EQ(sut.acceptedConnections(i), sut.acceptedConnectionsPerShard()[i]);
+    }
+
+    // the listening sockets are closed
+    TCPSocketV4 late{};
+    EXPECT_FALSE(late.connect(address));
+}
+
+TEST_F(NetworkShardedAcceptor, EphemeralPortIsShared)
+{
+    AcceptorV4 sut{4U, [](TCPSocketV4 &&, Address<IPVersion::V4> const &, std::size_t) {}};
+    if (!sut.start(address))
+    {
+        GTEST_SKIP() << "SO_REUSEPORT not supported.";
+    }
+    auto const bound = sut.address();
+    EXPECT_EQ(bound.ipAddress, address.ipAddress);
+    ASSERT_NE(bound.port, 0U);
+
+    // connections to the shared port are spread across the shards, so all of them must be listening on it
+    std::vector<TCPSocketV4> clients(64U);
+    for (auto &client : clients)
+    {
+        ASSERT_TRUE(client.connect(bound));
+    }
+    EXPECT_EQ(waitForConnections(sut, clients.size()), clients.size());
+
+    sut.stop();
+    for (auto i = 0U; i < sut.shardCount(); ++i)
+    {
+#ifdef __linux__
+        EXPECT_TRUE(sut.isPinned(i)) << i;
+#else
+        EXPECT_FALSE(sut.isPinned(i)) << i;
+#endif
+    }
+    EXPECT_FALSE(sut.isPinned(sut.shardCount()));
+}
+
+TEST_F(NetworkShardedAcceptor, StartFailsIfAlreadyRunning)
+{
+    AcceptorV4 sut{2U, [](TCPSocketV4 &&, Address<IPVersion::V4> const &, std::size_t) {}, false};
+    if (!tryStart(sut))
+    {
+        GTEST_SKIP() << "SO_REUSEPORT not supported.";
+    }
+    EXPECT_FALSE(sut.start(address));
+
+    // can be restarted after being stopped
+    sut.stop();
+    EXPECT_TRUE(sut.start(address));
+}
+
+TEST_F(NetworkShardedAcceptor, StartFailsIfPortIsTakenExclusively)
+{
+    TCPSocketV4 blocker{};
+    ASSERT_TRUE(blocker.setReuseAddr(true));
+    bool bound{};
+    for (uint16_t i = 0U; (i < 5U) && !bound; ++i)
+    {
+        address.port = static_cast<std::uint16_t>(8001U + (randomEngine() % 2000U));
+        bound        = blocker.bind(address);
+    }
+    ASSERT_TRUE(bound);
+    ASSERT_TRUE(blocker.listen(2U));
+
+    AcceptorV4 sut{2U, [](TCPSocketV4 &&, Address<IPVersion::V4> const &, std::size_t) {}, false};
+    EXPECT_FALSE(sut.start(address));
+    EXPECT_EQ(sut.acceptedConnections(0U), 0U);
+    EXPECT_EQ(sut.acceptedConnections(5U), 0U);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,280 @@
+#include "THzCommon/network/socketinstrumentation.hpp"
+
+#include "THzCommon/network/tcpsocket.hpp"
+#include "THzCommon/network/udpsocket.hpp"
+
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace Terrahertz::UnitTests {
+
+struct NetworkSocketInstrumentation : public testing::Test
+{
+    using UDPSocketV4 = UDPSocket<IPVersion::V4, SocketInstrumentation>;
+
+    using TCPSocketV4 = TCPSocket<IPVersion::V4, SocketInstrumentation>;
+
+    /// @brief Tries to bind the given socket to a random port on the loopback interface.
+    ///
+    /// @tparam TSocket The type of the socket.
+    /// @param socket The socket to bind.
+    /// @return The address the socket was bound to, if successful.
+    template <typename TSocket>
+    std::optional<Address<IPVersion::V4>> tryBind(TSocket &socket) noexcept
+    {
+        std::uniform_int_distribution<> distrib{10001, 12000};
+        for (uint16_t i = 0U; i < 5U; ++i)
+        {
+            Address<IPVersion::V4> const address{{127U, 0U, 0U, 1U}, static_cast<std::uint16_t>(distrib(randomEngine))};
+            if (socket.bind(address))
+            {
+                return address;
+            }
+        }
+        return {};
+    }
+
+    std::mt19937 randomEngine{1337};
+};
+
+TEST_F(NetworkSocketInstrumentation, DefaultPolicyAddsNoOverhead)
+{
+    // a polymorphic class holding nothing but the handle
+    struct Reference
+    {
+        virtual ~Reference() noexcept = default;
+
+        Internal::SocketHandleType handle;
+    };
+    EXPECT_EQ(sizeof(TCPSocket<IPVersion::V4>), sizeof(Reference));
+    EXPECT_EQ(sizeof(UDPSocket<IPVersion::V4>), sizeof(Reference));
+    EXPECT_LT(sizeof(UDPSocket<IPVersion::V4>), sizeof(UDPSocketV4));
+}
+
+TEST_F(NetworkSocketInstrumentation, HistogramBuckets)
+{
+    for (std::uint64_t value = 0U; value < 8U; ++value)
+    {
+        EXPECT_EQ(LatencyHistogram::bucketOf(value), value);
+        EXPECT_EQ(LatencyHistogram::highestValueOf(value), value);
+    }
+    EXPECT_EQ(LatencyHistogram::bucketOf(8U), 8U);
+    EXPECT_EQ(LatencyHistogram::bucketOf(15U), 15U);
+    EXPECT_EQ(LatencyHistogram::bucketOf(16U), 16U);
+    EXPECT_EQ(LatencyHistogram::bucketOf(17U), 16U);
+    EXPECT_EQ(LatencyHistogram::bucketOf(18U), 17U);
+    EXPECT_EQ(LatencyHistogram::highestValueOf(16U), 17U);
+    EXPECT_EQ(LatencyHistogram::bucketOf(~std::uint64_t{}), LatencyHistogram::BucketCount - 1U);
+    EXPECT_EQ(LatencyHistogram::highestValueOf(LatencyHistogram::BucketCount - 1U), ~std::uint64_t{});
+
+    // every value lies within the bucket it is counted in
+    std::uint64_t value{1U};
+    for (auto i = 0U; i < 60U; ++i, value = (value * 3U) + 1U)
+    {
+        auto const bucket = LatencyHistogram::bucketOf(value);
+        EXPECT_LE(value, LatencyHistogram::highestValueOf(bucket));
+        EXPECT_GT(value, LatencyHistogram::highestValueOf(bucket - 1U));
+    }
+}
+
+TEST_F(NetworkSocketInstrumentation, HistogramPercentiles)
+{
+    auto sut = std::make_unique<LatencyHistogram>();
+    EXPECT_EQ(sut->count(), 0U);
+    EXPECT_EQ(sut->percentile(50.0).count(), 0);
+
+    for (auto i = 1; i <= 1000; ++i)
+    {
+        sut->record(std::chrono::nanoseconds{i});
+    }
+    EXPECT_EQ(sut->count(), 1000U);
+    EXPECT_EQ(sut->max().count(), 1000);
+    EXPECT_EQ(sut->percentile(100.0).count(), 1000);
+
+    // the reported values lie within the precision of the buckets
+    EXPECT_GE(sut->percentile(50.0).count(), 500);
+    EXPECT_LE(sut->percentile(50.0).count(), 500 * 9 / 8);
+    EXPECT_GE(sut->percentile(99.0).count(), 990);
+    EXPECT_LE(sut->percentile(99.0).count(), 1000);
+
+    LatencyHistogram copy{*sut};
+    EXPECT_EQ(copy.count(), 1000U);
+    EXPECT_EQ(copy.percentile(50.0), sut->percentile(50.0));
+
+    sut->reset();
+    EXPECT_EQ(sut->count(), 0U);
+    EXPECT_EQ(sut->max().count(), 0);
+}
+
+TEST_F(NetworkSocketInstrumentation, RecordClassifiesErrors)
+{
+    SocketInstrumentation sut{};
+
+    auto const start = SocketInstrumentation::start();
+    sut.record(SocketOperation::Send, start, 100U, 0);
+    sut.record(SocketOperation::Send, start, 50U, 0);
+    sut.record(SocketOperation::Receive, start, 0U, EAGAIN);
+    sut.record(SocketOperation::Receive, start, 0U, ECONNRESET);
+
+    auto const statistics = sut.snapshot();
+    EXPECT_EQ(statistics.send.messages, 2U);
+    EXPECT_EQ(statistics.send.bytes, 150U);
+    EXPECT_EQ(statistics.send.wouldBlock, 0U);
+    EXPECT_EQ(statistics.send.errors, 0U);
+    EXPECT_EQ(statistics.receive.messages, 0U);
+    EXPECT_EQ(statistics.receive.bytes, 0U);
+    EXPECT_EQ(statistics.receive.wouldBlock, 1U);
+    EXPECT_EQ(statistics.receive.errors, 1U);
+    EXPECT_LE(statistics.send.p50, statistics.send.max);
+
+    sut.reset();
+    EXPECT_EQ(sut.snapshot().send.messages, 0U);
+    EXPECT_EQ(sut.snapshot().receive.errors, 0U);
+}
+
+TEST_F(NetworkSocketInstrumentation, UDPSocketCountsTraffic)
+{
+    UDPSocketV4 receiver{};
+    auto const  address = tryBind(receiver);
+    ASSERT_TRUE(address);
+    ASSERT_TRUE(receiver.setNonblocking(true));
+
+    std::array<std::byte, 64U> buffer{};
+    EXPECT_EQ(receiver.receiveFrom(nullptr, buffer).errorCode(), EAGAIN);
+
+    UDPSocketV4 sender{};
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        ASSERT_EQ(sender.sendTo(*address, std::span{buffer}.first(16U)).value(), 16U);
+    }
+    ASSERT_TRUE(receiver.setNonblocking(false));
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        ASSERT_EQ(receiver.receiveFrom(nullptr, buffer).value().size(), 16U);
+    }
+
+    auto const sent = sender.instrumentation().snapshot();
+    EXPECT_EQ(sent.send.messages, 3U);
+    EXPECT_EQ(sent.send.bytes, 48U);
+    EXPECT_EQ(sent.receive.messages, 0U);
+
+    auto const received = receiver.instrumentation().snapshot();
+    EXPECT_EQ(received.receive.messages, 3U);
+    EXPECT_EQ(received.receive.bytes, 48U);
+    EXPECT_EQ(received.receive.wouldBlock, 1U);
+    EXPECT_GT(received.receive.max.count(), 0);
+
+    // the statistics move with the socket
+    UDPSocketV4 moved{std::move(receiver)};
+    EXPECT_EQ(moved.instrumentation().snapshot().receive.messages, 3U);
+    moved.instrumentation().reset();
+    EXPECT_EQ(moved.instrumentation().snapshot().receive.messages, 0U);
+}
+
+TEST_F(NetworkSocketInstrumentation, UDPSocketCountsBatches)
+{
+    UDPSocketV4 receiver{};
+    auto const  address = tryBind(receiver);
+    ASSERT_TRUE(address);
+
+    std::array<std::byte, 64U>                 buffer{};
+    std::array<Datagram<IPVersion::V4>, 3U>    sendDatagrams{};
+    std::array<Datagram<IPVersion::V4>, 4U>    receiveDatagrams{};
+    std::array<std::array<std::byte, 16U>, 4U> receiveBuffers{};
+    for (auto i = 0U; i < sendDatagrams.size(); ++i)
+    {
+        sendDatagrams[i].address = *address;
+        sendDatagrams[i].buffer  = std::span{buffer}.first(i + 1U);
+    }
+    for (auto i = 0U; i < receiveDatagrams.size(); ++i)
+    {
+        receiveDatagrams[i].buffer = receiveBuffers[i];
+    }
+
+    UDPSocketV4 sender{};
+    ASSERT_EQ(sender.sendBatch(sendDatagrams).value(), sendDatagrams.size());
+    ASSERT_EQ(receiver.receiveBatch(receiveDatagrams).value(), sendDatagrams.size());
+
+    auto const sent = sender.instrumentation().snapshot();
+    EXPECT_GE(sent.send.messages, 1U);
+    EXPECT_EQ(sent.send.bytes, 6U);
+
+    auto const received = receiver.instrumentation().snapshot();
+    EXPECT_GE(received.receive.messages, 1U);
+    EXPECT_EQ(received.receive.bytes, 6U);
+}
+
+TEST_F(NetworkSocketInstrumentation, TCPSocketCountsVectoredTransfers)
+{
+    TCPSocketV4 server{};
+    auto const  address = tryBind(server);
+    ASSERT_TRUE(address);
+    ASSERT_TRUE(server.listen(1U));
+
+    TCPSocketV4 client{};
+    ASSERT_TRUE(client.connect(*address));
+    auto connection = server.accept(nullptr);
+    ASSERT_TRUE(connection.good());
+
+    std::array<std::byte, 4U>                  header{};
+    std::array<std::byte, 12U>                 body{};
+    std::array<std::span<std::byte const>, 2U> sendBuffers{header, body};
+    ASSERT_EQ(client.sendv(sendBuffers).value(), 16U);
+
+    std::array<std::byte, 16U>           received{};
+    std::array<std::span<std::byte>, 1U> receiveBuffers{received};
+    ASSERT_EQ(connection.receivev(receiveBuffers).value(), 16U);
+
+    auto const sent = client.instrumentation().snapshot();
+    EXPECT_EQ(sent.send.messages, 1U);
+    EXPECT_EQ(sent.send.bytes, 16U);
+
+    auto const receiveStatistics = connection.instrumentation().snapshot();
+    EXPECT_EQ(receiveStatistics.receive.messages, 1U);
+    EXPECT_EQ(receiveStatistics.receive.bytes, 16U);
+
+    // close the client first, so the port of the server does not linger in TIME_WAIT
+    client.close();
+}
+
+TEST_F(NetworkSocketInstrumentation, StatisticsAsText)
+{
+    SocketStatistics statistics{};
+    statistics.send.messages    = 2U;
+    statistics.send.bytes       = 150U;
+    statistics.receive.errors   = 1U;
+    statistics.receive.p50      = std::chrono::nanoseconds{42};
+    statistics.receive.p999     = std::chrono::nanoseconds{420};
+    statistics.receive.max      = std::chrono::nanoseconds{500};
+    statistics.send.wouldBlock  = 7U;
+    statistics.receive.messages = 3U;
+
+    EXPECT_EQ(toString(statistics),
+              "send: 2 msgs, 150 bytes, 7 EAGAIN, 0 errors, latency [ns] p50 0 p90 0 p99 0 p99.9 0 max 0; "
+              "receive: 3 msgs, 0 bytes, 0 EAGAIN, 1 errors, latency [ns] p50 42 p90 0 p99 0 p99.9 420 max 500");
+
+    auto logger = std::make_unique<Logger>();
+    logger->setFilepath("test_");
+    logger->maxLevel() = LogLevel::Info;
+
+    auto const loggerFilepath = logger->filepath();
+    logStatistics(statistics, "client", *logger);
+    logger.reset();
+
+    std::ifstream file{loggerFilepath};
+    ASSERT_TRUE(file.is_open());
+    std::string line{};
+    std::getline(file, line);
+    file.close();
+    std::remove(loggerFilepath.c_str());
+
+    EXPECT_NE(line.find(" I THzCommon.Network"), std::string::npos);
+    EXPECT_NE(line.find("client " + toString(statistics)), std::string::npos);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -2,9 +2,11 @@
 
 #include "THzCommon/network/address.hpp"
 
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <random>
 #include <thread>
+#include <vector>
 
 namespace Terrahertz::UnitTests {
 
@@ -31,6 +33,8 @@ struct NetworkTCPSocket : public testing::Test
     /// @return The address the socket was bind to, if successful.
     std::optional<Address<IPVersion::V4>> tryBind(TCPSocketV4 &socket) noexcept
     {
+        // allows binding to ports still in TIME_WAIT from previous runs
+        socket.setReuseAddr(true);
         for (uint16_t i = 0U; i < 5U; ++i)
         {
             auto const address = getLocalAddress();
@@ -61,6 +65,33 @@ TEST_F(NetworkTCPSocket, ReuseAddr)
     EXPECT_TRUE(sut.getReuseAddr().value());
 }
 
+TEST_F(NetworkTCPSocket, NoDelay)
+{
+    TCPSocketV4 sut{};
+    EXPECT_FALSE(sut.getNoDelay().value());
+    EXPECT_TRUE(sut.setNoDelay(true));
+    EXPECT_TRUE(sut.getNoDelay().value());
+}
+
+TEST_F(NetworkTCPSocket, KeepAlive)
+{
+    TCPSocketV4 sut{};
+    EXPECT_FALSE(sut.getKeepAlive().value());
+    EXPECT_TRUE(sut.setKeepAlive(true));
+    EXPECT_TRUE(sut.getKeepAlive().value());
+}
+
+TEST_F(NetworkTCPSocket, QuickAck)
+{
+    TCPSocketV4 sut{};
+    if (sut.getQuickAck().isError())
+    {
+        GTEST_SKIP() << "TCP_QUICKACK not supported.";
+    }
+    EXPECT_TRUE(sut.setQuickAck(true));
+    EXPECT_TRUE(sut.getQuickAck().value());
+}
+
 TEST_F(NetworkTCPSocket, Close)
 {
     TCPSocketV4 sut{};
@@ -172,4 +203,116 @@ TEST_F(NetworkTCPSocket, BidirectionalDataTransfer)
     }
 }
 
+TEST_F(NetworkTCPSocket, ScatterGatherDataTransfer)
+{
+    TCPSocketV4 server{};
+    auto const  address = tryBind(server);
+    ASSERT_TRUE(address) << "binding to address failed.";
+    EXPECT_TRUE(server.listen(2U));
+
+    TCPSocketV4 client{};
+    EXPECT_TRUE(client.connect(*address));
+
+    // wait a bit to stabilize test result
+    std::this_thread::sleep_for(std::chrono::milliseconds{10U});
+
+    ASSERT_TRUE(server.acceptIsNonblocking());
+    auto connectionSocket = server.accept(nullptr);
+
+    std::array<std::byte, 4U>  header{std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}};
+    std::array<std::byte, 10U> body{};
+    std::array<std::byte, 2U>  trailer{std::byte{0xFE}, std::byte{0xFF}};
+    for (auto i = 0U; i < body.size(); ++i)
+    {
+        body[i] = static_cast<std::byte>(0x10U + i);
+    }
+    std::array<std::span<std::byte const>, 3U> sendBuffers{header, body, trailer};
+
+    auto const sendResult = client.sendv(sendBuffers);
+    ASSERT_FALSE(sendResult.isError());
+    EXPECT_EQ(sendResult.value(), header.size() + body.size() + trailer.size());
+
+    // wait a bit to stabilize test result
+    std::this_thread::sleep_for(std::chrono::milliseconds{10U});
+
+    // receive into differently sized buffers to check the scattering
+    std::array<std::byte, 6U>                  receiveA{};
+    std::array<std::byte, 10U>                 receiveB{};
+    std::array<std::span<std::byte>, 2U>       receiveBuffers{receiveA, receiveB};
+    std::array<std::byte, 16U>                 expected{};
+    std::array<std::span<std::byte const>, 3U> parts{header, body, trailer};
+    auto                                       position = expected.begin();
+    for (auto const part : parts)
+    {
+        position = std::copy(part.begin(), part.end(), position);
+    }
+
+    ASSERT_TRUE(connectionSocket.receiveIsNonblocking());
+    auto const receiveResult = connectionSocket.receivev(receiveBuffers);
+    ASSERT_FALSE(receiveResult.isError());
+    ASSERT_EQ(receiveResult.value(), expected.size());
+    for (auto i = 0U; i < receiveA.size(); ++i)
+    {
+        EXPECT_EQ(receiveA[i], expected[i]);
+    }
+    for (auto i = 0U; i < receiveB.size(); ++i)
+    {
+        EXPECT_EQ(receiveB[i], expected[receiveA.size() + i]);
+    }
+
+    // close the client first, so the port of the server does not linger in TIME_WAIT
+    client.close();
+}
+
+TEST_F(NetworkTCPSocket, ZeroCopyDataTransfer)
+{
+    TCPSocketV4 server{};
+    auto const  address = tryBind(server);
+    ASSERT_TRUE(address) << "binding to address failed.";
+    EXPECT_TRUE(server.listen(2U));
+
+    TCPSocketV4 client{};
+    if (!client.setZeroCopy(true))
+    {
+        GTEST_SKIP() << "zero-copy sends are not supported by the system.";
+    }
+    EXPECT_TRUE(client.connect(*address));
+
+    // wait a bit to stabilize test result
+    std::this_thread::sleep_for(std::chrono::milliseconds{10U});
+
+    ASSERT_TRUE(server.acceptIsNonblocking());
+    auto connectionSocket = server.accept(nullptr);
+
+    EXPECT_TRUE(client.pollZeroCopyCompletion().isError());
+
+    std::vector<std::byte>                     payload(16384U, std::byte{0x5A});
+    std::array<std::span<std::byte const>, 1U> sendBuffers{payload};
+
+    auto const sendResult = client.sendvZeroCopy(sendBuffers);
+    ASSERT_FALSE(sendResult.isError());
+    EXPECT_EQ(sendResult.value(), payload.size());
+
+    std::vector<std::byte> received(payload.size());
+    std::size_t            receivedBytes{};
+    while (receivedBytes < received.size())
+    {
+        auto const receiveResult = connectionSocket.receive(std::span<std::byte>{received}.subspan(receivedBytes));
+        ASSERT_FALSE(receiveResult.isError());
+        receivedBytes += receiveResult.value().size();
+    }
+    EXPECT_EQ(received, payload);
+
+    // wait a bit to stabilize test result
+    std::this_thread::sleep_for(std::chrono::milliseconds{10U});
+
+    auto const completion = client.pollZeroCopyCompletion();
+    ASSERT_FALSE(completion.isError());
+    EXPECT_EQ(completion.value().first, 0U);
+    EXPECT_EQ(completion.value().last, 0U);
+
+    // close the client first, so the port of the server does not linger in TIME_WAIT
+    client.close();
+}
+
 } // namespace Terrahertz::UnitTests
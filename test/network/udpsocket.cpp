@@ -2,7 +2,10 @@
 
 #include "THzCommon/network/address.hpp"
 
+#include <array>
+#include <cerrno>
 #include <gtest/gtest.h>
+#include <limits>
 #include <random>
 
 namespace Terrahertz::UnitTests {
@@ -60,6 +63,107 @@ TEST_F(NetworkUDPSocket, ReuseAddr)
     EXPECT_TRUE(sut.getReuseAddr().value());
 }
 
+TEST_F(NetworkUDPSocket, ReusePort)
+{
+    UDPSocketV4 first{};
+    UDPSocketV4 second{};
+    if (first.getReusePort().isError())
+    {
+        GTEST_SKIP() << "SO_REUSEPORT not supported.";
+    }
+    EXPECT_FALSE(first.getReusePort().value());
+    ASSERT_TRUE(first.setReusePort(true));
+    ASSERT_TRUE(second.setReusePort(true));
+    EXPECT_TRUE(first.getReusePort().value());
+
+    auto const address = tryBind(first);
+    ASSERT_TRUE(address);
+    EXPECT_TRUE(second.bind(*address));
+}
+
+TEST_F(NetworkUDPSocket, BufferSizes)
+{
+    UDPSocketV4 sut{};
+    ASSERT_TRUE(sut.setReceiveBufferSize(65536U));
+    ASSERT_TRUE(sut.setSendBufferSize(32768U));
+
+    // Linux doubles the requested sizes, other systems may round them
+    EXPECT_GE(sut.getReceiveBufferSize().value(), 65536U);
+    EXPECT_GE(sut.getSendBufferSize().value(), 32768U);
+
+    // sizes not fitting into an int are rejected instead of being truncated
+    errno = 0;
+    EXPECT_FALSE(sut.setReceiveBufferSize(std::size_t{std::numeric_limits<int>::max()} + 65536U));
+    EXPECT_EQ(errno, EINVAL);
+    EXPECT_GE(sut.getReceiveBufferSize().value(), 65536U);
+}
+
+TEST_F(NetworkUDPSocket, TypeOfService)
+{
+    UDPSocketV4 sut{};
+    ASSERT_TRUE(sut.setTypeOfService(0x10U));
+    EXPECT_EQ(sut.getTypeOfService().value(), 0x10U);
+}
+
+TEST_F(NetworkUDPSocket, NonblockingMode)
+{
+    UDPSocketV4 sut{};
+    ASSERT_TRUE(tryBind(sut));
+    ASSERT_TRUE(sut.setNonblocking(true));
+    auto const mode = sut.getNonblocking();
+    if (!mode.isError())
+    {
+        EXPECT_TRUE(mode.value());
+    }
+
+    std::array<std::byte, 16U> buffer{};
+
+    auto const result = sut.receiveFrom(nullptr, buffer);
+    ASSERT_TRUE(result.isError());
+    EXPECT_TRUE((result.errorCode() == EAGAIN) || (result.errorCode() == EWOULDBLOCK));
+
+    ASSERT_TRUE(sut.setNonblocking(false));
+    if (!mode.isError())
+    {
+        EXPECT_FALSE(sut.getNonblocking().value());
+    }
+}
+
+#ifdef __linux__
+
+TEST_F(NetworkUDPSocket, LinuxSpecificOptions)
+{
+    UDPSocketV4 sut{};
+    ASSERT_TRUE(sut.setPriority(3U));
+    EXPECT_EQ(sut.getPriority().value(), 3U);
+
+    // SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE
+    ASSERT_TRUE(sut.setTimestamping((1U << 3U) | (1U << 4U)));
+    EXPECT_EQ(sut.getTimestamping().value(), (1U << 3U) | (1U << 4U));
+
+    // raising the busy poll time requires CAP_NET_ADMIN
+    EXPECT_EQ(sut.getBusyPoll().value(), std::chrono::microseconds{0U});
+    if (sut.setBusyPoll(std::chrono::microseconds{50U}))
+    {
+        EXPECT_EQ(sut.getBusyPoll().value(), std::chrono::microseconds{50U});
+    }
+}
+
+#else
+
+TEST_F(NetworkUDPSocket, LinuxSpecificOptions)
+{
+    UDPSocketV4 sut{};
+    EXPECT_FALSE(sut.setPriority(3U));
+    EXPECT_EQ(sut.getPriority().errorCode(), EOPNOTSUPP);
+    EXPECT_FALSE(sut.setTimestamping(0U));
+    EXPECT_EQ(sut.getTimestamping().errorCode(), EOPNOTSUPP);
+    EXPECT_FALSE(sut.setBusyPoll(std::chrono::microseconds{50U}));
+    EXPECT_EQ(sut.getBusyPoll().errorCode(), EOPNOTSUPP);
+}
+
+#endif // !__linux__
+
 TEST_F(NetworkUDPSocket, Close)
 {
     UDPSocketV4 sut{};
@@ -121,4 +225,95 @@ TEST_F(NetworkUDPSocket, BasicDataTransfer)
     }
 }
 
+TEST_F(NetworkUDPSocket, BatchedDataTransfer)
+{
+    using DatagramV4 = Datagram<IPVersion::V4>;
+
+    UDPSocketV4 sender{};
+    UDPSocketV4 receiver{};
+    auto const  senderAddress   = tryBind(sender);
+    auto const  receiverAddress = tryBind(receiver);
+    ASSERT_TRUE(senderAddress);
+    ASSERT_TRUE(receiverAddress);
+
+    std::array<std::array<std::byte, 8U>, 4U>  sendBuffers{};
+    std::array<std::array<std::byte, 16U>, 6U> receiveBuffers{};
+    std::array<DatagramV4, 4U>                 sendDatagrams{};
+    std::array<DatagramV4, 6U>                 receiveDatagrams{};
+    for (auto i = 0U; i < sendBuffers.size(); ++i)
+    {
+        for (auto j = 0U; j < sendBuffers[i].size(); ++j)
+        {
+            sendBuffers[i][j] = static_cast<std::byte>(i * 16U + j);
+        }
+        sendDatagrams[i].address = *receiverAddress;
+        sendDatagrams[i].buffer  = std::span<std::byte>{sendBuffers[i]}.first(i + 1U);
+    }
+    for (auto i = 0U; i < receiveBuffers.size(); ++i)
+    {
+        receiveDatagrams[i].buffer = receiveBuffers[i];
+    }
+
+    auto const sendResult = sender.sendBatch(sendDatagrams);
+    ASSERT_FALSE(sendResult.isError());
+    EXPECT_EQ(sendResult.value(), sendDatagrams.size());
+
+    ASSERT_TRUE(receiver.receiveIsNonblocking());
+    auto const receiveResult = receiver.receiveBatch(receiveDatagrams);
+    ASSERT_FALSE(receiveResult.isError());
+    ASSERT_EQ(receiveResult.value(), sendDatagrams.size());
+    for (auto i = 0U; i < sendDatagrams.size(); ++i)
+    {
+        EXPECT_EQ(receiveDatagrams[i].address.port, senderAddress->port);
+        EXPECT_EQ(receiveDatagrams[i].segmentSize, 0U);
+        ASSERT_EQ(receiveDatagrams[i].length, i + 1U);
+        for (auto j = 0U; j < receiveDatagrams[i].length; ++j)
+        {
+            EXPECT_EQ(receiveBuffers[i][j], sendBuffers[i][j]);
+        }
+    }
+    EXPECT_FALSE(receiver.receiveIsNonblocking());
+}
+
+TEST_F(NetworkUDPSocket, BatchedSendWithSegmentation)
+{
+    using DatagramV4 = Datagram<IPVersion::V4>;
+
+    UDPSocketV4 sender{};
+    UDPSocketV4 receiver{};
+    ASSERT_TRUE(tryBind(sender));
+    auto const receiverAddress = tryBind(receiver);
+    ASSERT_TRUE(receiverAddress);
+
+    std::array<std::byte, 12U> sendBuffer{};
+    for (auto i = 0U; i < sendBuffer.size(); ++i)
+    {
+        sendBuffer[i] = static_cast<std::byte>(i);
+    }
+    std::array<DatagramV4, 1U> sendDatagrams{DatagramV4{*receiverAddress, sendBuffer, 0U, 4U}};
+
+    auto const sendResult = sender.sendBatch(sendDatagrams);
+    ASSERT_FALSE(sendResult.isError());
+    EXPECT_EQ(sendResult.value(), 1U);
+
+    // without receive offload every segment arrives as a datagram of its own
+    std::array<std::array<std::byte, 16U>, 4U> receiveBuffers{};
+    std::array<DatagramV4, 4U>                 receiveDatagrams{};
+    for (auto i = 0U; i < receiveBuffers.size(); ++i)
+    {
+        receiveDatagrams[i].buffer = receiveBuffers[i];
+    }
+    auto const receiveResult = receiver.receiveBatch(receiveDatagrams);
+    ASSERT_FALSE(receiveResult.isError());
+    ASSERT_EQ(receiveResult.value(), 3U);
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        ASSERT_EQ(receiveDatagrams[i].length, 4U);
+        for (auto j = 0U; j < 4U; ++j)
+        {
+            EXPECT_EQ(receiveBuffers[i][j], sendBuffer[i * 4U + j]);
+        }
+    }
+}
+
 } // namespace Terrahertz::UnitTests
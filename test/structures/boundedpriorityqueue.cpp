@@ -0,0 +1,86 @@
+#include "THzCommon/structures/boundedpriorityqueue.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <gtest/gtest.h>
+
+namespace Terrahertz::UnitTests {
+
+struct StructuresBoundedPriorityQueue : public testing::Test
+{
+    std::array<std::uint32_t, 4U> buffer{};
+
+    BoundedPriorityQueue<std::uint32_t> sut{buffer};
+};
+
+TEST_F(StructuresBoundedPriorityQueue, EmptyOnConstruction)
+{
+    EXPECT_EQ(sut.size(), 4U);
+    EXPECT_EQ(sut.filled(), 0U);
+    EXPECT_FALSE(sut.full());
+    EXPECT_EQ(sut.top(), nullptr);
+    EXPECT_TRUE(sut.release().empty());
+}
+
+TEST_F(StructuresBoundedPriorityQueue, KeepsSmallestValues)
+{
+    for (auto const value : {9U, 3U, 7U, 5U})
+    {
+        EXPECT_TRUE(sut.push(value));
+    }
+    EXPECT_TRUE(sut.full());
+    ASSERT_NE(sut.top(), nullptr);
+    EXPECT_EQ(*sut.top(), 9U);
+
+    EXPECT_FALSE(sut.push(10U));
+    EXPECT_FALSE(sut.push(9U));
+    EXPECT_TRUE(sut.push(1U));
+    EXPECT_TRUE(sut.push(4U));
+    EXPECT_EQ(*sut.top(), 5U);
+
+    auto const values = sut.release();
+    ASSERT_EQ(values.size(), 4U);
+    EXPECT_EQ(values[0U], 1U);
+    EXPECT_EQ(values[1U], 3U);
+    EXPECT_EQ(values[2U], 4U);
+    EXPECT_EQ(values[3U], 5U);
+    EXPECT_EQ(sut.filled(), 0U);
+}
+
+TEST_F(StructuresBoundedPriorityQueue, PopAndClear)
+{
+    sut.push(2U);
+    sut.push(8U);
+    sut.push(6U);
+    sut.pop();
+    EXPECT_EQ(*sut.top(), 6U);
+    EXPECT_EQ(sut.filled(), 2U);
+    sut.clear();
+    EXPECT_EQ(sut.filled(), 0U);
+    sut.pop();
+    EXPECT_EQ(sut.filled(), 0U);
+}
+
+TEST_F(StructuresBoundedPriorityQueue, ZeroSizeKeepsNothing)
+{
+    BoundedPriorityQueue<std::uint32_t> empty{gsl::span<std::uint32_t>{}};
+    EXPECT_TRUE(empty.full());
+    EXPECT_FALSE(empty.push(1U));
+    EXPECT_EQ(empty.top(), nullptr);
+}
+
+TEST_F(StructuresBoundedPriorityQueue, CustomComparison)
+{
+    BoundedPriorityQueue<std::uint32_t, std::greater<std::uint32_t>> largest{buffer};
+    for (auto const value : {9U, 3U, 7U, 5U, 1U, 11U})
+    {
+        largest.push(value);
+    }
+    auto const values = largest.release();
+    ASSERT_EQ(values.size(), 4U);
+    EXPECT_EQ(values[0U], 11U);
+    EXPECT_EQ(values[3U], 5U);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,183 @@
+#include "THzCommon/structures/flatoctree.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace Terrahertz::UnitTests {
+
+struct StructuresFlatOctree : public testing::Test
+{
+    using TestOctreeType = FlatOctree<std::uint16_t, std::uint32_t, std::int32_t>;
+
+    TestOctreeType sut{128U, 128U, 128U, 256U, 4U, 8U};
+
+    void checkNode(TestOctreeType::Node const &node,
+                   std::uint16_t const         centerX,
+                   std::uint16_t const         centerY,
+                   std::uint16_t const         centerZ,
+                   std::uint32_t const         size,
+                   std::uint8_t const          maxDepth,
+                   size_t const                totalEntries) noexcept
+    {
+        EXPECT_EQ(node.getCenterX(), centerX);
+        EXPECT_EQ(node.getCenterY(), centerY);
+        EXPECT_EQ(node.getCenterZ(), centerZ);
+        EXPECT_EQ(node.getSize(), size);
+        EXPECT_EQ(node.getMaxDepth(), maxDepth);
+        EXPECT_EQ(node.totalEntries(), totalEntries);
+    }
+};
+
+TEST_F(StructuresFlatOctree, DefaultConstruction)
+{
+    TestOctreeType tree{};
+    checkNode(tree.getRoot(), {}, {}, {}, {}, {}, 0U);
+    EXPECT_EQ(tree.getMaxEntries(), 0U);
+    EXPECT_TRUE(tree.getChildNodes().empty());
+    EXPECT_EQ(tree.getNodes().size(), 1U);
+
+    // without depth every entry stays in the root
+    tree.addEntry(1U, 2U, 3U, 4);
+    tree.addEntry(1U, 2U, 3U, 5);
+    EXPECT_EQ(tree.totalEntries(), 2U);
+    EXPECT_EQ(tree.getNodes().size(), 1U);
+}
+
+TEST_F(StructuresFlatOctree, ParameterConstruction)
+{
+    TestOctreeType tree{127U, 128U, 126U, 255U, 4U, 8U};
+    EXPECT_EQ(tree.getCenterX(), 127U);
+    EXPECT_EQ(tree.getCenterY(), 128U);
+    EXPECT_EQ(tree.getCenterZ(), 126U);
+    EXPECT_EQ(tree.getSize(), 255U);
+    EXPECT_EQ(tree.getMaxEntries(), 4U);
+    EXPECT_EQ(tree.getMaxDepth(), 8U);
+    EXPECT_EQ(tree.totalEntries(), 0U);
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        EXPECT_EQ(tree.getNodes(i).size(), (i == 0 ? 1U : 0U));
+    }
+}
+
+TEST_F(StructuresFlatOctree, NodeIsSplitCorrectly)
+{
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        sut.addEntry(40U * i, 40U * i, 40U * i, 123);
+    }
+    EXPECT_EQ(sut.getNodes().size(), 1U);
+    sut.addEntry(160U, 160U, 160U, 123);
+    auto const nodes = sut.getNodes();
+    ASSERT_EQ(nodes.size(), 9U);
+    EXPECT_EQ(sut.getChildNodes().size(), 8U);
+    EXPECT_EQ(sut.getNodes(1U).size(), 8U);
+
+    checkNode(*nodes[0], 128U, 128U, 128U, 256U, 8U, 5U);
+    checkNode(*nodes[1], 64U, 64U, 64U, 128U, 7U, 4U);
+    checkNode(*nodes[2], 192U, 64U, 64U, 128U, 7U, 0U);
+    checkNode(*nodes[3], 64U, 192U, 64U, 128U, 7U, 0U);
+    checkNode(*nodes[4], 192U, 192U, 64U, 128U, 7U, 0U);
+    checkNode(*nodes[5], 64U, 64U, 192U, 128U, 7U, 0U);
+    checkNode(*nodes[6], 192U, 64U, 192U, 128U, 7U, 0U);
+    checkNode(*nodes[7], 64U, 192U, 192U, 128U, 7U, 0U);
+    checkNode(*nodes[8], 192U, 192U, 192U, 128U, 7U, 1U);
+}
+
+TEST_F(StructuresFlatOctree, EntriesBeyondMaxDepthChained)
+{
+    TestOctreeType tree{128U, 128U, 128U, 256U, 2U, 1U};
+    for (auto i = 0; i < 7; ++i)
+    {
+        tree.addEntry(10U, 10U, 10U, i);
+    }
+    EXPECT_EQ(tree.totalEntries(), 7U);
+    EXPECT_EQ(tree.getChildNodes()[0].totalEntries(), 7U);
+
+    auto sum    = 0;
+    auto lambda = [&](TestOctreeType::Entry const &e) noexcept { sum += e.value; };
+    tree.analyzeEntries(tree.getChildNodes()[0], lambda);
+    EXPECT_EQ(sum, 21);
+}
+
+TEST_F(StructuresFlatOctree, ResetKeepsMemory)
+{
+    std::mt19937                                 rng{42U};
+    std::uniform_int_distribution<std::uint16_t> coordinate{0U, 255U};
+    auto const                                   fill = [&]() noexcept {
+        rng.seed(42U);
+        for (auto i = 0; i < 1000; ++i)
+        {
+            sut.addEntry(coordinate(rng), coordinate(rng), coordinate(rng), i);
+        }
+    };
+    fill();
+    auto const first = sut.getNodes();
+    sut.reset();
+    EXPECT_EQ(sut.totalEntries(), 0U);
+    EXPECT_EQ(sut.getNodes().size(), 1U);
+    EXPECT_EQ(sut.getMaxEntries(), 4U);
+    EXPECT_EQ(sut.getMaxDepth(), 8U);
+
+    // the same entries produce the same nodes in the same places
+    fill();
+    EXPECT_EQ(sut.getNodes(), first);
+
+    sut.reset(12U, 13U, 14U, 24U, 4U, 3U);
+    EXPECT_EQ(sut.getCenterX(), 12U);
+    EXPECT_EQ(sut.getCenterY(), 13U);
+    EXPECT_EQ(sut.getCenterZ(), 14U);
+    EXPECT_EQ(sut.getSize(), 24U);
+    EXPECT_EQ(sut.getMaxDepth(), 3U);
+    EXPECT_EQ(sut.totalEntries(), 0U);
+}
+
+TEST_F(StructuresFlatOctree, AnalyzeEntries)
+{
+    for (auto i = 20U; i < 80; ++i)
+    {
+        sut.addEntry(i, i, i, i);
+    }
+
+    auto count  = 0U;
+    auto lambda = [&](TestOctreeType::Entry const &e) {
+        EXPECT_EQ(e.x, e.y);
+        EXPECT_EQ(e.x, e.z);
+        EXPECT_EQ(e.x, e.value);
+        ++count;
+    };
+    sut.analyzeEntries(lambda);
+    EXPECT_EQ(count, sut.totalEntries());
+}
+
+TEST_F(StructuresFlatOctree, MatchesOctree)
+{
+    Octree<std::uint16_t, std::uint32_t, std::int32_t> reference{128U, 128U, 128U, 256U, 4U, 8U};
+
+    std::mt19937                                 rng{7U};
+    std::uniform_int_distribution<std::uint16_t> coordinate{0U, 255U};
+    for (auto i = 0; i < 5000; ++i)
+    {
+        auto const x = coordinate(rng);
+        auto const y = coordinate(rng);
+        auto const z = coordinate(rng);
+        sut.addEntry(x, y, z, i);
+        reference.addEntry(x, y, z, i);
+    }
+
+    auto const nodes          = sut.getNodes();
+    auto const referenceNodes = reference.getNodes();
+    ASSERT_EQ(nodes.size(), referenceNodes.size());
+    for (size_t i = 0U; i < nodes.size(); ++i)
+    {
+        checkNode(*nodes[i],
+                  referenceNodes[i]->getCenterX(),
+                  referenceNodes[i]->getCenterY(),
+                  referenceNodes[i]->getCenterZ(),
+                  referenceNodes[i]->getSize(),
+                  referenceNodes[i]->getMaxDepth(),
+                  referenceNodes[i]->totalEntries());
+    }
+}
+
+} // namespace Terrahertz::UnitTests
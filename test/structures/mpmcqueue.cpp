@@ -0,0 +1,209 @@
+#include "THzCommon/structures/mpmcqueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct StructuresMpmcQueue : public testing::Test
+{
+    using TestQueue = MpmcQueue<std::uint32_t, 8U>;
+
+    /// @brief The number of values pushed by each producer during the stress tests.
+    static constexpr std::uint64_t ValuesPerProducer = 20000U;
+
+    /// @brief Pushes values from multiple threads and pops them from multiple others.
+    ///
+    /// @param producers The number of producing threads.
+    /// @param consumers The number of consuming threads.
+    /// @param blocking True to use push/pop, false to use try_push/try_pop.
+    void stress(std::size_t const producers, std::size_t const consumers, bool const blocking) noexcept
+    {
+        // each value encodes the producer in the upper and a running number in the lower bits
+        auto queue = std::make_unique<MpmcQueue<std::uint64_t, 64U>>();
+
+        auto const total = producers * ValuesPerProducer;
+
+        std::atomic<std::uint64_t> popped{};
+        std::atomic<std::uint64_t> sum{};
+        std::atomic_bool           inOrder{true};
+
+        auto const produce = [&](std::uint64_t const producer) noexcept {
+            for (std::uint64_t i = 0U; i < ValuesPerProducer; ++i)
+            {
+                auto const value = (producer << 32U) | i;
+                if (blocking)
+                {
+                    queue->push(value);
+                }
+                else
+                {
+                    while (!queue->try_push(value))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        };
+        auto const consume = [&]() noexcept {
+            // values of the same producer are popped in the order they have been pushed
+            std::vector<std::uint64_t> next(producers);
+            std::uint64_t              localSum{};
+            while (popped.fetch_add(1U) < total)
+            {
+                std::uint64_t value{};
+                if (blocking)
+                {
+                    queue->pop(value);
+                }
+                else
+                {
+                    while (!queue->try_pop(value))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                auto const producer = value >> 32U;
+                auto const number   = value & 0xFFFFFFFFU;
+                if ((producer >= producers) || (number < next[producer]))
+                {
+                    inOrder = false;
+                }
+                else
+                {
+                    next[producer] = number + 1U;
+                }
+                localSum += number;
+            }
+            sum += localSum;
+        };
+
+        std::vector<std::thread> threads{};
+        for (std::size_t i = 0U; i < consumers; ++i)
+        {
+            threads.emplace_back(consume);
+        }
+        for (std::size_t i = 0U; i < producers; ++i)
+        {
+            threads.emplace_back(produce, i);
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        EXPECT_TRUE(inOrder);
+        EXPECT_EQ(sum, producers * ((ValuesPerProducer * (ValuesPerProducer - 1U)) / 2U));
+        EXPECT_TRUE(queue->empty());
+    }
+
+    TestQueue sut{};
+};
+
+TEST_F(StructuresMpmcQueue, EmptyOnConstruction)
+{
+    EXPECT_TRUE(sut.empty());
+    EXPECT_EQ(sut.filled(), 0U);
+    EXPECT_EQ(sut.size(), 8U);
+
+    std::uint32_t value{};
+    EXPECT_FALSE(sut.try_pop(value));
+}
+
+TEST_F(StructuresMpmcQueue, PositionsOnSeparateCacheLines)
+{
+    EXPECT_GE(alignof(TestQueue), TestQueue::CacheLineSize);
+    EXPECT_GE(sizeof(TestQueue), 3U * TestQueue::CacheLineSize);
+}
+
+TEST_F(StructuresMpmcQueue, PushAndPop)
+{
+    EXPECT_TRUE(sut.try_push(23U));
+    sut.push(42U);
+    EXPECT_EQ(sut.filled(), 2U);
+
+    std::uint32_t value{};
+    EXPECT_TRUE(sut.try_pop(value));
+    EXPECT_EQ(value, 23U);
+    sut.pop(value);
+    EXPECT_EQ(value, 42U);
+    EXPECT_FALSE(sut.try_pop(value));
+    EXPECT_TRUE(sut.empty());
+}
+
+TEST_F(StructuresMpmcQueue, PushWhileFull)
+{
+    for (std::uint32_t i = 0U; i < sut.size(); ++i)
+    {
+        EXPECT_TRUE(sut.try_push(i));
+    }
+    EXPECT_FALSE(sut.try_push(23U));
+    EXPECT_EQ(sut.filled(), sut.size());
+
+    // values keep their order across multiple rounds
+    std::uint32_t value{};
+    for (std::uint32_t i = 0U; i < 3U * sut.size(); ++i)
+    {
+        EXPECT_TRUE(sut.try_pop(value));
+        EXPECT_EQ(value, i);
+        EXPECT_TRUE(sut.try_push(i + sut.size()));
+    }
+}
+
+TEST_F(StructuresMpmcQueue, MoveOnlyValues)
+{
+    MpmcQueue<std::unique_ptr<std::string>, 4U> queue{};
+    EXPECT_TRUE(queue.try_push(std::make_unique<std::string>("THz")));
+
+    std::unique_ptr<std::string> value{};
+    EXPECT_TRUE(queue.try_pop(value));
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*value, "THz");
+}
+
+TEST_F(StructuresMpmcQueue, BlockingPopWaitsForValue)
+{
+    std::uint32_t value{};
+    std::thread   consumer{[&]() noexcept { sut.pop(value); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{10U});
+    sut.push(1337U);
+    consumer.join();
+    EXPECT_EQ(value, 1337U);
+}
+
+TEST_F(StructuresMpmcQueue, BlockingPushWaitsForSpace)
+{
+    for (std::uint32_t i = 0U; i < sut.size(); ++i)
+    {
+        sut.push(i);
+    }
+    std::atomic_bool pushed{};
+
+    auto const pushValue = [&]() noexcept {
+        sut.push(1337U);
+        pushed = true;
+    };
+    std::thread producer{pushValue};
+    std::this_thread::sleep_for(std::chrono::milliseconds{10U});
+    EXPECT_FALSE(pushed);
+
+    std::uint32_t value{};
+    sut.pop(value);
+    producer.join();
+    EXPECT_TRUE(pushed);
+    EXPECT_EQ(sut.filled(), sut.size());
+}
+
+TEST_F(StructuresMpmcQueue, StressSingleProducerSingleConsumer) { stress(1U, 1U, false); }
+
+TEST_F(StructuresMpmcQueue, StressMultipleProducersMultipleConsumers) { stress(4U, 4U, false); }
+
+TEST_F(StructuresMpmcQueue, StressBlockingMultipleProducersMultipleConsumers) { stress(4U, 3U, true); }
+
+} // namespace Terrahertz::UnitTests
@@ -1,8 +1,13 @@
 #include "THzCommon/structures/octree.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <gtest/gtest.h>
 #include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace Terrahertz::UnitTests {
 
@@ -29,6 +34,71 @@ struct StructuresOctree : public testing::Test
         EXPECT_EQ(tree.getMaxDepth(), maxDepth);
         EXPECT_EQ(tree.totalEntries(), totalEntries);
     }
+
+    /// @brief Creates random entries, with a share of duplicates to create deep nodes.
+    ///
+    /// @param count The number of entries to create.
+    /// @return The entries.
+    static std::vector<TestOctreeType::Entry> createEntries(size_t const count) noexcept
+    {
+        std::mt19937                                 rng{42U};
+        std::uniform_int_distribution<std::uint16_t> coordinate{0U, 255U};
+        std::vector<TestOctreeType::Entry>           entries{};
+        for (auto i = 0; entries.size() < count; ++i)
+        {
+            if ((i % 10) == 9)
+            {
+                entries.emplace_back(entries[entries.size() / 2U]);
+                entries.back().value = i;
+            }
+            else
+            {
+                entries.emplace_back(TestOctreeType::Entry{coordinate(rng), coordinate(rng), coordinate(rng), i});
+            }
+        }
+        return entries;
+    }
+
+    /// @brief Checks that both trees have the same nodes, holding the same entries.
+    ///
+    /// @param expected The expected tree.
+    /// @param actual The tree to check.
+    void checkEquivalent(TestOctreeType const &expected, TestOctreeType const &actual) noexcept
+    {
+        auto const expectedNodes = expected.getNodes();
+        auto const actualNodes   = actual.getNodes();
+        ASSERT_EQ(expectedNodes.size(), actualNodes.size());
+        for (size_t i = 0U; i < expectedNodes.size(); ++i)
+        {
+            auto const &node = *expectedNodes[i];
+            checkTree(*actualNodes[i],
+                      node.getCenterX(),
+                      node.getCenterY(),
+                      node.getCenterZ(),
+                      node.getSize(),
+                      node.getMaxEntries(),
+                      node.getMaxDepth(),
+                      node.totalEntries());
+            if (node.getChildNodes().empty())
+            {
+                EXPECT_EQ(sortedEntries(node), sortedEntries(*actualNodes[i]));
+            }
+        }
+    }
+
+    /// @brief Returns the entries of the given tree in a defined order.
+    ///
+    /// @param tree The tree to return the entries of.
+    /// @return The entries as tuples, sorted.
+    static std::vector<std::tuple<std::uint16_t, std::uint16_t, std::uint16_t, std::int32_t>>
+    sortedEntries(TestOctreeType const &tree) noexcept
+    {
+        std::vector<std::tuple<std::uint16_t, std::uint16_t, std::uint16_t, std::int32_t>> entries{};
+        auto collect = [&](TestOctreeType::Entry const &e) noexcept { entries.emplace_back(e.x, e.y, e.z, e.value); };
+        tree.analyzeEntries(collect);
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
 };
 
 TEST_F(StructuresOctree, DefaultConstruction)
@@ -111,6 +181,13 @@ TEST_F(StructuresOctree, Reset)
         tree.reset(14U, 11U, 14U, 48U, 8U, 7U);
         checkTree(tree, 14U, 11U, 14U, 48U, 8U, 7U, 0U);
     }
+    {
+        // the totals calculated before are dropped as well
+        sut.addEntry(20U, 20U, 20U, 20U);
+        EXPECT_EQ(sut.totalEntries(), 1U);
+        sut.reset();
+        EXPECT_EQ(sut.totalEntries(), 0U);
+    }
 }
 
 TEST_F(StructuresOctree, AnalyzeEntries)
@@ -131,4 +208,459 @@ TEST_F(StructuresOctree, AnalyzeEntries)
     EXPECT_EQ(count, sut.totalEntries());
 }
 
+TEST_F(StructuresOctree, BuildMatchesAddEntry)
+{
+    auto const entries = createEntries(20000U);
+    for (auto const &entry : entries)
+    {
+        sut.addEntry(entry);
+    }
+    TestOctreeType built{128U, 128U, 128U, 256U, 4U, 8U};
+    built.build(entries);
+    checkEquivalent(sut, built);
+    EXPECT_EQ(built.totalEntries(), entries.size());
+}
+
+TEST_F(StructuresOctree, BuildUnevenSpace)
+{
+    // centers of odd sized nodes are rounded, the codes have to follow the same rounding
+    TestOctreeType incremental{100U, 90U, 80U, 201U, 3U, 7U};
+    TestOctreeType built{100U, 90U, 80U, 201U, 3U, 7U};
+    auto const     entries = createEntries(5000U);
+    for (auto const &entry : entries)
+    {
+        incremental.addEntry(entry);
+    }
+    built.build(entries);
+    checkEquivalent(incremental, built);
+}
+
+TEST_F(StructuresOctree, BuildDeeperThanMortonLevels)
+{
+    TestOctreeType incremental{32768U, 32768U, 32768U, 65536U, 2U, 30U};
+    TestOctreeType built{32768U, 32768U, 32768U, 65536U, 2U, 30U};
+
+    std::vector<TestOctreeType::Entry> entries{};
+    for (auto i = 0; i < 40; ++i)
+    {
+        // close enough to share the first levels, separated below
+        entries.emplace_back(TestOctreeType::Entry{static_cast<std::uint16_t>(1000 + (i % 4)), 1000U, 1000U, i});
+    }
+    for (auto const &entry : entries)
+    {
+        incremental.addEntry(entry);
+    }
+    built.build(entries);
+    checkEquivalent(incremental, built);
+}
+
+TEST_F(StructuresOctree, BuildReplacesContent)
+{
+    sut.addEntry(20U, 20U, 20U, 20);
+    sut.build(gsl::span<TestOctreeType::Entry const>{});
+    EXPECT_EQ(sut.totalEntries(), 0U);
+    EXPECT_EQ(sut.getNodes().size(), 1U);
+
+    auto const entries = createEntries(100U);
+    sut.build(entries);
+    sut.build(entries);
+    EXPECT_EQ(sut.totalEntries(), entries.size());
+}
+
+TEST_F(StructuresOctree, BuildInParallel)
+{
+    // large enough for the subtrees of the top-level octants to be built as separate jobs
+    auto const entries = createEntries(16U * TestOctreeType::ParallelBuildGrain);
+
+    TestOctreeType sequential{128U, 128U, 128U, 256U, 16U, 8U};
+    sequential.build(entries);
+
+    ThreadPool     pool{3U};
+    TestOctreeType parallel{128U, 128U, 128U, 256U, 16U, 8U};
+    parallel.build(entries, &pool);
+    checkEquivalent(sequential, parallel);
+}
+
+TEST_F(StructuresOctree, ParallelAnalyzeEntries)
+{
+    auto const entries = createEntries(20000U);
+    for (auto const &entry : entries)
+    {
+        sut.addEntry(entry);
+    }
+    ThreadPool pool{3U};
+
+    auto const sum = sut.parallelAnalyzeEntries(
+        pool,
+        std::int64_t{},
+        [](std::int64_t &result, TestOctreeType::Entry const &e) noexcept { result += e.value; },
+        [](std::int64_t const a, std::int64_t const b) noexcept { return a + b; });
+    std::int64_t expectedSum{};
+    for (auto const &entry : entries)
+    {
+        expectedSum += entry.value;
+    }
+    EXPECT_EQ(sum, expectedSum);
+
+    // concatenating is not commutative, the results have to be combined in the order of analyzeEntries
+    std::vector<std::int32_t> expected{};
+    auto                      collect = [&](TestOctreeType::Entry const &e) noexcept { expected.emplace_back(e.value); };
+    sut.analyzeEntries(collect);
+    auto const values = sut.parallelAnalyzeEntries(
+        pool,
+        std::vector<std::int32_t>{},
+        [](std::vector<std::int32_t> &result, TestOctreeType::Entry const &e) noexcept {
+            result.emplace_back(e.value);
+        },
+        [](std::vector<std::int32_t> a, std::vector<std::int32_t> const &b) noexcept {
+            a.insert(a.end(), b.begin(), b.end());
+            return a;
+        });
+    EXPECT_EQ(values, expected);
+}
+
+TEST_F(StructuresOctree, ParallelRecalculate)
+{
+    auto const entries = createEntries(20000U);
+    for (auto const &entry : entries)
+    {
+        sut.addEntry(entry);
+    }
+    ThreadPool pool{3U};
+    sut.parallelRecalculate(pool);
+
+    // the const overload reports the stored totals
+    TestOctreeType const &constSut = sut;
+    EXPECT_EQ(constSut.totalEntries(), entries.size());
+    for (auto const node : sut.getNodes())
+    {
+        size_t count{};
+        auto   counter = [&](TestOctreeType::Entry const &) noexcept { ++count; };
+        node->analyzeEntries(counter);
+        EXPECT_EQ(node->totalEntries(), count);
+    }
+
+    sut.addEntry(1U, 2U, 3U, 4);
+    sut.parallelRecalculate(pool);
+    EXPECT_EQ(constSut.totalEntries(), entries.size() + 1U);
+}
+
+TEST_F(StructuresOctree, QueryBox)
+{
+    auto const entries = createEntries(5000U);
+    sut.build(entries);
+    // entries outside of the cube are stored in the outermost nodes and have to be found as well
+    sut.addEntry(300U, 300U, 300U, -1);
+
+    for (auto const &box : {TestOctreeType::Box{10U, 20U, 30U, 90U, 60U, 200U},
+                            TestOctreeType::Box{0U, 0U, 0U, 400U, 400U, 400U},
+                            TestOctreeType::Box{128U, 128U, 128U, 128U, 128U, 128U},
+                            TestOctreeType::Box{250U, 250U, 250U, 310U, 310U, 310U},
+                            TestOctreeType::Box{50U, 50U, 50U, 40U, 40U, 40U}})
+    {
+        std::vector<std::tuple<std::uint16_t, std::uint16_t, std::uint16_t, std::int32_t>> expected{};
+        auto const expect = [&](TestOctreeType::Entry const &e) noexcept {
+            if ((e.x >= box.minX) && (e.x <= box.maxX) && (e.y >= box.minY) && (e.y <= box.maxY) &&
+                (e.z >= box.minZ) && (e.z <= box.maxZ))
+            {
+                expected.emplace_back(e.x, e.y, e.z, e.value);
+            }
+        };
+        std::for_each(entries.begin(), entries.end(), expect);
+        expect(TestOctreeType::Entry{300U, 300U, 300U, -1});
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<TestOctreeType::Entry> output(expected.size() + 1U);
+        ASSERT_EQ(sut.queryBox(box, output), expected.size());
+
+        std::vector<std::tuple<std::uint16_t, std::uint16_t, std::uint16_t, std::int32_t>> found{};
+        for (size_t i = 0U; i < expected.size(); ++i)
+        {
+            found.emplace_back(output[i].x, output[i].y, output[i].z, output[i].value);
+        }
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+}
+
+TEST_F(StructuresOctree, QueryBoxOutputTooSmall)
+{
+    sut.build(createEntries(1000U));
+    std::array<TestOctreeType::Entry, 3U> output{};
+    EXPECT_EQ(sut.queryBox(TestOctreeType::Box{0U, 0U, 0U, 255U, 255U, 255U}, output), 1000U);
+
+    auto count   = 0U;
+    auto counter = [&](TestOctreeType::Entry const &) noexcept { ++count; };
+    sut.queryBox(TestOctreeType::Box{0U, 0U, 0U, 127U, 255U, 255U}, counter);
+    EXPECT_GT(count, 0U);
+    EXPECT_LT(count, 1000U);
+}
+
+TEST_F(StructuresOctree, QuerySphere)
+{
+    auto const entries = createEntries(5000U);
+    sut.build(entries);
+
+    for (auto const radius : {0, 1, 20, 70, 500})
+    {
+        size_t expected{};
+        for (auto const &e : entries)
+        {
+            auto const dx = static_cast<std::int64_t>(e.x) - 100;
+            auto const dy = static_cast<std::int64_t>(e.y) - 150;
+            auto const dz = static_cast<std::int64_t>(e.z) - 30;
+            expected += ((dx * dx) + (dy * dy) + (dz * dz)) <= (radius * radius) ? 1U : 0U;
+        }
+
+        size_t found{};
+        auto   check = [&](TestOctreeType::Entry const &e) noexcept {
+            auto const dx = static_cast<std::int64_t>(e.x) - 100;
+            auto const dy = static_cast<std::int64_t>(e.y) - 150;
+            auto const dz = static_cast<std::int64_t>(e.z) - 30;
+            EXPECT_LE((dx * dx) + (dy * dy) + (dz * dz), radius * radius);
+            ++found;
+        };
+        sut.querySphere(100U, 150U, 30U, radius, check);
+        EXPECT_EQ(found, expected);
+        EXPECT_EQ(sut.querySphere(100U, 150U, 30U, radius, gsl::span<TestOctreeType::Entry>{}), expected);
+    }
+}
+
+TEST_F(StructuresOctree, QueryNearest)
+{
+    auto const entries = createEntries(5000U);
+    sut.build(entries);
+
+    for (auto const &position : {std::array<std::uint16_t, 3U>{0U, 0U, 0U},
+                                 std::array<std::uint16_t, 3U>{128U, 128U, 128U},
+                                 std::array<std::uint16_t, 3U>{200U, 17U, 99U},
+                                 std::array<std::uint16_t, 3U>{1000U, 1000U, 1000U}})
+    {
+        std::vector<std::int64_t> expected{};
+        for (auto const &e : entries)
+        {
+            auto const dx = static_cast<std::int64_t>(e.x) - position[0U];
+            auto const dy = static_cast<std::int64_t>(e.y) - position[1U];
+            auto const dz = static_cast<std::int64_t>(e.z) - position[2U];
+            expected.emplace_back((dx * dx) + (dy * dy) + (dz * dz));
+        }
+        std::sort(expected.begin(), expected.end());
+
+        std::array<TestOctreeType::Neighbour, 10U> output{};
+        ASSERT_EQ(sut.queryNearest(position[0U], position[1U], position[2U], output), output.size());
+        for (size_t i = 0U; i < output.size(); ++i)
+        {
+            EXPECT_EQ(output[i].distance, expected[i]);
+            auto const dx = static_cast<std::int64_t>(output[i].entry.x) - position[0U];
+            auto const dy = static_cast<std::int64_t>(output[i].entry.y) - position[1U];
+            auto const dz = static_cast<std::int64_t>(output[i].entry.z) - position[2U];
+            EXPECT_EQ((dx * dx) + (dy * dy) + (dz * dz), output[i].distance);
+        }
+    }
+}
+
+TEST_F(StructuresOctree, QueryNearestFewEntries)
+{
+    sut.addEntry(10U, 10U, 10U, 1);
+    sut.addEntry(20U, 10U, 10U, 2);
+
+    std::array<TestOctreeType::Neighbour, 4U> output{};
+    ASSERT_EQ(sut.queryNearest(18U, 10U, 10U, output), 2U);
+    EXPECT_EQ(output[0U].entry.value, 2);
+    EXPECT_EQ(output[0U].distance, 4);
+    EXPECT_EQ(output[1U].entry.value, 1);
+    EXPECT_EQ(output[1U].distance, 64);
+    EXPECT_EQ(sut.queryNearest(18U, 10U, 10U, gsl::span<TestOctreeType::Neighbour>{}), 0U);
+}
+
+TEST_F(StructuresOctree, StructureOfArraysLayout)
+{
+    using SoAOctreeType = Octree<std::uint16_t, std::uint32_t, std::int32_t, OctreeLayout::StructureOfArrays>;
+
+    // leaves holding more entries than a block and partial blocks
+    auto const     entries = createEntries(5000U);
+    TestOctreeType expected{128U, 128U, 128U, 256U, 40U, 8U};
+    SoAOctreeType  added{128U, 128U, 128U, 256U, 40U, 8U};
+    SoAOctreeType  built{128U, 128U, 128U, 256U, 40U, 8U};
+    for (auto const &entry : entries)
+    {
+        expected.addEntry(entry);
+        added.addEntry(entry);
+    }
+    built.build(entries);
+    EXPECT_EQ(added.totalEntries(), entries.size());
+    EXPECT_EQ(built.totalEntries(), entries.size());
+    ASSERT_EQ(added.getNodes().size(), expected.getNodes().size());
+    ASSERT_EQ(built.getNodes().size(), expected.getNodes().size());
+
+    using Tuples = std::vector<std::tuple<std::uint16_t, std::uint16_t, std::uint16_t, std::int32_t>>;
+    Tuples     found{};
+    auto const collect = [&](auto const &e) noexcept { found.emplace_back(e.x, e.y, e.z, e.value); };
+
+    // the same entries in the same order
+    expected.analyzeEntries(collect);
+    auto const all = std::exchange(found, {});
+    added.analyzeEntries(collect);
+    EXPECT_EQ(std::exchange(found, {}), all);
+
+    for (auto const &box : {TestOctreeType::Box{10U, 20U, 30U, 90U, 60U, 200U},
+                            TestOctreeType::Box{128U, 128U, 128U, 128U, 128U, 128U},
+                            TestOctreeType::Box{50U, 50U, 50U, 40U, 40U, 40U}})
+    {
+        expected.queryBox(box, collect);
+        auto const inBox = std::exchange(found, {});
+        added.queryBox(SoAOctreeType::Box{box.minX, box.minY, box.minZ, box.maxX, box.maxY, box.maxZ}, collect);
+        EXPECT_EQ(std::exchange(found, {}), inBox);
+        built.queryBox(SoAOctreeType::Box{box.minX, box.minY, box.minZ, box.maxX, box.maxY, box.maxZ}, collect);
+        std::sort(found.begin(), found.end());
+        auto sorted = inBox;
+        std::sort(sorted.begin(), sorted.end());
+        EXPECT_EQ(std::exchange(found, {}), sorted);
+    }
+
+    for (auto const radius : {0, 20, 70})
+    {
+        expected.querySphere(100U, 150U, 30U, radius, collect);
+        auto const inSphere = std::exchange(found, {});
+        added.querySphere(100U, 150U, 30U, radius, collect);
+        EXPECT_EQ(std::exchange(found, {}), inSphere);
+    }
+
+    std::array<TestOctreeType::Neighbour, 10U> nearest{};
+    std::array<SoAOctreeType::Neighbour, 10U>  soaNearest{};
+    ASSERT_EQ(expected.queryNearest(200U, 17U, 99U, nearest), nearest.size());
+    ASSERT_EQ(built.queryNearest(200U, 17U, 99U, soaNearest), soaNearest.size());
+    for (size_t i = 0U; i < nearest.size(); ++i)
+    {
+        EXPECT_EQ(soaNearest[i].distance, nearest[i].distance);
+    }
+
+    added.reset();
+    added.addEntry(1U, 2U, 3U, 4);
+    added.analyzeEntries(collect);
+    EXPECT_EQ(found, (Tuples{{1U, 2U, 3U, 4}}));
+}
+
+TEST_F(StructuresOctree, RemoveEntry)
+{
+    for (auto i = 0; i < 5; ++i)
+    {
+        sut.addEntry(40U * i, 40U * i, 40U * i, i);
+    }
+    ASSERT_EQ(sut.getNodes().size(), 9U);
+
+    EXPECT_FALSE(sut.removeEntry(40U, 40U, 40U, 2));
+    EXPECT_FALSE(sut.removeEntry(41U, 40U, 40U, 1));
+    EXPECT_TRUE(sut.removeEntry(40U, 40U, 40U, 1));
+    EXPECT_FALSE(sut.removeEntry(40U, 40U, 40U, 1));
+    EXPECT_EQ(sut.totalEntries(), 4U);
+    EXPECT_EQ(sut.getNodes().size(), 9U);
+
+    // the children are merged by recalculate, once they hold no more than half of the maximum
+    EXPECT_TRUE(sut.removeEntry(TestOctreeType::Entry{160U, 160U, 160U, 4}));
+    sut.recalculate();
+    EXPECT_EQ(sut.totalEntries(), 3U);
+    EXPECT_EQ(sut.getNodes().size(), 9U);
+    EXPECT_TRUE(sut.removeEntry(0U, 0U, 0U, 0));
+    EXPECT_EQ(sut.totalEntries(), 2U);
+    EXPECT_EQ(sut.getNodes().size(), 9U);
+    sut.recalculate();
+    EXPECT_EQ(sut.getNodes().size(), 1U);
+    EXPECT_EQ(sut.totalEntries(), 2U);
+    EXPECT_EQ(sortedEntries(sut), (std::vector<std::tuple<std::uint16_t, std::uint16_t, std::uint16_t, std::int32_t>>{
+                                      {80U, 80U, 80U, 2}, {120U, 120U, 120U, 3}}));
+}
+
+TEST_F(StructuresOctree, MoveEntry)
+{
+    for (auto i = 0; i < 5; ++i)
+    {
+        sut.addEntry(40U * i, 40U * i, 40U * i, i);
+    }
+    EXPECT_EQ(sut.totalEntries(), 5U);
+    EXPECT_FALSE(sut.moveEntry(TestOctreeType::Entry{40U, 40U, 40U, 2}, 1U, 2U, 3U));
+
+    // inside the leaf
+    EXPECT_TRUE(sut.moveEntry(TestOctreeType::Entry{40U, 40U, 40U, 1}, 100U, 10U, 20U));
+    EXPECT_EQ(sut.getChildNodes()[0].totalEntries(), 4U);
+    EXPECT_FALSE(sut.removeEntry(40U, 40U, 40U, 1));
+
+    // to another leaf
+    EXPECT_TRUE(sut.moveEntry(TestOctreeType::Entry{100U, 10U, 20U, 1}, 200U, 10U, 20U));
+    EXPECT_EQ(sut.getChildNodes()[0].totalEntries(), 3U);
+    EXPECT_EQ(sut.getChildNodes()[1].totalEntries(), 1U);
+    EXPECT_EQ(sut.totalEntries(), 5U);
+    EXPECT_TRUE(sut.removeEntry(200U, 10U, 20U, 1));
+}
+
+TEST_F(StructuresOctree, IncrementalUpdates)
+{
+    using SoAOctreeType = Octree<std::uint16_t, std::uint32_t, std::int32_t, OctreeLayout::StructureOfArrays>;
+
+    auto                                         entries = createEntries(5000U);
+    SoAOctreeType                                soa{128U, 128U, 128U, 256U, 4U, 8U};
+    ThreadPool                                   pool{2U};
+    std::mt19937                                 rng{3U};
+    std::uniform_int_distribution<std::uint16_t> coordinate{0U, 255U};
+    std::uniform_int_distribution<std::int32_t>  step{-3, 3};
+    sut.build(entries);
+    soa.build(entries);
+
+    auto const nudge = [&](std::uint16_t const value) noexcept {
+        return static_cast<std::uint16_t>(std::clamp(value + step(rng), 0, 255));
+    };
+    for (auto round = 0; round < 10; ++round)
+    {
+        for (size_t i = round; i < entries.size(); i += 7U)
+        {
+            auto &entry = entries[i];
+            auto  moved = entry;
+            if ((i % 3U) == 0U)
+            {
+                moved.x = coordinate(rng);
+                moved.y = coordinate(rng);
+                moved.z = coordinate(rng);
+            }
+            else
+            {
+                moved.x = nudge(entry.x);
+                moved.y = nudge(entry.y);
+                moved.z = nudge(entry.z);
+            }
+            ASSERT_TRUE(sut.moveEntry(entry, moved.x, moved.y, moved.z));
+            ASSERT_TRUE(soa.moveEntry(entry, moved.x, moved.y, moved.z));
+            entry = moved;
+        }
+        for (auto i = 0; i < 100; ++i)
+        {
+            ASSERT_TRUE(sut.removeEntry(entries.back()));
+            ASSERT_TRUE(soa.removeEntry(entries.back()));
+            entries.pop_back();
+        }
+        sut.recalculate();
+        soa.parallelRecalculate(pool);
+    }
+
+    TestOctreeType expected{128U, 128U, 128U, 256U, 4U, 8U};
+    expected.build(entries);
+    EXPECT_EQ(sortedEntries(sut), sortedEntries(expected));
+    EXPECT_EQ(sut.totalEntries(), entries.size());
+    EXPECT_EQ(soa.totalEntries(), entries.size());
+
+    // the totals are up to date and the entries are found by queries
+    for (auto const node : sut.getNodes())
+    {
+        size_t count{};
+        auto   counter = [&](TestOctreeType::Entry const &) noexcept { ++count; };
+        node->analyzeEntries(counter);
+        EXPECT_EQ(node->totalEntries(), count);
+        EXPECT_TRUE(node->getChildNodes().empty() || (count > 2U));
+    }
+    std::vector<TestOctreeType::Entry> output(entries.size());
+    EXPECT_EQ(sut.queryBox(TestOctreeType::Box{0U, 0U, 0U, 127U, 255U, 255U}, output),
+              expected.queryBox(TestOctreeType::Box{0U, 0U, 0U, 127U, 255U, 255U}, output));
+    EXPECT_EQ(soa.queryBox(SoAOctreeType::Box{30U, 0U, 60U, 127U, 255U, 200U}, output),
+              expected.queryBox(TestOctreeType::Box{30U, 0U, 60U, 127U, 255U, 200U}, output));
+}
+
 } // namespace Terrahertz::UnitTests
@@ -1,5 +1,6 @@
 #include "THzCommon/structures/queue.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <gtest/gtest.h>
 
@@ -24,7 +25,8 @@ TEST_F(StructuresQueue, QueueEmptyOnConstruction)
 {
     EXPECT_TRUE(sut.empty());
     EXPECT_EQ(sut.filled(), 0U);
-    EXPECT_TRUE(sut.data().empty());
+    EXPECT_TRUE(sut.firstSpan().empty());
+    EXPECT_TRUE(sut.secondSpan().empty());
 }
 
 TEST_F(StructuresQueue, PushElements)
@@ -33,7 +35,7 @@ TEST_F(StructuresQueue, PushElements)
     {
         EXPECT_FALSE(sut.empty());
         EXPECT_EQ(sut.filled(), 1U);
-        auto const data = sut.data();
+        auto const data = sut.firstSpan();
         ASSERT_EQ(data.size(), 1U);
         EXPECT_EQ(data[0], 23U);
     }
@@ -41,7 +43,7 @@ TEST_F(StructuresQueue, PushElements)
     {
         EXPECT_FALSE(sut.empty());
         EXPECT_EQ(sut.filled(), 2U);
-        auto const data = sut.data();
+        auto const data = sut.firstSpan();
         ASSERT_EQ(data.size(), 2U);
         EXPECT_EQ(data[0], 23U);
         EXPECT_EQ(data[1], 42U);
@@ -54,7 +56,7 @@ TEST_F(StructuresQueue, PushWhileFull)
     EXPECT_EQ(sut.filled(), sut.size());
     sut.push(23U);
     EXPECT_EQ(sut.filled(), sut.size());
-    for (auto const value : sut.data())
+    for (auto const value : sut.firstSpan())
     {
         EXPECT_EQ(value, 12U);
     }
@@ -68,7 +70,7 @@ TEST_F(StructuresQueue, Pop)
     sut.push(4U);
     sut.push(5U);
     sut.pop(2U);
-    auto const data = sut.data();
+    auto const data = sut.firstSpan();
     ASSERT_EQ(data.size(), 3U);
     EXPECT_EQ(data[0U], 3U);
     EXPECT_EQ(data[1U], 4U);
@@ -81,7 +83,8 @@ TEST_F(StructuresQueue, PopOnFullQueue)
     sut.push(1U);
     sut.pop(1U);
     EXPECT_EQ(sut.filled(), sut.size() - 1U);
-    EXPECT_EQ(sut.data().size(), sut.size() - 1U);
+    EXPECT_EQ(sut.firstSpan().size(), sut.size() - 1U);
+    EXPECT_TRUE(sut.secondSpan().empty());
 }
 
 TEST_F(StructuresQueue, PopMoreThanIsInTheQueue)
@@ -98,4 +101,128 @@ TEST_F(StructuresQueue, PopMoreThanIsInTheQueue)
     EXPECT_TRUE(sut.empty());
 }
 
+TEST_F(StructuresQueue, ValuesWrapAroundWithoutMoving)
+{
+    fillQueue();
+    sut.pop(5U);
+    auto const front = sut.firstSpan().data();
+    sut.push(1U);
+    sut.push(2U);
+    EXPECT_EQ(sut.filled(), 5U);
+
+    // the values at the front stay where they are, the new ones wrap around
+    auto const first  = sut.firstSpan();
+    auto const second = sut.secondSpan();
+    EXPECT_EQ(first.data(), front);
+    ASSERT_EQ(first.size(), 3U);
+    ASSERT_EQ(second.size(), 2U);
+    EXPECT_EQ(second[0U], 1U);
+    EXPECT_EQ(second[1U], 2U);
+
+    // once the front is popped the rest is contiguous again
+    sut.pop(3U);
+    EXPECT_EQ(sut.firstSpan().size(), 2U);
+    EXPECT_EQ(sut.firstSpan()[0U], 1U);
+    EXPECT_TRUE(sut.secondSpan().empty());
+}
+
+TEST_F(StructuresQueue, ValuesKeepOrderOverManyRounds)
+{
+    std::uint32_t next{};
+    std::uint32_t expected{};
+    for (auto round = 0U; round < 20U; ++round)
+    {
+        while (sut.filled() < sut.size())
+        {
+            sut.push(next++);
+        }
+
+        // both spans together hold all values in order
+        auto value = expected;
+        for (auto const stored : sut.firstSpan())
+        {
+            EXPECT_EQ(stored, value++);
+        }
+        for (auto const stored : sut.secondSpan())
+        {
+            EXPECT_EQ(stored, value++);
+        }
+        EXPECT_EQ(value, next);
+
+        sut.pop(3U);
+        expected += 3U;
+    }
+}
+
+TEST_F(StructuresQueue, MirroredMappingUsesGranularity)
+{
+    auto const granularity = Internal::MirroredMapping::granularity();
+    if (granularity == 0U)
+    {
+        GTEST_SKIP() << "Mirrored mappings not supported.";
+    }
+    EXPECT_EQ(Internal::MirroredMapping{granularity + 1U}.data(), nullptr);
+    EXPECT_EQ(Internal::MirroredMapping{0U}.data(), nullptr);
+
+    // writes to either half show up in the other one
+    Internal::MirroredMapping mapping{2U * granularity};
+    auto const                data = mapping.data();
+    ASSERT_NE(data, nullptr);
+    data[1U] = std::byte{42U};
+    EXPECT_EQ(data[(2U * granularity) + 1U], std::byte{42U});
+    data[(4U * granularity) - 1U] = std::byte{7U};
+    EXPECT_EQ(data[(2U * granularity) - 1U], std::byte{7U});
+}
+
+TEST_F(StructuresQueue, MirroredQueueIsAlwaysContiguous)
+{
+    // 64 KiB of values, a multiple of the common page sizes, so the memory can be double mapped where supported
+    constexpr std::uint32_t Capacity{16384U};
+
+    Queue<std::uint32_t, Capacity, QueueMode::Mirrored> mirrored{};
+    for (std::uint32_t i = 0U; i < mirrored.size(); ++i)
+    {
+        mirrored.push(i);
+    }
+    mirrored.pop(Capacity - 24U);
+    for (std::uint32_t i = 0U; i < 500U; ++i)
+    {
+        mirrored.push(Capacity + i);
+    }
+
+    auto const span = mirrored.firstSpan();
+    ASSERT_EQ(span.size(), 524U);
+    EXPECT_TRUE(mirrored.secondSpan().empty());
+    for (std::uint32_t i = 0U; i < span.size(); ++i)
+    {
+        EXPECT_EQ(span[i], Capacity - 24U + i);
+    }
+
+    auto const granularity = Internal::MirroredMapping::granularity();
+    auto const mappable    = (granularity != 0U) && (((sizeof(std::uint32_t) * Capacity) % granularity) == 0U);
+    EXPECT_EQ(mirrored.doubleMapped(), mappable);
+}
+
+TEST_F(StructuresQueue, MirroredQueueFallsBackToWritingTwice)
+{
+    // too small to be double mapped
+    Queue<std::uint32_t, 8U, QueueMode::Mirrored> mirrored{};
+    EXPECT_FALSE(mirrored.doubleMapped());
+    for (std::uint32_t i = 0U; i < 8U; ++i)
+    {
+        mirrored.push(i);
+    }
+    mirrored.pop(6U);
+    mirrored.push(8U);
+    mirrored.push(9U);
+
+    auto const span = mirrored.firstSpan();
+    ASSERT_EQ(span.size(), 4U);
+    EXPECT_EQ(span[0U], 6U);
+    EXPECT_EQ(span[1U], 7U);
+    EXPECT_EQ(span[2U], 8U);
+    EXPECT_EQ(span[3U], 9U);
+    EXPECT_FALSE(sut.doubleMapped());
+}
+
 } // namespace Terrahertz::UnitTests
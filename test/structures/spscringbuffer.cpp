@@ -0,0 +1,215 @@
+#include "THzCommon/structures/spscringbuffer.hpp"
+
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+namespace Terrahertz::UnitTests {
+
+struct StructuresSpscRingBuffer : public testing::Test
+{
+    using TestBuffer = SpscRingBuffer<std::uint32_t, 8U>;
+
+    TestBuffer sut{};
+
+    void fillBuffer() noexcept
+    {
+        for (auto i = 0U; i < sut.size(); ++i)
+        {
+            EXPECT_TRUE(sut.push(12U));
+        }
+    }
+};
+
+TEST_F(StructuresSpscRingBuffer, EmptyOnConstruction)
+{
+    EXPECT_TRUE(sut.empty());
+    EXPECT_EQ(sut.filled(), 0U);
+    EXPECT_EQ(sut.size(), 8U);
+    EXPECT_TRUE(sut.peek().empty());
+
+    std::uint32_t value{};
+    EXPECT_FALSE(sut.pop(value));
+}
+
+TEST_F(StructuresSpscRingBuffer, PositionsOnSeparateCacheLines)
+{
+    EXPECT_GE(alignof(TestBuffer), TestBuffer::CacheLineSize);
+    EXPECT_GE(sizeof(TestBuffer), 3U * TestBuffer::CacheLineSize);
+}
+
+TEST_F(StructuresSpscRingBuffer, PushAndPop)
+{
+    EXPECT_TRUE(sut.push(23U));
+    EXPECT_TRUE(sut.push(42U));
+    EXPECT_FALSE(sut.empty());
+    EXPECT_EQ(sut.filled(), 2U);
+
+    std::uint32_t value{};
+    EXPECT_TRUE(sut.pop(value));
+    EXPECT_EQ(value, 23U);
+    EXPECT_TRUE(sut.pop(value));
+    EXPECT_EQ(value, 42U);
+    EXPECT_FALSE(sut.pop(value));
+    EXPECT_TRUE(sut.empty());
+}
+
+TEST_F(StructuresSpscRingBuffer, PushWhileFull)
+{
+    fillBuffer();
+    EXPECT_EQ(sut.filled(), sut.size());
+    EXPECT_FALSE(sut.push(23U));
+    EXPECT_EQ(sut.filled(), sut.size());
+
+    std::uint32_t value{};
+    EXPECT_TRUE(sut.pop(value));
+    EXPECT_EQ(value, 12U);
+    EXPECT_TRUE(sut.push(23U));
+}
+
+TEST_F(StructuresSpscRingBuffer, ValuesKeepOrderAcrossWrapAround)
+{
+    std::uint32_t next{};
+    std::uint32_t expected{};
+    for (auto round = 0U; round < 10U; ++round)
+    {
+        for (auto i = 0U; i < 5U; ++i)
+        {
+            EXPECT_TRUE(sut.push(next++));
+        }
+        std::uint32_t value{};
+        for (auto i = 0U; i < 5U; ++i)
+        {
+            EXPECT_TRUE(sut.pop(value));
+            EXPECT_EQ(value, expected++);
+        }
+    }
+}
+
+TEST_F(StructuresSpscRingBuffer, BatchPushAndPop)
+{
+    std::array<std::uint32_t, 6U> input{};
+    std::iota(input.begin(), input.end(), 1U);
+    EXPECT_EQ(sut.push(std::span<std::uint32_t const>{input}), 6U);
+
+    // only the remaining space is used
+    EXPECT_EQ(sut.push(std::span<std::uint32_t const>{input}), 2U);
+    EXPECT_EQ(sut.filled(), 8U);
+
+    std::array<std::uint32_t, 5U> output{};
+    EXPECT_EQ(sut.pop(std::span{output}), 5U);
+    EXPECT_EQ(output, (std::array<std::uint32_t, 5U>{1U, 2U, 3U, 4U, 5U}));
+
+    // the batch wraps around the end of the buffer
+    EXPECT_EQ(sut.push(std::span<std::uint32_t const>{input}.first(4U)), 4U);
+    std::array<std::uint32_t, 10U> rest{};
+    EXPECT_EQ(sut.pop(std::span{rest}), 7U);
+    EXPECT_EQ(rest, (std::array<std::uint32_t, 10U>{6U, 1U, 2U, 1U, 2U, 3U, 4U, 0U, 0U, 0U}));
+    EXPECT_TRUE(sut.empty());
+}
+
+TEST_F(StructuresSpscRingBuffer, ReserveAndCommit)
+{
+    auto region = sut.reserve(5U);
+    ASSERT_EQ(region.size(), 5U);
+    std::iota(region.begin(), region.end(), 10U);
+
+    // nothing is visible before committing
+    EXPECT_TRUE(sut.empty());
+    sut.commit(3U);
+    EXPECT_EQ(sut.filled(), 3U);
+
+    // the region ends at the end of the buffer
+    region = sut.reserve(8U);
+    EXPECT_EQ(region.size(), 5U);
+    sut.commit(5U);
+    EXPECT_TRUE(sut.reserve(1U).empty());
+
+    std::uint32_t value{};
+    EXPECT_TRUE(sut.pop(value));
+    EXPECT_EQ(value, 10U);
+    EXPECT_TRUE(sut.pop(value));
+    EXPECT_TRUE(sut.pop(value));
+    EXPECT_EQ(value, 12U);
+
+    // space freed at the front becomes available after wrapping around
+    EXPECT_EQ(sut.reserve(8U).size(), 3U);
+}
+
+TEST_F(StructuresSpscRingBuffer, PeekAndConsume)
+{
+    std::array<std::uint32_t, 6U> input{};
+    std::iota(input.begin(), input.end(), 1U);
+    sut.push(std::span<std::uint32_t const>{input});
+
+    auto region = sut.peek(4U);
+    ASSERT_EQ(region.size(), 4U);
+    EXPECT_EQ(region[0U], 1U);
+    EXPECT_EQ(region[3U], 4U);
+    EXPECT_EQ(sut.filled(), 6U);
+    sut.consume(4U);
+    EXPECT_EQ(sut.filled(), 2U);
+
+    // the region ends at the end of the buffer
+    sut.push(std::span<std::uint32_t const>{input}.first(4U));
+    region = sut.peek();
+    ASSERT_EQ(region.size(), 4U);
+    EXPECT_EQ(region[0U], 5U);
+    EXPECT_EQ(region[1U], 6U);
+    EXPECT_EQ(region[2U], 1U);
+    sut.consume(region.size());
+    EXPECT_EQ(sut.peek().size(), 2U);
+}
+
+TEST_F(StructuresSpscRingBuffer, ProducerAndConsumerThreads)
+{
+    constexpr std::uint64_t Count = 100000U;
+
+    auto buffer = std::make_unique<SpscRingBuffer<std::uint64_t, 1024U>>();
+
+    std::thread producer{[&buffer]() noexcept {
+        std::array<std::uint64_t, 7U> batch{};
+        std::uint64_t                 next{};
+        while (next < Count)
+        {
+            // alternate between single values and batches
+            if ((next % 2U) == 0U)
+            {
+                next += buffer->push(next) ? 1U : 0U;
+                std::this_thread::yield();
+            }
+            else
+            {
+                auto const count = std::min<std::uint64_t>(batch.size(), Count - next);
+                std::iota(batch.begin(), batch.begin() + count, next);
+                next += buffer->push(std::span<std::uint64_t const>{batch}.first(count));
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    std::array<std::uint64_t, 13U> batch{};
+    std::uint64_t                  expected{};
+    bool                           inOrder{true};
+    while (expected < Count)
+    {
+        auto const count = buffer->pop(std::span{batch});
+        for (auto i = 0U; i < count; ++i)
+        {
+            inOrder = inOrder && (batch[i] == expected);
+            ++expected;
+        }
+        if (count == 0U)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(buffer->empty());
+}
+
+} // namespace Terrahertz::UnitTests
@@ -8,6 +8,12 @@ namespace Terrahertz::UnitTests {
 struct UtilityByteOrder : public testing::Test
 {};
 
+TEST_F(UtilityByteOrder, UInt16)
+{
+    std::uint16_t value{0x1234U};
+    EXPECT_EQ(flipByteOrder(value), 0x3412U);
+}
+
 TEST_F(UtilityByteOrder, UInt32)
 {
     std::uint32_t value{0x12345678U};
@@ -115,6 +115,13 @@ TEST_F(UtilityRange2D, UsableInForEachLoop)
     }
 }
 
+TEST_F(UtilityRange2D, DimensionsAccessible)
+{
+    Range2D const sut{16U, 9U};
+    EXPECT_EQ(sut.width(), 16U);
+    EXPECT_EQ(sut.height(), 9U);
+}
+
 TEST_F(UtilityRange2D, ConstructionWithWidthZeroDoesNotThrow) { Range2D::Iterator sut{0U, 0U}; }
 
 } // namespace Terrahertz::UnitTests
@@ -0,0 +1,132 @@
+#include "THzCommon/utility/task.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct UtilityTask : public testing::Test
+{
+    /// @brief Returns the given value.
+    ///
+    /// @param value The value to return.
+    /// @return The given value.
+    static Task<int> answer(int const value) noexcept { co_return value; }
+
+    /// @brief Adds up the results of two nested tasks.
+    ///
+    /// @return The sum of the results.
+    static Task<int> sum() noexcept
+    {
+        auto const first  = co_await answer(19);
+        auto const second = co_await answer(23);
+        co_return first + second;
+    }
+
+    /// @brief Awaits a chain of nested tasks.
+    ///
+    /// @param depth The remaining depth of the chain.
+    /// @return The depth of the chain.
+    static Task<std::uint32_t> chain(std::uint32_t const depth) noexcept
+    {
+        if (depth == 0U)
+        {
+            co_return 0U;
+        }
+        co_return (co_await chain(depth - 1U)) + 1U;
+    }
+
+    /// @brief Moves on to the pool and returns the thread it continued on.
+    ///
+    /// @param pool The pool to continue on.
+    /// @return The id of the thread the task continued on.
+    static Task<std::thread::id> moveTo(ThreadPool &pool) noexcept
+    {
+        co_await schedule(pool);
+        co_return std::this_thread::get_id();
+    }
+};
+
+TEST_F(UtilityTask, DefaultTaskNotValid)
+{
+    Task<int> sut{};
+    EXPECT_FALSE(sut.valid());
+    EXPECT_FALSE(sut.done());
+}
+
+TEST_F(UtilityTask, LazilyStarted)
+{
+    bool started{};
+
+    auto const body = [](bool &flag) noexcept -> Task<> {
+        flag = true;
+        co_return;
+    };
+    auto sut = body(started);
+    EXPECT_TRUE(sut.valid());
+    EXPECT_FALSE(started);
+    EXPECT_FALSE(sut.done());
+
+    syncWait(std::move(sut));
+    EXPECT_TRUE(started);
+}
+
+TEST_F(UtilityTask, SyncWaitReturnsResult) { EXPECT_EQ(syncWait(answer(42)), 42); }
+
+TEST_F(UtilityTask, NestedTasks) { EXPECT_EQ(syncWait(sum()), 42); }
+
+TEST_F(UtilityTask, MoveOnlyResult)
+{
+    auto const body = []() noexcept -> Task<std::unique_ptr<std::string>> {
+        co_return std::make_unique<std::string>("THz");
+    };
+    auto const result = syncWait(body());
+    ASSERT_TRUE(result);
+    EXPECT_EQ(*result, "THz");
+}
+
+TEST_F(UtilityTask, ChainOfTasks) { EXPECT_EQ(syncWait(chain(1000U)), 1000U); }
+
+TEST_F(UtilityTask, MoveAssignment)
+{
+    auto sut   = answer(1);
+    auto other = answer(2);
+    sut        = std::move(other);
+    EXPECT_EQ(syncWait(std::move(sut)), 2);
+}
+
+TEST_F(UtilityTask, ScheduleContinuesOnPool)
+{
+    ThreadPool pool{2U};
+
+    auto const caller = std::this_thread::get_id();
+    EXPECT_NE(syncWait(moveTo(pool)), caller);
+}
+
+TEST_F(UtilityTask, SpawnRunsDetached)
+{
+    std::atomic<std::uint32_t> finished{};
+
+    auto const body = [](ThreadPool &pool, std::atomic<std::uint32_t> &counter) noexcept -> Task<> {
+        co_await schedule(pool);
+        ++counter;
+    };
+    {
+        ThreadPool pool{2U};
+        for (auto i = 0U; i < 100U; ++i)
+        {
+            spawn(body(pool, finished));
+        }
+        // shutting down executes the remaining continuations
+        pool.shutdown();
+    }
+    EXPECT_EQ(finished, 100U);
+}
+
+} // namespace Terrahertz::UnitTests
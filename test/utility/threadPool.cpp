@@ -0,0 +1,311 @@
+#include "THzCommon/utility/threadPool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct UtilityWorkStealingDeque : public testing::Test
+{
+    /// @brief Job only counting its executions.
+    struct CountingJob : public Internal::PoolJob
+    {
+        void execute() noexcept override { ++executions; }
+
+        std::atomic<std::uint32_t> executions{};
+    };
+
+    Internal::WorkStealingDeque sut{4U};
+};
+
+TEST_F(UtilityWorkStealingDeque, EmptyOnConstruction)
+{
+    EXPECT_TRUE(sut.empty());
+    EXPECT_EQ(sut.take(), nullptr);
+    EXPECT_EQ(sut.steal(), nullptr);
+}
+
+TEST_F(UtilityWorkStealingDeque, OwnerTakesNewestThiefStealsOldest)
+{
+    std::vector<CountingJob> jobs(3U);
+    for (auto &job : jobs)
+    {
+        sut.push(&job);
+    }
+    EXPECT_FALSE(sut.empty());
+    EXPECT_EQ(sut.take(), &jobs[2U]);
+    EXPECT_EQ(sut.steal(), &jobs[0U]);
+    EXPECT_EQ(sut.take(), &jobs[1U]);
+    EXPECT_TRUE(sut.empty());
+}
+
+TEST_F(UtilityWorkStealingDeque, GrowsWhenFull)
+{
+    std::vector<CountingJob> jobs(100U);
+    for (auto &job : jobs)
+    {
+        sut.push(&job);
+    }
+    for (auto &job : jobs)
+    {
+        EXPECT_EQ(sut.steal(), &job);
+    }
+    EXPECT_TRUE(sut.empty());
+}
+
+TEST_F(UtilityWorkStealingDeque, EachJobHandedOutOnceUnderContention)
+{
+    constexpr std::size_t Count{50000U};
+
+    std::vector<CountingJob> jobs(Count);
+    std::atomic_bool         done{};
+
+    auto const steal = [&]() noexcept {
+        while (!done || !sut.empty())
+        {
+            if (auto const job = sut.steal(); job != nullptr)
+            {
+                job->execute();
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+    std::vector<std::thread> thieves{};
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        thieves.emplace_back(steal);
+    }
+    for (std::size_t i = 0U; i < Count; ++i)
+    {
+        sut.push(&jobs[i]);
+        if ((i % 3U) == 0U)
+        {
+            if (auto const job = sut.take(); job != nullptr)
+            {
+                job->execute();
+            }
+        }
+    }
+    while (auto const job = sut.take())
+    {
+        job->execute();
+    }
+    done = true;
+    for (auto &thief : thieves)
+    {
+        thief.join();
+    }
+
+    for (auto const &job : jobs)
+    {
+        EXPECT_EQ(job.executions, 1U);
+    }
+}
+
+struct UtilityThreadPool : public testing::Test
+{
+    /// @brief Sums up the values recursively, forking a job for the upper half of each range.
+    ///
+    /// @param pool The pool to fork the jobs into.
+    /// @param values The values to sum up.
+    /// @param begin The first index of the range.
+    /// @param end The index after the last index of the range.
+    /// @return The sum of the values of the range.
+    static std::uint64_t sum(ThreadPool                       &pool,
+                             std::vector<std::uint32_t> const &values,
+                             std::size_t const                 begin,
+                             std::size_t const                 end) noexcept
+    {
+        if ((end - begin) <= 256U)
+        {
+            return std::accumulate(values.begin() + begin, values.begin() + end, std::uint64_t{});
+        }
+        auto const middle = begin + ((end - begin) / 2U);
+        auto       upper  = pool.submit([&pool, &values, middle, end]() noexcept {
+            return sum(pool, values, middle, end);
+        });
+        auto const lower  = sum(pool, values, begin, middle);
+        return lower + upper.get();
+    }
+
+    ThreadPool sut{4U};
+};
+
+TEST_F(UtilityThreadPool, WorkerCount)
+{
+    EXPECT_EQ(sut.workerCount(), 4U);
+
+    ThreadPool pool{};
+    EXPECT_GE(pool.workerCount(), 1U);
+}
+
+TEST_F(UtilityThreadPool, DefaultFutureNotValid)
+{
+    TaskFuture<int> future{};
+    EXPECT_FALSE(future.valid());
+    EXPECT_FALSE(future.ready());
+    future.wait();
+}
+
+TEST_F(UtilityThreadPool, SubmitReturnsResult)
+{
+    auto future = sut.submit([]() noexcept { return 42; });
+    EXPECT_TRUE(future.valid());
+    EXPECT_EQ(future.get(), 42);
+    EXPECT_TRUE(future.ready());
+}
+
+TEST_F(UtilityThreadPool, SubmitWithoutResult)
+{
+    std::atomic_bool executed{};
+
+    auto future = sut.submit([&]() noexcept { executed = true; });
+    future.get();
+    EXPECT_TRUE(executed);
+}
+
+TEST_F(UtilityThreadPool, SubmitMoveOnlyResult)
+{
+    auto future = sut.submit([]() noexcept { return std::make_unique<std::string>("THz"); });
+    auto value  = future.get();
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*value, "THz");
+}
+
+TEST_F(UtilityThreadPool, PostExecutesFunction)
+{
+    std::atomic<std::uint32_t> executed{};
+    for (auto i = 0U; i < 100U; ++i)
+    {
+        sut.post([&]() noexcept { ++executed; });
+    }
+    sut.shutdown();
+    EXPECT_EQ(executed, 100U);
+}
+
+TEST_F(UtilityThreadPool, JobsExecutedByWorkers)
+{
+    auto future = sut.submit([]() noexcept { return std::this_thread::get_id(); });
+    // polling instead of waiting, as waiting would let the calling thread help out
+    while (!future.ready())
+    {
+        std::this_thread::yield();
+    }
+    EXPECT_NE(future.get(), std::this_thread::get_id());
+}
+
+TEST_F(UtilityThreadPool, RecursiveForkJoin)
+{
+    std::vector<std::uint32_t> values(100000U);
+    std::iota(values.begin(), values.end(), 0U);
+
+    auto future = sut.submit([&]() noexcept { return sum(sut, values, 0U, values.size()); });
+    EXPECT_EQ(future.get(), (values.size() * (values.size() - 1U)) / 2U);
+
+    // forking from outside the pool works as well
+    EXPECT_EQ(sum(sut, values, 0U, values.size()), (values.size() * (values.size() - 1U)) / 2U);
+}
+
+TEST_F(UtilityThreadPool, ParallelForCoversRangeOnce)
+{
+    std::vector<std::atomic<std::uint32_t>> visits(10000U);
+    sut.parallelFor(0U, visits.size(), [&](std::size_t const i) noexcept { ++visits[i]; });
+    for (auto const &visit : visits)
+    {
+        EXPECT_EQ(visit, 1U);
+    }
+
+    sut.parallelFor(
+        100U, 200U, [&](std::size_t const i) noexcept { ++visits[i]; }, 7U);
+    for (std::size_t i = 0U; i < visits.size(); ++i)
+    {
+        EXPECT_EQ(visits[i], ((i >= 100U) && (i < 200U)) ? 2U : 1U);
+    }
+}
+
+TEST_F(UtilityThreadPool, ParallelForEmptyRange)
+{
+    std::atomic<std::uint32_t> calls{};
+    sut.parallelFor(5U, 5U, [&](std::size_t) noexcept { ++calls; });
+    sut.parallelFor(6U, 5U, [&](std::size_t) noexcept { ++calls; });
+    sut.parallelFor(Range2D{0U, 4U}, [&](Range2D::Position) noexcept { ++calls; });
+    EXPECT_EQ(calls, 0U);
+}
+
+TEST_F(UtilityThreadPool, ParallelForRange2D)
+{
+    std::uint32_t const width{37U};
+    std::uint32_t const height{23U};
+
+    std::vector<std::atomic<std::uint32_t>> visits(width * height);
+    std::atomic_bool                        positionsCorrect{true};
+    sut.parallelFor(Range2D{width, height}, [&](Range2D::Position const position) noexcept {
+        if ((position.x >= width) || (position.y >= height) || (position.index != (position.y * width + position.x)))
+        {
+            positionsCorrect = false;
+            return;
+        }
+        ++visits[position];
+    });
+    EXPECT_TRUE(positionsCorrect);
+    for (auto const &visit : visits)
+    {
+        EXPECT_EQ(visit, 1U);
+    }
+}
+
+TEST_F(UtilityThreadPool, NestedParallelFor)
+{
+    std::vector<std::atomic<std::uint32_t>> visits(64U * 64U);
+    sut.parallelFor(
+        0U,
+        64U,
+        [&](std::size_t const outer) noexcept {
+            sut.parallelFor(
+                0U, 64U, [&](std::size_t const inner) noexcept { ++visits[outer * 64U + inner]; }, 4U);
+        },
+        1U);
+    for (auto const &visit : visits)
+    {
+        EXPECT_EQ(visit, 1U);
+    }
+}
+
+TEST_F(UtilityThreadPool, ShutdownExecutesPendingJobs)
+{
+    std::atomic<std::uint32_t> executed{};
+    for (auto i = 0U; i < 1000U; ++i)
+    {
+        sut.submit([&]() noexcept { ++executed; });
+    }
+    sut.shutdown();
+    EXPECT_EQ(executed, 1000U);
+
+    // calling it again does no harm
+    sut.shutdown();
+}
+
+TEST_F(UtilityThreadPool, SubmitAfterShutdownExecutesRightAway)
+{
+    sut.shutdown();
+
+    auto const caller = std::this_thread::get_id();
+    auto       future = sut.submit([]() noexcept { return std::this_thread::get_id(); });
+    EXPECT_TRUE(future.ready());
+    EXPECT_EQ(future.get(), caller);
+
+    std::atomic<std::uint32_t> calls{};
+    sut.parallelFor(0U, 100U, [&](std::size_t) noexcept { ++calls; });
+    EXPECT_EQ(calls, 100U);
+}
+
+} // namespace Terrahertz::UnitTests